@@ -6,7 +6,10 @@
 #ifndef AI_BEHAVIOR_HPP
 #define AI_BEHAVIOR_HPP
 
+#include "ai/AIMessage.hpp"
+#include "core/FrameContext.hpp"
 #include "entities/Entity.hpp"
+#include <span>
 #include <string>
 
 class AIBehavior {
@@ -16,14 +19,78 @@ public:
     // Core behavior methods - pure logic only
     virtual void executeLogic(EntityPtr entity) = 0;
     virtual void init(EntityPtr entity) = 0;
+
+    /**
+     * @brief Run this behavior for one entity with the frame's shared values
+     *
+     * Behaviors that read the clock or the player override this and take
+     * both from the context. The default ignores the context and calls
+     * executeLogic(entity).
+     */
+    virtual void executeLogic(EntityPtr entity, [[maybe_unused]] const FrameContext& context) {
+        executeLogic(entity);
+    }
+
     virtual void clean(EntityPtr entity) = 0;
 
+    /**
+     * @brief Run this behavior for a run of entities assigned to it
+     *
+     * AIManager groups its update list by BehaviorType and passes each run of
+     * consecutive entities sharing this instance in one call, so overrides
+     * can hoist per-frame work and loop over their states back to back.
+     * Cloned behaviors usually get runs of one. The default calls
+     * executeLogic() for each entity with the context narrowed to it.
+     */
+    virtual void executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) {
+        for (size_t i = 0; i < entities.size(); ++i) {
+            executeLogic(entities[i], context.forEntity(i));
+        }
+    }
+
     // Behavior identification
     virtual std::string getName() const = 0;
 
-    // Optional message handling for behavior communication
+    /**
+     * @brief Handle a message sent to an entity running this behavior
+     *
+     * AIManager delivers queued messages from the batch that updates the
+     * recipient, just before the recipient's executeLogic(). For a shared
+     * behavior other workers may be running it for other entities at the
+     * time, so a handler may only touch the recipient's own state and must
+     * not add or remove pool entries. The default looks up the message's
+     * name and calls the string overload.
+     */
+    virtual void onMessage(EntityPtr entity, const AIMessage& message) {
+        onMessage(entity, AIMessageRegistry::name(message.id));
+    }
+
+    // Name-based handling for behaviors that do not switch on message ids
     virtual void onMessage([[maybe_unused]] EntityPtr entity, [[maybe_unused]] const std::string& message) { }
 
+    // Whether onMessage() does anything with this id. Checked once per run of
+    // entities sharing an instance, so broadcasts skip behaviors that would
+    // ignore them.
+    virtual bool acceptsMessage([[maybe_unused]] AIMessageId id) const { return true; }
+
+    /**
+     * @brief What this behavior's entities should sense of the player
+     *
+     * Return true and fill settings to have AIManager work out each entity's
+     * Awareness in the batch that updates it, before executeBatch(). The
+     * entries arrive as FrameContext::entityAwareness, and as
+     * FrameContext::awareness once narrowed to one entity. Checked once per
+     * run of entities sharing an instance. The default senses nothing.
+     */
+    virtual bool getPerceptionSettings([[maybe_unused]] PerceptionSettings& settings) const { return false; }
+
+    // Unit direction an entity faces, for the view cone. Called from the batch
+    // updating the entity, just before executeBatch(). When this returns
+    // false the entity faces the way it last moved.
+    virtual bool getFacing([[maybe_unused]] const Entity& entity, [[maybe_unused]] Vector2D& facing) const {
+        return false;
+    }
+
     // Behavior state access
     virtual bool isActive() const { return m_active; }
     virtual void setActive(bool active) { m_active = active; }
@@ -33,12 +100,26 @@ public:
     // Entity range checks (behavior-specific logic)
     virtual bool isEntityInRange([[maybe_unused]] EntityPtr entity) const { return true; }
 
-    // Entity cleanup
+    // Entity cleanup: drop per-entity data without side effects on the entity.
+    // AIManager calls this when it removes an entity's slot.
     virtual void cleanupEntity(EntityPtr entity);
 
     // Clone method for creating unique behavior instances
     virtual std::shared_ptr<AIBehavior> clone() const = 0;
 
+    /**
+     * @brief Whether one instance can drive every entity assigned to it
+     *
+     * Shared behaviors keep all per-entity data in a BehaviorStatePool and
+     * never write other members from executeLogic(). AIManager then assigns
+     * the registered instance itself instead of a clone, so N entities cost
+     * one behavior plus N pooled states. executeLogic() may run on several
+     * workers at once for different entities, and so may queued
+     * onMessage() deliveries; AIManager keeps init(), clean(), immediate
+     * messages and cleanupEntity() from overlapping it.
+     */
+    virtual bool isShared() const { return false; }
+
     // Expose to AIManager for behavior management
     friend class AIManager;
 
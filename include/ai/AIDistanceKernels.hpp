@@ -0,0 +1,370 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef AI_DISTANCE_KERNELS_HPP
+#define AI_DISTANCE_KERNELS_HPP
+
+/**
+ * @file AIDistanceKernels.hpp
+ * @brief SIMD kernels over AIManager's structure-of-arrays hot data
+ *
+ * Passes over contiguous per-entity arrays:
+ * - distancesSquared(): squared distance from every entity to the player
+ * - buildUpdateList(): priority-scaled range test that writes a compact
+ *   list of the active entities to update this frame
+ * - buildScheduledUpdateList(): sorts entities into distance tiers and
+ *   lists the ones whose tier interval comes due this frame
+ *
+ * The backend is chosen at compile time: AVX2 (8 lanes) when the build
+ * enables it (release x86 builds use -mavx2), SSE2 (4 lanes) on any other
+ * x86-64 build, and a branch-free scalar loop everywhere else. The scalar
+ * versions are always available for reference and benchmarking.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AI_KERNELS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AI_KERNELS_SSE2 1
+#endif
+
+namespace AIDistanceKernels {
+
+enum class Backend : uint8_t {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+// Range thresholds per priority. AIManager clamps priorities to 0-9; the
+// kernels clamp anything higher to the last entry. 16 entries fit two AVX2
+// registers, so the lookup is a pair of permutes instead of a gather.
+static constexpr size_t PRIORITY_THRESHOLD_COUNT = 16;
+
+// Distance tiers of the update schedule: near, mid, far and distant
+static constexpr size_t UPDATE_TIER_COUNT = 4;
+
+/**
+ * @brief Per-priority tier bounds and update intervals for buildScheduledUpdateList()
+ *
+ * An entity is in tier t when its squared distance exceeds the bounds of
+ * every tier below t. It updates on frames where
+ * ((frame + phase) & intervalMasks[t][priority]) == 0, so intervals are
+ * powers of two and the phase spreads entities of one tier evenly across
+ * the frames of its interval.
+ */
+struct UpdateSchedule {
+    alignas(32) float tierLimits[UPDATE_TIER_COUNT - 1][PRIORITY_THRESHOLD_COUNT]{};
+    alignas(32) uint32_t intervalMasks[UPDATE_TIER_COUNT][PRIORITY_THRESHOLD_COUNT]{};
+};
+
+#if defined(AI_KERNELS_AVX2)
+static constexpr Backend ACTIVE_BACKEND = Backend::AVX2;
+#elif defined(AI_KERNELS_SSE2)
+static constexpr Backend ACTIVE_BACKEND = Backend::SSE2;
+#else
+static constexpr Backend ACTIVE_BACKEND = Backend::Scalar;
+#endif
+
+inline const char* backendName(Backend backend) {
+    switch (backend) {
+        case Backend::AVX2: return "AVX2";
+        case Backend::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
+
+/**
+ * @brief Fill the per-priority squared range table used by buildUpdateList()
+ *
+ * threshold[p] = maxDistSquared * (1 + p * priorityStep)^2, so priority 9
+ * with the default step of 0.1 updates out to 1.9x the base distance.
+ */
+inline void buildPriorityThresholds(float maxDistSquared, float priorityStep, float* thresholds) {
+    for (size_t p = 0; p < PRIORITY_THRESHOLD_COUNT; ++p) {
+        float multiplier = 1.0f + static_cast<float>(p) * priorityStep;
+        thresholds[p] = maxDistSquared * multiplier * multiplier;
+    }
+}
+
+inline void distancesSquaredScalar(const float* x, const float* y, size_t count,
+                                   float targetX, float targetY, float* out) {
+    for (size_t i = 0; i < count; ++i) {
+        float dx = x[i] - targetX;
+        float dy = y[i] - targetY;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+/**
+ * @brief Write indices of active entities within their priority range
+ * @param thresholds PRIORITY_THRESHOLD_COUNT entries from buildPriorityThresholds()
+ * @param out Must hold at least count entries
+ * @param firstIndex Added to every written index
+ * @return Number of indices written, in ascending order
+ */
+inline size_t buildUpdateListScalar(const float* distSquared, const uint8_t* active, const uint8_t* priority,
+                                    size_t count, const float* thresholds, uint32_t* out,
+                                    uint32_t firstIndex = 0) {
+    constexpr uint8_t maxPriority = PRIORITY_THRESHOLD_COUNT - 1;
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        float limit = thresholds[priority[i] < maxPriority ? priority[i] : maxPriority];
+        // Branch-free compaction: always store, only advance on a hit
+        out[written] = firstIndex + static_cast<uint32_t>(i);
+        written += static_cast<size_t>((active[i] != 0) & (distSquared[i] <= limit));
+    }
+    return written;
+}
+
+/**
+ * @brief Write indices of active entities whose tier interval is due this frame
+ * @param phase Per-entity stagger key; a stable per-entity value keeps the
+ *              entity on the same frames of its interval
+ * @param frame Frame number; wraps safely since intervals divide 2^32
+ * @return Number of indices written, in ascending order
+ */
+inline size_t buildScheduledUpdateListScalar(const float* distSquared, const uint8_t* active,
+                                             const uint8_t* priority, const uint32_t* phase, size_t count,
+                                             const UpdateSchedule& schedule, uint32_t frame, uint32_t* out,
+                                             uint32_t firstIndex = 0) {
+    constexpr uint8_t maxPriority = PRIORITY_THRESHOLD_COUNT - 1;
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t p = priority[i] < maxPriority ? priority[i] : maxPriority;
+        const float d = distSquared[i];
+        // Same select order as the SIMD paths, so NaN distances land in tier 0 everywhere
+        uint32_t mask = schedule.intervalMasks[0][p];
+        mask = d > schedule.tierLimits[0][p] ? schedule.intervalMasks[1][p] : mask;
+        mask = d > schedule.tierLimits[1][p] ? schedule.intervalMasks[2][p] : mask;
+        mask = d > schedule.tierLimits[2][p] ? schedule.intervalMasks[3][p] : mask;
+        out[written] = firstIndex + static_cast<uint32_t>(i);
+        written += static_cast<size_t>((active[i] != 0) & (((frame + phase[i]) & mask) == 0));
+    }
+    return written;
+}
+
+namespace detail {
+
+// Compaction table: for every lane mask, the set lanes packed to the front
+// plus their count. The SIMD loops add the block base to the packed lanes,
+// store a full vector at the output cursor and advance by the count, so the
+// list is built without a branch per entity.
+template<unsigned Lanes, typename LaneType>
+struct CompactTable {
+    alignas(16) LaneType lanes[1u << Lanes][Lanes]{};
+    uint8_t count[1u << Lanes]{};
+
+    constexpr CompactTable() {
+        for (unsigned mask = 0; mask < (1u << Lanes); ++mask) {
+            uint8_t n = 0;
+            for (unsigned lane = 0; lane < Lanes; ++lane) {
+                if (mask & (1u << lane)) {
+                    lanes[mask][n++] = static_cast<LaneType>(lane);
+                }
+            }
+            count[mask] = n;
+        }
+    }
+};
+
+// AVX2 widens 8 byte lanes on load; SSE2 has no widening load, so its lanes
+// are stored ready to use
+inline constexpr CompactTable<8, uint8_t> COMPACT_TABLE_8{};
+inline constexpr CompactTable<4, uint32_t> COMPACT_TABLE_4{};
+
+#if defined(AI_KERNELS_AVX2)
+// 16-entry priority table lookup: a permute of each half, then pick the
+// high half for priorities 8-15
+inline __m256 lookupPriority(const float* table, __m256i priorities, __m256 highLanes) {
+    return _mm256_blendv_ps(_mm256_permutevar8x32_ps(_mm256_load_ps(table), priorities),
+                            _mm256_permutevar8x32_ps(_mm256_load_ps(table + 8), priorities), highLanes);
+}
+
+inline __m256i lookupPriority(const uint32_t* table, __m256i priorities, __m256 highLanes) {
+    const __m256i* rows = reinterpret_cast<const __m256i*>(table);
+    return _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(_mm256_load_si256(rows), priorities),
+                              _mm256_permutevar8x32_epi32(_mm256_load_si256(rows + 1), priorities),
+                              _mm256_castps_si256(highLanes));
+}
+#elif defined(AI_KERNELS_SSE2)
+inline __m128i select(__m128 condition, __m128i ifTrue, __m128i ifFalse) {
+    __m128i mask = _mm_castps_si128(condition);
+    return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+}
+#endif
+
+} // namespace detail
+
+inline void distancesSquared(const float* x, const float* y, size_t count,
+                             float targetX, float targetY, float* out) {
+    size_t i = 0;
+#if defined(AI_KERNELS_AVX2)
+    const __m256 tx = _mm256_set1_ps(targetX);
+    const __m256 ty = _mm256_set1_ps(targetY);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), tx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), ty);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    }
+#elif defined(AI_KERNELS_SSE2)
+    const __m128 tx = _mm_set1_ps(targetX);
+    const __m128 ty = _mm_set1_ps(targetY);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), tx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), ty);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    }
+#endif
+    distancesSquaredScalar(x + i, y + i, count - i, targetX, targetY, out + i);
+}
+
+inline size_t buildUpdateList(const float* distSquared, const uint8_t* active, const uint8_t* priority,
+                              size_t count, const float* thresholds, uint32_t* out) {
+    constexpr uint8_t maxPriority = PRIORITY_THRESHOLD_COUNT - 1;
+    size_t i = 0;
+    size_t written = 0;
+#if defined(AI_KERNELS_AVX2)
+    const __m256 limitsLow = _mm256_loadu_ps(thresholds);
+    const __m256 limitsHigh = _mm256_loadu_ps(thresholds + 8);
+    const __m256i clampPriority = _mm256_set1_epi32(maxPriority);
+    const __m256i highStart = _mm256_set1_epi32(7);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        __m256i priorities = _mm256_min_epu32(
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(priority + i))), clampPriority);
+        // permutevar uses the low 3 bits; pick the high half for priorities 8-15
+        __m256 limit = _mm256_blendv_ps(_mm256_permutevar8x32_ps(limitsLow, priorities),
+                                        _mm256_permutevar8x32_ps(limitsHigh, priorities),
+                                        _mm256_castsi256_ps(_mm256_cmpgt_epi32(priorities, highStart)));
+        __m256 inRange = _mm256_cmp_ps(_mm256_loadu_ps(distSquared + i), limit, _CMP_LE_OQ);
+
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i)));
+        __m256 inactive = _mm256_castsi256_ps(_mm256_cmpeq_epi32(flags, zero));
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_andnot_ps(inactive, inRange)));
+        // Stores all 8 lanes; written <= i, so the store stays inside out[0, count)
+        __m256i packed = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(detail::COMPACT_TABLE_8.lanes[mask])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+                            _mm256_add_epi32(packed, _mm256_set1_epi32(static_cast<int>(i))));
+        written += detail::COMPACT_TABLE_8.count[mask];
+    }
+#elif defined(AI_KERNELS_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        // No variable permute before AVX, so the four limits are plain loads
+        __m128 limit = _mm_setr_ps(thresholds[priority[i] < maxPriority ? priority[i] : maxPriority],
+                                   thresholds[priority[i + 1] < maxPriority ? priority[i + 1] : maxPriority],
+                                   thresholds[priority[i + 2] < maxPriority ? priority[i + 2] : maxPriority],
+                                   thresholds[priority[i + 3] < maxPriority ? priority[i + 3] : maxPriority]);
+        __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(distSquared + i), limit);
+
+        int32_t flagBytes;
+        std::memcpy(&flagBytes, active + i, sizeof(flagBytes));
+        __m128i flags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(flagBytes), zero), zero);
+        __m128 inactive = _mm_castsi128_ps(_mm_cmpeq_epi32(flags, zero));
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_andnot_ps(inactive, inRange)));
+        __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(detail::COMPACT_TABLE_4.lanes[mask]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),
+                         _mm_add_epi32(packed, _mm_set1_epi32(static_cast<int>(i))));
+        written += detail::COMPACT_TABLE_4.count[mask];
+    }
+#endif
+    // Tail (and the whole range on scalar builds)
+    return written + buildUpdateListScalar(distSquared + i, active + i, priority + i, count - i,
+                                           thresholds, out + written, static_cast<uint32_t>(i));
+}
+
+inline size_t buildScheduledUpdateList(const float* distSquared, const uint8_t* active, const uint8_t* priority,
+                                       const uint32_t* phase, size_t count, const UpdateSchedule& schedule,
+                                       uint32_t frame, uint32_t* out) {
+    constexpr uint8_t maxPriority = PRIORITY_THRESHOLD_COUNT - 1;
+    size_t i = 0;
+    size_t written = 0;
+#if defined(AI_KERNELS_AVX2)
+    const __m256i clampPriority = _mm256_set1_epi32(maxPriority);
+    const __m256i highStart = _mm256_set1_epi32(7);
+    const __m256i frameLanes = _mm256_set1_epi32(static_cast<int>(frame));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        __m256i priorities = _mm256_min_epu32(
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(priority + i))), clampPriority);
+        __m256 highLanes = _mm256_castsi256_ps(_mm256_cmpgt_epi32(priorities, highStart));
+        __m256 d = _mm256_loadu_ps(distSquared + i);
+
+        // Later tiers override earlier ones, as in the scalar loop
+        __m256i mask = detail::lookupPriority(schedule.intervalMasks[0], priorities, highLanes);
+        for (size_t tier = 1; tier < UPDATE_TIER_COUNT; ++tier) {
+            __m256 beyond = _mm256_cmp_ps(d, detail::lookupPriority(schedule.tierLimits[tier - 1], priorities,
+                                                                    highLanes), _CMP_GT_OQ);
+            mask = _mm256_blendv_epi8(mask, detail::lookupPriority(schedule.intervalMasks[tier], priorities,
+                                                                   highLanes), _mm256_castps_si256(beyond));
+        }
+        __m256i phases = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(phase + i));
+        __m256i due = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_add_epi32(phases, frameLanes), mask), zero);
+
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i)));
+        __m256 inactive = _mm256_castsi256_ps(_mm256_cmpeq_epi32(flags, zero));
+
+        unsigned laneMask = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_andnot_ps(inactive, _mm256_castsi256_ps(due))));
+        __m256i packed = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(detail::COMPACT_TABLE_8.lanes[laneMask])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+                            _mm256_add_epi32(packed, _mm256_set1_epi32(static_cast<int>(i))));
+        written += detail::COMPACT_TABLE_8.count[laneMask];
+    }
+#elif defined(AI_KERNELS_SSE2)
+    const __m128i frameLanes = _mm_set1_epi32(static_cast<int>(frame));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        const size_t p0 = priority[i] < maxPriority ? priority[i] : maxPriority;
+        const size_t p1 = priority[i + 1] < maxPriority ? priority[i + 1] : maxPriority;
+        const size_t p2 = priority[i + 2] < maxPriority ? priority[i + 2] : maxPriority;
+        const size_t p3 = priority[i + 3] < maxPriority ? priority[i + 3] : maxPriority;
+        __m128 d = _mm_loadu_ps(distSquared + i);
+
+        const uint32_t* masks = schedule.intervalMasks[0];
+        __m128i mask = _mm_setr_epi32(static_cast<int>(masks[p0]), static_cast<int>(masks[p1]),
+                                      static_cast<int>(masks[p2]), static_cast<int>(masks[p3]));
+        for (size_t tier = 1; tier < UPDATE_TIER_COUNT; ++tier) {
+            const float* limits = schedule.tierLimits[tier - 1];
+            masks = schedule.intervalMasks[tier];
+            __m128 beyond = _mm_cmpgt_ps(d, _mm_setr_ps(limits[p0], limits[p1], limits[p2], limits[p3]));
+            mask = detail::select(beyond,
+                                  _mm_setr_epi32(static_cast<int>(masks[p0]), static_cast<int>(masks[p1]),
+                                                 static_cast<int>(masks[p2]), static_cast<int>(masks[p3])),
+                                  mask);
+        }
+        __m128i phases = _mm_loadu_si128(reinterpret_cast<const __m128i*>(phase + i));
+        __m128i due = _mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(phases, frameLanes), mask), zero);
+
+        int32_t flagBytes;
+        std::memcpy(&flagBytes, active + i, sizeof(flagBytes));
+        __m128i flags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(flagBytes), zero), zero);
+        __m128 inactive = _mm_castsi128_ps(_mm_cmpeq_epi32(flags, zero));
+
+        unsigned laneMask = static_cast<unsigned>(_mm_movemask_ps(_mm_andnot_ps(inactive, _mm_castsi128_ps(due))));
+        __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(detail::COMPACT_TABLE_4.lanes[laneMask]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),
+                         _mm_add_epi32(packed, _mm_set1_epi32(static_cast<int>(i))));
+        written += detail::COMPACT_TABLE_4.count[laneMask];
+    }
+#endif
+    return written + buildScheduledUpdateListScalar(distSquared + i, active + i, priority + i, phase + i,
+                                                    count - i, schedule, frame, out + written,
+                                                    static_cast<uint32_t>(i));
+}
+
+} // namespace AIDistanceKernels
+
+#endif // AI_DISTANCE_KERNELS_HPP
@@ -0,0 +1,194 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef AI_MESSAGE_HPP
+#define AI_MESSAGE_HPP
+
+/**
+ * @file AIMessage.hpp
+ * @brief Interned AI message ids and the small message passed to behaviors
+ *
+ * A message id is the 32-bit FNV-1a hash of the message name. Because it is
+ * constexpr, behaviors can switch on the AIMessages constants, and sending a
+ * message never copies or compares strings. AIMessageRegistry keeps the name
+ * for each interned id. Behaviors that still handle messages by name get the
+ * name from it, and it reports two names that hash to the same id.
+ */
+
+#include "core/Logger.hpp"
+#include "entities/EntityHandle.hpp"
+#include "utils/Vector2D.hpp"
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using AIMessageId = uint32_t;
+inline constexpr AIMessageId AI_MESSAGE_NONE = 0;
+
+constexpr AIMessageId aiMessageId(std::string_view name) {
+    if (name.empty()) {
+        return AI_MESSAGE_NONE;
+    }
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    // 0 is reserved for "no message"
+    return hash == AI_MESSAGE_NONE ? 1u : hash;
+}
+
+/**
+ * @brief One message for one entity
+ *
+ * The payload fields are optional and their meaning is set by the message,
+ * e.g. the threat position of a help call. The struct is copied into the
+ * inbox as-is, so it stays small and trivially copyable.
+ */
+struct AIMessage {
+    AIMessageId id{AI_MESSAGE_NONE};
+    EntityHandle sender{};
+    Vector2D position{0.0f, 0.0f};
+    float value{0.0f};
+
+    AIMessage() = default;
+    explicit AIMessage(AIMessageId messageId, EntityHandle from = {},
+                       const Vector2D& where = Vector2D(0.0f, 0.0f), float amount = 0.0f)
+        : id(messageId), sender(from), position(where), value(amount) {}
+};
+
+// Messages the built-in behaviors send or handle: X(CONSTANT, "name")
+#define HAMMER_AI_MESSAGES(X)                        \
+    X(PAUSE, "pause")                                \
+    X(RESUME, "resume")                              \
+    X(RELEASE_ENTITIES, "release_entities")          \
+    X(NEW_DIRECTION, "new_direction")                \
+    X(INCREASE_SPEED, "increase_speed")              \
+    X(DECREASE_SPEED, "decrease_speed")              \
+    X(REVERSE, "reverse")                            \
+    X(LOSE_TARGET, "lose_target")                    \
+    X(IDLE_STATIONARY, "idle_stationary")            \
+    X(IDLE_SWAY, "idle_sway")                        \
+    X(IDLE_TURN, "idle_turn")                        \
+    X(IDLE_FIDGET, "idle_fidget")                    \
+    X(RESET_POSITION, "reset_position")              \
+    X(FOLLOW_CLOSE, "follow_close")                  \
+    X(FOLLOW_LOOSE, "follow_loose")                  \
+    X(FOLLOW_FLANK, "follow_flank")                  \
+    X(FOLLOW_REAR, "follow_rear")                    \
+    X(FOLLOW_FORMATION, "follow_formation")          \
+    X(STOP_FOLLOWING, "stop_following")              \
+    X(START_FOLLOWING, "start_following")            \
+    X(RESET_FORMATION, "reset_formation")            \
+    X(PANIC, "panic")                                \
+    X(CALM_DOWN, "calm_down")                        \
+    X(STOP_FLEEING, "stop_fleeing")                  \
+    X(RECOVER_STAMINA, "recover_stamina")            \
+    X(GO_ON_DUTY, "go_on_duty")                      \
+    X(GO_OFF_DUTY, "go_off_duty")                    \
+    X(RAISE_ALERT, "raise_alert")                    \
+    X(CLEAR_ALERT, "clear_alert")                    \
+    X(INVESTIGATE_POSITION, "investigate_position")  \
+    X(RETURN_TO_POST, "return_to_post")              \
+    X(PATROL_MODE, "patrol_mode")                    \
+    X(STATIC_MODE, "static_mode")                    \
+    X(ROAM_MODE, "roam_mode")                        \
+    X(GUARD_HELP_NEEDED, "guard_help_needed")        \
+    X(GUARD_ALERT, "guard_alert")                    \
+    X(ATTACK_TARGET, "attack_target")                \
+    X(RETREAT, "retreat")                            \
+    X(STOP_ATTACK, "stop_attack")                    \
+    X(ENABLE_COMBO, "enable_combo")                  \
+    X(DISABLE_COMBO, "disable_combo")                \
+    X(HEAL, "heal")                                  \
+    X(BERSERK, "berserk")                            \
+    X(COORDINATE_ATTACK, "coordinate_attack")
+
+namespace AIMessages {
+
+#define HAMMER_AI_MESSAGE_ID(constant, name) inline constexpr AIMessageId constant = aiMessageId(name);
+HAMMER_AI_MESSAGES(HAMMER_AI_MESSAGE_ID)
+#undef HAMMER_AI_MESSAGE_ID
+
+#define HAMMER_AI_MESSAGE_NAME(constant, name) std::string_view(name),
+inline constexpr std::string_view BUILTIN_NAMES[] = {HAMMER_AI_MESSAGES(HAMMER_AI_MESSAGE_NAME)};
+#undef HAMMER_AI_MESSAGE_NAME
+
+constexpr bool builtinIdsAreUnique() {
+    constexpr size_t count = sizeof(BUILTIN_NAMES) / sizeof(BUILTIN_NAMES[0]);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 1; j < count; ++j) {
+            if (aiMessageId(BUILTIN_NAMES[i]) == aiMessageId(BUILTIN_NAMES[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(builtinIdsAreUnique(), "Two built-in AI message names hash to the same id");
+
+} // namespace AIMessages
+
+/**
+ * @brief Names of interned message ids
+ *
+ * Built-in names are registered up front. intern() adds others the first
+ * time they are seen; names are never removed, so references returned by
+ * name() stay valid. Thread-safe.
+ */
+class AIMessageRegistry {
+public:
+    static AIMessageId intern(std::string_view name) {
+        const AIMessageId id = aiMessageId(name);
+        if (id == AI_MESSAGE_NONE) {
+            return id;
+        }
+
+        Table& table = instance();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            auto it = table.names.find(id);
+            if (it != table.names.end()) {
+                if (it->second != name) {
+                    AI_ERROR("AI message '" + std::string(name) + "' has the same id as '" + it->second + "'");
+                }
+                return id;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        table.names.try_emplace(id, name);
+        return id;
+    }
+
+    // Empty if the id was never interned
+    static const std::string& name(AIMessageId id) {
+        static const std::string unknown;
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.names.find(id);
+        return it != table.names.end() ? it->second : unknown;
+    }
+
+private:
+    struct Table {
+        std::shared_mutex mutex;
+        std::unordered_map<AIMessageId, std::string> names;
+
+        Table() {
+            for (std::string_view builtin : AIMessages::BUILTIN_NAMES) {
+                names.try_emplace(aiMessageId(builtin), builtin);
+            }
+        }
+    };
+
+    static Table& instance() {
+        static Table table;
+        return table;
+    }
+};
+
+#endif // AI_MESSAGE_HPP
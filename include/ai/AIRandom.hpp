@@ -0,0 +1,90 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef AI_RANDOM_HPP
+#define AI_RANDOM_HPP
+
+/**
+ * @file AIRandom.hpp
+ * @brief Counter-based random numbers for AI behaviors
+ *
+ * AIRandom keeps no generator state between uses. Every draw hashes a
+ * counter with Widynski's Squares function. The counter combines the frame
+ * number, a stream id and the position of the draw in the sequence. The key
+ * combines the world seed and the entity's handle. The same (seed, entity,
+ * frame, stream) always gives the same numbers, whichever worker runs the
+ * entity and in whatever order. Multi-threaded updates therefore replay bit
+ * for bit, and behaviors need no shared mutable engine.
+ *
+ * Build one on the stack where numbers are needed and draw from it in
+ * order. Different decisions for the same entity in the same frame should
+ * use different streams, or they get the same numbers. A sequence holds
+ * 65536 draws before it runs into the next stream.
+ */
+
+#include "core/FrameContext.hpp"
+#include "entities/EntityHandle.hpp"
+#include <cstdint>
+
+class AIRandom {
+public:
+    AIRandom(uint64_t seed, EntityHandle handle, uint64_t frame, uint16_t stream)
+        : m_key(makeKey(seed, handle)),
+          m_counter(((frame & 0xFFFFFFFFull) << 32) | (static_cast<uint64_t>(stream) << 16)) {}
+
+    // Keyed by the frame's seed and number
+    AIRandom(const FrameContext& context, EntityHandle handle, uint16_t stream)
+        : AIRandom(context.randomSeed, handle, context.frameNumber, stream) {}
+
+    uint32_t nextU32() { return squares32(m_counter++, m_key); }
+
+    // Uniform in [0, 1)
+    float nextFloat() { return static_cast<float>(nextU32() >> 8) * (1.0f / 16777216.0f); }
+
+    // Uniform in [min, max)
+    float range(float min, float max) { return min + (max - min) * nextFloat(); }
+
+    // Uniform in [0, bound); bound 0 gives 0
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(nextU32()) * bound) >> 32);
+    }
+
+    // Uniform angle in [0, 2*pi) radians
+    float angle() { return nextFloat() * 6.28318530717958647692f; }
+
+private:
+    uint64_t m_key;
+    uint64_t m_counter;
+
+    static uint64_t mix64(uint64_t x) {
+        // SplitMix64 finalizer
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static uint64_t makeKey(uint64_t seed, EntityHandle handle) {
+        const uint64_t entity = (static_cast<uint64_t>(handle.generation) << 32) | handle.index;
+        // Squares wants an odd key with well-mixed bits
+        return mix64(seed ^ mix64(entity)) | 1ull;
+    }
+
+    // Squares: four rounds of middle-square with a Weyl sequence (Widynski, 2020)
+    static uint32_t squares32(uint64_t counter, uint64_t key) {
+        uint64_t x = counter * key;
+        const uint64_t y = x;
+        const uint64_t z = y + key;
+        x = x * x + y;
+        x = (x >> 32) | (x << 32);
+        x = x * x + z;
+        x = (x >> 32) | (x << 32);
+        x = x * x + y;
+        x = (x >> 32) | (x << 32);
+        return static_cast<uint32_t>((x * x + z) >> 32);
+    }
+};
+
+#endif // AI_RANDOM_HPP
@@ -0,0 +1,112 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef AI_SPATIAL_GRID_HPP
+#define AI_SPATIAL_GRID_HPP
+
+/**
+ * @file AISpatialGrid.hpp
+ * @brief Uniform spatial hash grid for AI neighbor queries
+ *
+ * Rebuilt from AIManager's structure-of-arrays positions once per frame.
+ * Cells are square, unbounded and hashed into a power-of-two bucket table;
+ * entries are counting-sorted by bucket so each bucket is one contiguous run
+ * of 16-byte {x, y, slot} records. Those records are the only copy of the
+ * positions; per slot the grid keeps just its bucket and its entry index,
+ * so a rebuild writes 24 bytes per entity. Queries write entity slot
+ * indices into caller-provided buffers and never allocate.
+ *
+ * Not internally synchronized: rebuild() must not overlap with queries on
+ * the same grid. AIManager builds into a back grid and swaps it in.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AISpatialGrid {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+
+    explicit AISpatialGrid(float cellSize = DEFAULT_CELL_SIZE);
+
+    /**
+     * @brief Rebuild the grid from per-slot position arrays
+     * @param x X positions, indexed by entity slot
+     * @param y Y positions, indexed by entity slot
+     * @param active Optional per-slot flags; slots with 0 are left out
+     * @param count Number of slots
+     * @param allowThreading Hash cells on ThreadSystem workers for large counts
+     */
+    void rebuild(const float* x, const float* y, const uint8_t* active, size_t count,
+                 bool allowThreading = true);
+
+    /**
+     * @brief Slots whose position lies within radius of (centerX, centerY)
+     * @return Number of indices written to out, at most capacity
+     */
+    size_t queryRadius(float centerX, float centerY, float radius,
+                       uint32_t* out, size_t capacity) const;
+
+    /**
+     * @brief Slots whose position lies inside the inclusive rectangle
+     * @return Number of indices written to out, at most capacity
+     */
+    size_t queryRect(float minX, float minY, float maxX, float maxY,
+                     uint32_t* out, size_t capacity) const;
+
+    // Position of a slot as of the last rebuild; the slot must be contained
+    float getPositionX(uint32_t slot) const { return m_entries[m_slotEntry[slot]].x; }
+    float getPositionY(uint32_t slot) const { return m_entries[m_slotEntry[slot]].y; }
+    bool contains(uint32_t slot) const { return slot < m_slotCount && m_slotEntry[slot] != EMPTY_SLOT; }
+
+    void clear();
+    void setCellSize(float cellSize);
+    float getCellSize() const { return m_cellSize; }
+    size_t getEntryCount() const { return m_entryCount; }
+    size_t getSlotCount() const { return m_slotCount; }
+    size_t getBucketCount() const { return m_bucketCount; }
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+    static constexpr size_t MIN_BUCKET_COUNT = 1024;
+    static constexpr size_t PARALLEL_THRESHOLD = 8192;
+    static constexpr size_t SORT_RANGE_COUNT = 8;   // Divides every bucket count
+
+    float m_cellSize;
+    float m_inverseCellSize;
+
+    size_t m_slotCount{0};
+    size_t m_entryCount{0};
+    size_t m_bucketCount{0};
+    uint32_t m_bucketShift{64};
+
+    struct Entry {
+        float x;
+        float y;
+        uint32_t slot;
+        uint32_t padding;
+    };
+
+    // Per-slot data (indexed by entity slot). m_slotEntry is the slot's
+    // index in m_entries, or EMPTY_SLOT when the slot was left out.
+    std::vector<uint32_t> m_slotBucket;
+    std::vector<uint32_t> m_slotEntry;
+
+    // Bucket-sorted entries; bucket b owns [m_bucketStart[b], m_bucketStart[b + 1]).
+    // Several cells can share a bucket, so queries recheck each entry's cell.
+    std::vector<uint32_t> m_bucketStart;
+    std::vector<Entry> m_entries;
+
+    int32_t cellCoord(float value) const;
+    uint32_t bucketOf(int32_t cellX, int32_t cellY) const;
+    void hashSlots(const float* x, const float* y, const uint8_t* active, size_t start, size_t end);
+    bool coversTooManyCells(int32_t minCellX, int32_t minCellY, int32_t maxCellX, int32_t maxCellY) const;
+    template<typename Accept>
+    size_t collect(int32_t minCellX, int32_t minCellY, int32_t maxCellX, int32_t maxCellY,
+                   Accept&& accept, uint32_t* out, size_t capacity) const;
+};
+
+#endif // AI_SPATIAL_GRID_HPP
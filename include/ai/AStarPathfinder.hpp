@@ -0,0 +1,77 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef ASTAR_PATHFINDER_HPP
+#define ASTAR_PATHFINDER_HPP
+
+/**
+ * @file AStarPathfinder.hpp
+ * @brief Reusable A* search over a NavigationGrid
+ *
+ * Eight-way movement with an octile heuristic, and no diagonal step
+ * between two blocked cells. Every per-cell array (cost, parent, open and
+ * closed marks) is sized to the grid once and kept between searches. A
+ * search stamps the cells it touches instead of clearing the arrays, so
+ * its cost follows the cells it visits, not the size of the grid. The open
+ * set is a binary heap in a vector that keeps its capacity.
+ *
+ * One instance runs one search at a time. PathfindingManager keeps a pool
+ * of them for its worker tasks.
+ */
+
+#include "ai/NavigationGrid.hpp"
+#include <cstdint>
+#include <vector>
+
+class AStarPathfinder {
+public:
+    enum class Result : uint8_t {
+        Found,
+        NoPath,            // Every reachable cell was searched
+        BudgetExceeded,    // Gave up after maxExpansions cells
+        InvalidEndpoints   // Start or goal outside the grid or blocked
+    };
+
+    /**
+     * @brief Find the cheapest path between two cells
+     * @param outCells Cells from start to goal, inclusive; cleared first
+     * @param maxExpansions Cells to expand before giving up; 0 = no limit
+     */
+    Result findPath(const NavigationGrid& grid, uint32_t startCell, uint32_t goalCell,
+                    std::vector<uint32_t>& outCells, uint32_t maxExpansions = 0);
+
+    /**
+     * @brief Drop the cells a straight walk can skip
+     *
+     * Keeps a cell only where the line from the previous kept cell loses
+     * sight of the next one. The result still starts and ends at the same
+     * cells, and every leg between kept cells is walkable.
+     */
+    static void smoothPath(const NavigationGrid& grid, std::vector<uint32_t>& cells);
+
+    // Cells expanded and cost, in cells, of the last search
+    uint32_t getLastExpansions() const { return m_lastExpansions; }
+    float getLastPathCost() const { return m_lastPathCost; }
+
+private:
+    struct OpenNode {
+        float f;
+        float g;
+        uint32_t cell;
+    };
+
+    std::vector<float> m_cost;          // Best known g per cell, valid if m_seen == m_stamp
+    std::vector<uint32_t> m_parent;
+    std::vector<uint32_t> m_seen;       // Stamp of the search that last reached the cell
+    std::vector<uint32_t> m_closed;     // Stamp of the search that last expanded the cell
+    std::vector<OpenNode> m_open;
+    uint32_t m_stamp{0};
+    uint32_t m_lastExpansions{0};
+    float m_lastPathCost{0.0f};
+
+    void prepare(size_t cellCount);
+};
+
+#endif // ASTAR_PATHFINDER_HPP
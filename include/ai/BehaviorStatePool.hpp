@@ -0,0 +1,169 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef BEHAVIOR_STATE_POOL_HPP
+#define BEHAVIOR_STATE_POOL_HPP
+
+/**
+ * @file BehaviorStatePool.hpp
+ * @brief Dense per-entity state storage for AI behaviors
+ *
+ * States live in one contiguous array of {handle, state} entries, removed
+ * with swap-and-pop. A sparse table indexed by EntityHandle::index maps each
+ * entity to its entry, so lookups are an index plus a handle compare. Pools
+ * of a few entries (a cloned behavior usually tracks one entity) skip the
+ * sparse table and scan the entries instead, keeping them a single small
+ * allocation.
+ *
+ * The interface mirrors the std::unordered_map calls the behaviors used
+ * (find, operator[], try_emplace, erase, iteration over .first/.second).
+ * Unlike a node-based map, inserting or erasing moves entries, so references
+ * into the pool are only valid until the next insertion or erase.
+ *
+ * Not internally synchronized. AIManager never runs a behavior's
+ * executeLogic() concurrently with init(), clean() or an immediate
+ * onMessage() on it. Queued messages are delivered alongside other entities'
+ * executeLogic(), so handlers only look up and modify existing entries.
+ */
+
+#include "entities/EntityHandle.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template<typename State>
+class BehaviorStatePool {
+public:
+    struct Entry {
+        EntityHandle first;
+        State second;
+    };
+
+    using iterator = Entry*;
+    using const_iterator = const Entry*;
+
+    iterator begin() { return m_entries.data(); }
+    iterator end() { return m_entries.data() + m_entries.size(); }
+    const_iterator begin() const { return m_entries.data(); }
+    const_iterator end() const { return m_entries.data() + m_entries.size(); }
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    iterator find(EntityHandle handle) {
+        size_t dense = denseIndex(handle);
+        return dense == NOT_FOUND ? end() : begin() + dense;
+    }
+
+    const_iterator find(EntityHandle handle) const {
+        size_t dense = denseIndex(handle);
+        return dense == NOT_FOUND ? end() : begin() + dense;
+    }
+
+    size_t count(EntityHandle handle) const { return denseIndex(handle) == NOT_FOUND ? 0 : 1; }
+
+    std::pair<iterator, bool> try_emplace(EntityHandle handle, State state = State{}) {
+        size_t dense = denseIndex(handle);
+        if (dense != NOT_FOUND) {
+            return {begin() + dense, false};
+        }
+        m_entries.push_back(Entry{handle, std::move(state)});
+        dense = m_entries.size() - 1;
+        if (!m_sparse.empty()) {
+            setSparse(handle, dense);
+        } else if (m_entries.size() > SMALL_POOL_SIZE) {
+            buildSparse();
+        }
+        return {begin() + dense, true};
+    }
+
+    State& operator[](EntityHandle handle) { return try_emplace(handle).first->second; }
+
+    State& at(EntityHandle handle) { return find(handle)->second; }
+    const State& at(EntityHandle handle) const { return find(handle)->second; }
+
+    size_t erase(EntityHandle handle) {
+        size_t dense = denseIndex(handle);
+        if (dense == NOT_FOUND) {
+            return 0;
+        }
+        eraseDense(dense);
+        return 1;
+    }
+
+    // Returns the entry that took the erased one's place
+    iterator erase(iterator it) {
+        size_t dense = static_cast<size_t>(it - begin());
+        eraseDense(dense);
+        return begin() + dense;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_sparse.clear();
+    }
+
+    void reserve(size_t capacity) { m_entries.reserve(capacity); }
+
+    // Heap bytes held by the pool, for memory accounting
+    size_t memoryBytes() const {
+        return m_entries.capacity() * sizeof(Entry) + m_sparse.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    static constexpr size_t SMALL_POOL_SIZE = 8;
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_sparse;   // EntityHandle::index -> entry, empty while the pool is small
+
+    size_t denseIndex(EntityHandle handle) const {
+        if (m_sparse.empty()) {
+            for (size_t i = 0; i < m_entries.size(); ++i) {
+                if (m_entries[i].first == handle) {
+                    return i;
+                }
+            }
+            return NOT_FOUND;
+        }
+        if (handle.index >= m_sparse.size() || m_sparse[handle.index] == EMPTY) {
+            return NOT_FOUND;
+        }
+        // The slot may belong to an older generation of the handle
+        size_t dense = m_sparse[handle.index];
+        return m_entries[dense].first == handle ? dense : NOT_FOUND;
+    }
+
+    void setSparse(EntityHandle handle, size_t dense) {
+        if (handle.index >= m_sparse.size()) {
+            m_sparse.resize(static_cast<size_t>(handle.index) + 1, EMPTY);
+        }
+        m_sparse[handle.index] = static_cast<uint32_t>(dense);
+    }
+
+    void buildSparse() {
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            setSparse(m_entries[i].first, i);
+        }
+    }
+
+    void eraseDense(size_t dense) {
+        const size_t last = m_entries.size() - 1;
+        if (!m_sparse.empty()) {
+            m_sparse[m_entries[dense].first.index] = EMPTY;
+        }
+        if (dense != last) {
+            m_entries[dense] = std::move(m_entries[last]);
+            if (!m_sparse.empty()) {
+                m_sparse[m_entries[dense].first.index] = static_cast<uint32_t>(dense);
+            }
+        }
+        m_entries.pop_back();
+    }
+};
+
+#endif // BEHAVIOR_STATE_POOL_HPP
@@ -0,0 +1,61 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef CROWD_STEERING_HPP
+#define CROWD_STEERING_HPP
+
+/**
+ * @file CrowdSteering.hpp
+ * @brief Local avoidance between AI entities: separation, alignment and cohesion
+ *
+ * Behaviors set the velocity they want; resolve() turns it into the one the
+ * entity moves with, given its neighbors. Neighbors come from a spatial grid
+ * query against the positions published at the end of the previous frame,
+ * so every agent of a frame sees the same neighbors whichever worker runs
+ * it, and agents can be resolved in any order or in parallel.
+ *
+ * AIManager runs resolve() inside its update batches, between a behavior's
+ * executeBatch() and the entity's own update(), when crowd steering is
+ * enabled with AIManager::setCrowdSettings().
+ */
+
+#include "ai/AISpatialGrid.hpp"
+#include "utils/Vector2D.hpp"
+#include <cstddef>
+#include <cstdint>
+
+struct CrowdSettings {
+    bool enabled{false};
+    float neighborRadius{64.0f};     // Neighbors within this distance count
+    float separationRadius{32.0f};   // Agents closer than this push apart; about one body width
+    float separationWeight{1.0f};    // Push at full overlap, in multiples of maxPushSpeed
+    float alignmentWeight{0.0f};     // 0-1 blend toward the neighbors' mean velocity
+    float cohesionWeight{0.0f};      // Pull toward the neighbors' center, in multiples of maxPushSpeed
+    float maxPushSpeed{60.0f};       // Speed avoidance may give an agent that wants to stand still
+    uint32_t maxNeighbors{16};       // Neighbors considered per agent, at most MAX_NEIGHBORS
+};
+
+namespace CrowdSteering {
+
+static constexpr size_t MAX_NEIGHBORS = 32;
+
+/**
+ * @brief Final velocity for one agent
+ * @param grid Positions of every agent as of the previous frame
+ * @param velocityX Velocities by slot, as of the same frame; with velocityY
+ *        may be null when alignmentWeight is 0
+ * @param slot The agent's own slot, left out of its neighbors
+ * @param position Where the agent is now
+ * @param desired Velocity its behavior asked for
+ * @return desired plus the avoidance terms, no faster than the larger of
+ *         |desired| and maxPushSpeed
+ */
+Vector2D resolve(const AISpatialGrid& grid, const float* velocityX, const float* velocityY,
+                 uint32_t slot, const Vector2D& position, const Vector2D& desired,
+                 const CrowdSettings& settings);
+
+} // namespace CrowdSteering
+
+#endif // CROWD_STEERING_HPP
@@ -0,0 +1,121 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+
+/**
+ * @file FlowField.hpp
+ * @brief Directions toward, and away from, one goal cell for every cell of a grid
+ *
+ * build() runs one Dijkstra pass outward from the goal over a
+ * NavigationGrid, with the same eight-way moves as AStarPathfinder, then
+ * stores two directions per cell. The toward direction is the next step on
+ * a cheapest route to the goal. The away direction is the step that gains
+ * the most route distance per unit moved, so fleeing entities run down
+ * corridors instead of into walls. Any number of entities sample the
+ * field in O(1), and sampling needs only this header.
+ *
+ * The field keeps the grid's geometry, not the grid, so it stays valid
+ * however the grid changes afterwards. build() reuses its arrays.
+ */
+
+#include "ai/NavigationGrid.hpp"
+#include "utils/Vector2D.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class FlowField {
+public:
+    static constexpr uint8_t NO_DIRECTION = 0xFF;
+
+    /**
+     * @brief Rebuild the field for a new goal
+     * @param maxCost Route length, in cells, beyond which cells stay
+     *        unreached and have no direction; 0 = the whole grid
+     */
+    void build(const NavigationGrid& grid, uint32_t goalCell, float maxCost = 0.0f);
+
+    void clear();
+    bool empty() const { return m_toward.empty(); }
+
+    uint32_t getGoalCell() const { return m_goalCell; }
+    uint32_t getWidth() const { return m_width; }
+    uint32_t getHeight() const { return m_height; }
+    size_t getReachedCellCount() const { return m_reachedCells; }
+
+    // Route length in cells from cell to the goal; infinity if unreached
+    float getCost(uint32_t cell) const {
+        return cell < m_cost.size() ? m_cost[cell] : std::numeric_limits<float>::infinity();
+    }
+
+    uint32_t cellAt(const Vector2D& position) const {
+        const float fx = std::floor((position.getX() - m_originX) * m_inverseCellSize);
+        const float fy = std::floor((position.getY() - m_originY) * m_inverseCellSize);
+        if (!(fx >= 0.0f && fy >= 0.0f && fx < static_cast<float>(m_width) && fy < static_cast<float>(m_height))) {
+            return NavigationGrid::INVALID_CELL;
+        }
+        return static_cast<uint32_t>(fy) * m_width + static_cast<uint32_t>(fx);
+    }
+
+    /**
+     * @brief Unit direction of the next step toward the goal
+     * @return false off the grid, in the goal cell, or in a cell the build
+     *         did not reach; direction is left unchanged
+     */
+    bool sampleToward(const Vector2D& position, Vector2D& direction) const {
+        return sample(m_toward, position, direction);
+    }
+
+    // Unit direction that gets farther from the goal fastest; false where no
+    // neighbor is farther, such as at the end of a dead end
+    bool sampleAway(const Vector2D& position, Vector2D& direction) const {
+        return sample(m_away, position, direction);
+    }
+
+    // Raw direction codes, index into STEP_X / STEP_Y; NO_DIRECTION if none
+    uint8_t getTowardCode(uint32_t cell) const { return m_toward[cell]; }
+    uint8_t getAwayCode(uint32_t cell) const { return m_away[cell]; }
+
+    // Straight steps first, so ties between equal routes prefer them
+    static constexpr int32_t STEP_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    static constexpr int32_t STEP_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+private:
+    struct OpenNode {
+        float cost;
+        uint32_t cell;
+    };
+
+    bool sample(const std::vector<uint8_t>& codes, const Vector2D& position, Vector2D& direction) const {
+        const uint32_t cell = cellAt(position);
+        if (cell == NavigationGrid::INVALID_CELL || codes[cell] == NO_DIRECTION) {
+            return false;
+        }
+        constexpr float DIAGONAL = 0.70710678f;
+        const uint8_t code = codes[cell];
+        const float scale = (code < 4) ? 1.0f : DIAGONAL;
+        direction = Vector2D(static_cast<float>(STEP_X[code]) * scale, static_cast<float>(STEP_Y[code]) * scale);
+        return true;
+    }
+
+    uint32_t m_width{0};
+    uint32_t m_height{0};
+    float m_originX{0.0f};
+    float m_originY{0.0f};
+    float m_inverseCellSize{1.0f};
+    uint32_t m_goalCell{NavigationGrid::INVALID_CELL};
+    size_t m_reachedCells{0};
+
+    std::vector<float> m_cost;
+    std::vector<uint8_t> m_toward;
+    std::vector<uint8_t> m_away;
+    std::vector<OpenNode> m_open;
+    std::vector<uint32_t> m_settled;   // Cells in the order Dijkstra finalized them
+};
+
+#endif // FLOW_FIELD_HPP
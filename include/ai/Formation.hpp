@@ -0,0 +1,75 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef FORMATION_HPP
+#define FORMATION_HPP
+
+/**
+ * @file Formation.hpp
+ * @brief Formation shapes, slot layouts and the per-frame slot snapshot
+ *
+ * FormationManager owns the formations; this file holds what followers and
+ * the manager share. Slot offsets are laid out in the leader's frame: +x
+ * points where the leader is heading, and slots behind it have negative x.
+ * A formation always has exactly as many slots as members, so the layout
+ * closes up when someone leaves.
+ *
+ * FormationSnapshot is what followers read. It lists the world position of
+ * every slot of every formation in one contiguous array, with a map from
+ * member to slot index, and is immutable once published.
+ */
+
+#include "entities/EntityHandle.hpp"
+#include "utils/Vector2D.hpp"
+#include <cstdint>
+#include <vector>
+
+using FormationId = uint32_t;
+inline constexpr FormationId INVALID_FORMATION = 0;
+
+enum class FormationShape : uint8_t {
+    Ring,     // Evenly around the leader, fixed to the world; widens as members join
+    Line,     // Side by side, one spacing behind the leader
+    Column,   // Single file behind the leader
+    Wedge     // V opening backward from the leader
+};
+
+namespace FormationLayout {
+
+/**
+ * @brief Offset of one slot from the leader
+ * @param slot Slot index, below slotCount
+ * @param spacing Distance between neighboring slots; the ring's radius
+ *        until the ring gets crowded
+ * @return Offset in the leader's frame for shapes that turn with the
+ *         leader, in world axes for Ring
+ */
+Vector2D slotOffset(FormationShape shape, uint32_t slot, uint32_t slotCount, float spacing);
+
+// Whether offsets are rotated by the leader's heading
+bool turnsWithLeader(FormationShape shape);
+
+} // namespace FormationLayout
+
+struct FormationSnapshot {
+    // World position of every slot, formations back to back
+    std::vector<Vector2D> slotPositions;
+
+    // Member -> index into slotPositions; rebuilt only when membership changes
+    EntityHandleMap<uint32_t> memberSlots;
+    uint64_t membershipVersion{0};
+
+    // Where member should stand this frame; false if it holds no slot
+    bool slotPosition(EntityHandle member, Vector2D& out) const {
+        const uint32_t* slot = memberSlots.find(member);
+        if (!slot) {
+            return false;
+        }
+        out = slotPositions[*slot];
+        return true;
+    }
+};
+
+#endif // FORMATION_HPP
@@ -0,0 +1,82 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef NAVIGATION_GRID_HPP
+#define NAVIGATION_GRID_HPP
+
+/**
+ * @file NavigationGrid.hpp
+ * @brief Occupancy grid that AI pathfinding searches over
+ *
+ * A fixed rectangle of square cells anchored at a world-space origin. Each
+ * cell is walkable or blocked. Cells are numbered row-major, y * width + x,
+ * so a cell index is also the index into any per-cell array sized to
+ * getCellCount().
+ *
+ * Not internally synchronized. PathfindingManager shares one grid between
+ * worker searches read-only and copies it before changing it while a
+ * search still holds it.
+ */
+
+#include "utils/Vector2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class NavigationGrid {
+public:
+    static constexpr uint32_t INVALID_CELL = 0xFFFFFFFFu;
+
+    NavigationGrid() = default;
+    NavigationGrid(uint32_t width, uint32_t height, float cellSize, const Vector2D& origin = Vector2D(0.0f, 0.0f));
+
+    uint32_t getWidth() const { return m_width; }
+    uint32_t getHeight() const { return m_height; }
+    size_t getCellCount() const { return m_blocked.size(); }
+    float getCellSize() const { return m_cellSize; }
+    const Vector2D& getOrigin() const { return m_origin; }
+    bool empty() const { return m_blocked.empty(); }
+
+    uint32_t cellIndex(uint32_t x, uint32_t y) const { return y * m_width + x; }
+    uint32_t cellX(uint32_t cell) const { return cell % m_width; }
+    uint32_t cellY(uint32_t cell) const { return cell / m_width; }
+
+    // Cell containing a world position, or INVALID_CELL outside the grid
+    uint32_t cellAt(const Vector2D& position) const;
+    Vector2D cellCenter(uint32_t cell) const;
+
+    bool isBlocked(uint32_t cell) const { return m_blocked[cell] != 0; }
+    bool isWalkable(int32_t x, int32_t y) const {
+        return x >= 0 && y >= 0 && static_cast<uint32_t>(x) < m_width && static_cast<uint32_t>(y) < m_height &&
+               m_blocked[static_cast<size_t>(y) * m_width + static_cast<size_t>(x)] == 0;
+    }
+
+    void setBlocked(uint32_t cell, bool blocked) { m_blocked[cell] = blocked ? 1 : 0; }
+
+    // Block or clear every cell the rectangle overlaps; returns the cells changed
+    size_t setBlockedArea(const Vector2D& minCorner, const Vector2D& maxCorner, bool blocked);
+
+    // Nearest walkable cell within maxRings rings around cell, or INVALID_CELL
+    uint32_t nearestWalkable(uint32_t cell, uint32_t maxRings) const;
+
+    /**
+     * @brief Whether a straight line between two cell centers stays on walkable cells
+     *
+     * Walks every cell the line touches. A line passing exactly through a
+     * corner needs both cells beside the corner walkable, so agents never
+     * squeeze diagonally between two blocked cells.
+     */
+    bool hasLineOfSight(uint32_t from, uint32_t to) const;
+
+private:
+    uint32_t m_width{0};
+    uint32_t m_height{0};
+    float m_cellSize{32.0f};
+    float m_inverseCellSize{1.0f / 32.0f};
+    Vector2D m_origin{0.0f, 0.0f};
+    std::vector<uint8_t> m_blocked;   // 1 = blocked, per cell
+};
+
+#endif // NAVIGATION_GRID_HPP
@@ -0,0 +1,97 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef PERCEPTION_HPP
+#define PERCEPTION_HPP
+
+/**
+ * @file Perception.hpp
+ * @brief What AI entities can sense of a target, worked out a batch at a time
+ *
+ * AIManager runs sense() once per update batch, for every entity whose
+ * behavior asks for perception, before any behavior in the batch runs.
+ * Each entity gets an Awareness entry: whether the target is in range, in
+ * its view cone and in plain sight, and where and when it last saw it.
+ * Behaviors read their entry from FrameContext::awareness instead of
+ * measuring distances and angles per entity in executeLogic().
+ *
+ * Sight lines are traced over the NavigationGrid: any blocked cell between
+ * the observer's cell and the target's hides the target. Traces run in
+ * lockstep lanes so the stepping is the same arithmetic on every lane.
+ */
+
+#include "utils/Vector2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class NavigationGrid;
+
+// What a behavior wants its entities to sense
+struct PerceptionSettings {
+    float range{250.0f};
+    float fieldOfView{360.0f};       // Degrees, centered on the entity's facing; 360 sees all round
+    bool requireLineOfSight{true};   // Blocked grid cells hide the target
+};
+
+// One entity's view of the target, kept between updates
+struct Awareness {
+    static constexpr uint8_t IN_RANGE = 1 << 0;
+    static constexpr uint8_t IN_VIEW = 1 << 1;    // In range and inside the view cone
+    static constexpr uint8_t VISIBLE = 1 << 2;    // In view and not hidden by the grid
+    static constexpr uint8_t SEEN = 1 << 3;       // Visible at some point; lastSeen* are set
+
+    Vector2D lastSeenPosition{0.0f, 0.0f};
+    uint64_t lastSeenMs{0};           // FrameContext::timeMs when last visible
+    Vector2D facing{1.0f, 0.0f};      // Unit direction the view cone was centered on
+    float distance{0.0f};             // To the target when last sensed
+    uint8_t flags{0};
+
+    bool inRange() const { return (flags & IN_RANGE) != 0; }
+    bool inView() const { return (flags & IN_VIEW) != 0; }
+    bool canSee() const { return (flags & VISIBLE) != 0; }
+    bool hasSeen() const { return (flags & SEEN) != 0; }
+};
+
+// An entity sensing this batch
+struct PerceptionObserver {
+    Vector2D position{0.0f, 0.0f};
+    Vector2D facing{1.0f, 0.0f};      // Unit length
+    const PerceptionSettings* settings{nullptr};
+};
+
+namespace Perception {
+
+// Sight lines traced side by side
+static constexpr size_t LANES = 8;
+
+/**
+ * @brief Sight lines between pairs of cells
+ *
+ * visible[i] is 1 when the line from fromCells[i] to toCells[i] stays on
+ * walkable cells, with the same answer as
+ * NavigationGrid::hasLineOfSight(). Traces step in lockstep across LANES
+ * lanes; a lane that finishes picks up the next trace.
+ */
+void traceLineOfSight(const NavigationGrid& grid, const uint32_t* fromCells, const uint32_t* toCells,
+                      size_t count, uint8_t* visible);
+
+/**
+ * @brief Update each observer's awareness of a target
+ *
+ * Replaces the range, view and visibility flags and the facing, and
+ * records the target's position and timeMs when it is visible. Observers
+ * or targets off the grid, and any observer when grid is null, see the
+ * target whenever it is in view.
+ */
+void sense(const NavigationGrid* grid, const Vector2D& target, uint64_t timeMs,
+           std::span<const PerceptionObserver> observers, std::span<Awareness> awareness);
+
+// Clear what each entry senses now but keep where the target was last seen
+void loseTarget(std::span<Awareness> awareness);
+
+} // namespace Perception
+
+#endif // PERCEPTION_HPP
@@ -7,11 +7,11 @@
 #define ATTACK_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "ai/BehaviorStatePool.hpp"
 #include "utils/Vector2D.hpp"
 #include <SDL3/SDL.h>
-#include <unordered_map>
 #include <vector>
-#include <random>
 
 class AttackBehavior : public AIBehavior {
 public:
@@ -42,8 +42,10 @@ public:
 
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
     std::string getName() const override;
 
     // Configuration methods
@@ -72,6 +74,7 @@ public:
     void setRetreatThreshold(float healthPercentage);
     void setAggression(float aggression); // 0.0 to 1.0
     void setTeamwork(bool enabled);
+    void setTeamCoordinationRadius(float radius);
     void setAvoidFriendlyFire(bool enabled);
     
     // Special abilities
@@ -164,8 +167,8 @@ private:
         {}
     };
 
-    // Map to store per-entity state
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
     // Attack parameters
     AttackMode m_attackMode{AttackMode::MELEE_ATTACK};
@@ -194,6 +197,7 @@ private:
     float m_retreatThreshold{0.3f};    // Retreat at 30% health
     float m_aggression{0.7f};          // 70% aggression
     bool m_teamwork{true};
+    float m_teamCoordinationRadius{400.0f}; // Allies this close hear coordinate_attack
     bool m_avoidFriendlyFire{true};
     
     // Special abilities
@@ -209,59 +213,54 @@ private:
     static constexpr Uint64 STRAFE_INTERVAL = 2000;    // 2 seconds between direction changes
     static constexpr float RETREAT_SPEED_MULTIPLIER = 1.5f;
     static constexpr float CHARGE_SPEED_MULTIPLIER = 2.0f;
-    
-    // Random number generation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_damageRoll{0.0f, 1.0f};
-    mutable std::uniform_real_distribution<float> m_criticalRoll{0.0f, 1.0f};
-    mutable std::uniform_real_distribution<float> m_specialRoll{0.0f, 1.0f};
-    mutable std::uniform_real_distribution<float> m_angleVariation{-0.5f, 0.5f};
+    static constexpr size_t MAX_NEARBY_ALLIES = 32;    // Cap on spatial query results
+    static constexpr uint16_t STREAM_ATTACK = 1;       // AIRandom stream for attack rolls
 
     // Helper methods
     EntityPtr getTarget() const; // Gets player reference from AIManager
     bool isTargetInRange(EntityPtr entity, EntityPtr target) const;
     bool isTargetInAttackRange(EntityPtr entity, EntityPtr target) const;
     bool canReachTarget(EntityPtr entity, EntityPtr target) const;
-    float calculateDamage(const EntityState& state) const;
-    Vector2D calculateOptimalAttackPosition(EntityPtr entity, EntityPtr target, const EntityState& state) const;
+    float calculateDamage(const EntityState& state, AIRandom& rng) const;
+    Vector2D calculateOptimalAttackPosition(EntityPtr entity, const Vector2D& targetPos, const EntityState& state) const;
     Vector2D calculateFlankingPosition(EntityPtr entity, EntityPtr target) const;
     Vector2D calculateStrafePosition(EntityPtr entity, EntityPtr target, const EntityState& state) const;
     
     // State management
-    void changeState(EntityState& state, AttackState newState);
-    void updateStateTimer(EntityState& state);
+    void changeState(EntityState& state, AttackState newState, Uint64 currentTime);
+    void updateStateTimer(EntityState& state, Uint64 currentTime);
     bool shouldRetreat(const EntityState& state) const;
-    bool shouldCharge(EntityPtr entity, EntityPtr target, const EntityState& state) const;
+    bool shouldCharge(EntityPtr entity, const EntityState& state) const;
     
     // Attack execution
-    void executeAttack(EntityPtr entity, EntityPtr target, EntityState& state);
-    void executeSpecialAttack(EntityPtr entity, EntityPtr target, EntityState& state);
-    void executeComboAttack(EntityPtr entity, EntityPtr target, EntityState& state);
+    void executeAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime, AIRandom& rng);
+    void executeSpecialAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime, AIRandom& rng);
+    void executeComboAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime, AIRandom& rng);
     void applyDamage(EntityPtr target, float damage, const Vector2D& knockback);
     void applyAreaOfEffectDamage(EntityPtr entity, EntityPtr target, float damage);
     
     // Mode-specific updates
-    void updateMeleeAttack(EntityPtr entity, EntityState& state);
-    void updateRangedAttack(EntityPtr entity, EntityState& state);
-    void updateChargeAttack(EntityPtr entity, EntityState& state);
-    void updateAmbushAttack(EntityPtr entity, EntityState& state);
-    void updateCoordinatedAttack(EntityPtr entity, EntityState& state);
-    void updateHitAndRun(EntityPtr entity, EntityState& state);
-    void updateBerserkerAttack(EntityPtr entity, EntityState& state);
+    void updateMeleeAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateRangedAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateChargeAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateAmbushAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateCoordinatedAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateHitAndRun(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateBerserkerAttack(EntityPtr entity, EntityState& state, const FrameContext& context);
     
     // State-specific updates
-    void updateSeeking(EntityPtr entity, EntityState& state);
-    void updateApproaching(EntityPtr entity, EntityState& state);
-    void updatePositioning(EntityPtr entity, EntityState& state);
-    void updateAttacking(EntityPtr entity, EntityState& state);
+    void updateSeeking(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateApproaching(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updatePositioning(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateAttacking(EntityPtr entity, EntityState& state, const FrameContext& context);
     void updateRecovering(EntityPtr entity, EntityState& state);
-    void updateRetreating(EntityPtr entity, EntityState& state);
+    void updateRetreating(EntityPtr entity, EntityState& state, const FrameContext& context);
     void updateCooldown(EntityPtr entity, EntityState& state);
     
     // Movement and positioning
     void moveToPosition(EntityPtr entity, const Vector2D& targetPos, float speed);
     void maintainDistance(EntityPtr entity, EntityPtr target, float desiredDistance);
-    void circleStrafe(EntityPtr entity, EntityPtr target, EntityState& state);
+    void circleStrafe(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime);
     void performFlankingManeuver(EntityPtr entity, EntityPtr target, EntityState& state);
     
     // Utility methods
@@ -17,10 +17,12 @@ public:
     void init(EntityPtr entity) override;
 
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
 
     void clean(EntityPtr entity) override;
 
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
 
     std::string getName() const override;
 
@@ -60,7 +62,7 @@ private:
     Vector2D m_currentDirection{0, 0};
 
     // Check if entity has line of sight to target (simplified)
-    bool checkLineOfSight(EntityPtr entity, EntityPtr target) const;
+    bool checkLineOfSight(EntityPtr entity, const Vector2D& targetPos) const;
 
     // Handle behavior when line of sight is lost
     void handleNoLineOfSight(EntityPtr entity);
@@ -7,10 +7,10 @@
 #define FLEE_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "ai/BehaviorStatePool.hpp"
 #include "utils/Vector2D.hpp"
 #include <SDL3/SDL.h>
-#include <unordered_map>
-#include <random>
 
 class FleeBehavior : public AIBehavior {
 public:
@@ -28,10 +28,15 @@ public:
 
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
     std::string getName() const override;
 
+    // The threat's distance comes from AIManager's perception pass
+    bool getPerceptionSettings(PerceptionSettings& settings) const override;
+
     // Configuration methods
     void setFleeSpeed(float speed);
     void setDetectionRange(float range);
@@ -93,8 +98,8 @@ private:
         SafeZone(const Vector2D& c, float r) : center(c), radius(r) {}
     };
 
-    // Map to store per-entity state
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
     // Behavior parameters
     FleeMode m_fleeMode{FleeMode::PANIC_FLEE};
@@ -119,24 +124,21 @@ private:
     float m_zigzagAngle{45.0f}; // Degrees
     Uint64 m_zigzagInterval{500}; // Milliseconds between direction changes
 
-    // Random number generation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_angleVariation{-0.5f, 0.5f}; // Radians
-    mutable std::uniform_real_distribution<float> m_panicVariation{0.8f, 1.2f};
-
     // Helper methods
     EntityPtr getThreat() const; // Gets player reference from AIManager
-    bool isThreatInRange(EntityPtr entity, EntityPtr threat) const;
-    Vector2D calculateFleeDirection(EntityPtr entity, EntityPtr threat, const EntityState& state);
+    bool isThreatInRange(EntityPtr entity, const Vector2D& threatPos) const;
+    // Away from the player, along the frame's flow field when there is one
+    Vector2D calculateFleeDirection(EntityPtr entity, const FrameContext& context, const EntityState& state,
+                                    AIRandom& rng);
     Vector2D findNearestSafeZone(const Vector2D& position) const;
     bool isPositionSafe(const Vector2D& position) const;
     bool isNearBoundary(const Vector2D& position) const;
     Vector2D avoidBoundaries(const Vector2D& position, const Vector2D& direction) const;
     
-    void updatePanicFlee(EntityPtr entity, EntityState& state);
-    void updateStrategicRetreat(EntityPtr entity, EntityState& state);
-    void updateEvasiveManeuver(EntityPtr entity, EntityState& state);
-    void updateSeekCover(EntityPtr entity, EntityState& state);
+    void updatePanicFlee(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng);
+    void updateStrategicRetreat(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng);
+    void updateEvasiveManeuver(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng);
+    void updateSeekCover(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng);
     
     void updateStamina(EntityState& state, float deltaTime, bool fleeing);
     Vector2D normalizeVector(const Vector2D& direction) const;
@@ -7,10 +7,10 @@
 #define FOLLOW_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/BehaviorStatePool.hpp"
+#include "ai/Formation.hpp"
 #include "utils/Vector2D.hpp"
 #include <SDL3/SDL.h>
-#include <unordered_map>
-#include <random>
 
 class FollowBehavior : public AIBehavior {
 public:
@@ -29,8 +29,10 @@ public:
 
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
     std::string getName() const override;
 
     // Configuration methods
@@ -40,6 +42,7 @@ public:
     void setFollowMode(FollowMode mode);
     void setCatchUpSpeed(float speedMultiplier); // Speed boost when far behind
     void setFormationOffset(const Vector2D& offset); // For formation following
+    void setFormationShape(FormationShape shape);    // Escort layout; spacing is the formation radius
     
     // Pathfinding and obstacle avoidance
     void setAvoidanceRadius(float radius);
@@ -56,6 +59,7 @@ public:
     bool isInFormation() const;
     float getDistanceToTarget() const;
     FollowMode getFollowMode() const;
+    FormationShape getFormationShape() const;
     Vector2D getTargetPosition() const;
 
     // Clone method for creating unique behavior instances
@@ -75,7 +79,8 @@ private:
         bool isFollowing{false};
         bool targetMoving{false};
         bool inFormation{true};
-        int formationSlot{0}; // For escort formation
+        FormationId formationId{INVALID_FORMATION}; // Escort formation joined in FormationManager
+        EntityHandle formationLeader{};             // Leader it was joined for
         
         // Pathfinding state
         std::vector<Vector2D> pathPoints;
@@ -94,14 +99,15 @@ private:
             , isFollowing(false)
             , targetMoving(false)
             , inFormation(true)
-            , formationSlot(0)
+            , formationId(INVALID_FORMATION)
+            , formationLeader()
             , currentPathIndex(0)
             , lastPathUpdate(0)
         {}
     };
 
-    // Map to store per-entity state
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
     // Behavior parameters
     FollowMode m_followMode{FollowMode::LOOSE_FOLLOW};
@@ -113,9 +119,11 @@ private:
     // Formation and positioning
     Vector2D m_formationOffset{0, 0};   // Custom formation offset
     float m_formationRadius{80.0f};     // Radius for escort formation
+    FormationShape m_formationShape{FormationShape::Ring};
     
     // Movement parameters
     float m_avoidanceRadius{30.0f};     // Radius for obstacle avoidance
+    static constexpr size_t MAX_AVOIDANCE_NEIGHBORS = 16; // Neighbors considered for separation
     float m_maxTurnRate{180.0f};        // Degrees per second
     float m_minimumMovementThreshold{5.0f}; // Minimum target movement to follow
     bool m_pathSmoothing{true};
@@ -128,21 +136,13 @@ private:
     // Timing parameters
     Uint64 m_stationaryThreshold{1000}; // Milliseconds before considering target stationary
     
-    // Formation management
-    static int s_nextFormationSlot;
-    static std::vector<Vector2D> s_escortFormationOffsets;
-    
-    // Random number generation for formation variation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_offsetVariation{-10.0f, 10.0f};
-
     // Helper methods
     EntityPtr getTarget() const; // Gets player reference from AIManager
-    Vector2D calculateDesiredPosition(EntityPtr entity, EntityPtr target, const EntityState& state);
+    Vector2D calculateDesiredPosition(EntityPtr entity, const Vector2D& targetPos, const EntityState& state);
     Vector2D calculateFormationOffset(const EntityState& state) const;
-    Vector2D predictTargetPosition(EntityPtr target, const EntityState& state) const;
+    Vector2D predictTargetPosition(const Vector2D& targetPos, const EntityState& state) const;
     
-    bool isTargetMoving(EntityPtr target, const EntityState& state) const;
+    bool isTargetMoving(const Vector2D& targetPos, const EntityState& state) const;
     bool shouldCatchUp(float distanceToTarget) const;
     float calculateFollowSpeed(EntityPtr entity, const EntityState& state, float distanceToTarget) const;
     
@@ -152,11 +152,12 @@ private:
     Vector2D smoothPath(const Vector2D& currentPos, const Vector2D& targetPos, const EntityState& state) const;
     
     // Mode-specific updates
-    void updateCloseFollow(EntityPtr entity, EntityState& state);
-    void updateLooseFollow(EntityPtr entity, EntityState& state);
-    void updateFlankingFollow(EntityPtr entity, EntityState& state);
-    void updateRearGuard(EntityPtr entity, EntityState& state);
-    void updateEscortFormation(EntityPtr entity, EntityState& state);
+    void updateCloseFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos);
+    void updateLooseFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos);
+    void updateFlankingFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos);
+    void updateRearGuard(EntityPtr entity, EntityState& state, const Vector2D& targetPos);
+    void updateEscortFormation(EntityPtr entity, EntityState& state, const Vector2D& targetPos,
+                               const FormationSnapshot* formations);
     
     // Utility methods
     Vector2D normalizeVector(const Vector2D& vector) const;
@@ -164,10 +165,9 @@ private:
     float clampAngle(float angle) const;
     Vector2D rotateVector(const Vector2D& vector, float angle) const;
     
-    // Formation setup
-    void initializeFormationOffsets();
-    int assignFormationSlot();
-    void releaseFormationSlot(int slot);
+    // Escort formation membership; FormationManager assigns the slots
+    void joinFormation(EntityHandle member, EntityState& state, EntityHandle leader);
+    void leaveFormation(EntityHandle member, EntityState& state);
 };
 
 #endif // FOLLOW_BEHAVIOR_HPP
\ No newline at end of file
@@ -7,11 +7,11 @@
 #define GUARD_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "ai/BehaviorStatePool.hpp"
 #include "utils/Vector2D.hpp"
 #include <SDL3/SDL.h>
-#include <unordered_map>
 #include <vector>
-#include <random>
 
 class GuardBehavior : public AIBehavior {
 public:
@@ -38,10 +38,17 @@ public:
 
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
     std::string getName() const override;
 
+    // Threats are sensed in AIManager's perception pass: detection range,
+    // field of view around the guard's heading, and line of sight
+    bool getPerceptionSettings(PerceptionSettings& settings) const override;
+    bool getFacing(const Entity& entity, Vector2D& facing) const override;
+
     // Configuration methods
     void setGuardPosition(const Vector2D& position);
     void setGuardRadius(float radius);
@@ -143,8 +150,8 @@ private:
         {}
     };
 
-    // Map to store per-entity state
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
     // Guard parameters
     GuardMode m_guardMode{GuardMode::STATIC_GUARD};
@@ -186,34 +193,29 @@ private:
     static constexpr Uint64 INVESTIGATING_THRESHOLD = 5000;  // 5 seconds
     static constexpr Uint64 HOSTILE_THRESHOLD = 1000;       // 1 second in sight
     
-    // Random number generation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_angleDistribution{0.0f, 2.0f * M_PI};
-    mutable std::uniform_real_distribution<float> m_radiusDistribution{0.3f, 1.0f};
-
     // Helper methods
-    EntityPtr detectThreat(EntityPtr entity, const EntityState& state) const;
-    bool isThreatInRange(EntityPtr entity, EntityPtr threat) const;
-    bool isThreatInFieldOfView(EntityPtr entity, EntityPtr threat, const EntityState& state) const;
-    bool hasLineOfSight(EntityPtr entity, EntityPtr threat) const;
-    float calculateThreatDistance(EntityPtr entity, EntityPtr threat) const;
-    
-    void updateAlertLevel(EntityPtr entity, EntityState& state, bool threatPresent);
-    void handleThreatDetection(EntityPtr entity, EntityState& state, EntityPtr threat);
-    void handleInvestigation(EntityPtr entity, EntityState& state);
+    bool detectThreat(EntityPtr entity, const EntityState& state, const FrameContext& context) const;
+    bool isThreatInRange(EntityPtr entity, const Vector2D& threatPos) const;
+    bool isThreatInFieldOfView(EntityPtr entity, const Vector2D& threatPos, const EntityState& state) const;
+    bool hasLineOfSight(EntityPtr entity, const Vector2D& threatPos) const;
+    float calculateThreatDistance(EntityPtr entity, const Vector2D& threatPos) const;
+    
+    void updateAlertLevel(EntityPtr entity, EntityState& state, bool threatPresent, Uint64 currentTime);
+    void handleThreatDetection(EntityPtr entity, EntityState& state, const Vector2D& threatPos, Uint64 currentTime);
+    void handleInvestigation(EntityPtr entity, EntityState& state, Uint64 currentTime);
     void handleReturnToPost(EntityPtr entity, EntityState& state);
     
     // Mode-specific updates
-    void updateStaticGuard(EntityPtr entity, EntityState& state);
+    void updateStaticGuard(EntityPtr entity, EntityState& state, Uint64 currentTime);
     void updatePatrolGuard(EntityPtr entity, EntityState& state);
-    void updateAreaGuard(EntityPtr entity, EntityState& state);
-    void updateRoamingGuard(EntityPtr entity, EntityState& state);
+    void updateAreaGuard(EntityPtr entity, EntityState& state, const FrameContext& context);
+    void updateRoamingGuard(EntityPtr entity, EntityState& state, const FrameContext& context);
     void updateAlertGuard(EntityPtr entity, EntityState& state);
     
     // Movement and positioning
     void moveToPosition(EntityPtr entity, const Vector2D& targetPos, float speed);
     Vector2D getNextPatrolWaypoint(const EntityState& state) const;
-    Vector2D generateRoamTarget(EntityPtr entity, const EntityState& state) const;
+    Vector2D generateRoamTarget(EntityPtr entity, const EntityState& state, AIRandom& rng) const;
     bool isAtPosition(const Vector2D& currentPos, const Vector2D& targetPos, float threshold = 25.0f) const;
     bool isWithinGuardArea(const Vector2D& position) const;
     
@@ -7,10 +7,10 @@
 #define IDLE_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "ai/BehaviorStatePool.hpp"
 #include "utils/Vector2D.hpp"
 #include <SDL3/SDL.h>
-#include <unordered_map>
-#include <random>
 
 class IdleBehavior : public AIBehavior {
 public:
@@ -25,11 +25,18 @@ public:
 
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
+    void executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
+    void cleanupEntity(EntityPtr entity) override;
     std::string getName() const override;
 
-    // Configuration methods
+    // One instance drives every idle entity; see AIBehavior::isShared()
+    bool isShared() const override { return true; }
+
+    // Configuration methods; these also apply to entities already idling
     void setIdleMode(IdleMode mode);
     void setIdleRadius(float radius);
     void setMovementFrequency(float frequency); // How often to make small movements (in seconds)
@@ -52,6 +59,9 @@ private:
         Uint64 nextMovementTime{0};
         Uint64 nextTurnTime{0};
         float currentAngle{0.0f};
+        float movementFrequency{0.0f};  // Per entity: messages switch one entity's mode
+        float turnFrequency{0.0f};
+        IdleMode mode{IdleMode::STATIONARY};
         bool initialized{false};
 
         EntityState() 
@@ -62,35 +72,38 @@ private:
             , nextMovementTime(0)
             , nextTurnTime(0)
             , currentAngle(0.0f)
+            , movementFrequency(0.0f)
+            , turnFrequency(0.0f)
+            , mode(IdleMode::STATIONARY)
             , initialized(false)
         {}
     };
 
-    // Map to store per-entity state
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
-    // Behavior parameters
+    // Behavior parameters, the defaults for newly initialized entities
     IdleMode m_idleMode{IdleMode::STATIONARY};
     float m_idleRadius{20.0f};
     float m_movementFrequency{3.0f};  // Seconds between movements
     float m_turnFrequency{5.0f};      // Seconds between turns
 
-    // Random number generation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_angleDistribution{0.0f, 2.0f * M_PI};
-    mutable std::uniform_real_distribution<float> m_radiusDistribution{0.0f, 1.0f};
-    mutable std::uniform_real_distribution<float> m_frequencyVariation{0.5f, 1.5f};
+    // Random numbers come from AIRandom keyed by entity and frame, so workers
+    // running this shared instance concurrently share no generator state
 
     // Helper methods
-    void initializeEntityState(EntityPtr entity, EntityState& state);
+    static void modeFrequencies(IdleMode mode, float& movementFrequency, float& turnFrequency);
+    void setEntityMode(EntityState& state, IdleMode mode);
+    void initializeEntityState(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng);
+    void updateEntity(EntityPtr entity, EntityState& state, const FrameContext& context);
     void updateStationary(EntityPtr entity, EntityState& state);
-    void updateSubtleSway(EntityPtr entity, EntityState& state);
-    void updateOccasionalTurn(EntityPtr entity, EntityState& state);
-    void updateLightFidget(EntityPtr entity, EntityState& state);
+    void updateSubtleSway(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng);
+    void updateOccasionalTurn(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng);
+    void updateLightFidget(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng);
     
-    Vector2D generateRandomOffset() const;
-    Uint64 getRandomMovementInterval() const;
-    Uint64 getRandomTurnInterval() const;
+    Vector2D generateRandomOffset(AIRandom& rng) const;
+    Uint64 getRandomMovementInterval(const EntityState& state, AIRandom& rng) const;
+    Uint64 getRandomTurnInterval(const EntityState& state, AIRandom& rng) const;
 };
 
 #endif // IDLE_BEHAVIOR_HPP
\ No newline at end of file
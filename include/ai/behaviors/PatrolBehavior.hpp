@@ -7,10 +7,11 @@
 #define PATROL_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "managers/PathfindingManager.hpp"
 #include "utils/Vector2D.hpp"
 #include <vector>
 #include <SDL3/SDL.h>
-#include <random>
 
 class PatrolBehavior : public AIBehavior {
 public:
@@ -29,7 +30,8 @@ public:
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
     std::string getName() const override;
 
     // Add a new waypoint to the patrol route
@@ -68,6 +70,11 @@ public:
     void setMinWaypointDistance(float distance);
     void setRandomSeed(unsigned int seed);
 
+    // Route around obstacles through PathfindingManager when it has a grid
+    // (default). Without a grid, or with this off, waypoints are walked in
+    // straight lines.
+    void setUsePathfinding(bool usePathfinding);
+
 private:
     std::vector<Vector2D> m_waypoints;
     size_t m_currentWaypoint{0};
@@ -97,9 +104,19 @@ private:
     Vector2D m_eventTarget{0, 0};
     float m_eventTargetRadius{100.0f};
     
-    // Random number generation
-    mutable std::mt19937 m_rng;
-    bool m_seedSet{false};
+    // Random waypoints come from AIRandom keyed by this seed and a count of
+    // waypoint sets generated so far
+    uint64_t m_randomSeed{0};
+    uint32_t m_waypointGeneration{0};
+
+    // Route to the current waypoint; empty while the request is pending or
+    // if it failed, in which case the entity heads straight for the waypoint
+    bool m_usePathfinding{true};
+    PathRequestHandle m_pathRequest;
+    std::vector<Vector2D> m_path;
+    size_t m_pathIndex{0};
+    Vector2D m_pathGoal{0, 0};
+    bool m_hasPathGoal{false};
 
     // Check if entity has reached the current waypoint
     bool isAtWaypoint(const Vector2D& position, const Vector2D& waypoint) const;
@@ -113,17 +130,25 @@ private:
     // Reset entity to a new position on screen edge
     void resetEntityPosition(EntityPtr entity);
 
+    // Point to steer towards on the way to waypoint; requests a new route
+    // when the waypoint changes and polls it on later frames
+    Vector2D nextPathPoint(const Vector2D& position, const Vector2D& waypoint);
+
+    // Drop the current route and release its request
+    void resetPath();
+
     // Reverse the order of waypoints
     void reverseWaypoints();
 
     // Random waypoint generation helpers
-    void generateRandomWaypointsInRectangle();
-    void generateRandomWaypointsInCircle();
-    void generateWaypointsAroundTarget();
-    Vector2D generateRandomPointInRectangle() const;
-    Vector2D generateRandomPointInCircle() const;
+    AIRandom waypointRandom(EntityHandle handle = EntityHandle{});
+    void regenerateRandomWaypoints(EntityHandle handle);
+    void generateRandomWaypointsInRectangle(EntityHandle handle = EntityHandle{});
+    void generateRandomWaypointsInCircle(EntityHandle handle = EntityHandle{});
+    void generateWaypointsAroundTarget(EntityHandle handle = EntityHandle{});
+    Vector2D generateRandomPointInRectangle(AIRandom& rng) const;
+    Vector2D generateRandomPointInCircle(AIRandom& rng) const;
     bool isValidWaypointDistance(const Vector2D& newPoint) const;
-    void ensureRandomSeed() const;
     
     // Mode setup helper
     void setupModeDefaults(PatrolMode mode, float screenWidth = 1280.0f, float screenHeight = 720.0f);
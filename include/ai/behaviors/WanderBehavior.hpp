@@ -7,10 +7,10 @@
 #define WANDER_BEHAVIOR_HPP
 
 #include "ai/AIBehavior.hpp"
+#include "ai/AIRandom.hpp"
+#include "ai/BehaviorStatePool.hpp"
 #include "utils/Vector2D.hpp"
 
-#include <random>
-#include <unordered_map>
 #include <SDL3/SDL.h>
 #include <memory>
 
@@ -31,10 +31,17 @@ public:
     // No state management - handled by AI Manager
     void init(EntityPtr entity) override;
     void executeLogic(EntityPtr entity) override;
+    void executeLogic(EntityPtr entity, const FrameContext& context) override;
+    void executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) override;
     void clean(EntityPtr entity) override;
-    void onMessage(EntityPtr entity, const std::string& message) override;
+    void onMessage(EntityPtr entity, const AIMessage& message) override;
+    bool acceptsMessage(AIMessageId id) const override;
+    void cleanupEntity(EntityPtr entity) override;
     std::string getName() const override;
 
+    // One instance drives every wandering entity; see AIBehavior::isShared()
+    bool isShared() const override { return true; }
+
     // Set a new center point for wandering
     void setCenterPoint(const Vector2D& centerPoint);
 
@@ -66,6 +73,9 @@ private:
         Uint64 lastDirectionFlip{0};
         Uint64 startDelay{0};           // Random delay before entity starts moving
         bool movementStarted{false};    // Flag to track if movement has started
+        bool paused{false};             // Set by the pause/resume messages
+        Vector2D centerPoint{0, 0};     // Where this entity was when it started wandering
+        float speedMultiplier{1.0f};    // Adjusted by the increase/decrease_speed messages
 
         // Constructor to ensure proper initialization
         EntityState() 
@@ -76,11 +86,14 @@ private:
             , lastDirectionFlip(0)
             , startDelay(0)
             , movementStarted(false)
+            , paused(false)
+            , centerPoint(0, 0)
+            , speedMultiplier(1.0f)
         {}
     };
 
-    // Map to store per-entity state using shared_ptr as key
-    std::unordered_map<EntityPtr, EntityState> m_entityStates;
+    // Per-entity state, dense and keyed by entity handle
+    BehaviorStatePool<EntityState> m_entityStates;
 
     // Shared behavior parameters
     float m_speed{1.5f};
@@ -98,19 +111,20 @@ private:
     // Flip stability properties
     Uint64 m_minimumFlipInterval{400}; // Minimum time between flips (milliseconds)
 
-    // Random number generation
-    mutable std::mt19937 m_rng{std::random_device{}()};
-    mutable std::uniform_real_distribution<float> m_angleDistribution{0.0f, 2.0f * M_PI};
-    mutable std::uniform_real_distribution<float> m_wanderOffscreenChance{0.0f, 1.0f};
+    // Random numbers come from AIRandom keyed by entity and frame, so workers
+    // running this shared instance concurrently share no generator state
 
     // Check if entity is well off screen (completely out of view)
     bool isWellOffscreen(const Vector2D& position) const;
 
+    // Advance one entity's wandering
+    void updateEntity(EntityPtr entity, EntityState& state, const FrameContext& context);
+
     // Reset entity to a new position on the opposite side of the screen
-    void resetEntityPosition(EntityPtr entity);
+    void resetEntityPosition(EntityPtr entity, EntityState& state, AIRandom& rng);
 
     // Choose a new random direction for the entity
-    void chooseNewDirection(EntityPtr entity, bool wanderOffscreen = false);
+    void chooseNewDirection(EntityPtr entity, EntityState& state, AIRandom& rng, bool wanderOffscreen = false);
     
     // Mode setup helper
     void setupModeDefaults(WanderMode mode, float screenWidth = 1280.0f, float screenHeight = 720.0f);
@@ -0,0 +1,135 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef BOUNDED_MPMC_QUEUE_HPP
+#define BOUNDED_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Hammer {
+
+/**
+ * @brief Lock-free bounded multi-producer/multi-consumer ring (Vyukov)
+ *
+ * Every cell carries a sequence number that tells producers and consumers
+ * whether the cell is free for the current lap. Push and pop each cost one
+ * CAS on their own cache-line-padded cursor and never move other elements,
+ * so both are O(1) regardless of how many tasks are queued.
+ *
+ * Capacity is rounded up to a power of two and fixed at construction.
+ * tryPush() fails instead of growing; callers decide what to do when full.
+ */
+template<typename T>
+class BoundedMPMCQueue {
+public:
+    explicit BoundedMPMCQueue(size_t requestedCapacity) {
+        size_t capacity = 2;
+        while (capacity < requestedCapacity) {
+            capacity <<= 1;
+        }
+        m_mask = capacity - 1;
+        m_cells = std::make_unique<Cell[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedMPMCQueue() {
+        T discard;
+        while (tryPop(discard)) {
+        }
+    }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    /**
+     * @brief Try to enqueue an item
+     * @param item Moved from only when the push succeeds
+     * @return false if the ring is full
+     */
+    bool tryPush(T& item) {
+        Cell* cell = nullptr;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Full: the cell still holds last lap's item
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) T(std::move(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Try to dequeue the oldest item
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        Cell* cell = nullptr;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Empty: producer has not published this cell yet
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* item = std::launder(reinterpret_cast<T*>(cell->storage));
+        out = std::move(*item);
+        item->~T();
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate size; exact only when no push/pop is in flight
+    size_t size() const {
+        size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask{0};
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+};
+
+} // namespace Hammer
+
+#endif // BOUNDED_MPMC_QUEUE_HPP
@@ -0,0 +1,92 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef BOUNDED_MPSC_QUEUE_HPP
+#define BOUNDED_MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hammer {
+
+/**
+ * @brief Fixed-capacity lock-free queue for many producers and one consumer
+ *
+ * Vyukov's bounded queue. Each cell has a sequence number that says whose
+ * turn it is. A producer claims a cell with one CAS on the enqueue position,
+ * writes the value and then hands the cell to the consumer by bumping the
+ * sequence. tryPush() fails instead of overwriting when the queue is full,
+ * so the caller can count what it drops. tryPop() stops at a cell whose
+ * producer has not finished writing, so values come out in claim order.
+ *
+ * Any number of threads may push at once; callers serialize tryPop().
+ */
+template<typename T, size_t Capacity>
+class BoundedMPSCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+public:
+    BoundedMPSCQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+    BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+    // Lock-free; false if every cell is waiting for the consumer
+    bool tryPush(const T& value) {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[position & MASK];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only; false if empty or the next value is still being written
+    bool tryPop(T& out) {
+        Cell& cell = m_cells[m_dequeuePosition & MASK];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_dequeuePosition + 1) {
+            return false;
+        }
+        out = cell.value;
+        cell.sequence.store(m_dequeuePosition + Capacity, std::memory_order_release);
+        ++m_dequeuePosition;
+        return true;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    std::array<Cell, Capacity> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(64) size_t m_dequeuePosition{0};
+};
+
+} // namespace Hammer
+
+#endif // BOUNDED_MPSC_QUEUE_HPP
@@ -0,0 +1,93 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef FRAME_CONTEXT_HPP
+#define FRAME_CONTEXT_HPP
+
+/**
+ * @file FrameContext.hpp
+ * @brief Per-frame values shared by everything updated in one frame
+ *
+ * Built once per update and handed by const reference to every batch, so
+ * workers running the same frame all see the same values. Behaviors read
+ * "now" and the player from here instead of SDL_GetTicks() and
+ * AIManager::getPlayerReference(), so results do not depend on which worker
+ * ran an entity or when.
+ */
+
+#include "ai/Perception.hpp"
+#include "entities/EntityHandle.hpp"
+#include "utils/Vector2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class FlowField;
+struct FormationSnapshot;
+
+// Where the player was when the frame started
+struct PlayerSnapshot {
+    EntityHandle handle{};
+    Vector2D position{0.0f, 0.0f};
+    Vector2D velocity{0.0f, 0.0f};
+    bool valid{false};
+};
+
+struct FrameContext {
+    float deltaTime{0.0f};       // Seconds since the previous update
+    uint64_t frameNumber{0};     // AIManager update counter
+
+    // AI clock in milliseconds: the sum of the deltaTimes AIManager has been
+    // given, fixed for the whole frame. Same base as
+    // AIManager::getFrameTimeMs(), which behaviors use for timestamps taken
+    // outside a frame (init, messages).
+    uint64_t timeMs{0};
+
+    PlayerSnapshot player{};
+
+    // Directions toward and away from the player around obstacles, shared
+    // by every chaser and fleer this frame. Null when no navigation grid is
+    // set; behaviors then steer in a straight line.
+    const FlowField* playerField{nullptr};
+
+    // Every formation slot's position this frame, from FormationManager.
+    // Null when no formation exists; escorts then fall back to the target.
+    const FormationSnapshot* formations{nullptr};
+
+    // World seed for AIRandom; with the frame number and an entity's handle
+    // it fixes every random draw made for that entity this frame
+    uint64_t randomSeed{0};
+
+    // Seconds since each entity of the current batch last updated, parallel to
+    // the entities passed with this context. Entities on a slower update tier
+    // accumulate the frames they skipped. Empty outside a batch.
+    std::span<const float> entityDeltaTimes{};
+
+    // What each entity of the current batch senses of the player, parallel to
+    // the entities like entityDeltaTimes. Empty unless the behavior asks
+    // for perception (AIBehavior::getPerceptionSettings()).
+    std::span<const Awareness> entityAwareness{};
+
+    // The one entity's entry once narrowed by forEntity(); null without one
+    const Awareness* awareness{nullptr};
+
+    float deltaTimeFor(size_t entityIndex) const {
+        return entityIndex < entityDeltaTimes.size() ? entityDeltaTimes[entityIndex] : deltaTime;
+    }
+
+    // This context narrowed to one entity of the batch
+    FrameContext forEntity(size_t entityIndex) const {
+        FrameContext entityContext = *this;
+        entityContext.deltaTime = deltaTimeFor(entityIndex);
+        entityContext.entityDeltaTimes = {};
+        if (entityIndex < entityAwareness.size()) {
+            entityContext.awareness = &entityAwareness[entityIndex];
+        }
+        entityContext.entityAwareness = {};
+        return entityContext;
+    }
+};
+
+#endif // FRAME_CONTEXT_HPP
@@ -0,0 +1,373 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+ *
+ * Frame Task Graph: declarative per-frame stage scheduling on the ThreadSystem
+*/
+
+#ifndef FRAME_TASK_GRAPH_HPP
+#define FRAME_TASK_GRAPH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Logger.hpp"
+#include "ThreadSystem.hpp"
+
+namespace Hammer {
+
+/**
+ * @brief Dependency graph of per-frame stages, built once and replayed every frame
+ *
+ * Each stage declares the named resources it reads and writes. Edges follow
+ * program order: a stage runs after the last earlier writer of anything it
+ * touches, and a writer also waits for earlier readers of that resource.
+ * Stages with no path between them run concurrently on the ThreadSystem.
+ *
+ * compile() sizes every container, so execute() never allocates: stages are
+ * submitted as inline Tasks, per-stage dependency counters are reset in
+ * place, and the calling thread runs pending tasks while it waits. Stages
+ * flagged runOnCaller always execute on the thread that called execute().
+ *
+ * After each frame the measured critical path (the longest chain of stage
+ * times through the graph) shows which stages bound the frame.
+ */
+class FrameTaskGraph {
+public:
+    using StageFunction = std::function<void(float deltaTime)>;
+
+    static constexpr size_t INVALID_STAGE = static_cast<size_t>(-1);
+
+    FrameTaskGraph() = default;
+    FrameTaskGraph(const FrameTaskGraph&) = delete;
+    FrameTaskGraph& operator=(const FrameTaskGraph&) = delete;
+
+    /**
+     * @brief Append a stage; stages added earlier win ties on shared resources
+     *
+     * @param name Stage name (string literal; used for logging and stats)
+     * @param function Work to run each frame
+     * @param reads Resources the stage only reads
+     * @param writes Resources the stage modifies
+     * @param priority ThreadSystem priority for the stage task
+     * @param runOnCaller Run on the thread calling execute() instead of a worker
+     * @return Stage index
+     */
+    size_t addStage(const char* name, StageFunction function,
+                    std::initializer_list<const char*> reads,
+                    std::initializer_list<const char*> writes,
+                    TaskPriority priority = TaskPriority::High,
+                    bool runOnCaller = false) {
+        auto stage = std::make_unique<Stage>();
+        stage->name = name;
+        stage->function = std::move(function);
+        stage->priority = priority;
+        stage->runOnCaller = runOnCaller;
+        for (const char* resource : reads) {
+            stage->reads.push_back(resourceId(resource));
+        }
+        for (const char* resource : writes) {
+            stage->writes.push_back(resourceId(resource));
+        }
+        m_stages.push_back(std::move(stage));
+        m_compiled = false;
+        return m_stages.size() - 1;
+    }
+
+    /**
+     * @brief Resolve dependencies and size all per-frame storage
+     *
+     * Called automatically by the first execute() after the graph changes.
+     */
+    void compile() {
+        const size_t stageCount = m_stages.size();
+        std::vector<size_t> lastWriter(m_resourceNames.size(), INVALID_STAGE);
+        std::vector<std::vector<size_t>> readersSinceWrite(m_resourceNames.size());
+
+        for (auto& stage : m_stages) {
+            stage->successors.clear();
+            stage->dependencyCount = 0;
+        }
+
+        for (size_t index = 0; index < stageCount; ++index) {
+            Stage& stage = *m_stages[index];
+            for (size_t resource : stage.reads) {
+                addEdge(lastWriter[resource], index);
+            }
+            for (size_t resource : stage.writes) {
+                addEdge(lastWriter[resource], index);
+                for (size_t reader : readersSinceWrite[resource]) {
+                    addEdge(reader, index);
+                }
+            }
+            for (size_t resource : stage.reads) {
+                readersSinceWrite[resource].push_back(index);
+            }
+            for (size_t resource : stage.writes) {
+                lastWriter[resource] = index;
+                readersSinceWrite[resource].clear();
+            }
+        }
+
+        // Edges only point forward, so insertion order is a topological order
+        m_roots.clear();
+        m_callerStages.clear();
+        m_criticalPath.clear();
+        m_criticalPath.reserve(stageCount);
+        m_pathStartNs.assign(stageCount, 0);
+        m_pathParent.assign(stageCount, INVALID_STAGE);
+        m_criticalPathDepth = 0;
+
+        std::vector<size_t> depth(stageCount, 1);
+        for (size_t index = 0; index < stageCount; ++index) {
+            const Stage& stage = *m_stages[index];
+            if (stage.dependencyCount == 0) {
+                m_roots.push_back(index);
+            }
+            if (stage.runOnCaller) {
+                m_callerStages.push_back(index);
+            }
+            for (size_t successor : stage.successors) {
+                depth[successor] = std::max(depth[successor], depth[index] + 1);
+            }
+            m_criticalPathDepth = std::max(m_criticalPathDepth, depth[index]);
+        }
+
+        m_compiled = true;
+    }
+
+    /**
+     * @brief Run every stage once, honoring dependencies; returns when all are done
+     *
+     * Falls back to running stages in order on the calling thread when the
+     * ThreadSystem is unavailable. Exceptions from a stage are logged and do
+     * not stop dependent stages.
+     */
+    void execute(float deltaTime) {
+        if (!m_compiled) {
+            compile();
+        }
+        if (m_stages.empty()) {
+            return;
+        }
+
+        const auto frameStart = std::chrono::steady_clock::now();
+        m_deltaTime = deltaTime;
+
+        if (!ThreadSystem::Exists()) {
+            m_remaining.store(m_stages.size(), std::memory_order_relaxed);
+            for (size_t index = 0; index < m_stages.size(); ++index) {
+                runStage(index, false);
+            }
+        } else {
+            for (auto& stage : m_stages) {
+                stage->pending.store(stage->dependencyCount, std::memory_order_relaxed);
+                stage->callerReady.store(false, std::memory_order_relaxed);
+            }
+            m_remaining.store(m_stages.size(), std::memory_order_release);
+
+            for (size_t root : m_roots) {
+                dispatch(root);
+            }
+
+            auto& threadSystem = ThreadSystem::Instance();
+            while (m_remaining.load(std::memory_order_acquire) != 0) {
+                if (runReadyCallerStages()) {
+                    continue;
+                }
+                if (!threadSystem.runPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        m_lastFrameNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - frameStart).count());
+        updateCriticalPath();
+    }
+
+    size_t getStageCount() const { return m_stages.size(); }
+
+    const char* getStageName(size_t index) const {
+        return index < m_stages.size() ? m_stages[index]->name : "";
+    }
+
+    // Duration of a stage in the last executed frame
+    double getStageTimeMs(size_t index) const {
+        if (index >= m_stages.size()) {
+            return 0.0;
+        }
+        return static_cast<double>(m_stages[index]->lastDurationNs.load(std::memory_order_relaxed)) / 1e6;
+    }
+
+    // Wall time of the last execute()
+    double getLastFrameTimeMs() const {
+        return static_cast<double>(m_lastFrameNs) / 1e6;
+    }
+
+    // Sum of stage times along the longest dependency chain of the last frame
+    double getCriticalPathMs() const {
+        return static_cast<double>(m_criticalPathNs) / 1e6;
+    }
+
+    // Stage indices along the last frame's critical path, first to last
+    const std::vector<size_t>& getCriticalPath() const {
+        return m_criticalPath;
+    }
+
+    // Longest chain in stage count, independent of timing (valid after compile)
+    size_t getCriticalPathDepth() const {
+        return m_criticalPathDepth;
+    }
+
+    // Direct successors of a stage (valid after compile)
+    const std::vector<size_t>& getSuccessors(size_t index) const {
+        return m_stages[index]->successors;
+    }
+
+private:
+    struct Stage {
+        const char* name{""};
+        StageFunction function{};
+        std::vector<size_t> reads{};
+        std::vector<size_t> writes{};
+        std::vector<size_t> successors{};
+        size_t dependencyCount{0};
+        TaskPriority priority{TaskPriority::High};
+        bool runOnCaller{false};
+
+        // Per-frame state
+        std::atomic<size_t> pending{0};
+        std::atomic<bool> callerReady{false};
+        std::atomic<uint64_t> lastDurationNs{0};
+    };
+
+    size_t resourceId(const char* name) {
+        for (size_t i = 0; i < m_resourceNames.size(); ++i) {
+            if (m_resourceNames[i] == name) {
+                return i;
+            }
+        }
+        m_resourceNames.emplace_back(name);
+        return m_resourceNames.size() - 1;
+    }
+
+    void addEdge(size_t from, size_t to) {
+        if (from == INVALID_STAGE || from == to) {
+            return;
+        }
+        auto& successors = m_stages[from]->successors;
+        if (std::find(successors.begin(), successors.end(), to) == successors.end()) {
+            successors.push_back(to);
+            m_stages[to]->dependencyCount++;
+        }
+    }
+
+    // Hand a stage whose dependencies are satisfied to the right thread
+    void dispatch(size_t index) {
+        Stage& stage = *m_stages[index];
+        if (stage.runOnCaller) {
+            stage.callerReady.store(true, std::memory_order_release);
+            return;
+        }
+        if (!ThreadSystem::Instance().enqueueTask([this, index]() { runStage(index, true); },
+                                                  stage.priority, stage.name)) {
+            runStage(index, true);
+        }
+    }
+
+    bool runReadyCallerStages() {
+        bool ranAny = false;
+        for (size_t index : m_callerStages) {
+            if (m_stages[index]->callerReady.exchange(false, std::memory_order_acq_rel)) {
+                runStage(index, true);
+                ranAny = true;
+            }
+        }
+        return ranAny;
+    }
+
+    void runStage(size_t index, bool releaseSuccessors) {
+        Stage& stage = *m_stages[index];
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            stage.function(m_deltaTime);
+        } catch (const std::exception& e) {
+            THREADSYSTEM_ERROR("Frame stage " + std::string(stage.name) + " threw: " + std::string(e.what()));
+        } catch (...) {
+            THREADSYSTEM_ERROR("Frame stage " + std::string(stage.name) + " threw an unknown exception");
+        }
+        stage.lastDurationNs.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+
+        if (releaseSuccessors) {
+            for (size_t successor : stage.successors) {
+                if (m_stages[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    dispatch(successor);
+                }
+            }
+        }
+        // Last access to the graph from this thread; execute() may return after it
+        m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    // Longest path by measured stage time, walking stages in topological order
+    void updateCriticalPath() {
+        const size_t stageCount = m_stages.size();
+        std::fill(m_pathStartNs.begin(), m_pathStartNs.end(), 0);
+        std::fill(m_pathParent.begin(), m_pathParent.end(), INVALID_STAGE);
+
+        uint64_t longest = 0;
+        size_t last = 0;
+        for (size_t index = 0; index < stageCount; ++index) {
+            const uint64_t finish = m_pathStartNs[index] +
+                m_stages[index]->lastDurationNs.load(std::memory_order_relaxed);
+            if (finish >= longest) {
+                longest = finish;
+                last = index;
+            }
+            for (size_t successor : m_stages[index]->successors) {
+                if (finish > m_pathStartNs[successor]) {
+                    m_pathStartNs[successor] = finish;
+                    m_pathParent[successor] = index;
+                }
+            }
+        }
+
+        m_criticalPathNs = longest;
+        m_criticalPath.clear();
+        for (size_t index = last; index != INVALID_STAGE; index = m_pathParent[index]) {
+            m_criticalPath.push_back(index);
+        }
+        std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+    }
+
+    std::vector<std::unique_ptr<Stage>> m_stages{};
+    std::vector<std::string> m_resourceNames{};
+    std::vector<size_t> m_roots{};
+    std::vector<size_t> m_callerStages{};
+    bool m_compiled{false};
+
+    std::atomic<size_t> m_remaining{0};
+    float m_deltaTime{0.0f};
+
+    // Critical path bookkeeping (sized by compile())
+    std::vector<uint64_t> m_pathStartNs{};
+    std::vector<size_t> m_pathParent{};
+    std::vector<size_t> m_criticalPath{};
+    size_t m_criticalPathDepth{0};
+    uint64_t m_criticalPathNs{0};
+    uint64_t m_lastFrameNs{0};
+};
+
+} // namespace Hammer
+
+#endif // FRAME_TASK_GRAPH_HPP
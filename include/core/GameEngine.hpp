@@ -6,6 +6,7 @@
 #ifndef GAME_ENGINE_HPP
 #define GAME_ENGINE_HPP
 
+#include "core/FrameTaskGraph.hpp"
 #include "managers/GameStateManager.hpp"
 #include <SDL3_image/SDL_image.h>
 #include <atomic>
@@ -81,6 +82,12 @@ class GameEngine {
    */
   void processEngineSecondaryTasks();
 
+  /**
+   * @brief Gets the per-frame update task graph (stage timings, critical path)
+   * @return Reference to the frame task graph; read it from the update thread
+   */
+  const Hammer::FrameTaskGraph& getFrameTaskGraph() const noexcept { return m_frameGraph; }
+
   /**
    * @brief Loads resources asynchronously in background threads
    * @param path Path to resources to load
@@ -293,6 +300,14 @@ class GameEngine {
   // Render synchronization
   std::mutex m_renderMutex{};
 
+  // Per-frame update stages and their resource dependencies (built on first update)
+  Hammer::FrameTaskGraph m_frameGraph{};
+
+  /**
+   * @brief Declares the update stages and the resources each one reads/writes
+   */
+  void buildFrameGraph();
+
 
 
   // Delete copy constructor and assignment operator
@@ -178,6 +178,18 @@ namespace Hammer {
     #define AI_INFO(msg) HAMMER_INFO("AIManager", msg)
     #define AI_DEBUG(msg) HAMMER_DEBUG("AIManager", msg)
 
+    #define PATHFINDING_CRITICAL(msg) HAMMER_CRITICAL("PathfindingManager", msg)
+    #define PATHFINDING_ERROR(msg) HAMMER_ERROR("PathfindingManager", msg)
+    #define PATHFINDING_WARN(msg) HAMMER_WARN("PathfindingManager", msg)
+    #define PATHFINDING_INFO(msg) HAMMER_INFO("PathfindingManager", msg)
+    #define PATHFINDING_DEBUG(msg) HAMMER_DEBUG("PathfindingManager", msg)
+
+    #define FORMATION_CRITICAL(msg) HAMMER_CRITICAL("FormationManager", msg)
+    #define FORMATION_ERROR(msg) HAMMER_ERROR("FormationManager", msg)
+    #define FORMATION_WARN(msg) HAMMER_WARN("FormationManager", msg)
+    #define FORMATION_INFO(msg) HAMMER_INFO("FormationManager", msg)
+    #define FORMATION_DEBUG(msg) HAMMER_DEBUG("FormationManager", msg)
+
     #define EVENT_CRITICAL(msg) HAMMER_CRITICAL("EventManager", msg)
     #define EVENT_ERROR(msg) HAMMER_ERROR("EventManager", msg)
     #define EVENT_WARN(msg) HAMMER_WARN("EventManager", msg)
@@ -0,0 +1,127 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef SNAPSHOT_RING_HPP
+#define SNAPSHOT_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hammer {
+
+/**
+ * @brief Lock-free single-writer snapshot publication
+ *
+ * The writer fills a slot that is neither published nor held by a reader,
+ * then publishes it with one atomic store. Readers pin the published slot
+ * with a per-slot reader count and read it in place, so a snapshot is never
+ * copied on the way out and a reader never blocks the writer or other
+ * readers. With three slots the writer always finds a free one unless
+ * readers hold two older snapshots at once; beginWrite() then returns
+ * nullptr and the current snapshot stays published.
+ *
+ * Slots are reused, not reset: a writer overwrites whatever the slot held
+ * two publishes ago, so containers inside T keep their capacity.
+ *
+ * One writer at a time; callers serialize beginWrite()/publish().
+ */
+template<typename T, size_t SlotCount = 3>
+class SnapshotRing {
+    static_assert(SlotCount >= 2, "A snapshot ring needs a slot to write while one is published");
+
+    struct alignas(64) Slot {
+        T value;
+        mutable std::atomic<uint32_t> readers{0};
+    };
+
+public:
+    /**
+     * @brief Pins one published snapshot until destroyed
+     */
+    class ReadGuard {
+    public:
+        ReadGuard() = default;
+        ~ReadGuard() { release(); }
+
+        ReadGuard(ReadGuard&& other) noexcept : m_slot(other.m_slot) { other.m_slot = nullptr; }
+        ReadGuard& operator=(ReadGuard&& other) noexcept {
+            if (this != &other) {
+                release();
+                m_slot = other.m_slot;
+                other.m_slot = nullptr;
+            }
+            return *this;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const T& operator*() const { return m_slot->value; }
+        const T* operator->() const { return &m_slot->value; }
+
+    private:
+        friend class SnapshotRing;
+        explicit ReadGuard(const Slot* slot) : m_slot(slot) {}
+
+        void release() {
+            if (m_slot) {
+                m_slot->readers.fetch_sub(1, std::memory_order_release);
+                m_slot = nullptr;
+            }
+        }
+
+        const Slot* m_slot{nullptr};
+    };
+
+    SnapshotRing() = default;
+    SnapshotRing(const SnapshotRing&) = delete;
+    SnapshotRing& operator=(const SnapshotRing&) = delete;
+
+    // Lock-free; retries only while a publish lands between its two loads
+    ReadGuard acquire() const {
+        for (;;) {
+            uint32_t index = m_published.load(std::memory_order_seq_cst);
+            m_slots[index].readers.fetch_add(1, std::memory_order_seq_cst);
+            // Still published after pinning, so the writer cannot have picked it
+            if (m_published.load(std::memory_order_seq_cst) == index) {
+                return ReadGuard(&m_slots[index]);
+            }
+            m_slots[index].readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Claim an unpinned slot to fill
+     * @return nullptr if readers hold every slot but the published one
+     */
+    T* beginWrite() {
+        const uint32_t published = m_published.load(std::memory_order_relaxed);
+        for (uint32_t i = 1; i < SlotCount; ++i) {
+            // Oldest first, so recently released slots get time to drain
+            uint32_t index = (published + i) % SlotCount;
+            if (m_slots[index].readers.load(std::memory_order_seq_cst) == 0) {
+                m_writeIndex = index;
+                return &m_slots[index].value;
+            }
+        }
+        return nullptr;
+    }
+
+    // Make the slot claimed by the last beginWrite() the current snapshot
+    void publish() { m_published.store(m_writeIndex, std::memory_order_seq_cst); }
+
+    // Current snapshot, for the writer only; readers use acquire()
+    const T& published() const { return m_slots[m_published.load(std::memory_order_relaxed)].value; }
+
+private:
+    std::array<Slot, SlotCount> m_slots;
+    std::atomic<uint32_t> m_published{0};
+    uint32_t m_writeIndex{0};
+};
+
+} // namespace Hammer
+
+#endif // SNAPSHOT_RING_HPP
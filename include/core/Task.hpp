@@ -0,0 +1,203 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace Hammer {
+
+/**
+ * @brief Move-only callable with inline storage for the job system
+ *
+ * Replaces std::function<void()> on the submit path. Callables up to
+ * INLINE_CAPACITY bytes (e.g. a lambda capturing `this`, two indices, a
+ * deltaTime and a buffer index) live inside the Task itself, so building
+ * and queueing one never touches the heap. Larger or throwing-move
+ * callables fall back to a single heap allocation.
+ */
+class Task {
+public:
+    static constexpr size_t INLINE_CAPACITY = 48;
+
+    Task() noexcept = default;
+    Task(std::nullptr_t) noexcept {}
+
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> &&
+                                         std::is_invocable_v<std::decay_t<F>&>>>
+    Task(F&& callable) {
+        using Callable = std::decay_t<F>;
+        if constexpr (fitsInline<Callable>()) {
+            new (m_storage) Callable(std::forward<F>(callable));
+            m_ops = &InlineOps<Callable>::table;
+        } else {
+            Callable* heapCallable = new Callable(std::forward<F>(callable));
+            new (m_storage) Callable*(heapCallable);
+            m_ops = &HeapOps<Callable>::table;
+        }
+    }
+
+    Task(Task&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    void operator()() {
+        m_ops->invoke(m_storage);
+    }
+
+    explicit operator bool() const noexcept {
+        return m_ops != nullptr;
+    }
+
+    // True when the callable lives in the inline buffer (no heap allocation)
+    bool isInline() const noexcept {
+        return m_ops != nullptr && m_ops->isInline;
+    }
+
+    template<typename Callable>
+    static constexpr bool fitsInline() {
+        return sizeof(Callable) <= INLINE_CAPACITY &&
+               alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+        bool isInline;
+    };
+
+    template<typename Callable>
+    struct InlineOps {
+        static void invoke(void* storage) {
+            (*std::launder(static_cast<Callable*>(storage)))();
+        }
+        static void relocate(void* destination, void* source) noexcept {
+            Callable* from = std::launder(static_cast<Callable*>(source));
+            new (destination) Callable(std::move(*from));
+            from->~Callable();
+        }
+        static void destroy(void* storage) noexcept {
+            std::launder(static_cast<Callable*>(storage))->~Callable();
+        }
+        static constexpr Ops table{&invoke, &relocate, &destroy, true};
+    };
+
+    template<typename Callable>
+    struct HeapOps {
+        static Callable*& pointer(void* storage) {
+            return *std::launder(static_cast<Callable**>(storage));
+        }
+        static void invoke(void* storage) {
+            (*pointer(storage))();
+        }
+        static void relocate(void* destination, void* source) noexcept {
+            new (destination) Callable*(pointer(source));
+        }
+        static void destroy(void* storage) noexcept {
+            delete pointer(storage);
+        }
+        static constexpr Ops table{&invoke, &relocate, &destroy, false};
+    };
+
+    void moveFrom(Task& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->relocate(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[INLINE_CAPACITY];
+    const Ops* m_ops{nullptr};
+};
+
+/**
+ * @brief Return a process-lifetime pointer for a task description
+ *
+ * Identical strings map to the same pointer, so descriptions built at
+ * runtime are copied once and can afterwards be stored as plain
+ * `const char*` without allocating per task.
+ */
+inline const char* internTaskDescription(const std::string& description) {
+    if (description.empty()) {
+        return "";
+    }
+
+    static std::shared_mutex registryMutex;
+    static std::unordered_set<std::string> registry;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(registryMutex);
+        auto it = registry.find(description);
+        if (it != registry.end()) {
+            return it->c_str();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registryMutex);
+    // Node-based set: element addresses are stable across rehashes
+    return registry.insert(description).first->c_str();
+}
+
+/**
+ * @brief Non-owning task description handle
+ *
+ * String literals are stored as-is (zero cost); std::string arguments are
+ * interned so the pointer stays valid for the life of the process.
+ */
+struct TaskDescription {
+    const char* text{""};
+
+    TaskDescription() noexcept = default;
+    TaskDescription(const char* literal) noexcept : text(literal ? literal : "") {}
+    TaskDescription(const std::string& description) : text(internTaskDescription(description)) {}
+
+    bool empty() const noexcept { return text[0] == '\0'; }
+    const char* c_str() const noexcept { return text; }
+};
+
+} // namespace Hammer
+
+#endif // TASK_HPP
@@ -0,0 +1,44 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef TASK_LATCH_HPP
+#define TASK_LATCH_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace Hammer {
+
+/**
+ * @brief Single-use countdown latch for fork/join work within a frame
+ *
+ * Lighter than a std::future per task: one atomic counter, no shared state
+ * allocation. The final countDown() is the last access a participant makes,
+ * so the waiter may destroy the latch as soon as isReady() returns true.
+ * Waiting is left to the caller (ThreadSystem::parallelFor runs pending
+ * tasks while it waits instead of sleeping).
+ */
+class TaskLatch {
+public:
+    explicit TaskLatch(size_t count) : m_count(count) {}
+
+    TaskLatch(const TaskLatch&) = delete;
+    TaskLatch& operator=(const TaskLatch&) = delete;
+
+    void countDown() {
+        m_count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    bool isReady() const {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    std::atomic<size_t> m_count;
+};
+
+} // namespace Hammer
+
+#endif // TASK_LATCH_HPP
@@ -8,10 +8,14 @@
 #ifndef THREAD_SYSTEM_HPP
 #define THREAD_SYSTEM_HPP
 
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <exception>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <array>
@@ -21,7 +25,16 @@
 #include <thread>
 #include <SDL3/SDL.h>
 #include <vector>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
 #include "Logger.hpp"
+#include "BoundedMPMCQueue.hpp"
+#include "Task.hpp"
+#include "TaskLatch.hpp"
+#include "TraceRecorder.hpp"
+#include "WorkStealingDeque.hpp"
+#include "WorkerBudget.hpp"
 
 namespace Hammer {
 
@@ -35,23 +48,26 @@ enum class TaskPriority {
 };
 
 // Task wrapper with priority information
+// Move-only and allocation-free: the callable is stored inline in Task and
+// the description is an interned/literal string that is never copied.
 struct PrioritizedTask {
-    std::function<void()> task;
+    Task task;
     TaskPriority priority;
     std::chrono::steady_clock::time_point enqueueTime;
-    std::string description;
+    const char* description;
 
     // Default constructor
     PrioritizedTask()
         : priority(TaskPriority::Normal),
-          enqueueTime(std::chrono::steady_clock::now()) {}
+          enqueueTime(std::chrono::steady_clock::now()),
+          description("") {}
 
     // Constructor
-    PrioritizedTask(std::function<void()> t, TaskPriority p, std::string desc = "")
+    PrioritizedTask(Task t, TaskPriority p, TaskDescription desc = {})
         : task(std::move(t)),
           priority(p),
           enqueueTime(std::chrono::steady_clock::now()),
-          description(std::move(desc)) {}
+          description(desc.c_str()) {}
 
     // Comparison operator for priority queue
     bool operator<(const PrioritizedTask& other) const {
@@ -64,141 +80,160 @@ struct PrioritizedTask {
     }
 };
 
+// Priority and description of a task handed to a worker (tracing, stats)
+struct TaskInfo {
+    TaskPriority priority{TaskPriority::Normal};
+    const char* description{""};
+};
+
+/**
+ * @brief What TaskQueue::push does when a priority ring is full
+ */
+enum class QueueOverflowPolicy {
+    Block,  // Spin/yield the submitting thread until a slot frees up
+    Spill,  // Append to a mutex-guarded overflow list (unbounded, default)
+    Reject  // Drop the task and report failure to the caller
+};
+
 /**
- * @brief Thread-safe prioritized task queue using separate queues per priority
+ * @brief Thread-safe prioritized task queue using lock-free rings per priority
  *
- * This class provides a thread-safe queue for tasks to be executed by
- * the worker threads. Uses separate queues for each priority level to
- * reduce lock contention and improve performance.
+ * Each priority level owns a bounded Vyukov MPMC ring, so push and pop are
+ * O(1) and never take a lock on the fast path. When a ring fills up, the
+ * configured QueueOverflowPolicy decides whether the producer blocks, the
+ * task spills into a slower mutex-guarded list, or the task is rejected.
+ * Once a level has spilled, later tasks for that level also spill until
+ * the overflow list drains, which keeps FIFO order within a priority.
  *
- * The queues automatically grow as needed, but can also have capacity
- * reserved in advance for better performance when submitting large
- * numbers of tasks at once.
+ * Ring sizes are fixed at construction from the initial capacity. Consumers
+ * never block here; idle workers park in ThreadPool and are woken by it.
  */
-// Forward declaration for work-stealing and budget integration
-struct WorkerBudget;
-
 class TaskQueue {
 
 public:
+    static constexpr size_t PRIORITY_LEVELS = 5;
+    static constexpr size_t MIN_RING_CAPACITY = 64;
+
     /**
      * @brief Construct a new Task Queue
      *
-     * @param initialCapacity Initial capacity to reserve per priority (default: 256)
+     * @param initialCapacity Total capacity distributed across priority rings (default: 256)
      * @param enableProfiling Enable detailed task profiling (default: false)
+     * @param overflowPolicy Behavior when a priority ring is full (default: Spill)
      */
-    explicit TaskQueue(size_t initialCapacity = 256, bool enableProfiling = false)
+    explicit TaskQueue(size_t initialCapacity = 256, bool enableProfiling = false,
+                       QueueOverflowPolicy overflowPolicy = QueueOverflowPolicy::Spill)
         : m_desiredCapacity(initialCapacity),
-          m_enableProfiling(enableProfiling) {
+          m_enableProfiling(enableProfiling),
+          m_overflowPolicy(overflowPolicy) {
 
-        // Initialize separate queues for each priority level
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            m_priorityQueues[i].reserve(initialCapacity / 5); // Distribute capacity
-            m_taskStats[static_cast<TaskPriority>(i)] = {0, 0, 0};
+        // Distribute capacity across priority levels
+        size_t ringCapacity = std::max(MIN_RING_CAPACITY, initialCapacity / PRIORITY_LEVELS);
+        for (size_t i = 0; i < PRIORITY_LEVELS; ++i) {
+            m_rings[i] = std::make_unique<BoundedMPMCQueue<PrioritizedTask>>(ringCapacity);
         }
     }
 
-    void push(std::function<void()> task, TaskPriority priority = TaskPriority::Normal, const std::string& description = "") {
-        int priorityIndex = static_cast<int>(priority);
+    /**
+     * @brief Push a task onto its priority ring
+     * @return false if the task was rejected (Reject policy or shutdown while blocking)
+     */
+    bool push(Task task, TaskPriority priority = TaskPriority::Normal, TaskDescription description = {}) {
+        const size_t priorityIndex = static_cast<size_t>(priority);
+        PrioritizedTask prioritizedTask(std::move(task), priority, description);
 
-        {
-            std::unique_lock<std::mutex> lock(m_priorityMutexes[priorityIndex]);
+        bool queued = false;
+        auto& ring = *m_rings[priorityIndex];
+        auto& overflow = m_overflow[priorityIndex];
 
-            // Check if we need to increase capacity for this priority level
-            auto& queue = m_priorityQueues[priorityIndex];
-            if (queue.size() >= static_cast<size_t>((m_desiredCapacity / 5) * 9 / 10)) { // 90% of allocated capacity per priority
-                size_t newCapacity = queue.capacity() * 2;
-                queue.reserve(newCapacity);
+        // Keep FIFO order: while a level has spilled tasks, new ones spill too
+        if (overflow.count.load(std::memory_order_acquire) == 0) {
+            queued = ring.tryPush(prioritizedTask);
+        }
 
-                if (m_enableProfiling) {
-                    THREADSYSTEM_INFO("Priority " + std::to_string(priorityIndex) +
-                                    " queue capacity increased to " + std::to_string(newCapacity));
+        if (!queued) {
+            switch (m_overflowPolicy.load(std::memory_order_relaxed)) {
+                case QueueOverflowPolicy::Block:
+                    while (!(queued = ring.tryPush(prioritizedTask))) {
+                        if (stopping.load(std::memory_order_acquire)) {
+                            break;
+                        }
+                        std::this_thread::yield();
+                    }
+                    break;
+                case QueueOverflowPolicy::Spill: {
+                    std::lock_guard<std::mutex> lock(overflow.mutex);
+                    overflow.tasks.push_back(std::move(prioritizedTask));
+                    overflow.count.fetch_add(1, std::memory_order_release);
+                    m_stats[priorityIndex].spilled.fetch_add(1, std::memory_order_relaxed);
+                    queued = true;
+                    break;
                 }
-            }
-
-            // Add the new task
-            queue.emplace_back(std::move(task), priority, description);
-
-            // Update statistics
-            m_taskStats[priority].enqueued++;
-            m_totalTasksEnqueued.fetch_add(1, std::memory_order_relaxed);
-
-            // If profiling is enabled and this is a high priority task, log it
-            if (m_enableProfiling && priority <= TaskPriority::High && !description.empty()) {
-                THREADSYSTEM_INFO("High priority task enqueued: " + description +
-                                " (Priority: " + std::to_string(priorityIndex) + ")");
+                case QueueOverflowPolicy::Reject:
+                    break;
             }
         }
 
-        // Smart notification: for high/critical priority, notify all for immediate response
-        // For normal/low priority, use single notification to reduce thundering herd
-        // Hold mutex during notification to avoid race conditions
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            if (priority <= TaskPriority::High) {
-                condition.notify_all();
-            } else {
-                condition.notify_one();
+        if (!queued) {
+            m_stats[priorityIndex].rejected.fetch_add(1, std::memory_order_relaxed);
+            if (m_enableProfiling) {
+                THREADSYSTEM_WARN("Priority " + std::to_string(priorityIndex) +
+                                " queue full, task rejected" +
+                                (description.empty() ? "" : ": " + std::string(description.c_str())));
             }
-        }
-    }
-
-    bool pop(std::function<void()>& task) {
-        // Early check for stopping to prevent entering wait state during shutdown
-        if (stopping.load(std::memory_order_acquire)) {
             return false;
         }
 
-        // First try to get a task without waiting
-        if (tryPopTask(task)) {
-            return true;
-        }
-
-        // If no task available, wait for notification
-        std::unique_lock<std::mutex> lock(queueMutex);
+        // Update statistics
+        m_stats[priorityIndex].enqueued.fetch_add(1, std::memory_order_relaxed);
+        m_totalTasksEnqueued.fetch_add(1, std::memory_order_relaxed);
 
-        // Use short timeout for better work-stealing responsiveness
-        auto timeout = std::chrono::milliseconds(2);
+        // If profiling is enabled and this is a high priority task, log it
+        if (m_enableProfiling && priority <= TaskPriority::High && !description.empty()) {
+            THREADSYSTEM_INFO("High priority task enqueued: " + std::string(description.c_str()) +
+                            " (Priority: " + std::to_string(priorityIndex) + ")");
+        }
 
-        condition.wait_for(lock, timeout,
-            [this] { return stopping.load(std::memory_order_acquire) || hasAnyTasksLockFree(); });
+        // Waking workers is the ThreadPool's job (one parked worker per task)
+        return true;
+    }
 
-        // Check stopping flag first with higher priority than tasks
+    /**
+     * @brief Non-blocking pop of the highest priority task
+     * @return true if a task was retrieved
+     */
+    bool tryPop(Task& task, TaskInfo* info = nullptr) {
         if (stopping.load(std::memory_order_acquire)) {
             return false;
         }
-
-        // Release lock and try to get task again
-        lock.unlock();
-        return tryPopTask(task);
+        return tryPopTask(task, info);
     }
 
     void stop() {
-        // First set the stopping flag before locking to indicate shutdown quickly
+        // Set the stopping flag first so tryPop() refuses new work immediately
         stopping.store(true, std::memory_order_release);
 
-        // Wake up all threads immediately
-        notifyAllThreads();
-
-        // Now take locks to clear all priority queues
-        std::unique_lock<std::mutex> lock(queueMutex);
-
         // Count and clear all priority queues
         size_t totalPending = 0;
         std::map<TaskPriority, int> pendingByPriority;
 
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[i]);
-            auto& queue = m_priorityQueues[i];
-
-            if (m_enableProfiling && !queue.empty()) {
-                TaskPriority priority = static_cast<TaskPriority>(i);
-                pendingByPriority[priority] = queue.size();
-                totalPending += queue.size();
+        for (size_t i = 0; i < PRIORITY_LEVELS; ++i) {
+            size_t cleared = 0;
+            PrioritizedTask discarded;
+            while (m_rings[i]->tryPop(discarded)) {
+                cleared++;
+            }
+            {
+                std::lock_guard<std::mutex> overflowLock(m_overflow[i].mutex);
+                cleared += m_overflow[i].tasks.size();
+                m_overflow[i].tasks.clear();
+                m_overflow[i].count.store(0, std::memory_order_release);
             }
 
-            // Clear the queue
-            queue.clear();
+            if (m_enableProfiling && cleared > 0) {
+                pendingByPriority[static_cast<TaskPriority>(i)] = static_cast<int>(cleared);
+                totalPending += cleared;
+            }
         }
 
         // Log statistics if any tasks were pending
@@ -215,22 +250,10 @@ public:
 
         // Memory fence for maximum visibility across all threads
         std::atomic_thread_fence(std::memory_order_seq_cst);
-
-        // Wake all waiting threads again after clearing queues (mutex already held)
-        notifyAllThreadsUnsafe();
-
-        // Small delay to let threads notice the stop signal
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
 
     bool isEmpty() const {
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[i]);
-            if (!m_priorityQueues[i].empty()) {
-                return false;
-            }
-        }
-        return true;
+        return !hasAnyTasksLockFree();
     }
 
     // Directly check if stopping without acquiring lock
@@ -238,25 +261,26 @@ public:
         return stopping.load(std::memory_order_acquire);
     }
 
-    // Reserve capacity for all priority queues to reduce memory reallocations
+    /**
+     * @brief Record a larger desired capacity
+     *
+     * Rings are fixed-size once constructed (resizing a lock-free ring needs
+     * quiescence), so this only raises the reported capacity; bursts beyond
+     * the ring size are handled by the overflow policy. Size the queue up
+     * front via ThreadSystem::init() instead.
+     */
     void reserve(size_t capacity) {
         // Only proceed if we're actually increasing capacity
         if (capacity <= m_desiredCapacity) {
             return;
         }
 
-        // Reserve capacity for each priority queue
-        size_t capacityPerQueue = capacity / 5;
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[i]);
-            m_priorityQueues[i].reserve(capacityPerQueue);
-        }
-
         m_desiredCapacity = capacity;
 
         if (m_enableProfiling) {
             THREADSYSTEM_INFO("Task queue capacity manually set to " + std::to_string(capacity) +
-                            " (" + std::to_string(capacityPerQueue) + " per priority)");
+                            " (ring capacity " + std::to_string(m_rings[0]->capacity()) +
+                            " per priority, excess handled by overflow policy)");
         }
     }
 
@@ -266,12 +290,17 @@ public:
         return m_desiredCapacity;
     }
 
+    // Per-priority lock-free ring capacity
+    size_t ringCapacity() const {
+        return m_rings[0]->capacity();
+    }
+
     // Get the current size of all task queues combined
     size_t size() const {
         size_t totalSize = 0;
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[i]);
-            totalSize += m_priorityQueues[i].size();
+        for (size_t i = 0; i < PRIORITY_LEVELS; ++i) {
+            totalSize += m_rings[i]->size();
+            totalSize += m_overflow[i].count.load(std::memory_order_relaxed);
         }
         return totalSize;
     }
@@ -281,11 +310,25 @@ public:
         m_enableProfiling = enabled;
     }
 
+    void setOverflowPolicy(QueueOverflowPolicy policy) {
+        m_overflowPolicy.store(policy, std::memory_order_relaxed);
+    }
+
+    QueueOverflowPolicy getOverflowPolicy() const {
+        return m_overflowPolicy.load(std::memory_order_relaxed);
+    }
+
     // Get task statistics
     struct TaskStats {
         size_t enqueued{0};
         size_t completed{0};
         size_t totalWaitTimeMs{0};
+        size_t spilled{0};          // Tasks that went to the overflow list
+        size_t rejected{0};         // Tasks dropped by the overflow policy
+        double p50PopLatencyUs{0.0}; // Enqueue-to-pop latency percentiles
+        double p90PopLatencyUs{0.0};
+        double p99PopLatencyUs{0.0};
+        double maxPopLatencyUs{0.0};
 
         double getAverageWaitTimeMs() const {
             return completed > 0 ? static_cast<double>(totalWaitTimeMs) / completed : 0.0;
@@ -294,11 +337,23 @@ public:
 
     // Get statistics for a specific priority level
     TaskStats getTaskStats(TaskPriority priority) const {
-        auto it = m_taskStats.find(priority);
-        if (it != m_taskStats.end()) {
-            return it->second;
+        size_t priorityIndex = static_cast<size_t>(priority);
+        if (priorityIndex >= PRIORITY_LEVELS) {
+            return TaskStats{};
         }
-        return TaskStats{};
+
+        const auto& source = m_stats[priorityIndex];
+        TaskStats stats;
+        stats.enqueued = source.enqueued.load(std::memory_order_relaxed);
+        stats.completed = source.completed.load(std::memory_order_relaxed);
+        stats.totalWaitTimeMs = source.totalWaitTimeUs.load(std::memory_order_relaxed) / 1000;
+        stats.spilled = source.spilled.load(std::memory_order_relaxed);
+        stats.rejected = source.rejected.load(std::memory_order_relaxed);
+        stats.p50PopLatencyUs = source.latency.percentile(0.50);
+        stats.p90PopLatencyUs = source.latency.percentile(0.90);
+        stats.p99PopLatencyUs = source.latency.percentile(0.99);
+        stats.maxPopLatencyUs = source.latency.percentile(1.0);
+        return stats;
     }
 
     // Get total tasks processed and enqueued
@@ -310,102 +365,178 @@ public:
         return m_totalTasksEnqueued.load(std::memory_order_relaxed);
     }
 
+    // Number of pops that had to take an overflow-list lock held by another thread
+    size_t getLockContentionCount() const {
+        return m_lockContentionCount.load(std::memory_order_relaxed);
+    }
+
 private:
-    // Separate queues for each priority level (reduces lock contention)
-    mutable std::array<std::vector<PrioritizedTask>, 5> m_priorityQueues{};
-    mutable std::array<std::mutex, 5> m_priorityMutexes{};
+    /**
+     * @brief Lock-free log2 histogram of enqueue-to-pop latency
+     *
+     * Bucket 0 holds sub-microsecond pops, bucket i holds [2^(i-1), 2^i) us.
+     * Percentiles resolve to the bucket's upper bound, which is plenty to
+     * tell a 5us queue from a 500us one.
+     */
+    struct LatencyHistogram {
+        static constexpr size_t BUCKETS = 32;
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+
+        void record(uint64_t micros) {
+            size_t bucket = 0;
+            while (micros > 0 && bucket < BUCKETS - 1) {
+                micros >>= 1;
+                bucket++;
+            }
+            buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        double percentile(double fraction) const {
+            uint64_t total = 0;
+            for (const auto& bucket : buckets) {
+                total += bucket.load(std::memory_order_relaxed);
+            }
+            if (total == 0) {
+                return 0.0;
+            }
+
+            uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(total));
+            target = std::max<uint64_t>(1, std::min(target, total));
+            uint64_t running = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                running += buckets[i].load(std::memory_order_relaxed);
+                if (running >= target) {
+                    return i == 0 ? 1.0 : static_cast<double>(uint64_t{1} << i);
+                }
+            }
+            return static_cast<double>(uint64_t{1} << (BUCKETS - 1));
+        }
+    };
+
+    struct PriorityStats {
+        std::atomic<size_t> enqueued{0};
+        std::atomic<size_t> completed{0};
+        std::atomic<uint64_t> totalWaitTimeUs{0};
+        std::atomic<size_t> spilled{0};
+        std::atomic<size_t> rejected{0};
+        LatencyHistogram latency{};
+    };
+
+    // Slow path for tasks that did not fit in a ring (Spill policy)
+    struct OverflowList {
+        std::mutex mutex{};
+        std::deque<PrioritizedTask> tasks{};
+        std::atomic<size_t> count{0};
+    };
+
+    // Lock-free ring per priority level plus its overflow list
+    std::array<std::unique_ptr<BoundedMPMCQueue<PrioritizedTask>>, PRIORITY_LEVELS> m_rings{};
+    mutable std::array<OverflowList, PRIORITY_LEVELS> m_overflow{};
 
-    mutable std::mutex queueMutex{};  // Main mutex for condition variable
-    std::condition_variable condition{};
     std::atomic<bool> stopping{false};
 
     // Statistics tracking
-    std::map<TaskPriority, TaskStats> m_taskStats{};
+    std::array<PriorityStats, PRIORITY_LEVELS> m_stats{};
     std::atomic<size_t> m_totalTasksProcessed{0};
     std::atomic<size_t> m_totalTasksEnqueued{0};
+    std::atomic<size_t> m_lockContentionCount{0};
 
     size_t m_desiredCapacity{256}; // Track desired capacity ourselves
     bool m_enableProfiling{false}; // Enable detailed performance metrics
+    std::atomic<QueueOverflowPolicy> m_overflowPolicy{QueueOverflowPolicy::Spill};
 
     // Lock-free check for any tasks
     bool hasAnyTasksLockFree() const {
-        for (int i = 0; i <= static_cast<int>(TaskPriority::Idle); ++i) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[i], std::try_to_lock);
-            if (!priorityLock.owns_lock()) {
-                continue; // Skip if mutex is locked
-            }
-            if (!m_priorityQueues[i].empty()) {
+        for (size_t i = 0; i < PRIORITY_LEVELS; ++i) {
+            if (!m_rings[i]->empty() || m_overflow[i].count.load(std::memory_order_relaxed) > 0) {
                 return true;
             }
         }
         return false;
     }
 
-    // Try to pop a task without blocking
-    bool tryPopTask(std::function<void()>& task) {
-        // Try to get task from highest priority queues first
-        for (int priorityIndex = 0; priorityIndex <= static_cast<int>(TaskPriority::Idle); ++priorityIndex) {
-            std::unique_lock<std::mutex> priorityLock(m_priorityMutexes[priorityIndex], std::try_to_lock);
-            if (!priorityLock.owns_lock()) {
-                continue; // Skip if we can't get the lock immediately
-            }
-
-            auto& queue = m_priorityQueues[priorityIndex];
-            if (!queue.empty()) {
-                // Get the oldest task from this priority level (FIFO within priority)
-                PrioritizedTask prioritizedTask = std::move(queue.front());
-                queue.erase(queue.begin());
-
-                // Calculate wait time for metrics
-                auto now = std::chrono::steady_clock::now();
-                auto waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - prioritizedTask.enqueueTime).count();
-
-                // Update statistics if profiling is enabled
-                if (m_enableProfiling) {
-                    TaskPriority priority = static_cast<TaskPriority>(priorityIndex);
-                    m_taskStats[priority].completed++;
-                    m_taskStats[priority].totalWaitTimeMs += waitTime;
-
-                    // Log long wait times for high priority tasks
-                    if (priorityIndex <= static_cast<int>(TaskPriority::High) && waitTime > 100 && !prioritizedTask.description.empty()) {
-                        THREADSYSTEM_WARN("High priority task delayed: " + prioritizedTask.description +
-                                        " waited " + std::to_string(waitTime) + "ms");
-                    }
-                }
+    bool popFromOverflow(size_t priorityIndex, PrioritizedTask& out) {
+        auto& overflow = m_overflow[priorityIndex];
+        if (overflow.count.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
 
-                // Return the actual task
-                task = std::move(prioritizedTask.task);
-                m_totalTasksProcessed.fetch_add(1, std::memory_order_relaxed);
-                return true;
-            }
+        std::unique_lock<std::mutex> lock(overflow.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            m_lockContentionCount.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
         }
-        return false;
+        if (overflow.tasks.empty()) {
+            return false;
+        }
+        out = std::move(overflow.tasks.front());
+        overflow.tasks.pop_front();
+        overflow.count.fetch_sub(1, std::memory_order_release);
+        return true;
     }
 
+    // Try to pop a task without blocking
+    bool tryPopTask(Task& task, TaskInfo* info) {
+        PrioritizedTask prioritizedTask;
 
+        // Try to get task from highest priority queues first
+        for (size_t priorityIndex = 0; priorityIndex < PRIORITY_LEVELS; ++priorityIndex) {
+            // Ring holds the oldest tasks for this level; overflow holds newer ones
+            if (!m_rings[priorityIndex]->tryPop(prioritizedTask) &&
+                !popFromOverflow(priorityIndex, prioritizedTask)) {
+                continue;
+            }
 
-public:
-    // Wake up all waiting threads without clearing the queue
-    void notifyAllThreads() {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        condition.notify_all();
-    }
+            // Calculate wait time for metrics
+            auto now = std::chrono::steady_clock::now();
+            auto waitTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - prioritizedTask.enqueueTime).count();
+            uint64_t waitMicros = waitTimeUs > 0 ? static_cast<uint64_t>(waitTimeUs) : 0;
+
+            auto& stats = m_stats[priorityIndex];
+            stats.completed.fetch_add(1, std::memory_order_relaxed);
+            stats.totalWaitTimeUs.fetch_add(waitMicros, std::memory_order_relaxed);
+            stats.latency.record(waitMicros);
+
+            // Log long wait times for high priority tasks
+            if (m_enableProfiling && priorityIndex <= static_cast<size_t>(TaskPriority::High) &&
+                waitMicros > 100000 && prioritizedTask.description[0] != '\0') {
+                THREADSYSTEM_WARN("High priority task delayed: " + std::string(prioritizedTask.description) +
+                                " waited " + std::to_string(waitMicros / 1000) + "ms");
+            }
 
-private:
-    // Internal notify without mutex - for use when mutex is already held
-    void notifyAllThreadsUnsafe() {
-        condition.notify_all();
+            // Return the actual task
+            task = std::move(prioritizedTask.task);
+            if (info) {
+                info->priority = prioritizedTask.priority;
+                info->description = prioritizedTask.description;
+            }
+            m_totalTasksProcessed.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
     }
 };
 
 // Thread pool for managing worker threads
-// WorkerBudget-aware work-stealing queue for fair task distribution
-
-
+// Each worker owns a Chase-Lev deque for tasks it spawns itself; idle workers
+// steal from the top of other workers' deques. External submissions keep going
+// through the global priority queue.
+//
+// A worker that runs out of work spins briefly, then parks on its own wait
+// word (a futex on Linux via std::atomic::wait). Every enqueue wakes at most
+// one parked worker, so a burst of N tasks wakes at most N workers and an
+// idle pool uses no CPU.
 class ThreadPool {
 
 public:
+    static constexpr size_t LOCAL_DEQUE_CAPACITY = 256;
+    static constexpr size_t LOCAL_NODE_PREALLOC = LOCAL_DEQUE_CAPACITY;
+
+    // Idle polls before parking: the first half pause the CPU with growing
+    // counts, the second half yield the time slice
+    static constexpr size_t WORKER_SPIN_ROUNDS = 32;
+
     /**
      * @brief Construct a new Thread Pool object
      *
@@ -416,7 +547,26 @@ public:
     explicit ThreadPool(size_t numThreads, size_t queueCapacity = 256, bool enableProfiling = false)
         : taskQueue(queueCapacity, enableProfiling) {
 
-        // Work stealing removed for simplicity and reliability
+        // Per-worker deques must exist before any worker starts stealing
+        // Pre-fill each worker's node pool so nested submission does not
+        // allocate until a worker has more than LOCAL_NODE_PREALLOC tasks in flight
+        m_workerQueues.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i) {
+            auto workerQueue = std::make_unique<WorkerQueue>();
+            workerQueue->nodeStorage.reserve(LOCAL_NODE_PREALLOC);
+            for (size_t n = 0; n < LOCAL_NODE_PREALLOC; ++n) {
+                workerQueue->nodeStorage.push_back(std::make_unique<LocalTaskNode>());
+                LocalTaskNode* node = workerQueue->nodeStorage.back().get();
+                node->owner = i;
+                node->next = workerQueue->freeNodes;
+                workerQueue->freeNodes = node;
+            }
+            m_workerQueues.push_back(std::move(workerQueue));
+        }
+        m_parkedWorkers.reserve(numThreads);
+
+        // Spinning only pays off when the submitter can run at the same time
+        m_spinRounds = std::thread::hardware_concurrency() > 1 ? WORKER_SPIN_ROUNDS : 0;
 
         // Set up worker threads
         m_workers.reserve(numThreads);
@@ -435,7 +585,7 @@ public:
 
         if (enableProfiling) {
             THREADSYSTEM_INFO("Thread pool created with " + std::to_string(numThreads) +
-                            " threads, simple queue-based threading, and profiling enabled");
+                            " threads, work-stealing deques, and profiling enabled");
         }
     }
 
@@ -446,21 +596,13 @@ public:
         // Ensure all threads see the update immediately
         std::atomic_thread_fence(std::memory_order_seq_cst);
 
-        // First notify all threads without clearing the queue
-        taskQueue.notifyAllThreads();
-
-        // Small delay to allow threads to notice the shutdown signal
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Unpark every idle worker so it observes isRunning == false. A worker
+        // that parks after this re-checks isRunning once it is listed as parked.
+        wakeAllWorkers();
 
         // Then stop and clear the queue
         taskQueue.stop();
 
-        // Notify again after stopping
-        taskQueue.notifyAllThreads();
-
-        // A short delay to allow threads to exit naturally
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
         // Join all worker threads
         for (auto& worker : m_workers) {
             if (worker.joinable()) {
@@ -475,6 +617,22 @@ public:
             }
         }
 
+        // Discard worker-local tasks that never ran (workers are joined, so
+        // stealing from every deque here is race-free). Node memory itself is
+        // owned by each worker's node storage and released with it.
+        size_t abandonedLocalTasks = 0;
+        for (auto& workerQueue : m_workerQueues) {
+            LocalTaskNode* pending = nullptr;
+            while (workerQueue->deque.steal(pending)) {
+                pending->task.task = nullptr;
+                abandonedLocalTasks++;
+            }
+        }
+        if (abandonedLocalTasks > 0) {
+            THREADSYSTEM_INFO("Discarded " + std::to_string(abandonedLocalTasks) +
+                            " worker-local tasks during shutdown");
+        }
+
         THREADSYSTEM_INFO("ThreadPool shutdown completed");
 
         // Clear the worker threads
@@ -484,22 +642,43 @@ public:
     /**
      * @brief Enqueue a task with specified priority
      *
+     * Tasks submitted from one of this pool's workers go to that worker's own
+     * deque (LIFO for the owner, stealable by others). Tasks submitted from
+     * any other thread go to the global priority queue.
+     *
+     * Neither path allocates once warmed up: worker-local tasks reuse pooled
+     * nodes and global tasks are moved straight into a ring cell.
+     *
      * @param task The task to execute
      * @param priority The priority level (default: Normal)
      * @param description Optional description for debugging
+     * @return false if the global queue rejected the task (Reject overflow policy)
      */
-    void enqueue(std::function<void()> task,
+    bool enqueue(Task task,
                  TaskPriority priority = TaskPriority::Normal,
-                 const std::string& description = "") {
-        // Simple single-queue design - all tasks go to global queue
-        taskQueue.push(std::move(task), priority, description);
+                 TaskDescription description = {}) {
+        if (t_currentPool == this && t_workerIndex < m_workerQueues.size()) {
+            auto& workerQueue = *m_workerQueues[t_workerIndex];
+            LocalTaskNode* node = acquireNode(workerQueue, t_workerIndex);
+            node->task.task = std::move(task);
+            node->task.priority = priority;
+            node->task.enqueueTime = std::chrono::steady_clock::now();
+            node->task.description = description.c_str();
+            workerQueue.deque.push(node);
+            workerQueue.localPushes.fetch_add(1, std::memory_order_relaxed);
+        } else if (!taskQueue.push(std::move(task), priority, description)) {
+            return false;
+        }
         // Update comprehensive statistics for all tasks
         m_totalTasksEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+        // One task, at most one parked worker (it may also be stolen by a spinner)
+        wakeWorkers(1);
+        return true;
     }
 
     bool busy() const {
-        // Simple design - check global queue and active tasks
-        if (!taskQueue.isEmpty()) {
+        if (!taskQueue.isEmpty() || hasStealableWork()) {
             return true;
         }
 
@@ -525,6 +704,94 @@ public:
         return m_totalTasksProcessed.load(std::memory_order_relaxed);
     }
 
+    // Tasks pushed to worker-local deques instead of the global queue
+    size_t getTotalLocalTasks() const {
+        size_t total = 0;
+        for (const auto& workerQueue : m_workerQueues) {
+            total += workerQueue->localPushes.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Tasks taken from another worker's deque
+    size_t getTotalTasksStolen() const {
+        size_t total = 0;
+        for (const auto& workerQueue : m_workerQueues) {
+            total += workerQueue->steals.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Workers currently parked waiting for work
+    size_t getParkedWorkerCount() const {
+        return m_parkedCount.load(std::memory_order_relaxed);
+    }
+
+    // Times a parked worker was woken by a submission
+    size_t getTotalWorkerWakeups() const {
+        return m_totalWakeups.load(std::memory_order_relaxed);
+    }
+
+    // Current number of tasks waiting in worker-local deques
+    size_t getLocalQueueSize() const {
+        size_t total = 0;
+        for (const auto& workerQueue : m_workerQueues) {
+            total += workerQueue->deque.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Run one queued task on the calling thread, if any is available
+     *
+     * Used by threads waiting on work they submitted (e.g. parallelFor) so
+     * they help drain the pool instead of idling. Workers take from their own
+     * deque first; other threads take from the global queue, then steal.
+     *
+     * @return true if a task was executed
+     */
+    bool runPendingTask() {
+        Task task;
+        TaskInfo info;
+        bool gotTask = false;
+        const bool onWorker = t_currentPool == this && t_workerIndex < m_workerQueues.size();
+
+        if (onWorker) {
+            gotTask = tryAcquireTask(t_workerIndex, task, info);
+        } else {
+            gotTask = taskQueue.tryPop(task, &info);
+            for (size_t i = 0; !gotTask && i < m_workerQueues.size(); ++i) {
+                LocalTaskNode* node = nullptr;
+                if (m_workerQueues[i]->deque.steal(node)) {
+                    unwrapLocalTask(node, NOT_A_WORKER, task, info);
+                    gotTask = true;
+                }
+            }
+        }
+
+        if (!gotTask) {
+            return false;
+        }
+
+        m_activeTasks.fetch_add(1, std::memory_order_relaxed);
+        m_totalTasksProcessed.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t traceStartNs = TraceRecorder::isEnabled() ? TraceRecorder::nowNs() : 0;
+        try {
+            task();
+        } catch (const std::exception& e) {
+            THREADSYSTEM_ERROR("Error in task run by waiting thread: " + std::string(e.what()));
+        } catch (...) {
+            THREADSYSTEM_ERROR("Unknown error in task run by waiting thread");
+        }
+        finishActiveSlot();
+        if (traceStartNs != 0 && TraceRecorder::isEnabled()) {
+            TraceRecorder::Instance().record(info.description, "task", traceStartNs, TraceRecorder::nowNs(),
+                                             onWorker ? static_cast<int32_t>(t_workerIndex) : -1,
+                                             static_cast<int32_t>(info.priority));
+        }
+        return true;
+    }
+
     /**
      * @brief Enqueue a task that returns a result with specified priority
      *
@@ -537,49 +804,269 @@ public:
     template<class F, class... Args>
     auto enqueueWithResult(F&& f,
                           TaskPriority priority = TaskPriority::Normal,
-                          const std::string& description = "",
+                          TaskDescription description = {},
                           Args&&... args)
         -> std::future<typename std::invoke_result<F, Args...>::type> {
         using return_type = typename std::invoke_result<F, Args...>::type;
 
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
+        auto promise = std::make_shared<std::promise<return_type>>();
+        std::future<return_type> result = promise->get_future();
 
-        std::future<return_type> result = task->get_future();
-        enqueue([task](){ (*task)(); }, priority, description);
+        // The active slot is released before the result is published, so a
+        // caller woken by the future already sees this task as finished
+        enqueue([this, promise, bound = std::bind(std::forward<F>(f), std::forward<Args>(args)...)]() mutable {
+            bool released = false;
+            try {
+                if constexpr (std::is_void_v<return_type>) {
+                    bound();
+                    releaseActiveSlot();
+                    released = true;
+                    promise->set_value();
+                } else {
+                    return_type value = bound();
+                    releaseActiveSlot();
+                    released = true;
+                    promise->set_value(std::move(value));
+                }
+            } catch (...) {
+                if (!released) {
+                    releaseActiveSlot();
+                }
+                promise->set_exception(std::current_exception());
+            }
+        }, priority, description);
         return result;
     }
 private:
+    // Pooled node for worker-local tasks; returned to its owner after running
+    struct LocalTaskNode {
+        PrioritizedTask task{};
+        LocalTaskNode* next{nullptr};
+        size_t owner{0};
+    };
+
+    // Per-worker deque plus counters, padded so workers never share a line
+    struct alignas(64) WorkerQueue {
+        WorkStealingDeque<LocalTaskNode*> deque{LOCAL_DEQUE_CAPACITY};
+        std::atomic<size_t> localPushes{0};
+        std::atomic<size_t> steals{0};
+
+        // Node pool: owner pops from freeNodes without synchronization; other
+        // workers hand nodes back through the returnedNodes stack, which the
+        // owner takes wholesale with a single exchange (no ABA possible)
+        LocalTaskNode* freeNodes{nullptr};
+        std::atomic<LocalTaskNode*> returnedNodes{nullptr};
+        std::vector<std::unique_ptr<LocalTaskNode>> nodeStorage{};
+
+        // Wait word for this worker: 0 while parked, set to 1 by the waker
+        std::atomic<uint32_t> wakeSignal{0};
+    };
+
+    // Worker index used when a non-worker thread takes a worker-local node
+    static constexpr size_t NOT_A_WORKER = std::numeric_limits<size_t>::max();
+
     std::vector<std::thread> m_workers; // Thread worker pool
-    TaskQueue taskQueue; // Global priority queue for high/critical tasks
+    std::vector<std::unique_ptr<WorkerQueue>> m_workerQueues; // Indexed by worker
+    TaskQueue taskQueue; // Global priority queue for externally submitted tasks
     std::atomic<bool> isRunning{true};
     mutable std::atomic<size_t> m_activeTasks{0}; // Track actively running tasks
     mutable std::mutex m_mutex{}; // For thread-safe access to members
 
-    // Simple reliable threading - unused fields removed
+    // Identifies the pool (and worker slot) owning the current thread
+    inline static thread_local ThreadPool* t_currentPool{nullptr};
+    inline static thread_local size_t t_workerIndex{0};
+
+    // Set when the running task already gave back its active slot
+    inline static thread_local bool t_activeSlotReleased{false};
 
     // Comprehensive task statistics tracking
     std::atomic<size_t> m_totalTasksEnqueued{0}; // All tasks (global + worker queues)
     std::atomic<size_t> m_totalTasksProcessed{0}; // All tasks processed
 
+    // Parked workers; the counter lets submitters skip the lock when nobody sleeps
+    std::mutex m_parkMutex{};
+    std::vector<size_t> m_parkedWorkers{};
+    std::atomic<size_t> m_parkedCount{0};
+    std::atomic<size_t> m_totalWakeups{0};
+    size_t m_spinRounds{WORKER_SPIN_ROUNDS};
+
+    static void cpuRelax() {
+        #if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        _mm_pause();
+        #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+        #else
+        std::this_thread::yield();
+        #endif
+    }
+
+    /**
+     * @brief Wake up to count parked workers
+     *
+     * The fence pairs with the one in parkWorker(): either the submitter sees
+     * the worker in the parked list, or the worker's re-check sees the task.
+     */
+    void wakeWorkers(size_t count) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_parkedCount.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_parkMutex);
+        while (count > 0 && !m_parkedWorkers.empty()) {
+            auto& workerQueue = *m_workerQueues[m_parkedWorkers.back()];
+            m_parkedWorkers.pop_back();
+            m_parkedCount.fetch_sub(1, std::memory_order_relaxed);
+            workerQueue.wakeSignal.store(1, std::memory_order_release);
+            workerQueue.wakeSignal.notify_one();
+            m_totalWakeups.fetch_add(1, std::memory_order_relaxed);
+            count--;
+        }
+    }
+
+    void wakeAllWorkers() {
+        wakeWorkers(m_workerQueues.size());
+    }
+
+    /**
+     * @brief Park an idle worker until a submitter wakes it
+     *
+     * The worker lists itself as parked before a final check for work, so a
+     * task pushed concurrently is either found here or wakes this worker.
+     *
+     * @return true if the final check found a task (worker did not sleep)
+     */
+    bool parkWorker(size_t threadIndex, Task& task, TaskInfo& info) {
+        auto& own = *m_workerQueues[threadIndex];
+        own.wakeSignal.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_parkedWorkers.push_back(threadIndex);
+            m_parkedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const bool gotTask = tryAcquireTask(threadIndex, task, info);
+        if (gotTask || !isRunning.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            auto it = std::find(m_parkedWorkers.begin(), m_parkedWorkers.end(), threadIndex);
+            if (it != m_parkedWorkers.end()) {
+                m_parkedWorkers.erase(it);
+                m_parkedCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+            // Otherwise a submitter already claimed us; we are awake anyway and
+            // will look for its task on the next loop
+            return gotTask;
+        }
+
+        own.wakeSignal.wait(0, std::memory_order_acquire);
+        return false;
+    }
+
+    // Drop the running task from m_activeTasks ahead of its runner (result tasks)
+    void releaseActiveSlot() {
+        m_activeTasks.fetch_sub(1, std::memory_order_relaxed);
+        t_activeSlotReleased = true;
+    }
+
+    // Runner side: drop the active slot unless the task already did
+    void finishActiveSlot() {
+        if (t_activeSlotReleased) {
+            t_activeSlotReleased = false;
+            return;
+        }
+        m_activeTasks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool hasStealableWork() const {
+        for (const auto& workerQueue : m_workerQueues) {
+            if (!workerQueue->deque.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Get a free node from the worker's pool (owner thread only)
+    static LocalTaskNode* acquireNode(WorkerQueue& workerQueue, size_t owner) {
+        if (!workerQueue.freeNodes) {
+            workerQueue.freeNodes = workerQueue.returnedNodes.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (LocalTaskNode* node = workerQueue.freeNodes) {
+            workerQueue.freeNodes = node->next;
+            return node;
+        }
+
+        // Pool exhausted - grow it (only happens while warming up)
+        workerQueue.nodeStorage.push_back(std::make_unique<LocalTaskNode>());
+        LocalTaskNode* node = workerQueue.nodeStorage.back().get();
+        node->owner = owner;
+        return node;
+    }
 
+    // Take the task out of a node and hand the node back to its owner's pool
+    void unwrapLocalTask(LocalTaskNode* node, size_t threadIndex, Task& task, TaskInfo& info) {
+        task = std::move(node->task.task);
+        info.priority = node->task.priority;
+        info.description = node->task.description;
 
+        auto& ownerQueue = *m_workerQueues[node->owner];
+        if (node->owner == threadIndex) {
+            node->next = ownerQueue.freeNodes;
+            ownerQueue.freeNodes = node;
+            return;
+        }
 
+        LocalTaskNode* head = ownerQueue.returnedNodes.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!ownerQueue.returnedNodes.compare_exchange_weak(head, node,
+                     std::memory_order_release, std::memory_order_relaxed));
+    }
 
+    /**
+     * @brief Non-blocking task acquisition for a worker
+     *
+     * Order: own deque (hot, LIFO) -> global priority queue -> steal from
+     * other workers starting after our own index so thieves spread out.
+     */
+    bool tryAcquireTask(size_t threadIndex, Task& task, TaskInfo& info) {
+        auto& own = *m_workerQueues[threadIndex];
+        LocalTaskNode* node = nullptr;
 
+        if (own.deque.pop(node)) {
+            unwrapLocalTask(node, threadIndex, task, info);
+            return true;
+        }
+
+        if (taskQueue.tryPop(task, &info)) {
+            return true;
+        }
+
+        const size_t workerCount = m_workerQueues.size();
+        for (size_t offset = 1; offset < workerCount; ++offset) {
+            auto& victim = *m_workerQueues[(threadIndex + offset) % workerCount];
+            if (victim.deque.steal(node)) {
+                own.steals.fetch_add(1, std::memory_order_relaxed);
+                unwrapLocalTask(node, threadIndex, task, info);
+                return true;
+            }
+        }
+        return false;
+    }
 
     void workerThread(size_t threadIndex = 0) {
-        std::function<void()> task;
+        Task task;
+
+        t_currentPool = this;
+        t_workerIndex = threadIndex;
+        TraceRecorder::setThreadName("Worker " + std::to_string(threadIndex));
 
         // For statistics tracking
         auto startTime = std::chrono::steady_clock::now();
         size_t tasksProcessed = 0;
         size_t highPriorityTasks = 0;
 
-        // Exponential backoff state (thread-local, no static variables)
-        size_t consecutiveEmptyPolls = 0;
-
         // Set thread as interruptible (platform-specific if needed)
         try {
             // Main worker loop
@@ -590,17 +1077,30 @@ private:
                 }
 
                 bool gotTask = false;
-                bool isHighPriority = false;
+                TaskInfo info;
 
                 try {
-                    // WorkerBudget-aware task acquisition priority order:
-                    // 1. Global queue for high/critical priority tasks (WorkerBudget engine/urgent tasks)
-                    if (taskQueue.pop(task)) {
-                        gotTask = true;
-                        isHighPriority = true;
+                    gotTask = tryAcquireTask(threadIndex, task, info);
+
+                    // Spin briefly: work usually arrives in bursts within a frame
+                    for (size_t spin = 0; !gotTask && spin < m_spinRounds; ++spin) {
+                        if (spin < m_spinRounds / 2) {
+                            for (size_t pause = 0; pause < (size_t{1} << std::min<size_t>(spin, 6)); ++pause) {
+                                cpuRelax();
+                            }
+                        } else {
+                            std::this_thread::yield();
+                        }
+                        gotTask = tryAcquireTask(threadIndex, task, info);
+                    }
+
+                    // Nothing anywhere - park until a submission wakes us
+                    if (!gotTask && !taskQueue.isStopping()) {
+                        gotTask = parkWorker(threadIndex, task, info);
+                    }
+                    if (gotTask && info.priority <= TaskPriority::High) {
                         highPriorityTasks++;
                     }
-                    // All tasks go through single global queue - simple and reliable
                 } catch (...) {
                     // If any exception occurs during pop, check shutdown
                     if (!isRunning.load(std::memory_order_acquire)) {
@@ -615,12 +1115,13 @@ private:
                 }
 
                 if (gotTask) {
-                    // Reset exponential backoff when work is found
-                    consecutiveEmptyPolls = 0;
-
                     // Optimized: Only increment counter when we actually have work
                     const size_t activeCount = m_activeTasks.fetch_add(1, std::memory_order_relaxed) + 1;
 
+                    // Counted when claimed so that a caller woken by the task's own
+                    // completion (e.g. a future) already observes it as processed
+                    m_totalTasksProcessed.fetch_add(1, std::memory_order_relaxed);
+
                     // Track execution time for profiling
                     auto taskStartTime = std::chrono::steady_clock::now();
 
@@ -628,9 +1129,6 @@ private:
                         // Execute the task and increment counter
                         task();
                         tasksProcessed++;
-
-                        // Update comprehensive statistics
-                        m_totalTasksProcessed.fetch_add(1, std::memory_order_relaxed);
                     } catch (const std::exception& e) {
                         THREADSYSTEM_ERROR("Error in worker thread " + std::to_string(threadIndex) +
                                          ": " + std::string(e.what()));
@@ -639,18 +1137,28 @@ private:
                     }
 
                     // Decrement with relaxed ordering - order doesn't matter for simple counting
-                    m_activeTasks.fetch_sub(1, std::memory_order_relaxed);
+                    finishActiveSlot();
 
                     // Track execution time
                     auto taskEndTime = std::chrono::steady_clock::now();
                     auto taskDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
                         taskEndTime - taskStartTime).count();
 
+                    // Reuses the timestamps above; disabled cost is one relaxed load
+                    if (TraceRecorder::isEnabled()) {
+                        TraceRecorder::Instance().record(info.description, "task",
+                                                         TraceRecorder::toNs(taskStartTime),
+                                                         TraceRecorder::toNs(taskEndTime),
+                                                         static_cast<int32_t>(threadIndex),
+                                                         static_cast<int32_t>(info.priority));
+                    }
+
                     // Log slow tasks if they exceed 100ms (truly problematic tasks)
                     if (taskDuration > 100) {
                         THREADSYSTEM_WARN("Worker " + std::to_string(threadIndex) +
                                         " - Slow task: " + std::to_string(taskDuration) + "ms" +
-                                        (isHighPriority ? " (HIGH PRIORITY)" : ""));
+                                        (info.priority <= TaskPriority::High ? " (HIGH PRIORITY)" : "") +
+                                        (info.description[0] != '\0' ? " " + std::string(info.description) : ""));
                     }
 
                     // Clear task after execution to free resources
@@ -658,25 +1166,6 @@ private:
 
                     // Unused variable warning suppression
                     (void)activeCount;
-                } else {
-                    // No task available, check shutdown and then sleep briefly
-                    if (!isRunning.load(std::memory_order_acquire)) {
-                        break;
-                    }
-
-                    // Less aggressive backoff sleep to reduce CPU usage and work stealing pressure
-                    consecutiveEmptyPolls++;
-
-                    // Simple exponential backoff for idle workers
-                    auto sleepTime = std::chrono::microseconds(50);   // Start with 50μs
-                    if (consecutiveEmptyPolls > 5) {
-                        sleepTime = std::chrono::microseconds(200);   // Ramp to 200μs
-                    }
-                    if (consecutiveEmptyPolls > 15) {
-                        sleepTime = std::chrono::microseconds(500);   // Max 500μs for responsiveness
-                    }
-
-                    std::this_thread::sleep_for(sleepTime);
                 }
             }
         } catch (const std::exception& e) {
@@ -687,6 +1176,8 @@ private:
                              " terminated with unknown exception");
         }
 
+        t_currentPool = nullptr;
+
         // Log worker thread statistics on exit
         auto endTime = std::chrono::steady_clock::now();
         auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -736,12 +1227,8 @@ public:
         std::atomic_thread_fence(std::memory_order_seq_cst);
 
         if (m_threadPool) {
-            // First signal the pool to stop accepting new tasks
-            // We don't actually need to wait for pending tasks to complete here
-            m_threadPool->getTaskQueue().notifyAllThreads();
-
-            // Allow a very brief delay for threads to notice shutdown signal
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // Pending tasks are not waited for; the pool destructor unparks
+            // the workers and discards whatever is still queued
 
             // Log the number of pending tasks
             size_t pendingTasks = m_threadPool->getTaskQueue().size();
@@ -806,6 +1293,7 @@ public:
         // Create thread pool with profiling if enabled
         try {
             m_threadPool = std::make_unique<ThreadPool>(m_numThreads, m_queueCapacity, m_enableProfiling);
+            m_budgetController.reset(m_numThreads);
 
             THREADSYSTEM_INFO("ThreadSystem initialized with " + std::to_string(m_numThreads) +
                             " worker threads" + (m_enableProfiling ? " (profiling enabled)" : ""));
@@ -827,26 +1315,28 @@ public:
      *
      * @param task The task to execute
      * @param priority The priority level for the task
-     * @param description Optional description for debugging and monitoring
+     * @param description Optional description; literals are stored as-is, std::string values are interned
+     * @return true if the task was queued; false after shutdown or when the
+     *         queue's overflow policy is Reject and the priority ring is full
      */
-    void enqueueTask(std::function<void()> task,
+    bool enqueueTask(Task task,
                      TaskPriority priority = TaskPriority::Normal,
-                     const std::string& description = "") {
+                     TaskDescription description = {}) {
         // If shutdown or no thread pool, silently reject the task (for tests)
         if (m_isShutdown.load(std::memory_order_acquire) || !m_threadPool) {
             if (m_enableDebugLogging) {
                 THREADSYSTEM_DEBUG("Ignoring task after shutdown" +
-                    (description.empty() ? "" : " (" + description + ")"));
+                    (description.empty() ? std::string() : " (" + std::string(description.c_str()) + ")"));
             }
-            return;
+            return false;
         }
 
         // If debug logging is enabled and we have a description, log it
         if (!description.empty() && m_enableDebugLogging) {
-            THREADSYSTEM_DEBUG("Enqueuing task: " + description);
+            THREADSYSTEM_DEBUG("Enqueuing task: " + std::string(description.c_str()));
         }
 
-        m_threadPool->enqueue(std::move(task), priority, description);
+        return m_threadPool->enqueue(std::move(task), priority, description);
     }
 
     /**
@@ -866,7 +1356,7 @@ public:
     template<class F, class... Args>
     auto enqueueTaskWithResult(F&& f,
                               TaskPriority priority = TaskPriority::Normal,
-                              const std::string& description = "",
+                              TaskDescription description = {},
                               Args&&... args)
         -> std::future<typename std::invoke_result<F, Args...>::type> {
         // If shutdown or no thread pool, return a future with default value (for tests)
@@ -877,7 +1367,7 @@ public:
 
             if (m_enableDebugLogging) {
                 THREADSYSTEM_DEBUG("Returning default value for task after shutdown" +
-                    (description.empty() ? "" : " (" + description + ")"));
+                    (description.empty() ? std::string() : " (" + std::string(description.c_str()) + ")"));
             }
 
             // Set the result using default construction if possible
@@ -915,6 +1405,124 @@ public:
         }
     }
 
+    /**
+     * @brief Run fn over [begin, end) in chunks and return once every chunk is done
+     *
+     * Chunks are claimed dynamically from a shared counter by the calling
+     * thread and up to workerCount helper tasks, so uneven chunks balance out.
+     * The caller always participates; once the range is exhausted it runs
+     * other pending tasks until all helpers have finished, which also keeps
+     * nested calls from worker threads deadlock-free. Completion is tracked
+     * with a TaskLatch, so no futures or shared state are allocated.
+     *
+     * The range is split into at most (helpers + 1) * PARALLEL_FOR_CHUNKS_PER_THREAD
+     * chunks of at least grainSize indices. Without a thread pool, or when the
+     * range fits in one chunk, fn runs inline on the caller.
+     *
+     * @param begin First index
+     * @param end One past the last index
+     * @param grainSize Minimum number of indices per chunk
+     * @param fn Callable invoked as fn(chunkBegin, chunkEnd)
+     * @param workerCount Helper workers to use, normally from
+     *        WorkerBudget::getOptimalWorkerCount(); 0 runs inline on the caller,
+     *        AUTO_WORKER_COUNT uses every worker not reserved for the engine
+     * @param priority Priority of the helper tasks (default: High)
+     * @param description Description of the helper tasks
+     * @throws Rethrows the first exception thrown by fn, after all chunks finish
+     */
+    template<typename Fn>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, Fn&& fn,
+                     size_t workerCount = AUTO_WORKER_COUNT,
+                     TaskPriority priority = TaskPriority::High,
+                     TaskDescription description = "ParallelFor_Chunk") {
+        if (begin >= end) {
+            return;
+        }
+
+        const size_t count = end - begin;
+        grainSize = std::max<size_t>(1, grainSize);
+        const size_t maxChunks = (count + grainSize - 1) / grainSize;
+
+        size_t helpers = 0;
+        if (maxChunks > 1 && m_threadPool && !m_isShutdown.load(std::memory_order_acquire)) {
+            if (workerCount == AUTO_WORKER_COUNT) {
+                WorkerBudget budget = m_budgetController.getBudget();
+                workerCount = budget.totalWorkers - budget.engineReserved;
+            }
+            helpers = std::min({workerCount, static_cast<size_t>(m_numThreads), maxChunks - 1});
+        }
+
+        if (helpers == 0) {
+            fn(begin, end);
+            return;
+        }
+
+        using State = ParallelForState<std::remove_reference_t<Fn>>;
+        const size_t chunkCount = std::min(maxChunks, (helpers + 1) * PARALLEL_FOR_CHUNKS_PER_THREAD);
+        State state(fn, begin, count, chunkCount, helpers);
+
+        for (size_t i = 0; i < helpers; ++i) {
+            // A rejected or discarded helper counts itself down when destroyed
+            m_threadPool->enqueue(ParallelForHelper<State>(&state), priority, description);
+        }
+
+        state.runChunks();
+
+        while (!state.helpersDone.isReady()) {
+            if (!m_threadPool->runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+    }
+
+    /**
+     * @brief Apply fn to every element of [first, last) using parallelFor
+     *
+     * @param first Random access iterator to the first element
+     * @param last Random access iterator one past the last element
+     * @param grainSize Minimum number of elements per chunk
+     * @param fn Callable invoked as fn(element)
+     * @param workerCount Helper workers to use (see parallelFor)
+     * @param priority Priority of the helper tasks (default: High)
+     * @param description Description of the helper tasks
+     */
+    template<typename RandomIt, typename Fn>
+    void parallelForEach(RandomIt first, RandomIt last, size_t grainSize, Fn&& fn,
+                         size_t workerCount = AUTO_WORKER_COUNT,
+                         TaskPriority priority = TaskPriority::High,
+                         TaskDescription description = "ParallelForEach_Chunk") {
+        const auto count = std::distance(first, last);
+        if (count <= 0) {
+            return;
+        }
+
+        parallelFor(0, static_cast<size_t>(count), grainSize,
+            [first, &fn](size_t chunkBegin, size_t chunkEnd) {
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                    fn(first[static_cast<typename std::iterator_traits<RandomIt>::difference_type>(i)]);
+                }
+            }, workerCount, priority, description);
+    }
+
+    /**
+     * @brief Execute one pending task on the calling thread, if there is one
+     *
+     * For threads that wait on work they submitted (parallelFor, FrameTaskGraph)
+     * so they contribute instead of idling.
+     *
+     * @return true if a task was executed
+     */
+    bool runPendingTask() {
+        if (m_isShutdown.load(std::memory_order_acquire) || !m_threadPool) {
+            return false;
+        }
+        return m_threadPool->runPendingTask();
+    }
+
     bool isBusy() const {
         // If shutdown or no thread pool, not busy anymore
         if (m_isShutdown.load(std::memory_order_acquire) || !m_threadPool) {
@@ -945,7 +1553,7 @@ public:
     // Get the current number of tasks in the queue
     size_t getQueueSize() const {
         if (m_threadPool) {
-            return m_threadPool->getTaskQueue().size();
+            return m_threadPool->getTaskQueue().size() + m_threadPool->getLocalQueueSize();
         }
         return 0;
     }
@@ -985,6 +1593,90 @@ public:
         return 0;
     }
 
+    // Work-stealing statistics (tasks spawned from workers stay worker-local)
+    size_t getTotalLocalTasks() const {
+        if (m_threadPool) {
+            return m_threadPool->getTotalLocalTasks();
+        }
+        return 0;
+    }
+
+    size_t getTotalTasksStolen() const {
+        if (m_threadPool) {
+            return m_threadPool->getTotalTasksStolen();
+        }
+        return 0;
+    }
+
+    // Idle workers currently parked (not spinning, not running tasks)
+    size_t getParkedWorkerCount() const {
+        if (m_threadPool) {
+            return m_threadPool->getParkedWorkerCount();
+        }
+        return 0;
+    }
+
+    // Parked workers woken by submissions; at most one per enqueued task
+    size_t getTotalWorkerWakeups() const {
+        if (m_threadPool) {
+            return m_threadPool->getTotalWorkerWakeups();
+        }
+        return 0;
+    }
+
+    // Contended lock acquisitions on the global queue (contention indicator)
+    size_t getQueueContentionCount() const {
+        if (m_threadPool) {
+            return m_threadPool->getTaskQueue().getLockContentionCount();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Choose what happens when a priority ring of the global queue is full
+     *
+     * Spill (default) keeps the old unbounded behavior via a slower overflow
+     * list, Block makes the submitting thread wait for space, and Reject
+     * drops the task (enqueueTask returns false, futures report broken_promise).
+     */
+    void setQueueOverflowPolicy(QueueOverflowPolicy policy) {
+        if (m_threadPool) {
+            m_threadPool->getTaskQueue().setOverflowPolicy(policy);
+        }
+    }
+
+    // Per-priority queue statistics including pop latency percentiles
+    TaskQueue::TaskStats getTaskStats(TaskPriority priority) const {
+        if (m_threadPool) {
+            return m_threadPool->getTaskQueue().getTaskStats(priority);
+        }
+        return TaskQueue::TaskStats{};
+    }
+
+    /**
+     * @brief Current worker budget, rebalanced at runtime from measured load
+     *
+     * Lock-free; managers should call this each frame instead of
+     * calculateWorkerBudget(), which only knows the thread count.
+     */
+    WorkerBudget getWorkerBudget() const {
+        return m_budgetController.getBudget();
+    }
+
+    // Report subsystem work time (see WorkerBudgetController::reportWorkTime)
+    void reportSubsystemWork(BudgetSubsystem subsystem, double workMs) {
+        m_budgetController.reportWorkTime(subsystem, workMs);
+    }
+
+    // Adaptive budget controller: endFrame() once per frame, stats for graphs
+    WorkerBudgetController& getWorkerBudgetController() {
+        return m_budgetController;
+    }
+
+    const WorkerBudgetController& getWorkerBudgetController() const {
+        return m_budgetController;
+    }
+
     // Enable or disable debug logging
     void setDebugLogging(bool enable) {
         m_enableDebugLogging = enable;
@@ -994,8 +1686,85 @@ public:
         return m_enableDebugLogging;
     }
 
+    // Chunks per participating thread in parallelFor (more chunks = better balance)
+    static constexpr size_t PARALLEL_FOR_CHUNKS_PER_THREAD = 4;
+
+    // parallelFor worker count meaning "derive from WorkerBudget"
+    static constexpr size_t AUTO_WORKER_COUNT = std::numeric_limits<size_t>::max();
+
 private:
+    // Shared state for one parallelFor call; lives on the caller's stack
+    template<typename Fn>
+    struct ParallelForState {
+        Fn& fn;
+        const size_t begin;
+        const size_t count;
+        const size_t chunkCount;
+        std::atomic<size_t> nextChunk{0};
+        TaskLatch helpersDone;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error{};
+
+        ParallelForState(Fn& function, size_t first, size_t total, size_t chunks, size_t helpers)
+            : fn(function), begin(first), count(total), chunkCount(chunks), helpersDone(helpers) {}
+
+        void runChunks() {
+            for (;;) {
+                const size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunkCount) {
+                    return;
+                }
+                // Even split: chunk sizes differ by at most one index
+                const size_t chunkBegin = begin + (count * chunk) / chunkCount;
+                const size_t chunkEnd = begin + (count * (chunk + 1)) / chunkCount;
+                try {
+                    fn(chunkBegin, chunkEnd);
+                } catch (...) {
+                    if (!failed.exchange(true, std::memory_order_acq_rel)) {
+                        error = std::current_exception();
+                    }
+                    nextChunk.store(chunkCount, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    // Helper task body; counts down exactly once whether it runs or is discarded
+    template<typename State>
+    class ParallelForHelper {
+    public:
+        explicit ParallelForHelper(State* state) noexcept : m_state(state) {}
+        ParallelForHelper(ParallelForHelper&& other) noexcept : m_state(other.m_state) {
+            other.m_state = nullptr;
+        }
+        ParallelForHelper(const ParallelForHelper&) = delete;
+        ParallelForHelper& operator=(const ParallelForHelper&) = delete;
+        ParallelForHelper& operator=(ParallelForHelper&&) = delete;
+
+        ~ParallelForHelper() {
+            release();
+        }
+
+        void operator()() {
+            if (m_state) {
+                m_state->runChunks();
+                release();
+            }
+        }
+
+    private:
+        void release() noexcept {
+            if (State* state = m_state) {
+                m_state = nullptr;
+                state->helpersDone.countDown(); // Last access to the caller's state
+            }
+        }
+
+        State* m_state;
+    };
+
     std::unique_ptr<ThreadPool> m_threadPool{nullptr};
+    WorkerBudgetController m_budgetController{};
     unsigned int m_numThreads{};
     size_t m_queueCapacity{DEFAULT_QUEUE_CAPACITY};
     std::atomic<bool> m_isShutdown{false}; // Flag to indicate shutdown status
@@ -0,0 +1,384 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef TRACE_RECORDER_HPP
+#define TRACE_RECORDER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Hammer {
+
+/**
+ * @brief One completed span ("X" event in the Chrome trace format)
+ *
+ * Names and categories must outlive the trace; string literals and
+ * interned task descriptions both qualify.
+ */
+struct TraceEvent {
+    const char* name{""};
+    const char* category{""};
+    uint64_t startNs{0};       // steady_clock time since epoch
+    uint64_t durationNs{0};
+    int32_t workerIndex{-1};   // ThreadSystem worker, -1 for other threads
+    int32_t priority{-1};      // TaskPriority value, -1 for zones
+};
+
+/**
+ * @brief Opt-in task and zone tracer that dumps Chrome Trace Event JSON
+ *
+ * Every thread records into its own fixed-capacity buffer, so recording is
+ * a plain store plus a release increment: no locks and no allocation once
+ * the thread's buffer exists. Full buffers drop new events (and count
+ * them) rather than wrap, which keeps dumping safe while threads record.
+ *
+ * Disabled cost is one relaxed atomic load per task or zone. Define
+ * HAMMER_DISABLE_TRACING to compile the zone macro out entirely.
+ *
+ * Open the written file in chrome://tracing or https://ui.perfetto.dev.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+
+    static TraceRecorder& Instance() {
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static uint64_t toNs(std::chrono::steady_clock::time_point time) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            time.time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Discard previous events and start recording
+     * @param eventsPerThread Capacity of each thread's buffer
+     */
+    void start(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD) {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_eventsPerThread.store(eventsPerThread > 0 ? eventsPerThread : 1, std::memory_order_relaxed);
+        m_startNs = nowNs();
+        // Buffers reset themselves lazily on their next record (see acquire())
+        m_generation.fetch_add(1, std::memory_order_release);
+        s_enabled.store(true, std::memory_order_release);
+    }
+
+    // Stop recording; events stay available for dumping until the next start()
+    void stop() {
+        s_enabled.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Record a completed span for the calling thread
+     *
+     * Callers check isEnabled() first so the disabled path stays a single load.
+     */
+    void record(const char* name, const char* category, uint64_t startNs, uint64_t endNs,
+                int32_t workerIndex = -1, int32_t priority = -1) {
+        ThreadBuffer* buffer = acquire();
+        if (!buffer) {
+            return;
+        }
+        const size_t index = buffer->count.load(std::memory_order_relaxed);
+        if (index >= buffer->events.size()) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        TraceEvent& event = buffer->events[index];
+        event.name = name ? name : "";
+        event.category = category;
+        event.startNs = startNs;
+        event.durationNs = endNs > startNs ? endNs - startNs : 0;
+        event.workerIndex = workerIndex;
+        event.priority = priority;
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Label the calling thread in the trace (e.g. "Worker 3")
+     *
+     * Applies to events recorded afterwards; cheap enough to call once per
+     * thread start even when tracing is off.
+     */
+    static void setThreadName(const std::string& name) {
+        threadName() = name;
+        if (ThreadBuffer* buffer = threadBuffer().buffer) {
+            std::lock_guard<std::mutex> lock(Instance().m_registryMutex);
+            buffer->threadName = name;
+        }
+    }
+
+    // Events recorded since start() (including by threads that have exited)
+    size_t getEventCount() const {
+        size_t total = 0;
+        forEachCurrentBuffer([&](const ThreadBuffer& buffer, size_t count) {
+            (void)buffer;
+            total += count;
+        });
+        return total;
+    }
+
+    // Events lost because a thread's buffer was full
+    size_t getDroppedEventCount() const {
+        size_t total = 0;
+        forEachCurrentBuffer([&](const ThreadBuffer& buffer, size_t count) {
+            (void)count;
+            total += buffer.dropped.load(std::memory_order_relaxed);
+        });
+        return total;
+    }
+
+    /**
+     * @brief Serialize the recorded events as Chrome Trace Event JSON
+     *
+     * Safe to call while recording; events finished after the call starts
+     * may or may not be included.
+     */
+    std::string toChromeTraceJson() const {
+        std::string json;
+        json.reserve(256 + getEventCount() * 128);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        char number[96];
+        forEachCurrentBuffer([&](const ThreadBuffer& buffer, size_t count) {
+            // Thread label shown by the viewer
+            json += first ? "\n" : ",\n";
+            first = false;
+            std::snprintf(number, sizeof(number), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,", buffer.threadId);
+            json += number;
+            json += "\"name\":\"thread_name\",\"args\":{\"name\":\"";
+            appendEscaped(json, buffer.threadName.empty()
+                ? "Thread " + std::to_string(buffer.threadId) : buffer.threadName);
+            json += "\"}}";
+
+            for (size_t i = 0; i < count; ++i) {
+                const TraceEvent& event = buffer.events[i];
+                const uint64_t relativeNs = event.startNs > m_startNs ? event.startNs - m_startNs : 0;
+                json += ",\n{\"ph\":\"X\",\"pid\":1,";
+                std::snprintf(number, sizeof(number), "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,",
+                              buffer.threadId, static_cast<double>(relativeNs) / 1000.0,
+                              static_cast<double>(event.durationNs) / 1000.0);
+                json += number;
+                json += "\"name\":\"";
+                appendEscaped(json, event.name[0] != '\0' ? event.name : "Task");
+                json += "\",\"cat\":\"";
+                appendEscaped(json, event.category);
+                json += "\"";
+                if (event.workerIndex >= 0 || event.priority >= 0) {
+                    json += ",\"args\":{";
+                    bool firstArg = true;
+                    if (event.workerIndex >= 0) {
+                        std::snprintf(number, sizeof(number), "\"worker\":%d", event.workerIndex);
+                        json += number;
+                        firstArg = false;
+                    }
+                    if (event.priority >= 0) {
+                        json += firstArg ? "" : ",";
+                        json += "\"priority\":\"";
+                        json += priorityName(event.priority);
+                        json += "\"";
+                    }
+                    json += "}";
+                }
+                json += "}";
+            }
+        });
+
+        json += "\n]}\n";
+        return json;
+    }
+
+    /**
+     * @brief Write the trace to disk
+     * @return false if the file could not be written
+     */
+    bool writeChromeTrace(const std::string& path) const {
+        const std::string json = toChromeTraceJson();
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        return (std::fclose(file) == 0) && written;
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+private:
+    struct ThreadBuffer {
+        std::vector<TraceEvent> events{};
+        std::atomic<size_t> count{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> generation{0};
+        std::string threadName{};
+        uint32_t threadId{0};
+        bool owned{false};           // Guarded by m_registryMutex
+    };
+
+    // Returns the thread's buffer to the registry when the thread exits
+    struct ThreadBufferHandle {
+        ThreadBuffer* buffer{nullptr};
+        ~ThreadBufferHandle() {
+            if (buffer) {
+                std::lock_guard<std::mutex> lock(Instance().m_registryMutex);
+                buffer->owned = false;
+            }
+        }
+    };
+
+    TraceRecorder() = default;
+
+    ThreadBuffer* acquire() {
+        const uint64_t generation = m_generation.load(std::memory_order_acquire);
+        ThreadBuffer* buffer = threadBuffer().buffer;
+        if (buffer && buffer->generation.load(std::memory_order_relaxed) == generation) {
+            return buffer;
+        }
+
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        const size_t capacity = m_eventsPerThread.load(std::memory_order_relaxed);
+        if (!buffer) {
+            // Reuse a buffer from an exited thread only if it holds no current events
+            for (auto& candidate : m_buffers) {
+                if (!candidate->owned && candidate->generation.load(std::memory_order_relaxed) != generation) {
+                    buffer = candidate.get();
+                    break;
+                }
+            }
+            if (!buffer) {
+                m_buffers.push_back(std::make_unique<ThreadBuffer>());
+                buffer = m_buffers.back().get();
+                buffer->threadId = static_cast<uint32_t>(m_buffers.size());
+            }
+            buffer->owned = true;
+            buffer->threadName = threadName();
+            threadBuffer().buffer = buffer;
+        }
+
+        // New session: only the owning thread resets its buffer
+        if (buffer->events.size() != capacity) {
+            buffer->events.assign(capacity, TraceEvent{});
+        }
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+        return buffer;
+    }
+
+    template<typename Visitor>
+    void forEachCurrentBuffer(Visitor&& visit) const {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        const uint64_t generation = m_generation.load(std::memory_order_acquire);
+        for (const auto& buffer : m_buffers) {
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+            visit(*buffer, buffer->count.load(std::memory_order_acquire));
+        }
+    }
+
+    static const char* priorityName(int32_t priority) {
+        switch (priority) {
+            case 0: return "Critical";
+            case 1: return "High";
+            case 2: return "Normal";
+            case 3: return "Low";
+            case 4: return "Idle";
+            default: return "Unknown";
+        }
+    }
+
+    static void appendEscaped(std::string& out, const std::string& text) {
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                        out += escaped;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+    }
+
+    static ThreadBufferHandle& threadBuffer() {
+        static thread_local ThreadBufferHandle handle;
+        return handle;
+    }
+
+    static std::string& threadName() {
+        static thread_local std::string name;
+        return name;
+    }
+
+    static inline std::atomic<bool> s_enabled{false};
+
+    mutable std::mutex m_registryMutex{};
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers{};
+    std::atomic<uint64_t> m_generation{0};
+    std::atomic<size_t> m_eventsPerThread{DEFAULT_EVENTS_PER_THREAD};
+    uint64_t m_startNs{0};
+};
+
+/**
+ * @brief RAII zone: records its lifetime as one span when tracing is on
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name, const char* category = "zone")
+        : m_name(name), m_category(category),
+          m_startNs(TraceRecorder::isEnabled() ? TraceRecorder::nowNs() : 0) {}
+
+    ~TraceZone() {
+        if (m_startNs != 0 && TraceRecorder::isEnabled()) {
+            TraceRecorder::Instance().record(m_name, m_category, m_startNs, TraceRecorder::nowNs());
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    uint64_t m_startNs;
+};
+
+} // namespace Hammer
+
+// Scoped trace zone; name must be a string literal or otherwise outlive the trace
+#ifndef HAMMER_DISABLE_TRACING
+#define HAMMER_TRACE_CONCAT_INNER(a, b) a##b
+#define HAMMER_TRACE_CONCAT(a, b) HAMMER_TRACE_CONCAT_INNER(a, b)
+#define HAMMER_TRACE_ZONE(name) Hammer::TraceZone HAMMER_TRACE_CONCAT(hammerTraceZone_, __LINE__)(name)
+#else
+#define HAMMER_TRACE_ZONE(name) ((void)0)
+#endif
+
+#endif // TRACE_RECORDER_HPP
@@ -0,0 +1,170 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Hammer {
+
+/**
+ * @brief Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli 2013)
+ *
+ * Single owner thread pushes and pops at the bottom (LIFO, cache-hot),
+ * any number of thief threads steal from the top (FIFO, oldest work first).
+ * The owner path is wait-free except when the buffer grows; thieves only
+ * contend with each other through a single CAS on the top index.
+ *
+ * Elements are copied racily by thieves before the CAS decides ownership,
+ * so T must be trivially copyable (in practice a pointer to a task node).
+ * Retired buffers are kept alive until the deque is destroyed because a
+ * thief may still be reading from one after the owner has grown it.
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WorkStealingDeque elements must be trivially copyable");
+
+public:
+    explicit WorkStealingDeque(size_t initialCapacity = 256) {
+        size_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        m_buffers.push_back(std::make_unique<Buffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Push an item at the bottom (owner thread only)
+     */
+    void push(T item) {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1) {
+            buffer = grow(buffer, bottom, top);
+        }
+
+        buffer->put(bottom, item);
+        // Release publishes the slot (and whatever it points to) to thieves
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pop the most recently pushed item (owner thread only)
+     * @return true if an item was taken
+     */
+    bool pop(T& out) {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        // seq_cst store/load pair orders the bottom reservation against
+        // concurrent thieves (equivalent to the paper's full fence)
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            // Deque was empty - restore bottom
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = buffer->get(bottom);
+        if (top == bottom) {
+            // Last element - race against thieves for it
+            bool won = m_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Steal the oldest item (any thread)
+     * @return true if an item was taken; false if empty or the race was lost
+     */
+    bool steal(T& out) {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T item = buffer->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued items (safe from any thread)
+     */
+    size_t size() const {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const {
+        return m_buffer.load(std::memory_order_relaxed)->capacity;
+    }
+
+private:
+    struct Buffer {
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Buffer(size_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+        void put(int64_t index, T item) {
+            slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        T get(int64_t index) const {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+    };
+
+    Buffer* grow(Buffer* old, int64_t bottom, int64_t top) {
+        auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Buffer* raw = bigger.get();
+        // Old buffer stays alive in m_buffers for in-flight thieves
+        m_buffers.push_back(std::move(bigger));
+        m_buffer.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+    alignas(64) std::atomic<Buffer*> m_buffer{nullptr};
+    std::vector<std::unique_ptr<Buffer>> m_buffers; // Owner-only, retired buffers
+};
+
+} // namespace Hammer
+
+#endif // WORK_STEALING_DEQUE_HPP
@@ -7,7 +7,13 @@
 #define WORKER_BUDGET_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace Hammer {
 
@@ -137,6 +143,247 @@ inline WorkerBudget calculateWorkerBudget(size_t availableWorkers) {
     return budget;
 }
 
-} // namespace Forge
+/**
+ * @brief Subsystems whose worker allocation the budget controller rebalances
+ */
+enum class BudgetSubsystem : size_t {
+    AI = 0,
+    Events = 1,
+    COUNT = 2
+};
+
+/**
+ * @brief One allocation change made by WorkerBudgetController
+ */
+struct WorkerBudgetDecision {
+    uint64_t frame{0};          // Controller frame the change was applied on
+    size_t aiAllocated{0};
+    size_t eventAllocated{0};
+    size_t remaining{0};
+    double aiLoadMs{0.0};       // Smoothed per-frame work that drove the change
+    double eventLoadMs{0.0};
+};
+
+/**
+ * @brief Snapshot of the controller state for graphs and debug overlays
+ */
+struct WorkerBudgetStats {
+    WorkerBudget budget{};      // Allocation currently handed out
+    WorkerBudget baseline{};    // Static calculateWorkerBudget() split
+    double aiLoadMs{0.0};       // Smoothed work per frame (summed over workers)
+    double eventLoadMs{0.0};
+    double aiShare{0.0};        // aiLoad / (aiLoad + eventLoad)
+    uint64_t frames{0};
+    uint64_t rebalances{0};
+    uint64_t lastRebalanceFrame{0};
+};
+
+/**
+ * @brief Runtime controller that rebalances AI/event workers from measured load
+ *
+ * Subsystems report the work time they spent each frame (summed over every
+ * thread that helped), and endFrame() folds the samples into an exponential
+ * moving average. The workers that calculateWorkerBudget() gives to AI and
+ * events are then split in proportion to their smoothed load. The buffer
+ * (remaining) and the engine reservation keep their baseline size.
+ *
+ * Hysteresis keeps the split from flapping between scenes:
+ * - shares within BUDGET_SHARE_DEADBAND of the current split are ignored
+ * - a new target must hold for BUDGET_HYSTERESIS_FRAMES consecutive frames
+ * - each rebalance moves a single worker
+ *
+ * getBudget() is lock-free (the allocation is published as one packed
+ * atomic), so managers may call it every frame from any thread. Systems
+ * with fewer than two allocatable workers keep the static budget.
+ */
+class WorkerBudgetController {
+public:
+    static constexpr double BUDGET_LOAD_SMOOTHING = 0.1;     // EMA weight of the newest frame
+    static constexpr double BUDGET_SHARE_DEADBAND = 0.1;     // Ignore share changes smaller than this
+    static constexpr double BUDGET_MIN_LOAD_MS = 0.05;       // Below this there is nothing to balance
+    static constexpr uint64_t BUDGET_HYSTERESIS_FRAMES = 30; // Frames a target must persist
+    static constexpr size_t BUDGET_HISTORY_SIZE = 64;        // Decisions kept for getRecentDecisions()
+
+    WorkerBudgetController() { reset(0); }
+
+    WorkerBudgetController(const WorkerBudgetController&) = delete;
+    WorkerBudgetController& operator=(const WorkerBudgetController&) = delete;
+
+    /**
+     * @brief Restart from the static budget for a new worker count
+     * @param availableWorkers Total workers available in ThreadSystem
+     */
+    void reset(size_t availableWorkers) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_baseline = calculateWorkerBudget(availableWorkers);
+        m_totalWorkers.store(availableWorkers, std::memory_order_relaxed);
+        publish(m_baseline);
+        for (auto& pending : m_pendingWorkNs) {
+            pending.store(0, std::memory_order_relaxed);
+        }
+        m_loadMs.fill(0.0);
+        m_pendingTarget = m_baseline.aiAllocated;
+        m_pendingFrames = 0;
+        m_frames = 0;
+        m_rebalances = 0;
+        m_lastRebalanceFrame = 0;
+        m_history.clear();
+        m_history.reserve(BUDGET_HISTORY_SIZE);
+        m_historyNext = 0;
+    }
+
+    /**
+     * @brief Add work time spent by a subsystem during the current frame
+     *
+     * Thread-safe; call it from every thread that did work for the
+     * subsystem (or once with the summed time).
+     */
+    void reportWorkTime(BudgetSubsystem subsystem, double workMs) {
+        if (workMs <= 0.0) {
+            return;
+        }
+        m_pendingWorkNs[static_cast<size_t>(subsystem)].fetch_add(
+            static_cast<uint64_t>(workMs * 1e6), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Fold this frame's reports into the averages and maybe rebalance
+     *
+     * Call once per frame from a single thread, after the subsystems ran.
+     * @return true if the allocation changed
+     */
+    bool endFrame() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frames++;
+
+        for (size_t i = 0; i < m_loadMs.size(); ++i) {
+            double sampleMs = static_cast<double>(m_pendingWorkNs[i].exchange(0, std::memory_order_relaxed)) / 1e6;
+            m_loadMs[i] += BUDGET_LOAD_SMOOTHING * (sampleMs - m_loadMs[i]);
+        }
+
+        const size_t allocatable = m_baseline.aiAllocated + m_baseline.eventAllocated;
+        const double aiLoad = m_loadMs[static_cast<size_t>(BudgetSubsystem::AI)];
+        const double eventLoad = m_loadMs[static_cast<size_t>(BudgetSubsystem::Events)];
+        const double totalLoad = aiLoad + eventLoad;
+        if (allocatable < 2 || totalLoad < BUDGET_MIN_LOAD_MS) {
+            m_pendingFrames = 0;
+            return false;
+        }
+
+        const WorkerBudget current = getBudget();
+        const double aiShare = aiLoad / totalLoad;
+        const double currentShare = static_cast<double>(current.aiAllocated) / static_cast<double>(allocatable);
+
+        // Each side keeps at least one worker so neither falls back to serial
+        size_t target = current.aiAllocated;
+        if (std::abs(aiShare - currentShare) > BUDGET_SHARE_DEADBAND) {
+            double ideal = aiShare * static_cast<double>(allocatable);
+            target = std::clamp(static_cast<size_t>(ideal + 0.5), size_t{1}, allocatable - 1);
+        }
+
+        if (target == current.aiAllocated) {
+            m_pendingFrames = 0;
+            return false;
+        }
+        if (target != m_pendingTarget) {
+            m_pendingTarget = target;
+            m_pendingFrames = 0;
+        }
+        if (++m_pendingFrames < BUDGET_HYSTERESIS_FRAMES) {
+            return false;
+        }
+
+        // Step one worker toward the target, then require the target to hold again
+        WorkerBudget next = current;
+        next.aiAllocated = target > current.aiAllocated ? current.aiAllocated + 1 : current.aiAllocated - 1;
+        next.eventAllocated = allocatable - next.aiAllocated;
+        publish(next);
+        m_pendingFrames = 0;
+        m_rebalances++;
+        m_lastRebalanceFrame = m_frames;
+        recordDecision(next, aiLoad, eventLoad);
+        return true;
+    }
+
+    /**
+     * @brief Current allocation (lock-free, callable from any thread)
+     */
+    WorkerBudget getBudget() const {
+        const uint64_t packed = m_packedBudget.load(std::memory_order_acquire);
+        WorkerBudget budget{};
+        budget.totalWorkers = m_totalWorkers.load(std::memory_order_relaxed);
+        budget.engineReserved = static_cast<size_t>(packed & FIELD_MASK);
+        budget.aiAllocated = static_cast<size_t>((packed >> 16) & FIELD_MASK);
+        budget.eventAllocated = static_cast<size_t>((packed >> 32) & FIELD_MASK);
+        budget.remaining = static_cast<size_t>((packed >> 48) & FIELD_MASK);
+        return budget;
+    }
+
+    WorkerBudgetStats getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        WorkerBudgetStats stats;
+        stats.budget = getBudget();
+        stats.baseline = m_baseline;
+        stats.aiLoadMs = m_loadMs[static_cast<size_t>(BudgetSubsystem::AI)];
+        stats.eventLoadMs = m_loadMs[static_cast<size_t>(BudgetSubsystem::Events)];
+        const double totalLoad = stats.aiLoadMs + stats.eventLoadMs;
+        stats.aiShare = totalLoad > 0.0 ? stats.aiLoadMs / totalLoad : 0.0;
+        stats.frames = m_frames;
+        stats.rebalances = m_rebalances;
+        stats.lastRebalanceFrame = m_lastRebalanceFrame;
+        return stats;
+    }
+
+    // Most recent allocation changes, oldest first
+    std::vector<WorkerBudgetDecision> getRecentDecisions() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<WorkerBudgetDecision> decisions;
+        decisions.reserve(m_history.size());
+        for (size_t i = 0; i < m_history.size(); ++i) {
+            decisions.push_back(m_history[(m_historyNext + i) % m_history.size()]);
+        }
+        return decisions;
+    }
+
+private:
+    static constexpr uint64_t FIELD_MASK = 0xFFFF;
+
+    void publish(const WorkerBudget& budget) {
+        const uint64_t packed =
+            (static_cast<uint64_t>(budget.engineReserved) & FIELD_MASK) |
+            ((static_cast<uint64_t>(budget.aiAllocated) & FIELD_MASK) << 16) |
+            ((static_cast<uint64_t>(budget.eventAllocated) & FIELD_MASK) << 32) |
+            ((static_cast<uint64_t>(budget.remaining) & FIELD_MASK) << 48);
+        m_packedBudget.store(packed, std::memory_order_release);
+    }
+
+    void recordDecision(const WorkerBudget& budget, double aiLoad, double eventLoad) {
+        WorkerBudgetDecision decision{m_frames, budget.aiAllocated, budget.eventAllocated,
+                                      budget.remaining, aiLoad, eventLoad};
+        if (m_history.size() < BUDGET_HISTORY_SIZE) {
+            m_history.push_back(decision);
+        } else {
+            m_history[m_historyNext] = decision;
+            m_historyNext = (m_historyNext + 1) % BUDGET_HISTORY_SIZE;
+        }
+    }
+
+    mutable std::mutex m_mutex{}; // Guards everything below except the atomics
+    std::atomic<uint64_t> m_packedBudget{0};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(BudgetSubsystem::COUNT)> m_pendingWorkNs{};
+    std::atomic<size_t> m_totalWorkers{0};
+
+    WorkerBudget m_baseline{};
+    std::array<double, static_cast<size_t>(BudgetSubsystem::COUNT)> m_loadMs{};
+    size_t m_pendingTarget{0};
+    uint64_t m_pendingFrames{0};
+    uint64_t m_frames{0};
+    uint64_t m_rebalances{0};
+    uint64_t m_lastRebalanceFrame{0};
+    std::vector<WorkerBudgetDecision> m_history{};
+    size_t m_historyNext{0};
+};
+
+} // namespace Hammer
 
 #endif // WORKER_BUDGET_HPP
\ No newline at end of file
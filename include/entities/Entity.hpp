@@ -6,6 +6,8 @@
 #ifndef ENTITY_HPP
 #define ENTITY_HPP
 
+#include "core/FrameContext.hpp"
+#include "entities/EntityRegistry.hpp"
 #include "utils/Vector2D.hpp"
 #include <string>
 #include <memory>
@@ -20,7 +22,23 @@ using EntityWeakPtr = std::weak_ptr<Entity>;
 
 class Entity : public std::enable_shared_from_this<Entity> {
  public:
+   Entity() : m_handle(EntityRegistry::Instance().create(this)) {}
+
+   // The handle identifies this object; copies would share it
+   Entity(const Entity&) = delete;
+   Entity& operator=(const Entity&) = delete;
+
    virtual void update(float deltaTime) = 0;
+
+   /**
+    * @brief Update with the frame's shared values
+    *
+    * AIManager updates the entities it manages through this overload, with
+    * the context narrowed to the entity, so deltaTime already covers any
+    * frames its update tier skipped. Entities that read the clock override
+    * it and use context.timeMs; the default calls update(context.deltaTime).
+    */
+   virtual void update(const FrameContext& context) { update(context.deltaTime); }
    virtual void render() = 0;
    
    /**
@@ -41,8 +59,9 @@ class Entity : public std::enable_shared_from_this<Entity> {
     * (like shared_this()) in the destructor. By the time the destructor runs,
     * all shared_ptrs to this object have been destroyed, and calling
     * shared_from_this() will throw std::bad_weak_ptr.
+    * Releases the entity's handle, so it stops resolving from here on.
     */
-   virtual ~Entity() = default;
+   virtual ~Entity() { EntityRegistry::Instance().release(m_handle); }
    
    /**
     * @brief Helper to get a shared_ptr to this object
@@ -72,6 +91,14 @@ class Entity : public std::enable_shared_from_this<Entity> {
      return shared_from_this();
    }
 
+   /**
+    * @brief Generational handle issued by EntityRegistry
+    *
+    * Stable for the entity's lifetime and cheap to copy, hash and compare.
+    * Managers key their per-entity bookkeeping on it instead of EntityPtr.
+    */
+   EntityHandle getHandle() const { return m_handle; }
+
    // Accessor methods
    Vector2D getPosition() const { return m_position; }
    Vector2D getVelocity() const { return m_velocity; }
@@ -111,5 +138,17 @@ class Entity : public std::enable_shared_from_this<Entity> {
     int m_currentRow{0};
     int m_numFrames{0};
     int m_animSpeed{0};
+
+   private:
+    const EntityHandle m_handle;
 };
+
+inline EntityPtr EntityRegistry::resolve(EntityHandle handle) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Holding the lock keeps the destructor from releasing the slot meanwhile
+  if (!isAliveLocked(handle)) {
+    return nullptr;
+  }
+  return m_slots[handle.index].entity->weak_from_this().lock();
+}
 #endif  // ENTITY_HPP
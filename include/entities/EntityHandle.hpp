@@ -0,0 +1,115 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef ENTITY_HANDLE_HPP
+#define ENTITY_HANDLE_HPP
+
+/**
+ * @file EntityHandle.hpp
+ * @brief Generational entity handles and a handle-indexed map
+ *
+ * An EntityHandle is a slot index plus the generation the slot had when the
+ * handle was issued by EntityRegistry. Releasing an entity bumps its slot's
+ * generation, so handles to destroyed entities stop matching even after the
+ * slot is reused. Handles are plain values: copying or comparing one never
+ * touches a reference count.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index{INVALID_INDEX};
+    uint32_t generation{0};   // Live handles never use generation 0
+
+    bool isValid() const { return index != INVALID_INDEX && generation != 0; }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+template<>
+struct std::hash<EntityHandle> {
+    size_t operator()(const EntityHandle& handle) const noexcept {
+        return std::hash<uint64_t>{}((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+    }
+};
+
+/**
+ * @brief Map from EntityHandle to T stored in a vector indexed by handle.index
+ *
+ * Lookups are an index and a generation compare. Registry slots are reused
+ * from a free list, so the table stays about as large as the peak number of
+ * live entities. Not internally synchronized.
+ */
+template<typename T>
+class EntityHandleMap {
+public:
+    T* find(EntityHandle handle) {
+        if (handle.index >= m_entries.size() || m_entries[handle.index].generation != handle.generation ||
+            handle.generation == 0) {
+            return nullptr;
+        }
+        return &m_entries[handle.index].value;
+    }
+
+    const T* find(EntityHandle handle) const {
+        return const_cast<EntityHandleMap*>(this)->find(handle);
+    }
+
+    bool contains(EntityHandle handle) const { return find(handle) != nullptr; }
+
+    // Inserts or overwrites; an entry left by an older generation is replaced
+    T& insert(EntityHandle handle, T value) {
+        if (handle.index >= m_entries.size()) {
+            m_entries.resize(static_cast<size_t>(handle.index) + 1);
+        }
+        Entry& entry = m_entries[handle.index];
+        if (entry.generation == 0) {
+            ++m_size;
+        }
+        entry.generation = handle.generation;
+        entry.value = std::move(value);
+        return entry.value;
+    }
+
+    bool erase(EntityHandle handle) {
+        if (!find(handle)) {
+            return false;
+        }
+        Entry& entry = m_entries[handle.index];
+        entry.generation = 0;
+        entry.value = T{};
+        --m_size;
+        return true;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_size = 0;
+    }
+
+    void reserve(size_t capacity) { m_entries.reserve(capacity); }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    struct Entry {
+        uint32_t generation{0};   // 0 = empty
+        T value{};
+    };
+
+    std::vector<Entry> m_entries;
+    size_t m_size{0};
+};
+
+#endif // ENTITY_HANDLE_HPP
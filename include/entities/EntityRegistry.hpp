@@ -0,0 +1,109 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef ENTITY_REGISTRY_HPP
+#define ENTITY_REGISTRY_HPP
+
+/**
+ * @file EntityRegistry.hpp
+ * @brief Central issuer of generational entity handles
+ *
+ * Every Entity takes a handle in its constructor and releases it in its
+ * destructor. Released slots go on a free list and their generation is
+ * bumped, so stale handles are detected instead of aliasing a new entity.
+ * resolve() is defined in Entity.hpp, where Entity is complete.
+ */
+
+#include "entities/EntityHandle.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Entity;
+
+class EntityRegistry {
+public:
+    // Intentionally never destroyed: entities owned by other singletons may be
+    // released during static destruction
+    static EntityRegistry& Instance() {
+        static EntityRegistry* instance = new EntityRegistry();
+        return *instance;
+    }
+
+    EntityHandle create(Entity* entity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t index;
+        if (m_freeHead != EntityHandle::INVALID_INDEX) {
+            index = m_freeHead;
+            m_freeHead = m_slots[index].nextFree;
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        Slot& slot = m_slots[index];
+        slot.entity = entity;
+        slot.nextFree = EntityHandle::INVALID_INDEX;
+        ++m_liveCount;
+        return EntityHandle{index, slot.generation};
+    }
+
+    void release(EntityHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!isAliveLocked(handle)) {
+            return;
+        }
+        Slot& slot = m_slots[handle.index];
+        slot.entity = nullptr;
+        // Skip 0 on wrap-around; it marks empty entries in EntityHandleMap
+        slot.generation = (slot.generation == 0xFFFFFFFFu) ? 1 : slot.generation + 1;
+        slot.nextFree = m_freeHead;
+        m_freeHead = handle.index;
+        --m_liveCount;
+    }
+
+    bool isAlive(EntityHandle handle) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return isAliveLocked(handle);
+    }
+
+    /**
+     * @brief Strong reference to a live entity
+     * @return nullptr for stale handles and for entities not owned by a shared_ptr
+     */
+    std::shared_ptr<Entity> resolve(EntityHandle handle) const;
+
+    size_t getLiveCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_liveCount;
+    }
+
+    size_t getSlotCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_slots.size();
+    }
+
+private:
+    EntityRegistry() = default;
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    struct Slot {
+        Entity* entity{nullptr};
+        uint32_t generation{1};
+        uint32_t nextFree{EntityHandle::INVALID_INDEX};
+    };
+
+    bool isAliveLocked(EntityHandle handle) const {
+        return handle.index < m_slots.size() && m_slots[handle.index].entity != nullptr &&
+               m_slots[handle.index].generation == handle.generation;
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+    uint32_t m_freeHead{EntityHandle::INVALID_INDEX};
+    size_t m_liveCount{0};
+};
+
+#endif // ENTITY_REGISTRY_HPP
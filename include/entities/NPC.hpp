@@ -49,7 +49,7 @@ private:
     int m_frameWidth{0};      // Width of a single animation frame
     int m_frameHeight{0};     // Height of a single animation frame
     int m_spriteSheetRows{0}; // Number of rows in the sprite sheet
-    Uint64 m_lastFrameTime{0}; // Time of last animation frame change
+    float m_animElapsedMs{0.0f}; // Time since the last animation frame change
     SDL_FlipMode m_flip{SDL_FLIP_NONE}; // Default flip direction
     
     // Wander area bounds
@@ -29,7 +29,15 @@
 #include <shared_mutex>
 #include <atomic>
 #include "entities/Entity.hpp"
+#include "entities/EntityHandle.hpp"
 #include "ai/AIBehavior.hpp"
+#include "ai/AIMessage.hpp"
+#include "ai/AISpatialGrid.hpp"
+#include "ai/CrowdSteering.hpp"
+#include "ai/NavigationGrid.hpp"
+#include "ai/Perception.hpp"
+#include "core/BoundedMPSCQueue.hpp"
+#include "core/SnapshotRing.hpp"
 
 // Conditional debug logging
 #ifdef AI_DEBUG_LOGGING
@@ -55,24 +63,10 @@ enum class BehaviorType : uint8_t {
 };
 
 /**
- * @brief Cache-efficient AI entity data using Structure of Arrays (SoA)
- * Hot data (frequently accessed) is separated from cold data for better cache performance
+ * @brief Cold per-entity AI data
+ * Hot per-frame data lives in AIManager's structure-of-arrays storage
  */
 struct AIEntityData {
-    // Hot data - accessed every frame
-    struct HotData {
-        Vector2D position;           // Current position (8 bytes)
-        Vector2D lastPosition;       // Last position (8 bytes)
-        float distanceSquared;       // Cached distance to player (4 bytes)
-        uint16_t frameCounter;       // Frame counter (2 bytes)
-        uint8_t priority;            // Priority level (1 byte)
-        uint8_t behaviorType;        // Behavior type enum (1 byte)
-        bool active;                 // Active flag (1 byte)
-        bool shouldUpdate;           // Update flag (1 byte)
-        // Total: 26 bytes, padding to 32 for cache alignment
-        uint8_t padding[6];
-    };
-    
     // Cold data - accessed occasionally
     EntityPtr entity;
     std::shared_ptr<AIBehavior> behavior;
@@ -90,6 +84,13 @@ struct AIPerformanceStats {
     uint64_t entitiesProcessed{0};
     double entitiesPerSecond{0.0};
 
+    // Update-rate LOD: entity updates actually dispatched per frame
+    uint64_t frameCount{0};
+    uint64_t scheduledUpdates{0};     // Summed over frameCount frames
+    uint64_t lastFrameUpdates{0};
+    uint64_t lastFrameEntities{0};    // Managed entities in the last frame
+    double updatesPerFrame{0.0};
+
     void addSample(double timeMs, uint64_t entities) {
         totalUpdateTime += timeMs;
         updateCount++;
@@ -99,14 +100,59 @@ struct AIPerformanceStats {
         }
     }
 
+    void addFrame(uint64_t updates, uint64_t entities) {
+        frameCount++;
+        scheduledUpdates += updates;
+        lastFrameUpdates = updates;
+        lastFrameEntities = entities;
+        updatesPerFrame = static_cast<double>(scheduledUpdates) / static_cast<double>(frameCount);
+    }
+
     void reset() {
         totalUpdateTime = 0.0;
         updateCount = 0;
         entitiesProcessed = 0;
         entitiesPerSecond = 0.0;
+        frameCount = 0;
+        scheduledUpdates = 0;
+        lastFrameUpdates = 0;
+        lastFrameEntities = 0;
+        updatesPerFrame = 0.0;
     }
 };
 
+/**
+ * @brief Update intervals, in frames, for each distance tier of one priority
+ *
+ * Tiers are bounded by the update distances scaled by the priority's range
+ * multiplier. Intervals are rounded up to a power of two (at most 256) so
+ * entities can be staggered evenly across the frames of their interval.
+ */
+struct AIUpdateSchedule {
+    uint32_t nearInterval{1};       // Within the near distance
+    uint32_t midInterval{2};        // Within the mid distance
+    uint32_t farInterval{4};        // Within the far distance
+    uint32_t distantInterval{16};   // Beyond the far distance
+};
+
+/**
+ * @brief AI positions as of the end of one update, with the spatial grid over them
+ *
+ * Published through a lock-free snapshot ring, so any thread (the render
+ * thread included) can read it without locking or copying. Hold the view
+ * from AIManager::getPositionSnapshot() only while reading: three snapshots
+ * rotate, and a view held across several updates pins its slot.
+ * Slot indices match the ones the spatial queries return.
+ */
+struct AIPositionSnapshot {
+    AISpatialGrid grid{AISpatialGrid::DEFAULT_CELL_SIZE}; // Per-slot positions and the hash over them
+    std::vector<float> velocityX;        // Per-slot velocities, for crowd alignment
+    std::vector<float> velocityY;
+    std::vector<EntityHandle> handles;   // Entity in each slot
+    uint64_t frameNumber{0};             // Update that produced the snapshot
+    uint64_t layoutVersion{0};           // Storage layout the handles were copied from
+};
+
 /**
  * @brief High-performance AI Manager
  */
@@ -144,9 +190,11 @@ public:
      * @brief Updates all active AI entities using lock-free asynchronous processing
      * 
      * PERFORMANCE IMPROVEMENTS:
-     * - Lock-free double buffering eliminates contention
-     * - Cache-efficient SoA layout for 3-4x better performance
-     * - Optimized scalar distance calculations for scattered memory access
+     * - Structure-of-arrays hot data (x/y, distance, active, priority)
+     * - SIMD distance and scheduling kernels build a compact update list
+     * - Distance tiers update at per-priority intervals, staggered so the
+     *   per-frame load stays flat; skipped time is handed to the next update
+     * - Only entities on the update list are dispatched to workers
      * - Simplified batch processing with WorkerBudget integration
      * 
      * Key Features:
@@ -225,6 +273,92 @@ public:
     Vector2D getPlayerPosition() const;
     bool isPlayerValid() const;
 
+    /**
+     * @brief AI clock in milliseconds as of the latest update
+     *
+     * The sum of the deltaTimes passed to update(), the same value every
+     * behavior sees as FrameContext::timeMs during that frame. Behaviors use
+     * it for timestamps they take outside a frame, such as in init() or
+     * onMessage(), so those compare directly with frame times.
+     */
+    uint64_t getFrameTimeMs() const;
+
+    // Frame number of the latest update, as in FrameContext::frameNumber.
+    // Lock-free, like getFrameTimeMs() and getRandomSeed(), so onMessage()
+    // can key AIRandom draws with it.
+    uint64_t getFrameNumber() const;
+
+    /**
+     * @brief A context for running behaviors outside update()
+     *
+     * Latest frame number, deltaTime and clock plus the player as it is now. Lets the
+     * single-entity executeLogic(entity) entry point share the per-frame path.
+     * Reads the player under m_entitiesMutex, so it must not be called from
+     * onMessage(): messages are delivered with that mutex already held.
+     */
+    FrameContext getFrameContext() const;
+
+    /**
+     * @brief Seed for the AI's random decisions
+     *
+     * Behaviors draw random numbers with AIRandom, keyed by this seed, the
+     * frame number and the entity's handle. Runs with the same seed and
+     * the same inputs make the same decisions on any number of threads.
+     * init() picks a seed from std::random_device unless one was set.
+     */
+    void setRandomSeed(uint64_t seed);
+    uint64_t getRandomSeed() const;
+
+    /**
+     * @brief Flow field toward the player for the coming frames
+     *
+     * Handed to behaviors as FrameContext::playerField, so chasers and
+     * fleers steer around obstacles without searching per entity. The
+     * caller keeps the field alive and unchanged until it sets another one;
+     * GameEngine passes PathfindingManager::getFlowField() each frame. Null
+     * turns it off.
+     */
+    void setPlayerFlowField(const FlowField* field);
+    const FlowField* getPlayerFlowField() const;
+
+    /**
+     * @brief Formation slot positions for the coming frames
+     *
+     * Handed to behaviors as FrameContext::formations, so escorts read their
+     * slot instead of working out an offset each. The caller keeps the
+     * snapshot alive and unchanged until it sets another one; GameEngine
+     * passes FormationManager::getSnapshot() each frame. Null turns it off.
+     */
+    void setFormations(const FormationSnapshot* formations);
+    const FormationSnapshot* getFormations() const;
+
+    /**
+     * @brief Crowd steering between AI entities
+     *
+     * When enabled, each entity's velocity after its behavior runs is taken
+     * as the one it wants, and CrowdSteering::resolve() adjusts it for the
+     * neighbors in the latest position snapshot before the entity moves.
+     * Runs inside the update batches, so it scales with them. Takes effect
+     * from the next update(). Off by default.
+     */
+    void setCrowdSettings(const CrowdSettings& settings);
+    CrowdSettings getCrowdSettings() const;
+
+    /**
+     * @brief Occupancy grid that blocks sight lines in the perception pass
+     *
+     * Entities whose behavior perceives (AIBehavior::getPerceptionSettings())
+     * cannot see the player through blocked cells of this grid. GameEngine
+     * passes PathfindingManager::getGrid() each frame. Takes effect from the
+     * next update(); null lets every entity see whatever is in its view cone.
+     */
+    void setPerceptionGrid(std::shared_ptr<const NavigationGrid> grid);
+    std::shared_ptr<const NavigationGrid> getPerceptionGrid() const;
+
+    // What the entity sensed of the player at its last update; default
+    // (senses nothing) when it is not managed or its behavior does not perceive
+    Awareness getAwareness(EntityPtr entity) const;
+
     // Entity management (now unified with spatial system)
     /**
      * @brief Register entity for AI updates with priority-based distance optimization
@@ -234,7 +368,8 @@ public:
      *   - 3-5: Standard entities (1.3x-1.5x update range)
      *   - 6-8: Important entities (1.6x-1.8x update range)
      *   - 9: Critical entities (1.9x update range)
-     * Higher priority = larger update distances = more responsive AI
+     * Higher priority = larger update distances = more responsive AI.
+     * How often each distance tier updates is set per priority with setUpdateSchedule().
      */
     void registerEntityForUpdates(EntityPtr entity, int priority = 5);
 
@@ -263,6 +398,22 @@ public:
     void configureThreading(bool useThreading, unsigned int maxThreads = 0);
     void configurePriorityMultiplier(float multiplier = 1.0f);
 
+    // Update-rate LOD
+    /**
+     * @brief Set the tier intervals for one priority level (0-9)
+     * @details Intervals are clamped to 1-256 frames and rounded up to a power of two
+     */
+    void setUpdateSchedule(int priority, const AIUpdateSchedule& schedule);
+    AIUpdateSchedule getUpdateSchedule(int priority) const;
+
+    /**
+     * @brief Set the base near/mid/far tier distances from the player, in pixels
+     * @details Each is scaled by getUpdateRangeMultiplier() for the entity's
+     * priority. Later tiers are raised to at least the previous one.
+     */
+    void setUpdateDistances(float nearDistance, float midDistance, float farDistance);
+    static constexpr uint32_t MAX_UPDATE_INTERVAL = 256;
+
     // Performance monitoring
     AIPerformanceStats getPerformanceStats() const;
     size_t getBehaviorCount() const;
@@ -272,11 +423,102 @@ public:
     // Thread-safe assignment tracking (atomic counter only)
     size_t getTotalAssignmentCount() const;
     
-    // Message system
+    // Spatial queries
+    /**
+     * @brief Find AI entities within a radius using the spatial hash grid
+     *
+     * Queries read the latest position snapshot, published at the end of every
+     * update() (and at the start of one after entities were added), so
+     * behaviors see where entities were at the end of the previous frame.
+     * Indices identify entity slots and stay valid until the next update().
+     * @param outIndices Caller-provided buffer for entity indices
+     * @param capacity Size of outIndices; the query stops when it is full
+     * @return Number of indices written
+     */
+    size_t queryEntitiesInRadius(const Vector2D& center, float radius,
+                                 uint32_t* outIndices, size_t capacity) const;
+
+    /**
+     * @brief Find AI entities inside an axis-aligned rectangle (inclusive)
+     * @return Number of indices written, see queryEntitiesInRadius()
+     */
+    size_t queryEntitiesInRect(const Vector2D& minCorner, const Vector2D& maxCorner,
+                               uint32_t* outIndices, size_t capacity) const;
+
+    // Resolve indices returned by the spatial queries
+    Vector2D getSpatialEntityPosition(uint32_t index) const;
+    EntityPtr getSpatialEntity(uint32_t index) const;
+
+    // Grid cell size in pixels; queries are fastest with radii near the cell size
+    void setSpatialCellSize(float cellSize);
+    float getSpatialCellSize() const;
+
+    /**
+     * @brief Lock-free view of the latest published AI positions
+     *
+     * Positions, slot handles and the spatial grid as of the end of the last
+     * update(). The view keeps its snapshot alive and unchanged until it is
+     * destroyed; update() never waits for it.
+     */
+    using PositionSnapshotView = Hammer::SnapshotRing<AIPositionSnapshot>::ReadGuard;
+    PositionSnapshotView getPositionSnapshot() const;
+
+    /**
+     * @brief Message system
+     *
+     * Queued messages go into a bounded lock-free inbox that any thread,
+     * including behaviors running on workers, can post to. The next update()
+     * drains it into per-entity inboxes and delivers each entity's messages
+     * from the batch that updates it, just before its executeLogic().
+     * Entities not due that frame get theirs on the update thread once the
+     * batches finish. Broadcasts skip runs of entities whose behavior does
+     * not accept the id. When the inbox is full a message is dropped and
+     * counted. Immediate messages are delivered on the calling thread once
+     * running batches finish. Sent from a behavior's executeLogic(),
+     * executeBatch() or onMessage(), an immediate message is queued instead:
+     * that thread already holds the lock immediate delivery needs.
+     *
+     * The string overloads intern the name and forward.
+     */
+    void sendMessageToEntity(EntityPtr entity, const AIMessage& message, bool immediate = false);
     void sendMessageToEntity(EntityPtr entity, const std::string& message, bool immediate = false);
+    void broadcastMessage(const AIMessage& message, bool immediate = false);
     void broadcastMessage(const std::string& message, bool immediate = false);
+
+    /**
+     * @brief Broadcasts scoped to an area or a group
+     *
+     * broadcastInRadius() reaches entities whose position in the latest
+     * snapshot lies within radius of center. broadcastToGroup() reaches the
+     * members of a group (see setEntityGroup()). Both are queued. The next
+     * update() expands them into per-entity inboxes, with a spatial query or
+     * the group index, so they are delivered in the parallel batches like
+     * direct messages. The message's sender, if set, does not get its own
+     * broadcast.
+     */
+    void broadcastInRadius(const Vector2D& center, float radius, const AIMessage& message);
+    void broadcastInRadius(const Vector2D& center, float radius, const std::string& message);
+    void broadcastToGroup(uint32_t groupId, const AIMessage& message);
+    void broadcastToGroup(uint32_t groupId, const std::string& message);
+
+    /**
+     * @brief Group membership for broadcastToGroup()
+     *
+     * An entity is in at most one group; group 0 means none. Membership is
+     * kept by handle. unregisterEntityFromUpdates() ends it, and so does
+     * destroying the entity.
+     */
+    void setEntityGroup(EntityPtr entity, uint32_t groupId);
+    uint32_t getEntityGroup(EntityPtr entity) const;
+    size_t getGroupSize(uint32_t groupId) const;
+
+    // Deliver everything queued now, on this thread
     void processMessageQueue();
 
+    // Messages dropped because the inbox was full, and messages delivered, since init()
+    uint64_t getDroppedMessageCount() const;
+    uint64_t getDeliveredMessageCount() const;
+
 private:
     AIManager() = default;
     ~AIManager() {
@@ -288,32 +530,153 @@ private:
     AIManager& operator=(const AIManager&) = delete;
 
     // Cache-efficient storage using Structure of Arrays (SoA)
+    // Every array is indexed by the same entity slot. Hot fields are split
+    // into contiguous arrays so the kernels in AIDistanceKernels.hpp stream
+    // them with full-width SIMD loads.
     struct EntityStorage {
-        // Hot data arrays - tightly packed for cache efficiency
-        std::vector<AIEntityData::HotData> hotData;
-        
+        // Hot data arrays - read by the distance/culling kernels every frame
+        std::vector<float> positionX;        // Position after the entity's last AI update
+        std::vector<float> positionY;
+        std::vector<float> velocityX;        // Velocity after the entity's last AI update
+        std::vector<float> velocityY;
+        std::vector<float> distanceSquared;  // To the player, refreshed every 4th frame
+        std::vector<uint8_t> active;         // 1 = active, 0 = awaiting release or free
+        std::vector<uint8_t> priorities;     // 0-9, scales the update range
+        std::vector<uint8_t> behaviorTypes;  // BehaviorType of the assigned behavior
+        std::vector<uint32_t> updatePhases;  // Schedule stagger key: the entity's handle index
+
         // Cold data arrays - accessed less frequently
+        std::vector<EntityHandle> handles;   // Key of the slot in m_entityToIndex
         std::vector<EntityPtr> entities;
         std::vector<std::shared_ptr<AIBehavior>> behaviors;
-        std::vector<float> lastUpdateTimes;
-        
-        // Double buffering for lock-free updates
-        std::atomic<int> currentBuffer{0};
-        std::array<std::vector<AIEntityData::HotData>, 2> doubleBuffer;
-        
+        std::vector<double> lastUpdateTimes; // m_aiTime at the slot's last update, < 0 before the first
+        std::vector<Awareness> awareness;    // Of the player, kept for behaviors that perceive
+
+        // Released slots, reused before the arrays grow. Slots never move, so
+        // a slot index held by a batch, an inbox or a snapshot names the same
+        // slot until it is released; its handle then no longer matches.
+        std::vector<uint32_t> freeSlots;
+
+        // Bumped whenever slots are added, reused or released, so position
+        // snapshots know when their copy of the handles is stale
+        uint64_t layoutVersion{0};
+
         size_t size() const { return entities.size(); }
         void reserve(size_t capacity) {
-            hotData.reserve(capacity);
+            positionX.reserve(capacity);
+            positionY.reserve(capacity);
+            velocityX.reserve(capacity);
+            velocityY.reserve(capacity);
+            distanceSquared.reserve(capacity);
+            active.reserve(capacity);
+            priorities.reserve(capacity);
+            behaviorTypes.reserve(capacity);
+            updatePhases.reserve(capacity);
+            handles.reserve(capacity);
             entities.reserve(capacity);
             behaviors.reserve(capacity);
             lastUpdateTimes.reserve(capacity);
-            doubleBuffer[0].reserve(capacity);
-            doubleBuffer[1].reserve(capacity);
+            awareness.reserve(capacity);
+        }
+        void pushBack(EntityPtr entity, std::shared_ptr<AIBehavior> behavior, const Vector2D& position,
+                      uint8_t priority, uint8_t behaviorType) {
+            ++layoutVersion;
+            positionX.push_back(position.getX());
+            positionY.push_back(position.getY());
+            velocityX.push_back(0.0f);
+            velocityY.push_back(0.0f);
+            distanceSquared.push_back(0.0f);
+            active.push_back(1);
+            priorities.push_back(priority);
+            behaviorTypes.push_back(behaviorType);
+            updatePhases.push_back(entity->getHandle().index);
+            handles.push_back(entity->getHandle());
+            entities.push_back(std::move(entity));
+            behaviors.push_back(std::move(behavior));
+            lastUpdateTimes.push_back(-1.0);
+            awareness.emplace_back();
+        }
+        // Fill a free slot, or append one if none is free; returns the slot
+        size_t emplace(EntityPtr entity, std::shared_ptr<AIBehavior> behavior, const Vector2D& position,
+                       uint8_t priority, uint8_t behaviorType) {
+            if (freeSlots.empty()) {
+                pushBack(std::move(entity), std::move(behavior), position, priority, behaviorType);
+                return size() - 1;
+            }
+            const size_t index = freeSlots.back();
+            freeSlots.pop_back();
+            ++layoutVersion;
+            positionX[index] = position.getX();
+            positionY[index] = position.getY();
+            velocityX[index] = 0.0f;
+            velocityY[index] = 0.0f;
+            distanceSquared[index] = 0.0f;
+            active[index] = 1;
+            priorities[index] = priority;
+            behaviorTypes[index] = behaviorType;
+            updatePhases[index] = entity->getHandle().index;
+            handles[index] = entity->getHandle();
+            entities[index] = std::move(entity);
+            behaviors[index] = std::move(behavior);
+            lastUpdateTimes[index] = -1.0;
+            awareness[index] = Awareness{};
+            return index;
+        }
+        // Drop the slot's entity and behavior and put it on the free list
+        void release(size_t index) {
+            ++layoutVersion;
+            active[index] = 0;
+            handles[index] = EntityHandle{};
+            entities[index].reset();
+            behaviors[index].reset();
+            freeSlots.push_back(static_cast<uint32_t>(index));
+        }
+        bool isFree(size_t index) const { return !entities[index]; }
+        void clear() {
+            ++layoutVersion;
+            positionX.clear();
+            positionY.clear();
+            velocityX.clear();
+            velocityY.clear();
+            distanceSquared.clear();
+            active.clear();
+            priorities.clear();
+            behaviorTypes.clear();
+            updatePhases.clear();
+            handles.clear();
+            entities.clear();
+            behaviors.clear();
+            lastUpdateTimes.clear();
+            awareness.clear();
+            freeSlots.clear();
         }
     };
     
     EntityStorage m_storage;
-    std::unordered_map<EntityPtr, size_t> m_entityToIndex;
+
+    // Slots to update this frame, built by the culling kernel and grouped by
+    // BehaviorType. Each batch range covers slots of a single type, so a worker
+    // runs one behavior's code back to back. Owned by the thread running
+    // update(); m_updateInProgress keeps updates from overlapping.
+    struct BatchRange {
+        uint32_t start;
+        uint32_t end;
+    };
+    std::vector<uint32_t> m_updateList;
+    std::vector<uint32_t> m_groupedUpdateList;
+    std::vector<BatchRange> m_batchRanges;
+    std::atomic<bool> m_updateInProgress{false};
+
+    // Position snapshots and their spatial grids. update() builds each one
+    // straight from the hot arrays into a slot no reader holds, then publishes
+    // it; readers never lock. Writes are serialized by m_entitiesMutex: the
+    // thread running update() commits under a shared lock, anything else
+    // under an exclusive one.
+    Hammer::SnapshotRing<AIPositionSnapshot> m_positionSnapshots;
+    std::atomic<float> m_spatialCellSize{AISpatialGrid::DEFAULT_CELL_SIZE};
+
+    // Entity handle -> storage slot; a lookup is an index and a generation check
+    EntityHandleMap<size_t> m_entityToIndex;
     std::unordered_map<std::string, std::shared_ptr<AIBehavior>> m_behaviorTemplates;
     std::unordered_map<std::string, BehaviorType> m_behaviorTypeMap;
 
@@ -326,6 +689,7 @@ private:
 
     // Entity management for distance optimization
     struct EntityUpdateInfo {
+        EntityHandle handle;
         EntityWeakPtr entityWeak;
         int priority;
         int frameCounter;
@@ -334,6 +698,7 @@ private:
         EntityUpdateInfo() : priority(0), frameCounter(0), lastUpdateTime(0) {}
     };
     std::vector<EntityUpdateInfo> m_managedEntities;
+    EntityHandleMap<uint8_t> m_entityPriorities; // Registered priority, applied when a behavior is assigned
 
     // Batch assignment queue with deduplication
     struct PendingAssignment {
@@ -343,24 +708,49 @@ private:
         PendingAssignment(EntityPtr e, const std::string& b) : entity(e), behaviorName(b) {}
     };
     std::vector<PendingAssignment> m_pendingAssignments;
-    std::unordered_map<EntityPtr, std::string> m_pendingAssignmentIndex; // For deduplication
+    EntityHandleMap<size_t> m_pendingAssignmentIndex; // Position in m_pendingAssignments, for deduplication
 
-    // Message queue
+    // Message inbox. Producers push lock-free; draining it is serialized by
+    // m_messagesMutex.
+    enum class MessageScope : uint8_t { Entity, All, Radius, Group };
     struct QueuedMessage {
-        EntityWeakPtr targetEntity;  // empty for broadcast
-        std::string message;
-        uint64_t timestamp;
-
-        QueuedMessage(EntityPtr target, const std::string& msg)
-            : targetEntity(target), message(msg), timestamp(getCurrentTimeNanos()) {}
+        AIMessage message;
+        EntityHandle target;                 // Entity scope
+        Vector2D center{0.0f, 0.0f};         // Radius scope
+        float radius{0.0f};
+        uint32_t group{0};                   // Group scope
+        MessageScope scope{MessageScope::Entity};
     };
-    std::vector<QueuedMessage> m_messageQueue;
+    static constexpr size_t MESSAGE_QUEUE_SIZE = 4096;
+    Hammer::BoundedMPSCQueue<QueuedMessage, MESSAGE_QUEUE_SIZE> m_messageQueue;
+    std::atomic<uint64_t> m_droppedMessages{0};
+    std::atomic<uint64_t> m_deliveredMessages{0};
+
+    // This frame's messages, drained by update() before batches run. Direct
+    // messages are sorted by recipient slot, so each entity's inbox is a
+    // contiguous range; a batch flags the ones it delivered. Broadcasts
+    // reach every active slot, and a batch flags the slots it covered.
+    // Owned by the thread running update().
+    struct InboxEntry {
+        uint32_t slot;
+        EntityHandle target;
+        AIMessage message;
+    };
+    std::vector<InboxEntry> m_frameInbox;
+    std::vector<uint8_t> m_frameInboxDelivered;
+    std::vector<AIMessage> m_frameBroadcasts;
+    std::vector<uint8_t> m_broadcastReceived;
+    std::vector<QueuedMessage> m_drainScratch;
+    std::vector<uint32_t> m_recipientScratch;
+
+    // Group id -> member handles, and each member's group; guarded by m_entitiesMutex
+    std::unordered_map<uint32_t, std::vector<EntityHandle>> m_groupMembers;
+    EntityHandleMap<uint32_t> m_entityGroups;
 
     // Threading and state
     std::atomic<bool> m_initialized{false};
     std::atomic<bool> m_useThreading{true};
     std::atomic<bool> m_globallyPaused{false};
-    std::atomic<bool> m_processingMessages{false};
     unsigned int m_maxThreads{0};
 
     // Behavior execution tracking
@@ -376,7 +766,11 @@ private:
     std::atomic<uint64_t> m_lastFrameWithTasks{0};
     
     // Cleanup timing (thread-safe)
-    std::atomic<uint64_t> m_lastCleanupFrame{0};
+    std::atomic<uint64_t> m_lastCleanupFrame{0};   // Frame dead group members were last pruned
+
+    // Next slot the incremental cleanup sweep looks at; update thread only
+    size_t m_cleanupCursor{0};
+    std::vector<uint32_t> m_cleanupScratch;
 
     // Distance optimization settings
     std::atomic<float> m_maxUpdateDistance{4000.0f};
@@ -384,7 +778,36 @@ private:
     std::atomic<float> m_minUpdateDistance{10000.0f};
     std::atomic<float> m_priorityMultiplier{1.0f};
 
-    // Thread synchronization
+    // Tier intervals per priority, already rounded to powers of two. Written
+    // under m_entitiesMutex (exclusive), read while building the update list.
+    std::array<AIUpdateSchedule, AI_MAX_PRIORITY + 1> m_updateSchedules{};
+
+    // Sum of the deltaTimes passed to update(); only the update thread writes
+    // it, before dispatching batches
+    double m_aiTime{0.0};
+    std::atomic<uint64_t> m_frameTimeMs{0};   // m_aiTime in whole milliseconds
+    std::atomic<float> m_frameDeltaTime{0.0f}; // deltaTime of the latest update
+    std::atomic<uint64_t> m_randomSeed{0};
+    std::atomic<bool> m_randomSeedSet{false};  // Set explicitly, so init() keeps it
+    std::atomic<const FlowField*> m_playerFlowField{nullptr};
+    std::atomic<const FormationSnapshot*> m_formations{nullptr};
+
+    // Crowd steering; written under m_entitiesMutex (exclusive). update()
+    // copies it for the frame's batches.
+    CrowdSettings m_crowdSettings{};
+    CrowdSettings m_frameCrowdSettings{};
+
+    // Perception sight-line grid; update() copies it for the frame's batches
+    mutable std::mutex m_perceptionGridMutex;
+    std::shared_ptr<const NavigationGrid> m_perceptionGrid;
+    std::shared_ptr<const NavigationGrid> m_framePerceptionGrid;   // Update thread only
+
+    // Thread synchronization. Batches hold m_behaviorExecutionMutex shared while
+    // behaviors run; anything that calls init/clean/cleanupEntity, delivers an
+    // immediate message or replaces a slot's behavior holds it exclusively, so
+    // shared behavior instances never see those overlap executeLogic(). Queued
+    // messages are delivered by the batches themselves. Taken before m_entitiesMutex.
+    mutable std::shared_mutex m_behaviorExecutionMutex;
     mutable std::shared_mutex m_entitiesMutex;
     mutable std::shared_mutex m_behaviorsMutex;
     mutable std::mutex m_assignmentsMutex;
@@ -395,27 +818,31 @@ private:
     static constexpr size_t CACHE_LINE_SIZE = 64;           // Standard cache line size
     static constexpr size_t BATCH_SIZE = 256;               // Larger batches for better throughput
     static constexpr size_t THREADING_THRESHOLD = 500;      // Higher threshold due to improved efficiency
+    static constexpr size_t CLEANUP_SLOTS_PER_FRAME = 1024; // Slots the cleanup sweep visits each frame
 
     // Optimized helper methods
     BehaviorType inferBehaviorType(const std::string& behaviorName) const;
-    void processBatch(size_t start, size_t end, float deltaTime, int bufferIndex);
-    void swapBuffers();
-    void cleanupInactiveEntities();
+    void processBatch(size_t start, size_t end, const FrameContext& context);
+    void cleanupInactiveEntities(size_t slotBudget);
     void cleanupAllEntities();
-    void updateDistancesScalar(const Vector2D& playerPos);
+    void updateDistances(const Vector2D& playerPos);
+    size_t buildUpdateList(bool hasPlayer, uint64_t frame);
+    void groupUpdateListByType();
+    void commitPositionSnapshot(uint64_t frame);
+    void clearPositionSnapshot();
     void recordPerformance(BehaviorType type, double timeMs, uint64_t entities);
     static uint64_t getCurrentTimeNanos();
-    
-    // Lock-free message queue
-    struct alignas(CACHE_LINE_SIZE) LockFreeMessage {
-        EntityWeakPtr target;
-        char message[48];  // Fixed size for lock-free queue
-        std::atomic<bool> ready{false};
-    };
-    static constexpr size_t MESSAGE_QUEUE_SIZE = 1024;
-    std::array<LockFreeMessage, MESSAGE_QUEUE_SIZE> m_lockFreeMessages{};
-    std::atomic<size_t> m_messageWriteIndex{0};
-    std::atomic<size_t> m_messageReadIndex{0};
+    void queueMessage(const QueuedMessage& queued);
+    void resolveRecipients(const QueuedMessage& queued, std::vector<uint32_t>& indexScratch,
+                           std::vector<InboxEntry>& out) const;
+    void leaveGroup(EntityHandle handle);
+    void pruneDeadGroupMembers();
+    size_t drainMessageQueue(std::vector<QueuedMessage>& out);
+    void collectFrameMessages();
+    size_t deliverFrameMessages(std::span<const uint32_t> slots, std::span<const EntityPtr> entities,
+                                AIBehavior* behavior);
+    void deliverRemainingFrameMessages();
+    void clearFrameMessages();
     
     // Shutdown state
     bool m_isShutdown{false};
@@ -364,6 +364,7 @@ private:
     std::atomic<bool> m_threadingEnabled{true};
     std::atomic<bool> m_initialized{false};
     size_t m_threadingThreshold{50}; // Thread for medium+ event counts (consistent with buffer threshold)
+    static constexpr size_t MIN_EVENTS_PER_BATCH = 8; // parallelForEach grain size
 
     // Performance monitoring
     mutable std::array<PerformanceStats, static_cast<size_t>(EventTypeId::COUNT)> m_performanceStats;
@@ -0,0 +1,142 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef FORMATION_MANAGER_HPP
+#define FORMATION_MANAGER_HPP
+
+/**
+ * @file FormationManager.hpp
+ * @brief Formations shared by every follower of a leader
+ *
+ * A formation is a leader, a shape, a spacing and its members; each member
+ * holds one slot. Behaviors join and leave from any thread. Slots are
+ * matched to members only when membership or shape changes: nearest member
+ * and slot pair first, so nobody crosses the formation to reach a slot a
+ * neighbor was standing on.
+ *
+ * update() runs once per frame, before AIManager::update(). It moves every
+ * slot with its leader and publishes all slot positions in one
+ * FormationSnapshot, which stays pinned until the next update(). Followers
+ * read their slot from the snapshot without locking and compute no offsets
+ * of their own. A formation whose leader no longer exists is dropped.
+ */
+
+#include "ai/Formation.hpp"
+#include "core/SnapshotRing.hpp"
+#include "entities/EntityHandle.hpp"
+#include "utils/Vector2D.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct FormationStats {
+    uint64_t rematches{0};   // Formations whose slots were matched to members again
+    uint64_t publishes{0};
+    double updateTimeMs{0.0};
+};
+
+class FormationManager {
+public:
+    static FormationManager& Instance() {
+        static FormationManager instance;
+        return instance;
+    }
+
+    bool init();
+    bool isInitialized() const { return m_initialized.load(std::memory_order_acquire); }
+
+    // Drops every formation and the published snapshot
+    void clean();
+
+    /**
+     * @brief Drops every formation but stays initialized
+     * @details Followers still holding an id find it gone and hold no slot
+     */
+    void prepareForStateTransition();
+
+    /**
+     * @brief Match changed formations, move slots with their leaders, publish
+     * @details Call once per frame from one thread, before AIManager::update()
+     */
+    void update();
+
+    /**
+     * @brief New formation around leader
+     * @param spacing Distance between neighboring slots
+     * @param maxMembers Joins past this many fail; 0 = no limit
+     * @return INVALID_FORMATION before init() or for an invalid leader
+     */
+    FormationId createFormation(EntityHandle leader, FormationShape shape, float spacing, uint32_t maxMembers = 0);
+
+    /**
+     * @brief The unlimited formation with this leader, shape and spacing, created if needed
+     * @details Lets behavior clones that share a configuration share one formation
+     */
+    FormationId findOrCreateFormation(EntityHandle leader, FormationShape shape, float spacing);
+
+    bool destroyFormation(FormationId id);
+    bool setFormationShape(FormationId id, FormationShape shape, float spacing);
+
+    // Takes effect at the next update(). Joining twice keeps one slot.
+    bool joinFormation(FormationId id, EntityHandle member);
+    void leaveFormation(FormationId id, EntityHandle member);
+
+    /**
+     * @brief Slot positions pinned by the last update(), or null
+     * @details Valid until the next update(); null before the first
+     *          update() with a formation, and after clean()
+     */
+    const FormationSnapshot* getSnapshot() const { return m_currentSnapshot.load(std::memory_order_acquire); }
+
+    size_t getFormationCount() const;
+    size_t getMemberCount(FormationId id) const;
+    EntityHandle getLeader(FormationId id) const;
+    FormationStats getStats() const;
+
+private:
+    FormationManager() = default;
+    ~FormationManager() = default;
+    FormationManager(const FormationManager&) = delete;
+    FormationManager& operator=(const FormationManager&) = delete;
+
+    struct Formation {
+        FormationId id{INVALID_FORMATION};
+        EntityHandle leader{};
+        FormationShape shape{FormationShape::Ring};
+        float spacing{0.0f};
+        uint32_t maxMembers{0};
+        bool shared{false};                // Made by findOrCreateFormation()
+        bool dirty{true};                  // Members or shape changed since the last match
+        float heading{0.0f};               // Radians; kept while the leader stands still
+        std::vector<EntityHandle> members; // members[i] holds slot i once matched
+        std::vector<Vector2D> offsets;     // Layout for the current member count
+    };
+
+    // Everything below is guarded by m_mutex, except the atomics
+    mutable std::mutex m_mutex;
+    std::vector<Formation> m_formations;   // In creation order, which is slot order
+    FormationId m_nextId{1};
+    uint64_t m_membershipVersion{1};       // Bumped when any member changes slot
+    FormationStats m_stats;
+
+    // update() is the ring's only writer and keeps the published snapshot
+    // pinned for the frame
+    Hammer::SnapshotRing<FormationSnapshot> m_snapshots;
+    Hammer::SnapshotRing<FormationSnapshot>::ReadGuard m_frameSnapshot;   // update() thread only
+    std::atomic<const FormationSnapshot*> m_currentSnapshot{nullptr};
+
+    std::atomic<bool> m_initialized{false};
+
+    // Greedy matching is quadratic in members; bigger formations keep join order
+    static constexpr size_t MAX_MATCHED_MEMBERS = 64;
+
+    Formation* findFormation(FormationId id);              // Caller holds m_mutex
+    const Formation* findFormation(FormationId id) const;  // Caller holds m_mutex
+    void matchSlots(Formation& formation, const Vector2D& leaderPosition);   // Caller holds m_mutex
+    void dropFormations();                                 // Caller holds m_mutex
+};
+
+#endif // FORMATION_MANAGER_HPP
@@ -0,0 +1,274 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#ifndef PATHFINDING_MANAGER_HPP
+#define PATHFINDING_MANAGER_HPP
+
+/**
+ * @file PathfindingManager.hpp
+ * @brief Asynchronous grid pathfinding for AI behaviors
+ *
+ * Behaviors call requestPath() and get a handle back straight away. They
+ * poll the handle on later frames until the path is Ready or Failed, then
+ * call releasePath(). Each update() hands at most getRequestsPerFrame()
+ * queued requests to ThreadSystem workers, a few per task. Each task runs
+ * A* with a pooled AStarPathfinder, so one frame never takes on more
+ * searches than its budget. Without a ThreadSystem, update() runs the
+ * searches itself.
+ *
+ * Finished paths are cached by (start cell, goal cell). A request for a
+ * cached pair is Ready the moment it is made. Any change to the grid bumps
+ * its version and empties the cache. A search still running on the old
+ * grid finishes for its requester, but its path is not cached.
+ *
+ * Searches read an immutable snapshot of the grid. An edit copies the grid
+ * only while a search still holds the current one.
+ *
+ * For crowds with one shared target, such as everything chasing the
+ * player, a flow field replaces per-entity searches. setFlowFieldGoal()
+ * names the target. update() rebuilds the field on a worker only when the
+ * target moves to another cell or the grid changes, and keeps serving the
+ * previous field until the new one is published. getFlowField() returns
+ * the field pinned for the current frame.
+ */
+
+#include "ai/AStarPathfinder.hpp"
+#include "ai/FlowField.hpp"
+#include "ai/NavigationGrid.hpp"
+#include "core/SnapshotRing.hpp"
+#include "utils/Vector2D.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Names one path request; a stale handle never matches a reused slot
+ */
+struct PathRequestHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index{INVALID_INDEX};
+    uint32_t generation{0};
+
+    bool isValid() const { return index != INVALID_INDEX && generation != 0; }
+    bool operator==(const PathRequestHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PathRequestHandle& other) const { return !(*this == other); }
+};
+
+enum class PathStatus : uint8_t {
+    Invalid,   // Unknown or released handle
+    Pending,   // Queued or being searched
+    Ready,     // getPath() returns the route
+    Failed     // No route, endpoints off the grid, or the search budget ran out
+};
+
+struct PathfindingStats {
+    uint64_t requests{0};
+    uint64_t cacheHits{0};
+    uint64_t searches{0};
+    uint64_t failures{0};
+    uint64_t cellsExpanded{0};
+    double searchTimeMs{0.0};   // Summed over worker threads
+    uint64_t flowFieldBuilds{0};
+    double flowFieldTimeMs{0.0};
+};
+
+class PathfindingManager {
+public:
+    static PathfindingManager& Instance() {
+        static PathfindingManager instance;
+        return instance;
+    }
+
+    bool init();
+    bool isInitialized() const { return m_initialized.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Waits for running searches, then drops requests, cache and grid
+     */
+    void clean();
+
+    /**
+     * @brief Drops requests, cached paths and the flow field goal but keeps the grid
+     * @details Handles held by behaviors become Invalid
+     */
+    void prepareForStateTransition();
+
+    /**
+     * @brief Dispatch queued requests, at most getRequestsPerFrame() of them
+     * @details Call once per frame, before AIManager::update(), so behaviors
+     *          see paths that finished during the previous frame. Also
+     *          starts a flow field rebuild if its goal changed cell, and pins
+     *          the latest finished field for this frame.
+     */
+    void update();
+
+    // Grid setup and edits. Every edit that changes a cell invalidates the cache.
+    void setGrid(uint32_t width, uint32_t height, float cellSize, const Vector2D& origin = Vector2D(0.0f, 0.0f));
+    bool hasGrid() const { return m_hasGrid.load(std::memory_order_acquire); }
+    void setCellBlocked(const Vector2D& position, bool blocked);
+    void setAreaBlocked(const Vector2D& minCorner, const Vector2D& maxCorner, bool blocked);
+    bool isBlocked(const Vector2D& position) const;
+    uint64_t getGridVersion() const;
+
+    // Read-only snapshot of the current grid; null before setGrid()
+    std::shared_ptr<const NavigationGrid> getGrid() const;
+
+    /**
+     * @brief Queue a path from start to goal
+     *
+     * A start or goal inside a blocked cell is moved to the nearest
+     * walkable cell within a few cells. Returns an invalid handle before
+     * setGrid().
+     */
+    PathRequestHandle requestPath(const Vector2D& start, const Vector2D& goal);
+
+    PathStatus getPathStatus(PathRequestHandle handle) const;
+
+    /**
+     * @brief Copy a Ready path into out
+     *
+     * Points are where the route turns, after the start cell, ending at
+     * the requested goal. They are cell centers in between, and the goal
+     * cell's center if the goal had to be moved off a blocked cell.
+     * @return false unless the request is Ready
+     */
+    bool getPath(PathRequestHandle handle, std::vector<Vector2D>& out) const;
+
+    // Frees the request; its handle becomes Invalid. Safe on any handle.
+    void releasePath(PathRequestHandle handle);
+
+    /**
+     * @brief Search on the calling thread, bypassing queue, budget and cache
+     * @return Ready or Failed
+     */
+    PathStatus findPathNow(const Vector2D& start, const Vector2D& goal, std::vector<Vector2D>& out);
+
+    // Flow field toward one shared goal. The goal is snapped to a walkable
+    // cell like request endpoints; clearing it stops serving a field.
+    void setFlowFieldGoal(const Vector2D& position);
+    void clearFlowFieldGoal();
+    void setFlowFieldRadius(float radius);   // World units of route; 0 = whole grid
+
+    /**
+     * @brief The flow field pinned by the last update(), or null
+     * @details Valid until the next update(); null before the first build
+     *          finishes, without a goal, or after clean()
+     */
+    const FlowField* getFlowField() const { return m_currentFlowField.load(std::memory_order_acquire); }
+
+    void setRequestsPerFrame(size_t requests);
+    size_t getRequestsPerFrame() const { return m_requestsPerFrame.load(std::memory_order_relaxed); }
+    void setMaxExpansions(uint32_t expansions);   // Per search; 0 = no limit
+    void setCacheCapacity(size_t paths);
+
+    size_t getQueuedRequestCount() const;
+    size_t getCachedPathCount() const;
+    bool isIdle() const;   // Nothing queued and no search running
+    PathfindingStats getStats() const;
+    void resetStats();
+
+private:
+    PathfindingManager() = default;
+    ~PathfindingManager() = default;
+    PathfindingManager(const PathfindingManager&) = delete;
+    PathfindingManager& operator=(const PathfindingManager&) = delete;
+
+    using Path = std::vector<Vector2D>;
+    using PathPtr = std::shared_ptr<const Path>;
+
+    struct RequestSlot {
+        uint32_t generation{1};
+        PathStatus status{PathStatus::Invalid};
+        Vector2D goal{0.0f, 0.0f};
+        bool exactGoal{false};   // Goal lies in the goal cell, so it replaces the cell's center
+        PathPtr path;
+    };
+
+    struct SearchJob {
+        uint32_t slot;
+        uint32_t generation;
+        uint32_t startCell;
+        uint32_t goalCell;
+    };
+
+    struct SearchResult {
+        SearchJob job;
+        PathPtr path;   // Null if the search failed
+    };
+
+    static uint64_t cacheKey(uint32_t startCell, uint32_t goalCell) {
+        return (static_cast<uint64_t>(startCell) << 32) | goalCell;
+    }
+
+    // Everything below is guarded by m_mutex, except the atomics
+    mutable std::mutex m_mutex;
+    std::shared_ptr<NavigationGrid> m_grid;
+    uint64_t m_gridVersion{0};
+
+    std::vector<RequestSlot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::deque<SearchJob> m_queue;
+
+    // Cached paths with their keys in insertion order; the oldest goes first
+    std::unordered_map<uint64_t, PathPtr> m_cache;
+    std::deque<uint64_t> m_cacheOrder;
+    size_t m_cacheCapacity{4096};
+
+    PathfindingStats m_stats;
+
+    std::mutex m_poolMutex;
+    std::vector<std::unique_ptr<AStarPathfinder>> m_searchPool;
+
+    // Flow field state; the plain members are guarded by m_mutex. One build
+    // runs at a time and is the ring's only writer. update() keeps the
+    // published field pinned for the frame.
+    bool m_hasFlowGoal{false};
+    Vector2D m_flowGoal{0.0f, 0.0f};
+    float m_flowFieldRadius{0.0f};
+    uint32_t m_flowBuiltCell{NavigationGrid::INVALID_CELL};   // Goal cell of the published field
+    uint64_t m_flowBuiltVersion{0};
+    uint64_t m_flowGeneration{0};      // Bumped when the goal is cleared; stale builds are not published
+    bool m_flowFieldReady{false};
+    Hammer::SnapshotRing<FlowField> m_flowFields;
+    Hammer::SnapshotRing<FlowField>::ReadGuard m_frameFlowField;   // update() thread only
+    std::atomic<const FlowField*> m_currentFlowField{nullptr};
+    std::atomic<bool> m_flowFieldBuilding{false};
+
+    std::atomic<bool> m_initialized{false};
+    std::atomic<bool> m_hasGrid{false};
+    std::atomic<size_t> m_requestsPerFrame{64};
+    std::atomic<uint32_t> m_maxExpansions{0};
+    std::atomic<size_t> m_runningTasks{0};
+
+    static constexpr size_t SEARCHES_PER_TASK = 4;
+    static constexpr uint32_t ENDPOINT_SNAP_RINGS = 4;
+
+    void dispatchSearches(std::vector<SearchJob> jobs, std::shared_ptr<const NavigationGrid> grid,
+                          uint64_t gridVersion);
+    void runSearches(std::vector<SearchJob> jobs, std::shared_ptr<const NavigationGrid> grid, uint64_t gridVersion);
+    PathPtr search(AStarPathfinder& pathfinder, const NavigationGrid& grid, uint32_t startCell, uint32_t goalCell,
+                   uint64_t& expanded) const;
+    void publish(std::vector<SearchResult>& results, uint64_t gridVersion, uint64_t expanded, double searchMs);
+    void buildFlowField(std::shared_ptr<const NavigationGrid> grid, uint32_t goalCell, uint64_t gridVersion,
+                        float maxCost, uint64_t generation);
+    void pinFlowField();
+    void resetFlowField();   // Caller holds m_mutex
+    void retireSlot(uint32_t index);  // Caller holds m_mutex
+    NavigationGrid& editableGrid();   // Caller holds m_mutex
+    void invalidateCache();           // Caller holds m_mutex
+    void cachePath(uint64_t key, PathPtr path);   // Caller holds m_mutex
+    void waitForSearches() const;
+    std::unique_ptr<AStarPathfinder> acquirePathfinder();
+    void returnPathfinder(std::unique_ptr<AStarPathfinder> pathfinder);
+};
+
+#endif // PATHFINDING_MANAGER_HPP
@@ -0,0 +1,235 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/AISpatialGrid.hpp"
+#include "core/ThreadSystem.hpp"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// Keeps cell coordinates of far-off or non-finite positions in range
+constexpr float MAX_CELL_COORD = 1073741824.0f; // 2^30
+
+} // namespace
+
+AISpatialGrid::AISpatialGrid(float cellSize)
+    : m_cellSize(DEFAULT_CELL_SIZE), m_inverseCellSize(1.0f / DEFAULT_CELL_SIZE) {
+    setCellSize(cellSize);
+}
+
+void AISpatialGrid::setCellSize(float cellSize) {
+    if (!(cellSize > 0.0f)) {
+        cellSize = DEFAULT_CELL_SIZE;
+    }
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.0f / cellSize;
+    // Cell membership depends on the size; the next rebuild repopulates
+    clear();
+}
+
+void AISpatialGrid::clear() {
+    m_slotCount = 0;
+    m_entryCount = 0;
+    m_bucketCount = 0;
+    m_slotBucket.clear();
+    m_slotEntry.clear();
+    m_bucketStart.clear();
+    m_entries.clear();
+}
+
+int32_t AISpatialGrid::cellCoord(float value) const {
+    float scaled = value * m_inverseCellSize;
+    if (!(scaled > -MAX_CELL_COORD)) scaled = -MAX_CELL_COORD; // Also catches NaN
+    if (scaled > MAX_CELL_COORD) scaled = MAX_CELL_COORD;
+    // Truncate and step down for negatives; std::floor is a library call without SSE4.1
+    int32_t cell = static_cast<int32_t>(scaled);
+    return cell - static_cast<int32_t>(scaled < static_cast<float>(cell));
+}
+
+uint32_t AISpatialGrid::bucketOf(int32_t cellX, int32_t cellY) const {
+    // Fibonacci hashing of the packed cell: the high bits of the product are well mixed
+    uint64_t cell = (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+    return static_cast<uint32_t>((cell * 0x9E3779B97F4A7C15ull) >> m_bucketShift);
+}
+
+void AISpatialGrid::hashSlots(const float* x, const float* y, const uint8_t* active, size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+        const bool skipped = active && !active[i];
+        m_slotBucket[i] = skipped ? EMPTY_SLOT : bucketOf(cellCoord(x[i]), cellCoord(y[i]));
+        m_slotEntry[i] = EMPTY_SLOT;   // Set by the scatter for slots it places
+    }
+}
+
+void AISpatialGrid::rebuild(const float* x, const float* y, const uint8_t* active, size_t count,
+                            bool allowThreading) {
+    m_slotCount = count;
+    m_slotBucket.resize(count);
+    m_slotEntry.resize(count);
+
+    // About one bucket per entity keeps runs short and the tables cache-sized
+    size_t bucketCount = MIN_BUCKET_COUNT;
+    uint32_t bucketBits = 10;
+    while (bucketCount < count) {
+        bucketCount <<= 1;
+        ++bucketBits;
+    }
+    m_bucketCount = bucketCount;
+    m_bucketShift = 64 - bucketBits;
+
+    const bool parallel = allowThreading && count >= PARALLEL_THRESHOLD && Hammer::ThreadSystem::Exists();
+
+    // Pass 1: bucket per slot, independent per slot
+    if (parallel) {
+        Hammer::ThreadSystem::Instance().parallelFor(0, count, PARALLEL_THRESHOLD / 2,
+            [this, x, y, active](size_t start, size_t end) {
+                hashSlots(x, y, active, start, end);
+            }, Hammer::ThreadSystem::AUTO_WORKER_COUNT, Hammer::TaskPriority::High, "AI_SpatialHash");
+    } else {
+        hashSlots(x, y, active, 0, count);
+    }
+
+    // Pass 2: counting sort by bucket. The bucket table is split into ranges
+    // that each own their buckets and their part of the entry array, so
+    // ranges count and scatter independently without atomics.
+    const size_t rangeCount = parallel ? SORT_RANGE_COUNT : 1;
+    const size_t bucketsPerRange = bucketCount / rangeCount;
+    std::array<uint32_t, SORT_RANGE_COUNT + 1> rangeBase{};
+    m_bucketStart.resize(bucketCount + 1);
+
+    auto countRange = [this, count, bucketsPerRange, &rangeBase](size_t range) {
+        const uint32_t firstBucket = static_cast<uint32_t>(range * bucketsPerRange);
+        const uint32_t endBucket = static_cast<uint32_t>(firstBucket + bucketsPerRange);
+        std::fill(m_bucketStart.begin() + firstBucket, m_bucketStart.begin() + endBucket, 0u);
+        uint32_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t bucket = m_slotBucket[i];
+            if (bucket >= firstBucket && bucket < endBucket) {
+                ++m_bucketStart[bucket];
+                ++total;
+            }
+        }
+        rangeBase[range + 1] = total;
+    };
+
+    // Counts become end offsets, then the reverse scatter walks them back to
+    // start offsets, keeping slots in ascending order within each bucket.
+    // Positions are read from the caller's arrays straight into the entries.
+    auto scatterRange = [this, x, y, count, bucketsPerRange, &rangeBase](size_t range) {
+        const uint32_t firstBucket = static_cast<uint32_t>(range * bucketsPerRange);
+        const uint32_t endBucket = static_cast<uint32_t>(firstBucket + bucketsPerRange);
+        uint32_t offset = rangeBase[range];
+        for (uint32_t b = firstBucket; b < endBucket; ++b) {
+            offset += m_bucketStart[b];
+            m_bucketStart[b] = offset;
+        }
+        for (size_t i = count; i-- > 0;) {
+            uint32_t bucket = m_slotBucket[i];
+            if (bucket >= firstBucket && bucket < endBucket) {
+                const uint32_t entry = --m_bucketStart[bucket];
+                m_entries[entry] = Entry{x[i], y[i], static_cast<uint32_t>(i), 0};
+                m_slotEntry[i] = entry;
+            }
+        }
+    };
+
+    if (parallel) {
+        auto& threadSystem = Hammer::ThreadSystem::Instance();
+        threadSystem.parallelFor(0, rangeCount, 1, [&countRange](size_t start, size_t end) {
+            for (size_t range = start; range < end; ++range) countRange(range);
+        }, Hammer::ThreadSystem::AUTO_WORKER_COUNT, Hammer::TaskPriority::High, "AI_SpatialCount");
+    } else {
+        countRange(0);
+    }
+
+    for (size_t range = 0; range < rangeCount; ++range) {
+        rangeBase[range + 1] += rangeBase[range];
+    }
+    m_entryCount = rangeBase[rangeCount];
+    m_entries.resize(m_entryCount);
+    m_bucketStart[bucketCount] = static_cast<uint32_t>(m_entryCount);
+
+    if (parallel) {
+        auto& threadSystem = Hammer::ThreadSystem::Instance();
+        threadSystem.parallelFor(0, rangeCount, 1, [&scatterRange](size_t start, size_t end) {
+            for (size_t range = start; range < end; ++range) scatterRange(range);
+        }, Hammer::ThreadSystem::AUTO_WORKER_COUNT, Hammer::TaskPriority::High, "AI_SpatialScatter");
+    } else {
+        scatterRange(0);
+    }
+}
+
+bool AISpatialGrid::coversTooManyCells(int32_t minCellX, int32_t minCellY,
+                                       int32_t maxCellX, int32_t maxCellY) const {
+    // Past this point a linear scan of the entries is cheaper than walking cells
+    uint64_t width = static_cast<uint64_t>(static_cast<int64_t>(maxCellX) - minCellX + 1);
+    uint64_t height = static_cast<uint64_t>(static_cast<int64_t>(maxCellY) - minCellY + 1);
+    return width * height > m_entryCount;
+}
+
+template<typename Accept>
+size_t AISpatialGrid::collect(int32_t minCellX, int32_t minCellY, int32_t maxCellX, int32_t maxCellY,
+                              Accept&& accept, uint32_t* out, size_t capacity) const {
+    size_t written = 0;
+
+    if (coversTooManyCells(minCellX, minCellY, maxCellX, maxCellY)) {
+        for (size_t e = 0; e < m_entryCount && written < capacity; ++e) {
+            if (accept(m_entries[e].x, m_entries[e].y)) {
+                out[written++] = m_entries[e].slot;
+            }
+        }
+        return written;
+    }
+
+    for (int32_t cellY = minCellY; cellY <= maxCellY; ++cellY) {
+        for (int32_t cellX = minCellX; cellX <= maxCellX; ++cellX) {
+            const uint32_t bucket = bucketOf(cellX, cellY);
+            const uint32_t end = m_bucketStart[bucket + 1];
+            for (uint32_t e = m_bucketStart[bucket]; e < end; ++e) {
+                const Entry& entry = m_entries[e];
+                if (!accept(entry.x, entry.y)) {
+                    continue;
+                }
+                // Another cell can share the bucket; it is visited in its own iteration
+                if (cellCoord(entry.x) != cellX || cellCoord(entry.y) != cellY) {
+                    continue;
+                }
+                out[written++] = entry.slot;
+                if (written == capacity) {
+                    return written;
+                }
+            }
+        }
+    }
+    return written;
+}
+
+size_t AISpatialGrid::queryRadius(float centerX, float centerY, float radius,
+                                  uint32_t* out, size_t capacity) const {
+    if (m_entryCount == 0 || capacity == 0 || !(radius >= 0.0f)) {
+        return 0;
+    }
+
+    const float radiusSquared = radius * radius;
+    auto inRange = [centerX, centerY, radiusSquared](float px, float py) {
+        float dx = px - centerX;
+        float dy = py - centerY;
+        return dx * dx + dy * dy <= radiusSquared;
+    };
+    return collect(cellCoord(centerX - radius), cellCoord(centerY - radius),
+                   cellCoord(centerX + radius), cellCoord(centerY + radius), inRange, out, capacity);
+}
+
+size_t AISpatialGrid::queryRect(float minX, float minY, float maxX, float maxY,
+                                uint32_t* out, size_t capacity) const {
+    if (m_entryCount == 0 || capacity == 0 || !(minX <= maxX) || !(minY <= maxY)) {
+        return 0;
+    }
+
+    auto inside = [minX, minY, maxX, maxY](float px, float py) {
+        return px >= minX && px <= maxX && py >= minY && py <= maxY;
+    };
+    return collect(cellCoord(minX), cellCoord(minY), cellCoord(maxX), cellCoord(maxY), inside, out, capacity);
+}
@@ -0,0 +1,153 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/AStarPathfinder.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+namespace {
+
+constexpr float DIAGONAL_COST = 1.41421356f;
+
+// Exact cost of an unobstructed eight-way walk, so A* never overestimates
+float octileDistance(int32_t dx, int32_t dy) {
+    dx = std::abs(dx);
+    dy = std::abs(dy);
+    const int32_t straight = std::max(dx, dy) - std::min(dx, dy);
+    return static_cast<float>(straight) + DIAGONAL_COST * static_cast<float>(std::min(dx, dy));
+}
+
+struct Step {
+    int32_t dx;
+    int32_t dy;
+    float cost;
+};
+
+constexpr std::array<Step, 8> STEPS{{
+    {1, 0, 1.0f}, {-1, 0, 1.0f}, {0, 1, 1.0f}, {0, -1, 1.0f},
+    {1, 1, DIAGONAL_COST}, {1, -1, DIAGONAL_COST}, {-1, 1, DIAGONAL_COST}, {-1, -1, DIAGONAL_COST},
+}};
+
+} // namespace
+
+void AStarPathfinder::prepare(size_t cellCount) {
+    if (m_cost.size() != cellCount) {
+        m_cost.assign(cellCount, 0.0f);
+        m_parent.assign(cellCount, NavigationGrid::INVALID_CELL);
+        m_seen.assign(cellCount, 0);
+        m_closed.assign(cellCount, 0);
+        m_stamp = 0;
+    }
+    if (++m_stamp == 0) {
+        // Stamps wrapped; old marks could match again
+        std::fill(m_seen.begin(), m_seen.end(), 0);
+        std::fill(m_closed.begin(), m_closed.end(), 0);
+        m_stamp = 1;
+    }
+    m_open.clear();
+}
+
+AStarPathfinder::Result AStarPathfinder::findPath(const NavigationGrid& grid, uint32_t startCell, uint32_t goalCell,
+                                                  std::vector<uint32_t>& outCells, uint32_t maxExpansions) {
+    outCells.clear();
+    m_lastExpansions = 0;
+    m_lastPathCost = 0.0f;
+    const size_t cellCount = grid.getCellCount();
+    if (startCell >= cellCount || goalCell >= cellCount || grid.isBlocked(startCell) || grid.isBlocked(goalCell)) {
+        return Result::InvalidEndpoints;
+    }
+
+    prepare(cellCount);
+    const int32_t goalX = static_cast<int32_t>(grid.cellX(goalCell));
+    const int32_t goalY = static_cast<int32_t>(grid.cellY(goalCell));
+    auto heuristic = [goalX, goalY](int32_t x, int32_t y) { return octileDistance(goalX - x, goalY - y); };
+    // Lowest f on top; among equal f the deeper node, which is closer to the goal
+    auto openAfter = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+
+    m_cost[startCell] = 0.0f;
+    m_parent[startCell] = NavigationGrid::INVALID_CELL;
+    m_seen[startCell] = m_stamp;
+    m_open.push_back({heuristic(static_cast<int32_t>(grid.cellX(startCell)),
+                                static_cast<int32_t>(grid.cellY(startCell))), 0.0f, startCell});
+
+    uint32_t expansions = 0;
+    bool found = false;
+    while (!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), openAfter);
+        const OpenNode node = m_open.back();
+        m_open.pop_back();
+
+        // Entries left behind when a cheaper route reached the same cell
+        if (m_closed[node.cell] == m_stamp || node.g > m_cost[node.cell]) {
+            continue;
+        }
+        if (node.cell == goalCell) {
+            found = true;
+            break;
+        }
+        m_closed[node.cell] = m_stamp;
+        if (maxExpansions != 0 && ++expansions > maxExpansions) {
+            m_lastExpansions = expansions;
+            return Result::BudgetExceeded;
+        }
+        ++m_lastExpansions;
+
+        const int32_t x = static_cast<int32_t>(grid.cellX(node.cell));
+        const int32_t y = static_cast<int32_t>(grid.cellY(node.cell));
+        for (const Step& step : STEPS) {
+            const int32_t nx = x + step.dx;
+            const int32_t ny = y + step.dy;
+            if (!grid.isWalkable(nx, ny)) {
+                continue;
+            }
+            // No squeezing diagonally between two blocked cells
+            if (step.dx != 0 && step.dy != 0 &&
+                (!grid.isWalkable(x + step.dx, y) || !grid.isWalkable(x, y + step.dy))) {
+                continue;
+            }
+            const uint32_t next = grid.cellIndex(static_cast<uint32_t>(nx), static_cast<uint32_t>(ny));
+            if (m_closed[next] == m_stamp) {
+                continue;
+            }
+            const float g = node.g + step.cost;
+            if (m_seen[next] == m_stamp && g >= m_cost[next]) {
+                continue;
+            }
+            m_seen[next] = m_stamp;
+            m_cost[next] = g;
+            m_parent[next] = node.cell;
+            m_open.push_back({g + heuristic(nx, ny), g, next});
+            std::push_heap(m_open.begin(), m_open.end(), openAfter);
+        }
+    }
+
+    if (!found) {
+        return Result::NoPath;
+    }
+
+    for (uint32_t cell = goalCell; cell != NavigationGrid::INVALID_CELL; cell = m_parent[cell]) {
+        outCells.push_back(cell);
+    }
+    std::reverse(outCells.begin(), outCells.end());
+    m_lastPathCost = m_cost[goalCell];
+    return Result::Found;
+}
+
+void AStarPathfinder::smoothPath(const NavigationGrid& grid, std::vector<uint32_t>& cells) {
+    if (cells.size() < 3) {
+        return;
+    }
+    size_t kept = 1;   // cells[0] stays
+    size_t anchor = 0;
+    for (size_t i = 2; i < cells.size(); ++i) {
+        if (!grid.hasLineOfSight(cells[anchor], cells[i])) {
+            anchor = i - 1;
+            cells[kept++] = cells[anchor];
+        }
+    }
+    cells[kept++] = cells.back();
+    cells.resize(kept);
+}
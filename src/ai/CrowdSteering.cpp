@@ -0,0 +1,102 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/CrowdSteering.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace CrowdSteering {
+
+Vector2D resolve(const AISpatialGrid& grid, const float* velocityX, const float* velocityY,
+                 uint32_t slot, const Vector2D& position, const Vector2D& desired,
+                 const CrowdSettings& settings) {
+    const float px = position.getX();
+    const float py = position.getY();
+    std::array<uint32_t, MAX_NEIGHBORS + 1> neighbors;   // The agent finds itself too
+    const size_t capacity = std::min<size_t>(settings.maxNeighbors, MAX_NEIGHBORS) + 1;
+    const size_t found = grid.queryRadius(px, py, settings.neighborRadius, neighbors.data(), capacity);
+
+    const float separationRadius = settings.separationRadius;
+    const float separationSquared = separationRadius * separationRadius;
+    const bool align = settings.alignmentWeight > 0.0f && velocityX && velocityY;
+    float separationX = 0.0f, separationY = 0.0f;
+    float sumVelocityX = 0.0f, sumVelocityY = 0.0f;
+    float sumX = 0.0f, sumY = 0.0f;
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < found; ++i) {
+        const uint32_t other = neighbors[i];
+        if (other == slot) {
+            continue;
+        }
+        const float ox = grid.getPositionX(other);
+        const float oy = grid.getPositionY(other);
+        float dx = px - ox;
+        float dy = py - oy;
+        const float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared < separationSquared) {
+            float distance = std::sqrt(distanceSquared);
+            if (distance < 0.001f) {
+                // Stacked exactly: the pair splits along a direction fixed by
+                // their slots, each one the opposite way
+                const float angle = static_cast<float>(std::min(slot, other)) * 2.3999632f;
+                const float sign = (slot < other) ? 1.0f : -1.0f;
+                dx = std::cos(angle) * sign;
+                dy = std::sin(angle) * sign;
+                distance = 1.0f;
+            }
+            // Full strength at full overlap, nothing at the edge of the radius
+            const float strength = (separationRadius - std::min(distance, separationRadius)) / (separationRadius * distance);
+            separationX += dx * strength;
+            separationY += dy * strength;
+        }
+        if (align) {
+            sumVelocityX += velocityX[other];
+            sumVelocityY += velocityY[other];
+        }
+        sumX += ox;
+        sumY += oy;
+        ++count;
+    }
+    if (count == 0) {
+        return desired;
+    }
+
+    float resultX = desired.getX();
+    float resultY = desired.getY();
+    const float push = settings.separationWeight * settings.maxPushSpeed;
+    resultX += separationX * push;
+    resultY += separationY * push;
+    if (align) {
+        const float inverse = 1.0f / static_cast<float>(count);
+        resultX += (sumVelocityX * inverse - desired.getX()) * settings.alignmentWeight;
+        resultY += (sumVelocityY * inverse - desired.getY()) * settings.alignmentWeight;
+    }
+    if (settings.cohesionWeight > 0.0f) {
+        const float inverse = 1.0f / static_cast<float>(count);
+        const float toCenterX = sumX * inverse - px;
+        const float toCenterY = sumY * inverse - py;
+        const float toCenter = std::sqrt(toCenterX * toCenterX + toCenterY * toCenterY);
+        if (toCenter > 0.001f) {
+            const float pull = settings.cohesionWeight * settings.maxPushSpeed / toCenter;
+            resultX += toCenterX * pull;
+            resultY += toCenterY * pull;
+        }
+    }
+
+    // Avoidance steers; it never makes an agent faster than it or the push allows
+    const float desiredSpeed = desired.length();
+    const float limit = std::max(desiredSpeed, settings.maxPushSpeed);
+    const float speedSquared = resultX * resultX + resultY * resultY;
+    if (speedSquared > limit * limit) {
+        const float scale = limit / std::sqrt(speedSquared);
+        resultX *= scale;
+        resultY *= scale;
+    }
+    return Vector2D(resultX, resultY);
+}
+
+} // namespace CrowdSteering
@@ -0,0 +1,119 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/FlowField.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr float DIAGONAL_COST = 1.41421356f;
+
+float stepCost(uint8_t code) {
+    return code < 4 ? 1.0f : DIAGONAL_COST;
+}
+
+// Same rule as AStarPathfinder: no diagonal step past a blocked corner
+bool canStep(const NavigationGrid& grid, int32_t x, int32_t y, uint8_t code) {
+    const int32_t dx = FlowField::STEP_X[code];
+    const int32_t dy = FlowField::STEP_Y[code];
+    if (!grid.isWalkable(x + dx, y + dy)) {
+        return false;
+    }
+    return code < 4 || (grid.isWalkable(x + dx, y) && grid.isWalkable(x, y + dy));
+}
+
+} // namespace
+
+void FlowField::clear() {
+    m_width = 0;
+    m_height = 0;
+    m_goalCell = NavigationGrid::INVALID_CELL;
+    m_reachedCells = 0;
+    m_cost.clear();
+    m_toward.clear();
+    m_away.clear();
+}
+
+void FlowField::build(const NavigationGrid& grid, uint32_t goalCell, float maxCost) {
+    const size_t cellCount = grid.getCellCount();
+    m_width = grid.getWidth();
+    m_height = grid.getHeight();
+    m_originX = grid.getOrigin().getX();
+    m_originY = grid.getOrigin().getY();
+    m_inverseCellSize = 1.0f / grid.getCellSize();
+    m_goalCell = goalCell;
+    m_reachedCells = 0;
+
+    const float unreached = std::numeric_limits<float>::infinity();
+    m_cost.assign(cellCount, unreached);
+    m_toward.assign(cellCount, NO_DIRECTION);
+    m_away.assign(cellCount, NO_DIRECTION);
+    m_open.clear();
+    m_settled.clear();
+    if (goalCell >= cellCount || grid.isBlocked(goalCell)) {
+        return;
+    }
+
+    const float costLimit = (maxCost > 0.0f) ? maxCost : unreached;
+    auto openAfter = [](const OpenNode& a, const OpenNode& b) { return a.cost > b.cost; };
+    m_cost[goalCell] = 0.0f;
+    m_open.push_back({0.0f, goalCell});
+
+    while (!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), openAfter);
+        const OpenNode node = m_open.back();
+        m_open.pop_back();
+        if (node.cost > m_cost[node.cell]) {
+            continue;
+        }
+        m_settled.push_back(node.cell);
+
+        const int32_t x = static_cast<int32_t>(grid.cellX(node.cell));
+        const int32_t y = static_cast<int32_t>(grid.cellY(node.cell));
+        for (uint8_t code = 0; code < 8; ++code) {
+            if (!canStep(grid, x, y, code)) {
+                continue;
+            }
+            const float cost = node.cost + stepCost(code);
+            const uint32_t next = grid.cellIndex(static_cast<uint32_t>(x + STEP_X[code]),
+                                                 static_cast<uint32_t>(y + STEP_Y[code]));
+            if (cost < m_cost[next] && cost <= costLimit) {
+                m_cost[next] = cost;
+                m_open.push_back({cost, next});
+                std::push_heap(m_open.begin(), m_open.end(), openAfter);
+            }
+        }
+    }
+    m_reachedCells = m_settled.size();
+
+    // Directions from the finished costs. Moves are symmetric, so a step
+    // this cell could take is also a step its neighbor could take back.
+    for (uint32_t cell : m_settled) {
+        const int32_t x = static_cast<int32_t>(grid.cellX(cell));
+        const int32_t y = static_cast<int32_t>(grid.cellY(cell));
+        const float cost = m_cost[cell];
+        float bestToward = unreached;
+        float bestAway = 0.0f;
+        for (uint8_t code = 0; code < 8; ++code) {
+            if (!canStep(grid, x, y, code)) {
+                continue;
+            }
+            const uint32_t next = grid.cellIndex(static_cast<uint32_t>(x + STEP_X[code]),
+                                                 static_cast<uint32_t>(y + STEP_Y[code]));
+            const float nextCost = m_cost[next];
+            // The neighbor this cell's cheapest route passes through
+            if (nextCost < cost && nextCost + stepCost(code) < bestToward) {
+                bestToward = nextCost + stepCost(code);
+                m_toward[cell] = code;
+            }
+            // Distance gained per unit moved; past the build radius counts as farthest
+            const float gain = (nextCost == unreached) ? unreached : (nextCost - cost) / stepCost(code);
+            if (gain > bestAway) {
+                bestAway = gain;
+                m_away[cell] = code;
+            }
+        }
+    }
+}
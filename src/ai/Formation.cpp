@@ -0,0 +1,49 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/Formation.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace FormationLayout {
+
+namespace {
+constexpr float TWO_PI = 6.28318531f;
+}
+
+Vector2D slotOffset(FormationShape shape, uint32_t slot, uint32_t slotCount, float spacing) {
+    if (slotCount == 0) {
+        return Vector2D(0.0f, 0.0f);
+    }
+    const float index = static_cast<float>(slot);
+    switch (shape) {
+        case FormationShape::Ring: {
+            // Neighbors stay at least a spacing apart along the ring
+            const float count = static_cast<float>(slotCount);
+            const float radius = std::max(spacing, count * spacing / TWO_PI);
+            const float angle = index * TWO_PI / count;
+            return Vector2D(std::cos(angle) * radius, std::sin(angle) * radius);
+        }
+        case FormationShape::Line: {
+            const float center = static_cast<float>(slotCount - 1) * 0.5f;
+            return Vector2D(-spacing, (index - center) * spacing);
+        }
+        case FormationShape::Column:
+            return Vector2D(-(index + 1.0f) * spacing, 0.0f);
+        case FormationShape::Wedge: {
+            // Slots pair up row by row, alternating sides
+            const float row = static_cast<float>(slot / 2 + 1);
+            const float side = (slot % 2 == 0) ? 1.0f : -1.0f;
+            return Vector2D(-row * spacing, side * row * spacing);
+        }
+    }
+    return Vector2D(0.0f, 0.0f);
+}
+
+bool turnsWithLeader(FormationShape shape) {
+    return shape != FormationShape::Ring;
+}
+
+} // namespace FormationLayout
@@ -0,0 +1,143 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/NavigationGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+NavigationGrid::NavigationGrid(uint32_t width, uint32_t height, float cellSize, const Vector2D& origin)
+    : m_width(width), m_height(height), m_origin(origin) {
+    if (cellSize > 0.0f) {
+        m_cellSize = cellSize;
+    }
+    m_inverseCellSize = 1.0f / m_cellSize;
+    m_blocked.assign(static_cast<size_t>(width) * height, 0);
+}
+
+uint32_t NavigationGrid::cellAt(const Vector2D& position) const {
+    const float fx = std::floor((position.getX() - m_origin.getX()) * m_inverseCellSize);
+    const float fy = std::floor((position.getY() - m_origin.getY()) * m_inverseCellSize);
+    // Also rejects NaN
+    if (!(fx >= 0.0f && fy >= 0.0f && fx < static_cast<float>(m_width) && fy < static_cast<float>(m_height))) {
+        return INVALID_CELL;
+    }
+    return cellIndex(static_cast<uint32_t>(fx), static_cast<uint32_t>(fy));
+}
+
+Vector2D NavigationGrid::cellCenter(uint32_t cell) const {
+    return Vector2D(m_origin.getX() + (static_cast<float>(cellX(cell)) + 0.5f) * m_cellSize,
+                    m_origin.getY() + (static_cast<float>(cellY(cell)) + 0.5f) * m_cellSize);
+}
+
+size_t NavigationGrid::setBlockedArea(const Vector2D& minCorner, const Vector2D& maxCorner, bool blocked) {
+    if (empty()) {
+        return 0;
+    }
+    auto clampedCell = [this](float world, float origin, uint32_t limit) {
+        const float cell = std::floor((world - origin) * m_inverseCellSize);
+        return static_cast<uint32_t>(std::clamp(cell, 0.0f, static_cast<float>(limit - 1)));
+    };
+    const float minX = std::min(minCorner.getX(), maxCorner.getX());
+    const float maxX = std::max(minCorner.getX(), maxCorner.getX());
+    const float minY = std::min(minCorner.getY(), maxCorner.getY());
+    const float maxY = std::max(minCorner.getY(), maxCorner.getY());
+    const float gridMaxX = m_origin.getX() + static_cast<float>(m_width) * m_cellSize;
+    const float gridMaxY = m_origin.getY() + static_cast<float>(m_height) * m_cellSize;
+    if (maxX < m_origin.getX() || maxY < m_origin.getY() || minX >= gridMaxX || minY >= gridMaxY) {
+        return 0;
+    }
+
+    const uint8_t value = blocked ? 1 : 0;
+    size_t changed = 0;
+    const uint32_t x0 = clampedCell(minX, m_origin.getX(), m_width);
+    const uint32_t x1 = clampedCell(maxX, m_origin.getX(), m_width);
+    const uint32_t y0 = clampedCell(minY, m_origin.getY(), m_height);
+    const uint32_t y1 = clampedCell(maxY, m_origin.getY(), m_height);
+    for (uint32_t y = y0; y <= y1; ++y) {
+        for (uint32_t x = x0; x <= x1; ++x) {
+            uint8_t& cell = m_blocked[cellIndex(x, y)];
+            changed += (cell != value) ? 1 : 0;
+            cell = value;
+        }
+    }
+    return changed;
+}
+
+uint32_t NavigationGrid::nearestWalkable(uint32_t cell, uint32_t maxRings) const {
+    if (cell >= getCellCount()) {
+        return INVALID_CELL;
+    }
+    if (!isBlocked(cell)) {
+        return cell;
+    }
+
+    const int32_t cx = static_cast<int32_t>(cellX(cell));
+    const int32_t cy = static_cast<int32_t>(cellY(cell));
+    for (int32_t ring = 1; ring <= static_cast<int32_t>(maxRings); ++ring) {
+        // Closest walkable cell on this ring's perimeter
+        uint32_t best = INVALID_CELL;
+        int32_t bestDistance = 0;
+        for (int32_t dy = -ring; dy <= ring; ++dy) {
+            const bool edgeRow = (dy == -ring || dy == ring);
+            for (int32_t dx = -ring; dx <= ring; dx += edgeRow ? 1 : 2 * ring) {
+                if (!isWalkable(cx + dx, cy + dy)) {
+                    continue;
+                }
+                const int32_t distance = dx * dx + dy * dy;
+                if (best == INVALID_CELL || distance < bestDistance) {
+                    best = cellIndex(static_cast<uint32_t>(cx + dx), static_cast<uint32_t>(cy + dy));
+                    bestDistance = distance;
+                }
+            }
+        }
+        if (best != INVALID_CELL) {
+            return best;
+        }
+    }
+    return INVALID_CELL;
+}
+
+bool NavigationGrid::hasLineOfSight(uint32_t from, uint32_t to) const {
+    int32_t x = static_cast<int32_t>(cellX(from));
+    int32_t y = static_cast<int32_t>(cellY(from));
+    const int32_t x1 = static_cast<int32_t>(cellX(to));
+    const int32_t y1 = static_cast<int32_t>(cellY(to));
+    int32_t dx = std::abs(x1 - x);
+    int32_t dy = std::abs(y1 - y);
+    const int32_t stepX = (x1 > x) ? 1 : -1;
+    const int32_t stepY = (y1 > y) ? 1 : -1;
+
+    // Supercover traversal from center to center: every cell the line enters
+    int32_t remaining = 1 + dx + dy;
+    int32_t error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+    for (; remaining > 0; --remaining) {
+        if (!isWalkable(x, y)) {
+            return false;
+        }
+        if (x == x1 && y == y1) {
+            break;
+        }
+        if (error > 0) {
+            x += stepX;
+            error -= dy;
+        } else if (error < 0) {
+            y += stepY;
+            error += dx;
+        } else {
+            // Through a corner: both cells beside it must be open
+            if (!isWalkable(x + stepX, y) || !isWalkable(x, y + stepY)) {
+                return false;
+            }
+            x += stepX;
+            y += stepY;
+            error += dx - dy;
+            --remaining;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,199 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "ai/Perception.hpp"
+#include "ai/NavigationGrid.hpp"
+#include <cmath>
+#include <vector>
+
+namespace Perception {
+
+namespace {
+constexpr float DEGREES_TO_RADIANS = 3.14159265f / 180.0f;
+constexpr size_t NO_TRACE = static_cast<size_t>(-1);
+
+// sense() trace buffers, one set per thread. Cleared on each call but keep
+// their capacity, so a worker sensing batch after batch stops allocating.
+struct TraceScratch {
+    std::vector<uint32_t> from;
+    std::vector<uint32_t> to;
+    std::vector<uint32_t> observer;
+    std::vector<uint8_t> visible;
+};
+}
+
+void traceLineOfSight(const NavigationGrid& grid, const uint32_t* fromCells, const uint32_t* toCells,
+                      size_t count, uint8_t* visible) {
+    // Per-lane state of the supercover walk in NavigationGrid::hasLineOfSight().
+    // Zeroed, and reset by start() when a lane goes idle, so the step loop
+    // only ever reads defined values.
+    alignas(32) int32_t x[LANES]{};
+    alignas(32) int32_t y[LANES]{};
+    alignas(32) int32_t endX[LANES]{};
+    alignas(32) int32_t endY[LANES]{};
+    alignas(32) int32_t stepX[LANES]{};
+    alignas(32) int32_t stepY[LANES]{};
+    alignas(32) int32_t spanX[LANES]{};      // Twice the cell distance, as in the scalar walk
+    alignas(32) int32_t spanY[LANES]{};
+    alignas(32) int32_t error[LANES]{};
+    alignas(32) int32_t remaining[LANES]{};  // Cells left to visit; <= 0 once the lane is done
+    alignas(32) int32_t open[LANES]{};       // 1 while every cell visited is walkable
+    size_t trace[LANES];
+
+    size_t next = 0;
+    size_t busy = 0;
+    auto start = [&](size_t lane) {
+        if (next == count) {
+            // Idle: no steps and no spans, so the lane stays put at zero
+            trace[lane] = NO_TRACE;
+            x[lane] = y[lane] = endX[lane] = endY[lane] = 0;
+            stepX[lane] = stepY[lane] = spanX[lane] = spanY[lane] = 0;
+            error[lane] = remaining[lane] = open[lane] = 0;
+            return;
+        }
+        trace[lane] = next;
+        x[lane] = static_cast<int32_t>(grid.cellX(fromCells[next]));
+        y[lane] = static_cast<int32_t>(grid.cellY(fromCells[next]));
+        endX[lane] = static_cast<int32_t>(grid.cellX(toCells[next]));
+        endY[lane] = static_cast<int32_t>(grid.cellY(toCells[next]));
+        const int32_t dx = std::abs(endX[lane] - x[lane]);
+        const int32_t dy = std::abs(endY[lane] - y[lane]);
+        stepX[lane] = (endX[lane] > x[lane]) ? 1 : -1;
+        stepY[lane] = (endY[lane] > y[lane]) ? 1 : -1;
+        remaining[lane] = 1 + dx + dy;
+        error[lane] = dx - dy;
+        spanX[lane] = dx * 2;
+        spanY[lane] = dy * 2;
+        open[lane] = 1;
+        ++next;
+        ++busy;
+    };
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        start(lane);
+    }
+
+    while (busy > 0) {
+        // Cell lookups are gathers; done one lane at a time
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            if (remaining[lane] <= 0) {
+                continue;
+            }
+            bool walkable = grid.isWalkable(x[lane], y[lane]);
+            const bool arrived = x[lane] == endX[lane] && y[lane] == endY[lane];
+            if (walkable && !arrived && error[lane] == 0) {
+                // Through a corner: both cells beside it must be open
+                walkable = grid.isWalkable(x[lane] + stepX[lane], y[lane]) &&
+                           grid.isWalkable(x[lane], y[lane] + stepY[lane]);
+            }
+            open[lane] = walkable ? 1 : 0;
+        }
+
+        // Step every lane at once. Branch-free, so the compiler keeps all
+        // lanes in vector registers. Idle lanes add zeros and keep remaining at 0.
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const int32_t arrived = static_cast<int32_t>(x[lane] == endX[lane]) &
+                                    static_cast<int32_t>(y[lane] == endY[lane]);
+            const int32_t alongX = static_cast<int32_t>(error[lane] > 0);
+            const int32_t alongY = static_cast<int32_t>(error[lane] < 0);
+            const int32_t diagonal = static_cast<int32_t>(error[lane] == 0);
+            x[lane] += stepX[lane] * (alongX | diagonal);
+            y[lane] += stepY[lane] * (alongY | diagonal);
+            error[lane] += alongY * spanX[lane] - alongX * spanY[lane] + diagonal * (spanX[lane] - spanY[lane]);
+            remaining[lane] = (remaining[lane] - 1 - diagonal) * (open[lane] & (arrived ^ 1));
+        }
+
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            if (trace[lane] != NO_TRACE && remaining[lane] <= 0) {
+                visible[trace[lane]] = static_cast<uint8_t>(open[lane]);
+                --busy;
+                start(lane);
+            }
+        }
+    }
+}
+
+void sense(const NavigationGrid* grid, const Vector2D& target, uint64_t timeMs,
+           std::span<const PerceptionObserver> observers, std::span<Awareness> awareness) {
+    const bool useGrid = grid && !grid->empty();
+    const uint32_t targetCell = useGrid ? grid->cellAt(target) : NavigationGrid::INVALID_CELL;
+
+    // Observers that need a sight line, traced together once the cheap
+    // tests are done
+    thread_local TraceScratch scratch;
+    std::vector<uint32_t>& traceFrom = scratch.from;
+    std::vector<uint32_t>& traceTo = scratch.to;
+    std::vector<uint32_t>& traceObserver = scratch.observer;
+    std::vector<uint8_t>& visible = scratch.visible;
+    traceFrom.clear();
+    traceTo.clear();
+    traceObserver.clear();
+
+    const PerceptionSettings* cachedSettings = nullptr;
+    float rangeSquared = 0.0f;
+    float cosHalfView = -1.0f;
+    bool seesAllRound = true;
+    for (size_t i = 0; i < observers.size(); ++i) {
+        const PerceptionObserver& observer = observers[i];
+        Awareness& entry = awareness[i];
+        if (observer.settings != cachedSettings) {
+            // Observers of one behavior come in runs; set up once per run
+            cachedSettings = observer.settings;
+            rangeSquared = cachedSettings ? cachedSettings->range * cachedSettings->range : 0.0f;
+            seesAllRound = !cachedSettings || cachedSettings->fieldOfView >= 360.0f;
+            cosHalfView = seesAllRound ? -1.0f : std::cos(cachedSettings->fieldOfView * 0.5f * DEGREES_TO_RADIANS);
+        }
+
+        const Vector2D toTarget = target - observer.position;
+        const float distanceSquared = toTarget.lengthSquared();
+        const float distance = std::sqrt(distanceSquared);
+        entry.facing = observer.facing;
+        entry.distance = distance;
+        entry.flags &= Awareness::SEEN;
+        if (!cachedSettings || distanceSquared > rangeSquared) {
+            continue;
+        }
+        entry.flags |= Awareness::IN_RANGE;
+
+        const float alignment = toTarget.getX() * observer.facing.getX() + toTarget.getY() * observer.facing.getY();
+        if (!seesAllRound && distance > 0.0f && alignment < cosHalfView * distance) {
+            continue;
+        }
+        entry.flags |= Awareness::IN_VIEW;
+
+        const uint32_t observerCell = useGrid ? grid->cellAt(observer.position) : NavigationGrid::INVALID_CELL;
+        if (cachedSettings->requireLineOfSight && observerCell != NavigationGrid::INVALID_CELL &&
+            targetCell != NavigationGrid::INVALID_CELL) {
+            traceFrom.push_back(observerCell);
+            traceTo.push_back(targetCell);
+            traceObserver.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+        entry.flags |= Awareness::VISIBLE | Awareness::SEEN;
+        entry.lastSeenPosition = target;
+        entry.lastSeenMs = timeMs;
+    }
+
+    if (traceFrom.empty()) {
+        return;
+    }
+    visible.resize(traceFrom.size());
+    traceLineOfSight(*grid, traceFrom.data(), traceTo.data(), traceFrom.size(), visible.data());
+    for (size_t t = 0; t < traceObserver.size(); ++t) {
+        if (visible[t]) {
+            Awareness& entry = awareness[traceObserver[t]];
+            entry.flags |= Awareness::VISIBLE | Awareness::SEEN;
+            entry.lastSeenPosition = target;
+            entry.lastSeenMs = timeMs;
+        }
+    }
+}
+
+void loseTarget(std::span<Awareness> awareness) {
+    for (Awareness& entry : awareness) {
+        entry.flags &= Awareness::SEEN;
+    }
+}
+
+} // namespace Perception
@@ -6,6 +6,7 @@
 #include "ai/behaviors/AttackBehavior.hpp"
 #include "managers/AIManager.hpp"
 #include <algorithm>
+#include <array>
 
 AttackBehavior::AttackBehavior(float attackRange, float attackDamage, float attackSpeed)
     : m_attackRange(attackRange)
@@ -80,33 +81,36 @@ AttackBehavior::AttackBehavior(AttackMode mode, float attackRange, float attackD
 void AttackBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    auto& state = m_entityStates[entity];
+    auto& state = m_entityStates[entity->getHandle()];
     state = EntityState(); // Reset to default state
     state.currentState = AttackState::SEEKING;
-    state.stateChangeTime = SDL_GetTicks();
+    state.stateChangeTime = AIManager::Instance().getFrameTimeMs();
     state.currentHealth = state.maxHealth;
     state.currentStamina = 100.0f;
     state.canAttack = true;
 }
 
 void AttackBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void AttackBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !isActive()) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) {
         init(entity);
-        it = m_entityStates.find(entity);
+        it = m_entityStates.find(entity->getHandle());
         if (it == m_entityStates.end()) return;
     }
 
     EntityState& state = it->second;
-    EntityPtr target = getTarget();
 
     // Update target tracking
-    if (target) {
+    if (context.player.valid) {
         state.hasTarget = true;
-        state.lastTargetPosition = target->getPosition();
-        state.targetDistance = (entity->getPosition() - target->getPosition()).length();
+        state.lastTargetPosition = context.player.position;
+        state.targetDistance = (entity->getPosition() - context.player.position).length();
 
         if (!state.inCombat && state.targetDistance <= m_attackRange * 1.2f) {
             state.inCombat = true;
@@ -118,78 +122,104 @@ void AttackBehavior::executeLogic(EntityPtr entity) {
         state.hasTarget = false;
         state.inCombat = false;
         if (state.currentState != AttackState::SEEKING) {
-            changeState(state, AttackState::SEEKING);
+            changeState(state, AttackState::SEEKING, context.timeMs);
         }
     }
 
     // Update state timer
-    updateStateTimer(state);
+    updateStateTimer(state, context.timeMs);
 
     // Check for retreat conditions
     if (shouldRetreat(state) && state.currentState != AttackState::RETREATING) {
-        changeState(state, AttackState::RETREATING);
+        changeState(state, AttackState::RETREATING, context.timeMs);
     }
 
     // Execute behavior based on attack mode
     switch (m_attackMode) {
         case AttackMode::MELEE_ATTACK:
-            updateMeleeAttack(entity, state);
+            updateMeleeAttack(entity, state, context);
             break;
         case AttackMode::RANGED_ATTACK:
-            updateRangedAttack(entity, state);
+            updateRangedAttack(entity, state, context);
             break;
         case AttackMode::CHARGE_ATTACK:
-            updateChargeAttack(entity, state);
+            updateChargeAttack(entity, state, context);
             break;
         case AttackMode::AMBUSH_ATTACK:
-            updateAmbushAttack(entity, state);
+            updateAmbushAttack(entity, state, context);
             break;
         case AttackMode::COORDINATED_ATTACK:
-            updateCoordinatedAttack(entity, state);
+            updateCoordinatedAttack(entity, state, context);
             break;
         case AttackMode::HIT_AND_RUN:
-            updateHitAndRun(entity, state);
+            updateHitAndRun(entity, state, context);
             break;
         case AttackMode::BERSERKER_ATTACK:
-            updateBerserkerAttack(entity, state);
+            updateBerserkerAttack(entity, state, context);
             break;
     }
 }
 
 void AttackBehavior::clean(EntityPtr entity) {
     if (entity) {
-        m_entityStates.erase(entity);
+        m_entityStates.erase(entity->getHandle());
     }
 }
 
-void AttackBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void AttackBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) return;
 
     EntityState& state = it->second;
+    const Uint64 currentTime = AIManager::Instance().getFrameTimeMs();
 
-    if (message == "attack_target") {
-        if (state.canAttack && state.hasTarget) {
-            changeState(state, AttackState::ATTACKING);
-        }
-    } else if (message == "retreat") {
-        changeState(state, AttackState::RETREATING);
-    } else if (message == "stop_attack") {
-        changeState(state, AttackState::SEEKING);
-        state.inCombat = false;
-    } else if (message == "enable_combo") {
-        m_comboAttacks = true;
-    } else if (message == "disable_combo") {
-        m_comboAttacks = false;
-        state.currentCombo = 0;
-    } else if (message == "heal") {
-        state.currentHealth = state.maxHealth;
-    } else if (message == "berserk") {
-        m_aggression = 1.0f;
-        m_attackSpeed *= 1.5f;
-        m_movementSpeed *= 1.3f;
+    switch (message.id) {
+        case AIMessages::ATTACK_TARGET:
+            if (state.canAttack && state.hasTarget) {
+                changeState(state, AttackState::ATTACKING, currentTime);
+            }
+            break;
+        case AIMessages::RETREAT:
+            changeState(state, AttackState::RETREATING, currentTime);
+            break;
+        case AIMessages::STOP_ATTACK:
+            changeState(state, AttackState::SEEKING, currentTime);
+            state.inCombat = false;
+            break;
+        case AIMessages::ENABLE_COMBO:
+            m_comboAttacks = true;
+            break;
+        case AIMessages::DISABLE_COMBO:
+            m_comboAttacks = false;
+            state.currentCombo = 0;
+            break;
+        case AIMessages::HEAL:
+            state.currentHealth = state.maxHealth;
+            break;
+        case AIMessages::BERSERK:
+            m_aggression = 1.0f;
+            m_attackSpeed *= 1.5f;
+            m_movementSpeed *= 1.3f;
+            break;
+        default:
+            break;
+    }
+}
+
+bool AttackBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::ATTACK_TARGET:
+        case AIMessages::RETREAT:
+        case AIMessages::STOP_ATTACK:
+        case AIMessages::ENABLE_COMBO:
+        case AIMessages::DISABLE_COMBO:
+        case AIMessages::HEAL:
+        case AIMessages::BERSERK:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -276,6 +306,10 @@ void AttackBehavior::setTeamwork(bool enabled) {
     m_teamwork = enabled;
 }
 
+void AttackBehavior::setTeamCoordinationRadius(float radius) {
+    m_teamCoordinationRadius = std::max(0.0f, radius);
+}
+
 void AttackBehavior::setAvoidFriendlyFire(bool enabled) {
     m_avoidFriendlyFire = enabled;
 }
@@ -379,6 +413,7 @@ std::shared_ptr<AIBehavior> AttackBehavior::clone() const {
     clone->m_retreatThreshold = m_retreatThreshold;
     clone->m_aggression = m_aggression;
     clone->m_teamwork = m_teamwork;
+    clone->m_teamCoordinationRadius = m_teamCoordinationRadius;
     clone->m_avoidFriendlyFire = m_avoidFriendlyFire;
     clone->m_comboAttacks = m_comboAttacks;
     clone->m_maxCombo = m_maxCombo;
@@ -403,7 +438,7 @@ bool AttackBehavior::isTargetInAttackRange(EntityPtr entity, EntityPtr target) c
     if (!entity || !target) return false;
 
     float distance = (entity->getPosition() - target->getPosition()).length();
-    return distance <= calculateEffectiveRange(m_entityStates.at(entity));
+    return distance <= calculateEffectiveRange(m_entityStates.at(entity->getHandle()));
 }
 
 bool AttackBehavior::canReachTarget(EntityPtr entity, EntityPtr target) const {
@@ -411,15 +446,15 @@ bool AttackBehavior::canReachTarget(EntityPtr entity, EntityPtr target) const {
     return isTargetInRange(entity, target);
 }
 
-float AttackBehavior::calculateDamage(const EntityState& state) const {
+float AttackBehavior::calculateDamage(const EntityState& state, AIRandom& rng) const {
     float baseDamage = m_attackDamage;
 
     // Apply damage variation
-    float variation = (m_damageRoll(m_rng) - 0.5f) * 2.0f * m_damageVariation;
+    float variation = (rng.nextFloat() - 0.5f) * 2.0f * m_damageVariation;
     baseDamage *= (1.0f + variation);
 
     // Check for critical hit
-    if (m_criticalRoll(m_rng) < m_criticalHitChance) {
+    if (rng.nextFloat() < m_criticalHitChance) {
         baseDamage *= m_criticalHitMultiplier;
     }
 
@@ -437,10 +472,9 @@ float AttackBehavior::calculateDamage(const EntityState& state) const {
     return baseDamage;
 }
 
-Vector2D AttackBehavior::calculateOptimalAttackPosition(EntityPtr entity, EntityPtr target, const EntityState& /*state*/) const {
-    if (!entity || !target) return Vector2D(0, 0);
+Vector2D AttackBehavior::calculateOptimalAttackPosition(EntityPtr entity, const Vector2D& targetPos, const EntityState& /*state*/) const {
+    if (!entity) return Vector2D(0, 0);
 
-    Vector2D targetPos = target->getPosition();
     Vector2D entityPos = entity->getPosition();
 
     // Calculate direction from target to optimal position
@@ -488,10 +522,10 @@ Vector2D AttackBehavior::calculateStrafePosition(EntityPtr entity, EntityPtr tar
     return entityPos + strafeDir * (m_movementSpeed * 2.0f);
 }
 
-void AttackBehavior::changeState(EntityState& state, AttackState newState) {
+void AttackBehavior::changeState(EntityState& state, AttackState newState, Uint64 currentTime) {
     if (state.currentState != newState) {
         state.currentState = newState;
-        state.stateChangeTime = SDL_GetTicks();
+        state.stateChangeTime = currentTime;
 
         // Reset state-specific flags
         switch (newState) {
@@ -499,7 +533,7 @@ void AttackBehavior::changeState(EntityState& state, AttackState newState) {
                 state.recoveryStartTime = 0.0f;
                 break;
             case AttackState::RECOVERING:
-                state.recoveryStartTime = static_cast<float>(SDL_GetTicks()) / 1000.0f;
+                state.recoveryStartTime = static_cast<float>(currentTime) / 1000.0f;
                 break;
             case AttackState::RETREATING:
                 state.isRetreating = true;
@@ -511,27 +545,26 @@ void AttackBehavior::changeState(EntityState& state, AttackState newState) {
     }
 }
 
-void AttackBehavior::updateStateTimer(EntityState& state) {
-    Uint64 currentTime = SDL_GetTicks();
+void AttackBehavior::updateStateTimer(EntityState& state, Uint64 currentTime) {
     Uint64 timeInState = currentTime - state.stateChangeTime;
 
     // Handle state transitions based on timing
     switch (state.currentState) {
         case AttackState::ATTACKING:
             if (timeInState > static_cast<Uint64>(1000.0f / m_attackSpeed)) {
-                changeState(state, AttackState::RECOVERING);
+                changeState(state, AttackState::RECOVERING, currentTime);
             }
             break;
 
         case AttackState::RECOVERING:
             if (timeInState > static_cast<Uint64>(m_recoveryTime * 1000)) {
-                changeState(state, AttackState::COOLDOWN);
+                changeState(state, AttackState::COOLDOWN, currentTime);
             }
             break;
 
         case AttackState::COOLDOWN:
             if (timeInState > static_cast<Uint64>(m_attackCooldown * 1000)) {
-                changeState(state, state.hasTarget ? AttackState::APPROACHING : AttackState::SEEKING);
+                changeState(state, state.hasTarget ? AttackState::APPROACHING : AttackState::SEEKING, currentTime);
             }
             break;
 
@@ -545,18 +578,19 @@ bool AttackBehavior::shouldRetreat(const EntityState& state) const {
     return healthRatio <= m_retreatThreshold && m_aggression < 0.8f;
 }
 
-bool AttackBehavior::shouldCharge(EntityPtr entity, EntityPtr target, const EntityState& state) const {
-    if (!entity || !target || m_attackMode != AttackMode::CHARGE_ATTACK) return false;
+bool AttackBehavior::shouldCharge(EntityPtr entity, const EntityState& state) const {
+    if (!entity || m_attackMode != AttackMode::CHARGE_ATTACK) return false;
 
     float distance = state.targetDistance;
     return distance > m_optimalRange * 1.5f && distance <= m_attackRange;
 }
 
-void AttackBehavior::executeAttack(EntityPtr entity, EntityPtr target, EntityState& state) {
+void AttackBehavior::executeAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime,
+                                   AIRandom& rng) {
     if (!entity || !target) return;
 
     // Calculate damage
-    float damage = calculateDamage(state);
+    float damage = calculateDamage(state, rng);
 
     // Calculate knockback
     Vector2D knockback = calculateKnockbackVector(entity, target);
@@ -566,12 +600,11 @@ void AttackBehavior::executeAttack(EntityPtr entity, EntityPtr target, EntitySta
     applyDamage(target, damage, knockback);
 
     // Update attack state
-    state.lastAttackTime = SDL_GetTicks();
+    state.lastAttackTime = currentTime;
     state.lastAttackHit = true; // Simplified - assume all attacks hit
 
     // Handle combo system
     if (m_comboAttacks) {
-        Uint64 currentTime = SDL_GetTicks();
         if (currentTime - state.comboStartTime < COMBO_TIMEOUT) {
             state.currentCombo = std::min(state.currentCombo + 1, m_maxCombo);
         } else {
@@ -586,26 +619,28 @@ void AttackBehavior::executeAttack(EntityPtr entity, EntityPtr target, EntitySta
     }
 }
 
-void AttackBehavior::executeSpecialAttack(EntityPtr entity, EntityPtr target, EntityState& state) {
+void AttackBehavior::executeSpecialAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime,
+                                          AIRandom& rng) {
     // Enhanced attack with special effects
-    float specialDamage = calculateDamage(state) * 1.5f;
+    float specialDamage = calculateDamage(state, rng) * 1.5f;
     Vector2D knockback = calculateKnockbackVector(entity, target) * (m_knockbackForce * 1.5f);
 
     applyDamage(target, specialDamage, knockback);
 
-    state.lastAttackTime = SDL_GetTicks();
+    state.lastAttackTime = currentTime;
     state.specialAttackReady = false;
 }
 
-void AttackBehavior::executeComboAttack(EntityPtr entity, EntityPtr target, EntityState& state) {
+void AttackBehavior::executeComboAttack(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime,
+                                        AIRandom& rng) {
     if (!m_comboAttacks || state.currentCombo == 0) {
-        executeAttack(entity, target, state);
+        executeAttack(entity, target, state, currentTime, rng);
         return;
     }
 
     // Combo finisher
     if (state.currentCombo >= m_maxCombo) {
-        float comboDamage = calculateDamage(state) * 2.0f;
+        float comboDamage = calculateDamage(state, rng) * 2.0f;
         Vector2D knockback = calculateKnockbackVector(entity, target) * (m_knockbackForce * 2.0f);
 
         applyDamage(target, comboDamage, knockback);
@@ -614,7 +649,7 @@ void AttackBehavior::executeComboAttack(EntityPtr entity, EntityPtr target, Enti
         state.currentCombo = 0;
         state.comboStartTime = 0;
     } else {
-        executeAttack(entity, target, state);
+        executeAttack(entity, target, state, currentTime, rng);
     }
 }
 
@@ -635,28 +670,27 @@ void AttackBehavior::applyAreaOfEffectDamage(EntityPtr /*entity*/, EntityPtr /*t
     // and apply damage to them
 }
 
-void AttackBehavior::updateMeleeAttack(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateMeleeAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
     switch (state.currentState) {
         case AttackState::SEEKING:
-            updateSeeking(entity, state);
+            updateSeeking(entity, state, context);
             break;
         case AttackState::APPROACHING:
-            updateApproaching(entity, state);
+            updateApproaching(entity, state, context);
             break;
         case AttackState::POSITIONING:
-            updatePositioning(entity, state);
+            updatePositioning(entity, state, context);
             break;
         case AttackState::ATTACKING:
-            updateAttacking(entity, state);
+            updateAttacking(entity, state, context);
             break;
         case AttackState::RECOVERING:
             updateRecovering(entity, state);
             break;
         case AttackState::RETREATING:
-            updateRetreating(entity, state);
+            updateRetreating(entity, state, context);
             break;
         case AttackState::COOLDOWN:
             updateCooldown(entity, state);
@@ -664,125 +698,125 @@ void AttackBehavior::updateMeleeAttack(EntityPtr entity, EntityState& state) {
     }
 }
 
-void AttackBehavior::updateRangedAttack(EntityPtr entity, EntityState& state) {
+void AttackBehavior::updateRangedAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
     // Similar to melee but with different positioning logic
-    updateMeleeAttack(entity, state);
+    updateMeleeAttack(entity, state, context);
 }
 
-void AttackBehavior::updateChargeAttack(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateChargeAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
-    if (shouldCharge(entity, target, state) && !state.isCharging) {
+    if (shouldCharge(entity, state) && !state.isCharging) {
         state.isCharging = true;
-        state.attackChargeTime = static_cast<float>(SDL_GetTicks()) / 1000.0f;
+        state.attackChargeTime = static_cast<float>(context.timeMs) / 1000.0f;
     }
 
     if (state.isCharging) {
         // Charge towards target at high speed
-        moveToPosition(entity, target->getPosition(), m_movementSpeed * CHARGE_SPEED_MULTIPLIER);
+        moveToPosition(entity, context.player.position, m_movementSpeed * CHARGE_SPEED_MULTIPLIER);
 
         // Check if charge is complete or target reached
         if (state.targetDistance <= m_minimumRange) {
-            executeAttack(entity, target, state);
+            // Only landing a hit needs the player itself
+            AIRandom rng(context, entity->getHandle(), STREAM_ATTACK);
+            executeAttack(entity, getTarget(), state, context.timeMs, rng);
             state.isCharging = false;
-            changeState(state, AttackState::RECOVERING);
+            changeState(state, AttackState::RECOVERING, context.timeMs);
         }
     } else {
-        updateMeleeAttack(entity, state);
+        updateMeleeAttack(entity, state, context);
     }
 }
 
-void AttackBehavior::updateAmbushAttack(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateAmbushAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
     // Wait for optimal moment to strike
     if (state.currentState == AttackState::POSITIONING && state.targetDistance <= m_optimalRange) {
         // Ambush when target is close
-        executeAttack(entity, target, state);
-        changeState(state, AttackState::RECOVERING);
+        AIRandom rng(context, entity->getHandle(), STREAM_ATTACK);
+        executeAttack(entity, getTarget(), state, context.timeMs, rng);
+        changeState(state, AttackState::RECOVERING, context.timeMs);
     } else {
-        updateMeleeAttack(entity, state);
+        updateMeleeAttack(entity, state, context);
     }
 }
 
-void AttackBehavior::updateCoordinatedAttack(EntityPtr entity, EntityState& state) {
+void AttackBehavior::updateCoordinatedAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
     if (m_teamwork) {
         coordinateWithTeam(entity, state);
     }
-    updateMeleeAttack(entity, state);
+    updateMeleeAttack(entity, state, context);
 }
 
-void AttackBehavior::updateHitAndRun(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateHitAndRun(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
     // After attacking, immediately retreat
     if (state.currentState == AttackState::RECOVERING) {
-        changeState(state, AttackState::RETREATING);
+        changeState(state, AttackState::RETREATING, context.timeMs);
     }
 
-    updateMeleeAttack(entity, state);
+    updateMeleeAttack(entity, state, context);
 }
 
-void AttackBehavior::updateBerserkerAttack(EntityPtr entity, EntityState& state) {
+void AttackBehavior::updateBerserkerAttack(EntityPtr entity, EntityState& state, const FrameContext& context) {
     // Aggressive continuous attacks with reduced cooldown
     if (state.currentState == AttackState::COOLDOWN) {
-        Uint64 timeInState = SDL_GetTicks() - state.stateChangeTime;
+        Uint64 timeInState = context.timeMs - state.stateChangeTime;
         if (timeInState > static_cast<Uint64>(m_attackCooldown * 500)) { // Half cooldown
-            changeState(state, AttackState::APPROACHING);
+            changeState(state, AttackState::APPROACHING, context.timeMs);
         }
     }
 
-    updateMeleeAttack(entity, state);
+    updateMeleeAttack(entity, state, context);
 }
 
-void AttackBehavior::updateSeeking(EntityPtr /*entity*/, EntityState& state) {
+void AttackBehavior::updateSeeking(EntityPtr /*entity*/, EntityState& state, const FrameContext& context) {
     if (state.hasTarget && state.targetDistance <= m_attackRange * 1.5f) {
-        changeState(state, AttackState::APPROACHING);
+        changeState(state, AttackState::APPROACHING, context.timeMs);
     }
 }
 
-void AttackBehavior::updateApproaching(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateApproaching(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
     if (state.targetDistance <= m_optimalRange) {
-        changeState(state, AttackState::POSITIONING);
+        changeState(state, AttackState::POSITIONING, context.timeMs);
     } else {
-        moveToPosition(entity, target->getPosition(), m_movementSpeed);
+        moveToPosition(entity, context.player.position, m_movementSpeed);
     }
 }
 
-void AttackBehavior::updatePositioning(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updatePositioning(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
-    Vector2D optimalPos = calculateOptimalAttackPosition(entity, target, state);
+    Vector2D optimalPos = calculateOptimalAttackPosition(entity, context.player.position, state);
     Vector2D currentPos = entity->getPosition();
 
     if ((currentPos - optimalPos).length() > 15.0f) {
         moveToPosition(entity, optimalPos, m_movementSpeed);
     } else if (state.canAttack) {
-        changeState(state, AttackState::ATTACKING);
+        changeState(state, AttackState::ATTACKING, context.timeMs);
     }
 }
 
-void AttackBehavior::updateAttacking(EntityPtr entity, EntityState& state) {
+void AttackBehavior::updateAttacking(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    // Only landing a hit needs the player itself
     EntityPtr target = getTarget();
     if (!target) return;
 
     // Execute the attack
-    if (m_specialRoll(m_rng) < m_specialAttackChance && state.specialAttackReady) {
-        executeSpecialAttack(entity, target, state);
+    AIRandom rng(context, entity->getHandle(), STREAM_ATTACK);
+    if (rng.nextFloat() < m_specialAttackChance && state.specialAttackReady) {
+        executeSpecialAttack(entity, target, state, context.timeMs, rng);
     } else if (m_comboAttacks) {
-        executeComboAttack(entity, target, state);
+        executeComboAttack(entity, target, state, context.timeMs, rng);
     } else {
-        executeAttack(entity, target, state);
+        executeAttack(entity, target, state, context.timeMs, rng);
     }
 
-    changeState(state, AttackState::RECOVERING);
+    changeState(state, AttackState::RECOVERING, context.timeMs);
 }
 
 void AttackBehavior::updateRecovering(EntityPtr /*entity*/, EntityState& /*state*/) {
@@ -790,13 +824,12 @@ void AttackBehavior::updateRecovering(EntityPtr /*entity*/, EntityState& /*state
     // State transition handled by updateStateTimer
 }
 
-void AttackBehavior::updateRetreating(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
+void AttackBehavior::updateRetreating(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (!context.player.valid) return;
 
     // Move away from target
     Vector2D entityPos = entity->getPosition();
-    Vector2D targetPos = target->getPosition();
+    const Vector2D& targetPos = context.player.position;
     Vector2D retreatDir = normalizeDirection(entityPos - targetPos);
 
     Vector2D retreatVelocity = retreatDir * (m_movementSpeed * RETREAT_SPEED_MULTIPLIER);
@@ -805,7 +838,7 @@ void AttackBehavior::updateRetreating(EntityPtr entity, EntityState& state) {
     // Stop retreating if far enough or health recovered
     if (state.targetDistance > m_attackRange * 2.0f || !shouldRetreat(state)) {
         state.isRetreating = false;
-        changeState(state, AttackState::SEEKING);
+        changeState(state, AttackState::SEEKING, context.timeMs);
     }
 }
 
@@ -840,10 +873,9 @@ void AttackBehavior::maintainDistance(EntityPtr entity, EntityPtr target, float
     }
 }
 
-void AttackBehavior::circleStrafe(EntityPtr entity, EntityPtr target, EntityState& state) {
+void AttackBehavior::circleStrafe(EntityPtr entity, EntityPtr target, EntityState& state, Uint64 currentTime) {
     if (!entity || !target || !m_circleStrafe) return;
 
-    Uint64 currentTime = SDL_GetTicks();
     if (currentTime >= state.nextStrafeTime) {
         state.strafeDirectionInt *= -1; // Change direction
         state.nextStrafeTime = currentTime + STRAFE_INTERVAL;
@@ -940,11 +972,12 @@ Vector2D AttackBehavior::calculateKnockbackVector(EntityPtr attacker, EntityPtr
     return normalizeDirection(targetPos - attackerPos);
 }
 
-void AttackBehavior::coordinateWithTeam(EntityPtr /*entity*/, const EntityState& state) {
+void AttackBehavior::coordinateWithTeam(EntityPtr entity, const EntityState& state) {
     // In a full implementation, this would coordinate with nearby allies
     // For now, we just broadcast coordination messages
-    if (state.inCombat && state.hasTarget) {
-        AIManager::Instance().broadcastMessage("coordinate_attack", false);
+    if (entity && state.inCombat && state.hasTarget) {
+        AIManager::Instance().broadcastInRadius(entity->getPosition(), m_teamCoordinationRadius,
+            AIMessage(AIMessages::COORDINATE_ATTACK, entity->getHandle(), state.lastTargetPosition));
     }
 }
 
@@ -956,8 +989,20 @@ bool AttackBehavior::isFriendlyFireRisk(EntityPtr /*entity*/, EntityPtr /*target
     return false;
 }
 
-std::vector<EntityPtr> AttackBehavior::getNearbyAllies(EntityPtr /*entity*/, float /*radius*/) const {
-    // In a full implementation, this would query the entity system for nearby allies
-    // For now, return empty vector
-    return std::vector<EntityPtr>();
+std::vector<EntityPtr> AttackBehavior::getNearbyAllies(EntityPtr entity, float radius) const {
+    std::vector<EntityPtr> allies;
+    if (!entity) return allies;
+
+    // Other AI-managed entities from AIManager's spatial grid
+    AIManager& aiManager = AIManager::Instance();
+    std::array<uint32_t, MAX_NEARBY_ALLIES + 1> indices;
+    size_t found = aiManager.queryEntitiesInRadius(entity->getPosition(), radius, indices.data(), indices.size());
+    allies.reserve(found);
+    for (size_t i = 0; i < found && allies.size() < MAX_NEARBY_ALLIES; ++i) {
+        EntityPtr ally = aiManager.getSpatialEntity(indices[i]);
+        if (ally && ally != entity) {
+            allies.push_back(ally);
+        }
+    }
+    return allies;
 }
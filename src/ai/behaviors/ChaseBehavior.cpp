@@ -5,6 +5,7 @@
 
 #include "ai/behaviors/ChaseBehavior.hpp"
 #include "managers/AIManager.hpp"
+#include "ai/FlowField.hpp"
 
 ChaseBehavior::ChaseBehavior(float chaseSpeed, float maxRange, float minRange)
     : m_chaseSpeed(chaseSpeed), 
@@ -36,21 +37,21 @@ void ChaseBehavior::init(EntityPtr entity) {
         float distance = (targetPos - entityPos).length();
 
         m_isChasing = (distance <= m_maxRange);
-        m_hasLineOfSight = checkLineOfSight(entity, target);
+        m_hasLineOfSight = checkLineOfSight(entity, targetPos);
     }
 }
 
 void ChaseBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void ChaseBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !m_active) {
         return;
     }
     
-    // Cache AIManager reference for better performance
-    const AIManager& aiMgr = AIManager::Instance();
-    
-    // Get player target from AIManager
-    auto target = aiMgr.getPlayerReference();
-    if (!target) {
+    // The player as of this frame
+    if (!context.player.valid) {
         // No target, stop chasing efficiently
         if (m_isChasing) {
             entity->setVelocity(Vector2D(0, 0));
@@ -61,7 +62,7 @@ void ChaseBehavior::executeLogic(EntityPtr entity) {
 
     // Get positions
     Vector2D entityPos = entity->getPosition();
-    Vector2D targetPos = target->getPosition();
+    const Vector2D& targetPos = context.player.position;
 
     // Pre-calculate squared distances for efficiency
     Vector2D toTarget = targetPos - entityPos;
@@ -74,13 +75,18 @@ void ChaseBehavior::executeLogic(EntityPtr entity) {
 
     // Fast range check using squared distance
     if (distanceSquared <= maxRangeSquared) {
-        m_hasLineOfSight = checkLineOfSight(entity, target);
+        m_hasLineOfSight = checkLineOfSight(entity, targetPos);
 
         if (m_hasLineOfSight) {
             if (distanceSquared > minRangeSquared) {
                 // Only calculate sqrt and normalize when actually moving
                 float invDistance = 1.0f / std::sqrt(distanceSquared);
                 Vector2D direction = toTarget * invDistance;
+
+                // Around obstacles along the shared field; straight in the player's own cell
+                if (context.playerField) {
+                    context.playerField->sampleToward(entityPos, direction);
+                }
                 
                 m_isChasing = true;
                 entity->setVelocity(direction * m_chaseSpeed);
@@ -122,36 +128,53 @@ void ChaseBehavior::clean(EntityPtr entity) {
     m_timeWithoutSight = 0;
 }
 
-void ChaseBehavior::onMessage(EntityPtr entity, const std::string& message) {
-    if (message == "pause") {
-        setActive(false);
-        if (entity) {
-            entity->setVelocity(Vector2D(0, 0));
-        }
-    } else if (message == "resume") {
-        setActive(true);
-        // Cache AIManager reference for better performance
-        const AIManager& aiMgr = AIManager::Instance();
-        
-        // Reinitialize chase state when resuming
-        if (entity && aiMgr.isPlayerValid()) {
-            init(entity);
-        }
-    } else if (message == "lose_target") {
-        m_isChasing = false;
-        m_hasLineOfSight = false;
-        if (entity) {
-            entity->setVelocity(Vector2D(0, 0));
-        }
-    } else if (message == "release_entities") {
-        // Reset state when asked to release entities
-        m_isChasing = false;
-        m_hasLineOfSight = false;
-        m_lastKnownTargetPos = Vector2D(0, 0);
-        m_timeWithoutSight = 0;
-        if (entity) {
-            entity->setVelocity(Vector2D(0, 0));
-        }
+void ChaseBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
+    switch (message.id) {
+        case AIMessages::PAUSE:
+            setActive(false);
+            if (entity) {
+                entity->setVelocity(Vector2D(0, 0));
+            }
+            break;
+        case AIMessages::RESUME:
+            // The chase is picked up again from the frame's player at the next
+            // update. Messages arrive with AIManager's entity lock held, so
+            // nothing here may ask AIManager for the player.
+            setActive(true);
+            m_isChasing = false;
+            m_hasLineOfSight = false;
+            break;
+        case AIMessages::LOSE_TARGET:
+            m_isChasing = false;
+            m_hasLineOfSight = false;
+            if (entity) {
+                entity->setVelocity(Vector2D(0, 0));
+            }
+            break;
+        case AIMessages::RELEASE_ENTITIES:
+            // Reset state when asked to release entities
+            m_isChasing = false;
+            m_hasLineOfSight = false;
+            m_lastKnownTargetPos = Vector2D(0, 0);
+            m_timeWithoutSight = 0;
+            if (entity) {
+                entity->setVelocity(Vector2D(0, 0));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool ChaseBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::PAUSE:
+        case AIMessages::RESUME:
+        case AIMessages::LOSE_TARGET:
+        case AIMessages::RELEASE_ENTITIES:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -206,13 +229,12 @@ void ChaseBehavior::onTargetLost(EntityPtr entity) {
     (void)entity; // Mark parameter as intentionally unused
 }
 
-bool ChaseBehavior::checkLineOfSight(EntityPtr entity, EntityPtr target) const {
+bool ChaseBehavior::checkLineOfSight(EntityPtr entity, const Vector2D& targetPos) const {
     // For a more complex implementation, you would do raycasting here
     // This simplified version just checks distance
-    if (!entity || !target) return false;
+    if (!entity) return false;
 
     Vector2D entityPos = entity->getPosition();
-    Vector2D targetPos = target->getPosition();
     float distance = (targetPos - entityPos).length();
 
     // Always report in range for testing purposes
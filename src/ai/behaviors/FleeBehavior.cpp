@@ -5,9 +5,17 @@
 
 #include "ai/behaviors/FleeBehavior.hpp"
 #include "managers/AIManager.hpp"
+#include "ai/FlowField.hpp"
 #include <cmath>
 #include <algorithm>
 
+namespace {
+
+// AIRandom stream for per-frame flee decisions
+constexpr uint16_t STREAM_UPDATE = 1;
+
+} // namespace
+
 FleeBehavior::FleeBehavior(float fleeSpeed, float detectionRange, float safeDistance)
     : m_fleeSpeed(fleeSpeed)
     , m_detectionRange(detectionRange)
@@ -42,25 +50,28 @@ FleeBehavior::FleeBehavior(FleeMode mode, float fleeSpeed, float detectionRange)
 void FleeBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    auto& state = m_entityStates[entity];
+    auto& state = m_entityStates[entity->getHandle()];
     state = EntityState(); // Reset to default state
     state.currentStamina = m_maxStamina;
 }
 
 void FleeBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void FleeBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !isActive()) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) {
         init(entity);
-        it = m_entityStates.find(entity);
+        it = m_entityStates.find(entity->getHandle());
         if (it == m_entityStates.end()) return;
     }
 
     EntityState& state = it->second;
-    EntityPtr threat = getThreat();
     
-    if (!threat) {
+    if (!context.player.valid) {
         // No threat detected, stop fleeing and recover stamina
         if (state.isFleeing) {
             state.isFleeing = false;
@@ -69,34 +80,37 @@ void FleeBehavior::executeLogic(EntityPtr entity) {
         }
         
         if (m_useStamina) {
-            updateStamina(state, 0.016f, false); // Assume ~60 FPS
+            updateStamina(state, context.deltaTime, false);
         }
         return;
     }
 
     // Check if threat is in detection range
-    bool threatInRange = isThreatInRange(entity, threat);
-    Uint64 currentTime = SDL_GetTicks();
+    const Vector2D& threatPos = context.player.position;
+    bool threatInRange = context.awareness ? context.awareness->inRange() : isThreatInRange(entity, threatPos);
+    const Uint64 currentTime = context.timeMs;
+    AIRandom rng(context, entity->getHandle(), STREAM_UPDATE);
     
     if (threatInRange) {
         // Start fleeing if not already
         if (!state.isFleeing) {
             state.isFleeing = true;
             state.fleeStartTime = currentTime;
-            state.lastThreatPosition = threat->getPosition();
+            state.lastThreatPosition = threatPos;
             
             // Determine if this should trigger panic
             if (m_fleeMode == FleeMode::PANIC_FLEE) {
                 state.isInPanic = true;
-                state.panicEndTime = currentTime + static_cast<Uint64>(m_panicDuration * m_panicVariation(m_rng));
+                state.panicEndTime = currentTime + static_cast<Uint64>(m_panicDuration * rng.range(0.8f, 1.2f));
             }
         }
         
         state.hasValidThreat = true;
-        state.lastThreatPosition = threat->getPosition();
+        state.lastThreatPosition = threatPos;
     } else if (state.isFleeing) {
         // Check if we're at safe distance
-        float distanceToThreat = (entity->getPosition() - threat->getPosition()).length();
+        float distanceToThreat = context.awareness ? context.awareness->distance
+                                                   : (entity->getPosition() - threatPos).length();
         if (distanceToThreat >= m_safeDistance) {
             state.isFleeing = false;
             state.isInPanic = false;
@@ -113,50 +127,69 @@ void FleeBehavior::executeLogic(EntityPtr entity) {
     if (state.isFleeing) {
         switch (m_fleeMode) {
             case FleeMode::PANIC_FLEE:
-                updatePanicFlee(entity, state);
+                updatePanicFlee(entity, state, context, rng);
                 break;
             case FleeMode::STRATEGIC_RETREAT:
-                updateStrategicRetreat(entity, state);
+                updateStrategicRetreat(entity, state, context, rng);
                 break;
             case FleeMode::EVASIVE_MANEUVER:
-                updateEvasiveManeuver(entity, state);
+                updateEvasiveManeuver(entity, state, context, rng);
                 break;
             case FleeMode::SEEK_COVER:
-                updateSeekCover(entity, state);
+                updateSeekCover(entity, state, context, rng);
                 break;
         }
         
         if (m_useStamina) {
-            updateStamina(state, 0.016f, true);
+            updateStamina(state, context.deltaTime, true);
         }
     }
 }
 
 void FleeBehavior::clean(EntityPtr entity) {
     if (entity) {
-        m_entityStates.erase(entity);
+        m_entityStates.erase(entity->getHandle());
     }
 }
 
-void FleeBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void FleeBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) return;
 
     EntityState& state = it->second;
 
-    if (message == "panic") {
-        state.isInPanic = true;
-        state.panicEndTime = SDL_GetTicks() + static_cast<Uint64>(m_panicDuration);
-    } else if (message == "calm_down") {
-        state.isInPanic = false;
-    } else if (message == "stop_fleeing") {
-        state.isFleeing = false;
-        state.isInPanic = false;
-        state.hasValidThreat = false;
-    } else if (message == "recover_stamina") {
-        state.currentStamina = m_maxStamina;
+    switch (message.id) {
+        case AIMessages::PANIC:
+            state.isInPanic = true;
+            state.panicEndTime = AIManager::Instance().getFrameTimeMs() + static_cast<Uint64>(m_panicDuration);
+            break;
+        case AIMessages::CALM_DOWN:
+            state.isInPanic = false;
+            break;
+        case AIMessages::STOP_FLEEING:
+            state.isFleeing = false;
+            state.isInPanic = false;
+            state.hasValidThreat = false;
+            break;
+        case AIMessages::RECOVER_STAMINA:
+            state.currentStamina = m_maxStamina;
+            break;
+        default:
+            break;
+    }
+}
+
+bool FleeBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::PANIC:
+        case AIMessages::CALM_DOWN:
+        case AIMessages::STOP_FLEEING:
+        case AIMessages::RECOVER_STAMINA:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -226,7 +259,9 @@ float FleeBehavior::getDistanceToThreat() const {
     // Return distance for first fleeing entity found
     for (const auto& pair : m_entityStates) {
         if (pair.second.isFleeing) {
-            return (pair.first->getPosition() - threat->getPosition()).length();
+            if (EntityPtr entity = EntityRegistry::Instance().resolve(pair.first)) {
+                return (entity->getPosition() - threat->getPosition()).length();
+            }
         }
     }
     return -1.0f;
@@ -253,21 +288,35 @@ EntityPtr FleeBehavior::getThreat() const {
     return AIManager::Instance().getPlayerReference();
 }
 
-bool FleeBehavior::isThreatInRange(EntityPtr entity, EntityPtr threat) const {
-    if (!entity || !threat) return false;
+bool FleeBehavior::getPerceptionSettings(PerceptionSettings& settings) const {
+    // Fleeing starts on range alone: no view cone, no sight line
+    settings.range = m_detectionRange;
+    settings.fieldOfView = 360.0f;
+    settings.requireLineOfSight = false;
+    return true;
+}
+
+bool FleeBehavior::isThreatInRange(EntityPtr entity, const Vector2D& threatPos) const {
+    if (!entity) return false;
     
-    float distance = (entity->getPosition() - threat->getPosition()).length();
+    float distance = (entity->getPosition() - threatPos).length();
     return distance <= m_detectionRange;
 }
 
-Vector2D FleeBehavior::calculateFleeDirection(EntityPtr entity, EntityPtr threat, const EntityState& state) {
-    if (!entity || !threat) return Vector2D(0, 0);
+Vector2D FleeBehavior::calculateFleeDirection(EntityPtr entity, const FrameContext& context, const EntityState& state,
+                                              AIRandom& rng) {
+    if (!entity) return Vector2D(0, 0);
     
     Vector2D entityPos = entity->getPosition();
-    Vector2D threatPos = threat->getPosition();
     
     // Basic flee direction (away from threat)
-    Vector2D fleeDir = entityPos - threatPos;
+    Vector2D fleeDir = entityPos - context.player.position;
+
+    // Down corridors rather than into walls; falls back where the field has
+    // no farther cell, such as in a dead end
+    if (context.playerField) {
+        context.playerField->sampleAway(entityPos, fleeDir);
+    }
     
     if (fleeDir.length() < 0.001f) {
         // If too close, use last known direction or random
@@ -275,7 +324,7 @@ Vector2D FleeBehavior::calculateFleeDirection(EntityPtr entity, EntityPtr threat
             fleeDir = state.fleeDirection;
         } else {
             // Random direction
-            float angle = m_angleVariation(m_rng) * 2.0f * M_PI;
+            float angle = rng.range(-0.5f, 0.5f) * 2.0f * M_PI;
             fleeDir = Vector2D(std::cos(angle), std::sin(angle));
         }
     }
@@ -337,19 +386,18 @@ Vector2D FleeBehavior::avoidBoundaries(const Vector2D& position, const Vector2D&
     return adjustedDir;
 }
 
-void FleeBehavior::updatePanicFlee(EntityPtr entity, EntityState& state) {
-    EntityPtr threat = getThreat();
-    if (!threat) return;
+void FleeBehavior::updatePanicFlee(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng) {
+    if (!context.player.valid) return;
     
     Vector2D currentPos = entity->getPosition();
-    Uint64 currentTime = SDL_GetTicks();
+    const Uint64 currentTime = context.timeMs;
     
     // In panic mode, change direction more frequently
     if (currentTime - state.lastDirectionChange > 200 || state.fleeDirection.length() < 0.001f) {
-        state.fleeDirection = calculateFleeDirection(entity, threat, state);
+        state.fleeDirection = calculateFleeDirection(entity, context, state, rng);
         
         // Add some randomness to panic movement
-        float randomAngle = m_angleVariation(m_rng);
+        float randomAngle = rng.range(-0.5f, 0.5f);
         float cos_a = std::cos(randomAngle);
         float sin_a = std::sin(randomAngle);
         
@@ -367,16 +415,15 @@ void FleeBehavior::updatePanicFlee(EntityPtr entity, EntityState& state) {
     entity->setVelocity(velocity);
 }
 
-void FleeBehavior::updateStrategicRetreat(EntityPtr entity, EntityState& state) {
-    EntityPtr threat = getThreat();
-    if (!threat) return;
+void FleeBehavior::updateStrategicRetreat(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng) {
+    if (!context.player.valid) return;
     
     Vector2D currentPos = entity->getPosition();
-    Uint64 currentTime = SDL_GetTicks();
+    const Uint64 currentTime = context.timeMs;
     
     // Strategic retreat: plan a good escape route
     if (currentTime - state.lastDirectionChange > 1000 || state.fleeDirection.length() < 0.001f) {
-        state.fleeDirection = calculateFleeDirection(entity, threat, state);
+        state.fleeDirection = calculateFleeDirection(entity, context, state, rng);
         
         // Look for safe zones
         Vector2D safeZoneDirection = findNearestSafeZone(currentPos);
@@ -394,12 +441,11 @@ void FleeBehavior::updateStrategicRetreat(EntityPtr entity, EntityState& state)
     entity->setVelocity(velocity);
 }
 
-void FleeBehavior::updateEvasiveManeuver(EntityPtr entity, EntityState& state) {
-    EntityPtr threat = getThreat();
-    if (!threat) return;
+void FleeBehavior::updateEvasiveManeuver(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng) {
+    if (!context.player.valid) return;
     
     Vector2D currentPos = entity->getPosition();
-    Uint64 currentTime = SDL_GetTicks();
+    const Uint64 currentTime = context.timeMs;
     
     // Zigzag pattern
     if (currentTime - state.lastZigzagTime > m_zigzagInterval) {
@@ -408,7 +454,7 @@ void FleeBehavior::updateEvasiveManeuver(EntityPtr entity, EntityState& state) {
     }
     
     // Base flee direction
-    Vector2D baseFleeDir = calculateFleeDirection(entity, threat, state);
+    Vector2D baseFleeDir = calculateFleeDirection(entity, context, state, rng);
     
     // Apply zigzag
     float zigzagAngleRad = (m_zigzagAngle * M_PI / 180.0f) * state.zigzagDirection;
@@ -427,7 +473,7 @@ void FleeBehavior::updateEvasiveManeuver(EntityPtr entity, EntityState& state) {
     entity->setVelocity(velocity);
 }
 
-void FleeBehavior::updateSeekCover(EntityPtr entity, EntityState& state) {
+void FleeBehavior::updateSeekCover(EntityPtr entity, EntityState& state, const FrameContext& context, AIRandom& rng) {
     Vector2D currentPos = entity->getPosition();
     
     // Prioritize moving to safe zones
@@ -437,9 +483,8 @@ void FleeBehavior::updateSeekCover(EntityPtr entity, EntityState& state) {
         state.fleeDirection = normalizeVector(safeZoneDirection);
     } else {
         // No safe zones, use regular flee behavior
-        EntityPtr threat = getThreat();
-        if (threat) {
-            state.fleeDirection = calculateFleeDirection(entity, threat, state);
+        if (context.player.valid) {
+            state.fleeDirection = calculateFleeDirection(entity, context, state, rng);
         }
     }
     float speedModifier = calculateFleeSpeedModifier(state);
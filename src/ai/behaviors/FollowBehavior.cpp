@@ -5,27 +5,22 @@
 
 #include "ai/behaviors/FollowBehavior.hpp"
 #include "managers/AIManager.hpp"
+#include "managers/FormationManager.hpp"
 #include <cmath>
 #include <algorithm>
-
-// Static member initialization
-int FollowBehavior::s_nextFormationSlot = 0;
-std::vector<Vector2D> FollowBehavior::s_escortFormationOffsets;
+#include <array>
 
 FollowBehavior::FollowBehavior(float followSpeed, float followDistance, float maxDistance)
     : m_followSpeed(followSpeed)
     , m_followDistance(followDistance)
     , m_maxDistance(maxDistance)
 {
-    initializeFormationOffsets();
 }
 
 FollowBehavior::FollowBehavior(FollowMode mode, float followSpeed)
     : m_followMode(mode)
     , m_followSpeed(followSpeed)
 {
-    initializeFormationOffsets();
-    
     // Adjust parameters based on mode
     switch (mode) {
         case FollowMode::CLOSE_FOLLOW:
@@ -59,7 +54,8 @@ FollowBehavior::FollowBehavior(FollowMode mode, float followSpeed)
 void FollowBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    auto& state = m_entityStates[entity];
+    auto& state = m_entityStates[entity->getHandle()];
+    leaveFormation(entity->getHandle(), state);
     state = EntityState(); // Reset to default state
     
     EntityPtr target = getTarget();
@@ -69,10 +65,12 @@ void FollowBehavior::init(EntityPtr entity) {
         state.isFollowing = true;
     }
     
-    // Assign formation slot for escort formation
+    // Escorts take a slot in the target's formation; without a target yet
+    // they join on the first frame that has one
     if (m_followMode == FollowMode::ESCORT_FORMATION) {
-        state.formationSlot = assignFormationSlot();
-        state.formationOffset = calculateFormationOffset(state);
+        if (target) {
+            joinFormation(entity->getHandle(), state, target->getHandle());
+        }
         state.inFormation = true;
     } else {
         state.formationOffset = m_formationOffset;
@@ -80,31 +78,40 @@ void FollowBehavior::init(EntityPtr entity) {
 }
 
 void FollowBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void FollowBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !isActive()) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) {
         init(entity);
-        it = m_entityStates.find(entity);
+        it = m_entityStates.find(entity->getHandle());
         if (it == m_entityStates.end()) return;
     }
 
     EntityState& state = it->second;
-    EntityPtr target = getTarget();
     
-    if (!target) {
+    if (!context.player.valid) {
         // No target, stop following
         state.isFollowing = false;
         return;
     }
 
+    // Rejoin when the target changes, so the slot belongs to its formation
+    if (m_followMode == FollowMode::ESCORT_FORMATION && state.formationLeader != context.player.handle) {
+        leaveFormation(entity->getHandle(), state);
+        joinFormation(entity->getHandle(), state, context.player.handle);
+    }
+
     Vector2D currentPos = entity->getPosition();
-    Vector2D targetPos = target->getPosition();
+    const Vector2D& targetPos = context.player.position;
     float distanceToTarget = (currentPos - targetPos).length();
     
     // Update target movement tracking
-    Uint64 currentTime = SDL_GetTicks();
-    bool targetMoved = isTargetMoving(target, state);
+    const Uint64 currentTime = context.timeMs;
+    bool targetMoved = isTargetMoving(targetPos, state);
     
     if (targetMoved) {
         state.lastTargetMoveTime = currentTime;
@@ -133,19 +140,19 @@ void FollowBehavior::executeLogic(EntityPtr entity) {
         // Execute appropriate follow behavior based on mode
         switch (m_followMode) {
             case FollowMode::CLOSE_FOLLOW:
-                updateCloseFollow(entity, state);
+                updateCloseFollow(entity, state, targetPos);
                 break;
             case FollowMode::LOOSE_FOLLOW:
-                updateLooseFollow(entity, state);
+                updateLooseFollow(entity, state, targetPos);
                 break;
             case FollowMode::FLANKING_FOLLOW:
-                updateFlankingFollow(entity, state);
+                updateFlankingFollow(entity, state, targetPos);
                 break;
             case FollowMode::REAR_GUARD:
-                updateRearGuard(entity, state);
+                updateRearGuard(entity, state, targetPos);
                 break;
             case FollowMode::ESCORT_FORMATION:
-                updateEscortFormation(entity, state);
+                updateEscortFormation(entity, state, targetPos, context.formations);
                 break;
         }
     }
@@ -153,45 +160,70 @@ void FollowBehavior::executeLogic(EntityPtr entity) {
 
 void FollowBehavior::clean(EntityPtr entity) {
     if (entity) {
-        auto it = m_entityStates.find(entity);
+        auto it = m_entityStates.find(entity->getHandle());
         if (it != m_entityStates.end()) {
-            // Release formation slot if using escort formation
-            if (m_followMode == FollowMode::ESCORT_FORMATION) {
-                releaseFormationSlot(it->second.formationSlot);
-            }
+            leaveFormation(entity->getHandle(), it->second);
             m_entityStates.erase(it);
         }
     }
 }
 
-void FollowBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void FollowBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) return;
 
     EntityState& state = it->second;
 
-    if (message == "follow_close") {
-        setFollowMode(FollowMode::CLOSE_FOLLOW);
-    } else if (message == "follow_loose") {
-        setFollowMode(FollowMode::LOOSE_FOLLOW);
-    } else if (message == "follow_flank") {
-        setFollowMode(FollowMode::FLANKING_FOLLOW);
-    } else if (message == "follow_rear") {
-        setFollowMode(FollowMode::REAR_GUARD);
-    } else if (message == "follow_formation") {
-        setFollowMode(FollowMode::ESCORT_FORMATION);
-    } else if (message == "stop_following") {
-        state.isFollowing = false;
-    } else if (message == "start_following") {
-        state.isFollowing = true;
-    } else if (message == "reset_formation") {
-        if (m_followMode == FollowMode::ESCORT_FORMATION) {
-            releaseFormationSlot(state.formationSlot);
-            state.formationSlot = assignFormationSlot();
-            state.formationOffset = calculateFormationOffset(state);
-        }
+    switch (message.id) {
+        case AIMessages::FOLLOW_CLOSE:
+            setFollowMode(FollowMode::CLOSE_FOLLOW);
+            break;
+        case AIMessages::FOLLOW_LOOSE:
+            setFollowMode(FollowMode::LOOSE_FOLLOW);
+            break;
+        case AIMessages::FOLLOW_FLANK:
+            setFollowMode(FollowMode::FLANKING_FOLLOW);
+            break;
+        case AIMessages::FOLLOW_REAR:
+            setFollowMode(FollowMode::REAR_GUARD);
+            break;
+        case AIMessages::FOLLOW_FORMATION:
+            setFollowMode(FollowMode::ESCORT_FORMATION);
+            break;
+        case AIMessages::STOP_FOLLOWING:
+            state.isFollowing = false;
+            break;
+        case AIMessages::START_FOLLOWING:
+            state.isFollowing = true;
+            break;
+        case AIMessages::RESET_FORMATION:
+            // Rejoining makes the formation match its slots again
+            if (m_followMode == FollowMode::ESCORT_FORMATION) {
+                EntityHandle leader = state.formationLeader;
+                leaveFormation(entity->getHandle(), state);
+                joinFormation(entity->getHandle(), state, leader);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool FollowBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::FOLLOW_CLOSE:
+        case AIMessages::FOLLOW_LOOSE:
+        case AIMessages::FOLLOW_FLANK:
+        case AIMessages::FOLLOW_REAR:
+        case AIMessages::FOLLOW_FORMATION:
+        case AIMessages::STOP_FOLLOWING:
+        case AIMessages::START_FOLLOWING:
+        case AIMessages::RESET_FORMATION:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -214,14 +246,11 @@ void FollowBehavior::setMaxDistance(float maxDistance) {
 void FollowBehavior::setFollowMode(FollowMode mode) {
     m_followMode = mode;
     
-    // Update all entity states for new mode
+    // Update all entity states for new mode; escorts join on their next frame
     for (auto& pair : m_entityStates) {
         EntityState& state = pair.second;
-        if (mode == FollowMode::ESCORT_FORMATION && state.formationSlot == 0) {
-            state.formationSlot = assignFormationSlot();
-        } else if (mode != FollowMode::ESCORT_FORMATION && state.formationSlot != 0) {
-            releaseFormationSlot(state.formationSlot);
-            state.formationSlot = 0;
+        if (mode != FollowMode::ESCORT_FORMATION) {
+            leaveFormation(pair.first, state);
         }
         state.formationOffset = calculateFormationOffset(state);
     }
@@ -242,6 +271,18 @@ void FollowBehavior::setFormationOffset(const Vector2D& offset) {
     }
 }
 
+void FollowBehavior::setFormationShape(FormationShape shape) {
+    if (shape == m_formationShape) {
+        return;
+    }
+    m_formationShape = shape;
+
+    // Escorts move to the formation with the new shape on their next frame
+    for (auto& pair : m_entityStates) {
+        leaveFormation(pair.first, pair.second);
+    }
+}
+
 void FollowBehavior::setAvoidanceRadius(float radius) {
     m_avoidanceRadius = std::max(0.0f, radius);
 }
@@ -289,7 +330,9 @@ float FollowBehavior::getDistanceToTarget() const {
     
     for (const auto& pair : m_entityStates) {
         if (pair.second.isFollowing) {
-            return (pair.first->getPosition() - target->getPosition()).length();
+            if (EntityPtr entity = EntityRegistry::Instance().resolve(pair.first)) {
+                return (entity->getPosition() - target->getPosition()).length();
+            }
         }
     }
     return -1.0f;
@@ -299,6 +342,10 @@ FollowBehavior::FollowMode FollowBehavior::getFollowMode() const {
     return m_followMode;
 }
 
+FormationShape FollowBehavior::getFormationShape() const {
+    return m_formationShape;
+}
+
 Vector2D FollowBehavior::getTargetPosition() const {
     EntityPtr target = getTarget();
     return target ? target->getPosition() : Vector2D(0, 0);
@@ -311,6 +358,7 @@ std::shared_ptr<AIBehavior> FollowBehavior::clone() const {
     clone->m_catchUpSpeedMultiplier = m_catchUpSpeedMultiplier;
     clone->m_formationOffset = m_formationOffset;
     clone->m_formationRadius = m_formationRadius;
+    clone->m_formationShape = m_formationShape;
     clone->m_avoidanceRadius = m_avoidanceRadius;
     clone->m_maxTurnRate = m_maxTurnRate;
     clone->m_minimumMovementThreshold = m_minimumMovementThreshold;
@@ -325,59 +373,49 @@ EntityPtr FollowBehavior::getTarget() const {
     return AIManager::Instance().getPlayerReference();
 }
 
-Vector2D FollowBehavior::calculateDesiredPosition(EntityPtr entity, EntityPtr target, const EntityState& state) {
-    if (!entity || !target) return Vector2D(0, 0);
-    
-    Vector2D targetPos = target->getPosition();
+Vector2D FollowBehavior::calculateDesiredPosition(EntityPtr entity, const Vector2D& targetPos, const EntityState& state) {
+    if (!entity) return Vector2D(0, 0);
     
     // Apply predictive following if enabled
+    Vector2D followPos = targetPos;
     if (m_predictiveFollowing && state.targetMoving) {
-        targetPos = predictTargetPosition(target, state);
+        followPos = predictTargetPosition(targetPos, state);
     }
     
     // Apply formation offset
-    Vector2D desiredPos = targetPos + state.formationOffset;
+    Vector2D desiredPos = followPos + state.formationOffset;
     
     return desiredPos;
 }
 
-Vector2D FollowBehavior::calculateFormationOffset(const EntityState& state) const {
+Vector2D FollowBehavior::calculateFormationOffset(const EntityState& /*state*/) const {
     switch (m_followMode) {
         case FollowMode::CLOSE_FOLLOW:
         case FollowMode::LOOSE_FOLLOW:
             return Vector2D(0, 0);
             
         case FollowMode::FLANKING_FOLLOW:
-            // Alternate left and right flanking positions
-            return Vector2D(m_formationOffset.getX() * (state.formationSlot % 2 == 0 ? 1 : -1), m_formationOffset.getY());
-            
         case FollowMode::REAR_GUARD:
             return m_formationOffset;
             
         case FollowMode::ESCORT_FORMATION:
-            if (state.formationSlot < static_cast<int>(s_escortFormationOffsets.size())) {
-                return s_escortFormationOffsets[state.formationSlot] * m_formationRadius;
-            }
+            // The slot comes from FormationManager's snapshot each frame
             break;
     }
     
     return Vector2D(0, 0);
 }
 
-Vector2D FollowBehavior::predictTargetPosition(EntityPtr target, const EntityState& state) const {
-    if (!target || !state.targetMoving) return target->getPosition();
+Vector2D FollowBehavior::predictTargetPosition(const Vector2D& targetPos, const EntityState& state) const {
+    if (!state.targetMoving) return targetPos;
     
-    Vector2D currentPos = target->getPosition();
-    Vector2D velocity = (currentPos - state.lastTargetPosition) / 0.016f; // Assume 60 FPS
+    Vector2D velocity = (targetPos - state.lastTargetPosition) / 0.016f; // Assume 60 FPS
     
-    return currentPos + velocity * m_predictionTime;
+    return targetPos + velocity * m_predictionTime;
 }
 
-bool FollowBehavior::isTargetMoving(EntityPtr target, const EntityState& state) const {
-    if (!target) return false;
-    
-    Vector2D currentPos = target->getPosition();
-    float movementDistance = (currentPos - state.lastTargetPosition).length();
+bool FollowBehavior::isTargetMoving(const Vector2D& targetPos, const EntityState& state) const {
+    float movementDistance = (targetPos - state.lastTargetPosition).length();
     
     return movementDistance > m_minimumMovementThreshold;
 }
@@ -423,10 +461,30 @@ Vector2D FollowBehavior::calculateSteeringForce(EntityPtr entity, const Vector2D
     return steeringForce;
 }
 
-Vector2D FollowBehavior::avoidObstacles(EntityPtr /*entity*/, const Vector2D& desiredVelocity) const {
-    // Simple obstacle avoidance - in a full implementation, this would check for collisions
-    // For now, just return the desired velocity
-    return desiredVelocity;
+Vector2D FollowBehavior::avoidObstacles(EntityPtr entity, const Vector2D& desiredVelocity) const {
+    if (!entity || m_avoidanceRadius <= 0.0f) return desiredVelocity;
+
+    // Separation from other AI entities inside the avoidance radius
+    const AIManager& aiManager = AIManager::Instance();
+    const Vector2D position = entity->getPosition();
+    std::array<uint32_t, MAX_AVOIDANCE_NEIGHBORS> neighbors;
+    size_t found = aiManager.queryEntitiesInRadius(position, m_avoidanceRadius, neighbors.data(), neighbors.size());
+
+    Vector2D separation(0, 0);
+    for (size_t i = 0; i < found; ++i) {
+        Vector2D away = position - aiManager.getSpatialEntityPosition(neighbors[i]);
+        float distance = away.length();
+        if (distance < 0.001f) {
+            continue; // This entity, or one exactly on top of it
+        }
+        // Push harder the closer the neighbor is
+        separation += away * ((m_avoidanceRadius - distance) / (m_avoidanceRadius * distance));
+    }
+
+    if (separation.length() < 0.001f) {
+        return desiredVelocity;
+    }
+    return normalizeVector(desiredVelocity + separation);
 }
 
 Vector2D FollowBehavior::smoothPath(const Vector2D& currentPos, const Vector2D& targetPos, const EntityState& state) const {
@@ -447,12 +505,9 @@ Vector2D FollowBehavior::smoothPath(const Vector2D& currentPos, const Vector2D&
     return normalizeVector(blendedDirection);
 }
 
-void FollowBehavior::updateCloseFollow(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
-    
+void FollowBehavior::updateCloseFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos) {
     Vector2D currentPos = entity->getPosition();
-    Vector2D desiredPos = calculateDesiredPosition(entity, target, state);
+    Vector2D desiredPos = calculateDesiredPosition(entity, targetPos, state);
     float distanceToDesired = (currentPos - desiredPos).length();
     
     if (distanceToDesired > m_followDistance * 0.3f) {
@@ -470,12 +525,9 @@ void FollowBehavior::updateCloseFollow(EntityPtr entity, EntityState& state) {
     }
 }
 
-void FollowBehavior::updateLooseFollow(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
-    
+void FollowBehavior::updateLooseFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos) {
     Vector2D currentPos = entity->getPosition();
-    Vector2D desiredPos = calculateDesiredPosition(entity, target, state);
+    Vector2D desiredPos = calculateDesiredPosition(entity, targetPos, state);
     float distanceToDesired = (currentPos - desiredPos).length();
     
     // Only move if outside the follow distance
@@ -496,12 +548,9 @@ void FollowBehavior::updateLooseFollow(EntityPtr entity, EntityState& state) {
     }
 }
 
-void FollowBehavior::updateFlankingFollow(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
-    
+void FollowBehavior::updateFlankingFollow(EntityPtr entity, EntityState& state, const Vector2D& targetPos) {
     Vector2D currentPos = entity->getPosition();
-    Vector2D desiredPos = calculateDesiredPosition(entity, target, state);
+    Vector2D desiredPos = calculateDesiredPosition(entity, targetPos, state);
     float distanceToDesired = (currentPos - desiredPos).length();
     
     if (distanceToDesired > m_followDistance * 0.5f) {
@@ -515,12 +564,9 @@ void FollowBehavior::updateFlankingFollow(EntityPtr entity, EntityState& state)
     }
 }
 
-void FollowBehavior::updateRearGuard(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
-    
+void FollowBehavior::updateRearGuard(EntityPtr entity, EntityState& state, const Vector2D& targetPos) {
     Vector2D currentPos = entity->getPosition();
-    Vector2D desiredPos = calculateDesiredPosition(entity, target, state);
+    Vector2D desiredPos = calculateDesiredPosition(entity, targetPos, state);
     float distanceToDesired = (currentPos - desiredPos).length();
     
     // Rear guard follows more conservatively
@@ -535,12 +581,17 @@ void FollowBehavior::updateRearGuard(EntityPtr entity, EntityState& state) {
     }
 }
 
-void FollowBehavior::updateEscortFormation(EntityPtr entity, EntityState& state) {
-    EntityPtr target = getTarget();
-    if (!target) return;
-    
+void FollowBehavior::updateEscortFormation(EntityPtr entity, EntityState& state, const Vector2D& targetPos,
+                                           const FormationSnapshot* formations) {
     Vector2D currentPos = entity->getPosition();
-    Vector2D desiredPos = calculateDesiredPosition(entity, target, state);
+    Vector2D desiredPos = calculateDesiredPosition(entity, targetPos, state);
+
+    // The published slot already moves and turns with the target; only the
+    // prediction is added on top. Without a slot, close in on the target.
+    Vector2D slotPos;
+    if (formations && formations->slotPosition(entity->getHandle(), slotPos)) {
+        desiredPos = slotPos + (desiredPos - targetPos);
+    }
     float distanceToDesired = (currentPos - desiredPos).length();
     
     // Check if in formation
@@ -588,28 +639,18 @@ Vector2D FollowBehavior::rotateVector(const Vector2D& vector, float angle) const
     );
 }
 
-void FollowBehavior::initializeFormationOffsets() {
-    if (s_escortFormationOffsets.empty()) {
-        // Initialize escort formation positions (8 positions around target)
-        s_escortFormationOffsets.reserve(8);
-        
-        for (int i = 0; i < 8; ++i) {
-            float angle = (i * 2.0f * M_PI) / 8.0f;
-            s_escortFormationOffsets.emplace_back(
-                std::cos(angle),
-                std::sin(angle)
-            );
-        }
-    }
+void FollowBehavior::joinFormation(EntityHandle member, EntityState& state, EntityHandle leader) {
+    // Clones with the same shape and radius share one formation per leader
+    FormationManager& formations = FormationManager::Instance();
+    FormationId id = formations.findOrCreateFormation(leader, m_formationShape, m_formationRadius);
+    state.formationId = formations.joinFormation(id, member) ? id : INVALID_FORMATION;
+    state.formationLeader = leader;
 }
 
-int FollowBehavior::assignFormationSlot() {
-    int slot = s_nextFormationSlot;
-    s_nextFormationSlot = (s_nextFormationSlot + 1) % 8; // Cycle through 8 slots
-    return slot;
+void FollowBehavior::leaveFormation(EntityHandle member, EntityState& state) {
+    if (state.formationId != INVALID_FORMATION) {
+        FormationManager::Instance().leaveFormation(state.formationId, member);
+    }
+    state.formationId = INVALID_FORMATION;
+    state.formationLeader = EntityHandle{};
 }
-
-void FollowBehavior::releaseFormationSlot(int /*slot*/) {
-    // In a more sophisticated implementation, you might track which slots are in use
-    // For now, we just cycle through slots
-}
\ No newline at end of file
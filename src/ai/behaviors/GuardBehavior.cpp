@@ -8,6 +8,14 @@
 #include <cmath>
 #include <algorithm>
 
+namespace {
+
+// AIRandom streams, one per kind of decision
+constexpr uint16_t STREAM_INIT = 1;
+constexpr uint16_t STREAM_ROAM = 2;
+
+} // namespace
+
 GuardBehavior::GuardBehavior(const Vector2D& guardPosition, float guardRadius, float alertRadius)
     : m_guardPosition(guardPosition)
     , m_guardRadius(guardRadius)
@@ -55,29 +63,43 @@ GuardBehavior::GuardBehavior(GuardMode mode, const Vector2D& guardPosition, floa
 void GuardBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    auto& state = m_entityStates[entity];
+    auto& state = m_entityStates[entity->getHandle()];
     state = EntityState(); // Reset to default state
     state.assignedPosition = m_guardPosition;
     state.currentMode = m_guardMode;
     state.onDuty = true;
 
+    // Join the group alerts are broadcast to
+    if (m_guardGroup != 0) {
+        AIManager& aiMgr = AIManager::Instance();
+        if (aiMgr.getEntityGroup(entity) != static_cast<uint32_t>(m_guardGroup)) {
+            aiMgr.setEntityGroup(entity, static_cast<uint32_t>(m_guardGroup));
+        }
+    }
+
     // Initialize based on mode
     if (m_guardMode == GuardMode::PATROL_GUARD && !m_patrolWaypoints.empty()) {
         state.currentPatrolTarget = m_patrolWaypoints[0];
         state.currentPatrolIndex = 0;
     } else if (m_guardMode == GuardMode::ROAMING_GUARD) {
-        state.roamTarget = generateRoamTarget(entity, state);
-        state.nextRoamTime = SDL_GetTicks() + static_cast<Uint64>(m_roamInterval * 1000);
+        const FrameContext context = AIManager::Instance().getFrameContext();
+        AIRandom rng(context, entity->getHandle(), STREAM_INIT);
+        state.roamTarget = generateRoamTarget(entity, state, rng);
+        state.nextRoamTime = context.timeMs + static_cast<Uint64>(m_roamInterval * 1000);
     }
 }
 
 void GuardBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void GuardBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !isActive()) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) {
         init(entity);
-        it = m_entityStates.find(entity);
+        it = m_entityStates.find(entity->getHandle());
         if (it == m_entityStates.end()) return;
     }
 
@@ -87,35 +109,34 @@ void GuardBehavior::executeLogic(EntityPtr entity) {
         return; // Guard is off duty
     }
 
-    Uint64 currentTime = SDL_GetTicks();
+    const Uint64 currentTime = context.timeMs;
 
     // Detect threats
-    EntityPtr threat = detectThreat(entity, state);
-    bool threatPresent = (threat != nullptr);
+    bool threatPresent = detectThreat(entity, state, context);
 
     // Update alert level based on threat presence
-    updateAlertLevel(entity, state, threatPresent);
+    updateAlertLevel(entity, state, threatPresent, currentTime);
 
     if (threatPresent) {
-        handleThreatDetection(entity, state, threat);
+        handleThreatDetection(entity, state, context.player.position, currentTime);
     } else if (state.isInvestigating) {
-        handleInvestigation(entity, state);
+        handleInvestigation(entity, state, currentTime);
     } else if (state.returningToPost) {
         handleReturnToPost(entity, state);
     } else {
         // Normal guard behavior based on mode
         switch (state.currentMode) {
             case GuardMode::STATIC_GUARD:
-                updateStaticGuard(entity, state);
+                updateStaticGuard(entity, state, currentTime);
                 break;
             case GuardMode::PATROL_GUARD:
                 updatePatrolGuard(entity, state);
                 break;
             case GuardMode::AREA_GUARD:
-                updateAreaGuard(entity, state);
+                updateAreaGuard(entity, state, context);
                 break;
             case GuardMode::ROAMING_GUARD:
-                updateRoamingGuard(entity, state);
+                updateRoamingGuard(entity, state, context);
                 break;
             case GuardMode::ALERT_GUARD:
                 updateAlertGuard(entity, state);
@@ -136,41 +157,70 @@ void GuardBehavior::executeLogic(EntityPtr entity) {
 
 void GuardBehavior::clean(EntityPtr entity) {
     if (entity) {
-        m_entityStates.erase(entity);
+        m_entityStates.erase(entity->getHandle());
     }
 }
 
-void GuardBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void GuardBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it == m_entityStates.end()) return;
 
     EntityState& state = it->second;
 
-    if (message == "go_on_duty") {
-        state.onDuty = true;
-    } else if (message == "go_off_duty") {
-        state.onDuty = false;
-        state.currentAlertLevel = AlertLevel::CALM;
-    } else if (message == "raise_alert") {
-        state.currentAlertLevel = AlertLevel::HOSTILE;
-        state.alertStartTime = SDL_GetTicks();
-    } else if (message == "clear_alert") {
-        clearAlert(entity);
-    } else if (message == "investigate_position") {
-        state.isInvestigating = true;
-        state.investigationTarget = entity->getPosition(); // Use current position as default
-        state.investigationStartTime = SDL_GetTicks();
-    } else if (message == "return_to_post") {
-        state.returningToPost = true;
-        state.isInvestigating = false;
-    } else if (message == "patrol_mode") {
-        state.currentMode = GuardMode::PATROL_GUARD;
-    } else if (message == "static_mode") {
-        state.currentMode = GuardMode::STATIC_GUARD;
-    } else if (message == "roam_mode") {
-        state.currentMode = GuardMode::ROAMING_GUARD;
+    switch (message.id) {
+        case AIMessages::GO_ON_DUTY:
+            state.onDuty = true;
+            break;
+        case AIMessages::GO_OFF_DUTY:
+            state.onDuty = false;
+            state.currentAlertLevel = AlertLevel::CALM;
+            break;
+        case AIMessages::RAISE_ALERT:
+            state.currentAlertLevel = AlertLevel::HOSTILE;
+            state.alertStartTime = AIManager::Instance().getFrameTimeMs();
+            break;
+        case AIMessages::CLEAR_ALERT:
+            clearAlert(entity);
+            break;
+        case AIMessages::INVESTIGATE_POSITION:
+            state.isInvestigating = true;
+            state.investigationTarget = entity->getPosition(); // Use current position as default
+            state.investigationStartTime = AIManager::Instance().getFrameTimeMs();
+            break;
+        case AIMessages::RETURN_TO_POST:
+            state.returningToPost = true;
+            state.isInvestigating = false;
+            break;
+        case AIMessages::PATROL_MODE:
+            state.currentMode = GuardMode::PATROL_GUARD;
+            break;
+        case AIMessages::STATIC_MODE:
+            state.currentMode = GuardMode::STATIC_GUARD;
+            break;
+        case AIMessages::ROAM_MODE:
+            state.currentMode = GuardMode::ROAMING_GUARD;
+            break;
+        default:
+            break;
+    }
+}
+
+bool GuardBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::GO_ON_DUTY:
+        case AIMessages::GO_OFF_DUTY:
+        case AIMessages::RAISE_ALERT:
+        case AIMessages::CLEAR_ALERT:
+        case AIMessages::INVESTIGATE_POSITION:
+        case AIMessages::RETURN_TO_POST:
+        case AIMessages::PATROL_MODE:
+        case AIMessages::STATIC_MODE:
+        case AIMessages::ROAM_MODE:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -246,10 +296,11 @@ void GuardBehavior::setGuardArea(const Vector2D& topLeft, const Vector2D& bottom
 }
 
 void GuardBehavior::setAlertLevel(AlertLevel level) {
+    const Uint64 currentTime = AIManager::Instance().getFrameTimeMs();
     for (auto& pair : m_entityStates) {
         pair.second.currentAlertLevel = level;
         if (level > AlertLevel::CALM) {
-            pair.second.alertStartTime = SDL_GetTicks();
+            pair.second.alertStartTime = currentTime;
         }
     }
 }
@@ -257,11 +308,11 @@ void GuardBehavior::setAlertLevel(AlertLevel level) {
 void GuardBehavior::raiseAlert(EntityPtr entity, const Vector2D& alertPosition) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it != m_entityStates.end()) {
         EntityState& state = it->second;
         state.currentAlertLevel = AlertLevel::HOSTILE;
-        state.alertStartTime = SDL_GetTicks();
+        state.alertStartTime = AIManager::Instance().getFrameTimeMs();
         state.lastKnownThreatPosition = alertPosition;
         state.alertRaised = true;
 
@@ -275,7 +326,7 @@ void GuardBehavior::raiseAlert(EntityPtr entity, const Vector2D& alertPosition)
 void GuardBehavior::clearAlert(EntityPtr entity) {
     if (!entity) return;
 
-    auto it = m_entityStates.find(entity);
+    auto it = m_entityStates.find(entity->getHandle());
     if (it != m_entityStates.end()) {
         EntityState& state = it->second;
         state.currentAlertLevel = AlertLevel::CALM;
@@ -357,7 +408,9 @@ Vector2D GuardBehavior::getGuardPosition() const {
 float GuardBehavior::getDistanceFromPost() const {
     for (const auto& pair : m_entityStates) {
         if (pair.second.onDuty) {
-            return (pair.first->getPosition() - pair.second.assignedPosition).length();
+            if (EntityPtr entity = EntityRegistry::Instance().resolve(pair.first)) {
+                return (entity->getPosition() - pair.second.assignedPosition).length();
+            }
         }
     }
     return 0.0f;
@@ -387,42 +440,60 @@ std::shared_ptr<AIBehavior> GuardBehavior::clone() const {
     return clone;
 }
 
-EntityPtr GuardBehavior::detectThreat(EntityPtr entity, const EntityState& state) const {
-    if (!entity) return nullptr;
-    
-    EntityPtr threat = AIManager::Instance().getPlayerReference();
-    if (!threat) return nullptr;
+bool GuardBehavior::getPerceptionSettings(PerceptionSettings& settings) const {
+    settings.range = m_threatDetectionRange;
+    settings.fieldOfView = m_fieldOfView;
+    settings.requireLineOfSight = m_lineOfSightRequired;
+    return true;
+}
+
+bool GuardBehavior::getFacing(const Entity& entity, Vector2D& facing) const {
+    auto it = m_entityStates.find(entity.getHandle());
+    if (it == m_entityStates.end()) {
+        return false;
+    }
+    facing = Vector2D(std::cos(it->second.currentHeading), std::sin(it->second.currentHeading));
+    return true;
+}
+
+bool GuardBehavior::detectThreat(EntityPtr entity, const EntityState& state, const FrameContext& context) const {
+    const PlayerSnapshot& threat = context.player;
+    if (!entity || !threat.valid) return false;
+
+    // Sensed for the whole batch before this guard ran
+    if (context.awareness) {
+        return context.awareness->canSee();
+    }
     
     // Check if threat is in detection range
-    if (!isThreatInRange(entity, threat)) {
-        return nullptr;
+    if (!isThreatInRange(entity, threat.position)) {
+        return false;
     }
     
     // Check field of view if required
-    if (m_fieldOfView < 360.0f && !isThreatInFieldOfView(entity, threat, state)) {
-        return nullptr;
+    if (m_fieldOfView < 360.0f && !isThreatInFieldOfView(entity, threat.position, state)) {
+        return false;
     }
     
     // Check line of sight if required
-    if (m_lineOfSightRequired && !hasLineOfSight(entity, threat)) {
-        return nullptr;
+    if (m_lineOfSightRequired && !hasLineOfSight(entity, threat.position)) {
+        return false;
     }
     
-    return threat;
+    return true;
 }
 
-bool GuardBehavior::isThreatInRange(EntityPtr entity, EntityPtr threat) const {
-    if (!entity || !threat) return false;
+bool GuardBehavior::isThreatInRange(EntityPtr entity, const Vector2D& threatPos) const {
+    if (!entity) return false;
     
-    float distance = calculateThreatDistance(entity, threat);
+    float distance = calculateThreatDistance(entity, threatPos);
     return distance <= m_threatDetectionRange;
 }
 
-bool GuardBehavior::isThreatInFieldOfView(EntityPtr entity, EntityPtr threat, const EntityState& state) const {
-    if (!entity || !threat) return false;
+bool GuardBehavior::isThreatInFieldOfView(EntityPtr entity, const Vector2D& threatPos, const EntityState& state) const {
+    if (!entity) return false;
     
     Vector2D entityPos = entity->getPosition();
-    Vector2D threatPos = threat->getPosition();
     
     // Calculate angle to threat
     float angleToThreat = calculateAngleToTarget(entityPos, threatPos);
@@ -435,21 +506,19 @@ bool GuardBehavior::isThreatInFieldOfView(EntityPtr entity, EntityPtr threat, co
     return angleDiff <= halfFOV;
 }
 
-bool GuardBehavior::hasLineOfSight(EntityPtr /*entity*/, EntityPtr /*threat*/) const {
+bool GuardBehavior::hasLineOfSight(EntityPtr /*entity*/, const Vector2D& /*threatPos*/) const {
     // Simplified line of sight check
     // In a full implementation, this would do proper collision detection
     return true;
 }
 
-float GuardBehavior::calculateThreatDistance(EntityPtr entity, EntityPtr threat) const {
-    if (!entity || !threat) return std::numeric_limits<float>::max();
+float GuardBehavior::calculateThreatDistance(EntityPtr entity, const Vector2D& threatPos) const {
+    if (!entity) return std::numeric_limits<float>::max();
     
-    return (entity->getPosition() - threat->getPosition()).length();
+    return (entity->getPosition() - threatPos).length();
 }
 
-void GuardBehavior::updateAlertLevel(EntityPtr /*entity*/, EntityState& state, bool threatPresent) {
-    Uint64 currentTime = SDL_GetTicks();
-    
+void GuardBehavior::updateAlertLevel(EntityPtr /*entity*/, EntityState& state, bool threatPresent, Uint64 currentTime) {
     if (threatPresent) {
         state.lastThreatSighting = currentTime;
         state.hasActiveThreat = true;
@@ -475,10 +544,10 @@ void GuardBehavior::updateAlertLevel(EntityPtr /*entity*/, EntityState& state, b
     }
 }
 
-void GuardBehavior::handleThreatDetection(EntityPtr entity, EntityState& state, EntityPtr threat) {
-    if (!entity || !threat) return;
+void GuardBehavior::handleThreatDetection(EntityPtr entity, EntityState& state, const Vector2D& threatPos,
+                                          Uint64 currentTime) {
+    if (!entity) return;
     
-    Vector2D threatPos = threat->getPosition();
     state.lastKnownThreatPosition = threatPos;
     
     // React based on alert level
@@ -492,7 +561,7 @@ void GuardBehavior::handleThreatDetection(EntityPtr entity, EntityState& state,
             // Move towards threat for investigation
             state.isInvestigating = true;
             state.investigationTarget = threatPos;
-            state.investigationStartTime = SDL_GetTicks();
+            state.investigationStartTime = currentTime;
             moveToPosition(entity, threatPos, m_movementSpeed);
             break;
             
@@ -516,11 +585,9 @@ void GuardBehavior::handleThreatDetection(EntityPtr entity, EntityState& state,
     }
 }
 
-void GuardBehavior::handleInvestigation(EntityPtr entity, EntityState& state) {
+void GuardBehavior::handleInvestigation(EntityPtr entity, EntityState& state, Uint64 currentTime) {
     if (!entity) return;
     
-    Uint64 currentTime = SDL_GetTicks();
-    
     // Check if investigation time has expired
     if (currentTime - state.investigationStartTime > static_cast<Uint64>(m_investigationTime * 1000)) {
         state.isInvestigating = false;
@@ -549,7 +616,7 @@ void GuardBehavior::handleReturnToPost(EntityPtr entity, EntityState& state) {
     }
 }
 
-void GuardBehavior::updateStaticGuard(EntityPtr entity, EntityState& state) {
+void GuardBehavior::updateStaticGuard(EntityPtr entity, EntityState& state, Uint64 currentTime) {
     if (!entity) return;
     
     Vector2D currentPos = entity->getPosition();
@@ -560,7 +627,6 @@ void GuardBehavior::updateStaticGuard(EntityPtr entity, EntityState& state) {
     }
     
     // Update heading to scan area
-    Uint64 currentTime = SDL_GetTicks();
     if (currentTime - state.lastPositionCheck > 2000) { // Check every 2 seconds
         state.currentHeading += 0.5f; // Slow rotation
         state.currentHeading = normalizeAngle(state.currentHeading);
@@ -592,10 +658,11 @@ void GuardBehavior::updatePatrolGuard(EntityPtr entity, EntityState& state) {
     }
 }
 
-void GuardBehavior::updateAreaGuard(EntityPtr entity, EntityState& state) {
+void GuardBehavior::updateAreaGuard(EntityPtr entity, EntityState& state, const FrameContext& context) {
     if (!entity) return;
     
     Vector2D currentPos = entity->getPosition();
+    const Uint64 currentTime = context.timeMs;
     
     // Ensure we're within the guard area
     if (!isWithinGuardArea(currentPos)) {
@@ -603,9 +670,9 @@ void GuardBehavior::updateAreaGuard(EntityPtr entity, EntityState& state) {
         moveToPosition(entity, clampedPos, m_movementSpeed);
     } else {
         // Patrol within the area
-        Uint64 currentTime = SDL_GetTicks();
         if (currentTime >= state.nextRoamTime) {
-            state.roamTarget = generateRoamTarget(entity, state);
+            AIRandom rng(context, entity->getHandle(), STREAM_ROAM);
+            state.roamTarget = generateRoamTarget(entity, state, rng);
             state.nextRoamTime = currentTime + static_cast<Uint64>(m_roamInterval * 1000);
         }
         
@@ -615,15 +682,16 @@ void GuardBehavior::updateAreaGuard(EntityPtr entity, EntityState& state) {
     }
 }
 
-void GuardBehavior::updateRoamingGuard(EntityPtr entity, EntityState& state) {
+void GuardBehavior::updateRoamingGuard(EntityPtr entity, EntityState& state, const FrameContext& context) {
     if (!entity) return;
     
     Vector2D currentPos = entity->getPosition();
-    Uint64 currentTime = SDL_GetTicks();
+    const Uint64 currentTime = context.timeMs;
     
     // Generate new roam target if needed
     if (currentTime >= state.nextRoamTime || isAtPosition(currentPos, state.roamTarget)) {
-        state.roamTarget = generateRoamTarget(entity, state);
+        AIRandom rng(context, entity->getHandle(), STREAM_ROAM);
+        state.roamTarget = generateRoamTarget(entity, state, rng);
         state.nextRoamTime = currentTime + static_cast<Uint64>(m_roamInterval * 1000);
     }
     
@@ -666,15 +734,15 @@ Vector2D GuardBehavior::getNextPatrolWaypoint(const EntityState& state) const {
     return m_patrolWaypoints[state.currentPatrolIndex];
 }
 
-Vector2D GuardBehavior::generateRoamTarget(EntityPtr entity, const EntityState& /*state*/) const {
+Vector2D GuardBehavior::generateRoamTarget(EntityPtr entity, const EntityState& /*state*/, AIRandom& rng) const {
     if (!entity) return Vector2D(0, 0);
     
     Vector2D target;
     
     if (m_useCircularArea) {
         // Generate random point within circular area
-            float angle = m_angleDistribution(m_rng);
-            float radius = m_radiusDistribution(m_rng) * m_areaRadius;
+        float angle = rng.angle();
+        float radius = rng.range(0.3f, 1.0f) * m_areaRadius;
         
         target = m_areaCenter + Vector2D(
             radius * std::cos(angle),
@@ -682,10 +750,9 @@ Vector2D GuardBehavior::generateRoamTarget(EntityPtr entity, const EntityState&
         );
     } else {
         // Generate random point within rectangular area
-        std::uniform_real_distribution<float> xDist(m_areaTopLeft.getX(), m_areaBottomRight.getX());
-        std::uniform_real_distribution<float> yDist(m_areaTopLeft.getY(), m_areaBottomRight.getY());
-        
-        target = Vector2D(xDist(m_rng), yDist(m_rng));
+        float x = rng.range(m_areaTopLeft.getX(), m_areaBottomRight.getX());
+        float y = rng.range(m_areaTopLeft.getY(), m_areaBottomRight.getY());
+        target = Vector2D(x, y);
     }
     
     return target;
@@ -741,19 +808,23 @@ Vector2D GuardBehavior::clampToGuardArea(const Vector2D& position) const {
     }
 }
 
-void GuardBehavior::callForHelp(EntityPtr entity, const Vector2D& /*threatPosition*/) {
+void GuardBehavior::callForHelp(EntityPtr entity, const Vector2D& threatPosition) {
     if (!entity) return;
     
-    // In a full implementation, this would communicate with nearby guards
-    // For now, we'll use the AI Manager's message system
-    std::string helpMessage = "guard_help_needed";
-    AIManager::Instance().broadcastMessage(helpMessage, false);
+    // Only entities within earshot hear the call
+    AIManager::Instance().broadcastInRadius(entity->getPosition(), m_helpCallRadius,
+        AIMessage(AIMessages::GUARD_HELP_NEEDED, entity->getHandle(), threatPosition));
 }
 
-void GuardBehavior::broadcastAlert(EntityPtr entity, AlertLevel level, const Vector2D& /*alertPosition*/) {
+void GuardBehavior::broadcastAlert(EntityPtr entity, AlertLevel level, const Vector2D& alertPosition) {
     if (!entity) return;
     
-    // Broadcast alert to other guards in the same group
-    std::string alertMessage = "guard_alert_" + std::to_string(static_cast<int>(level));
-    AIManager::Instance().broadcastMessage(alertMessage, false);
+    // Broadcast alert to other guards in the same group, or to those nearby
+    // when ungrouped; the level rides in the payload
+    AIMessage alert(AIMessages::GUARD_ALERT, entity->getHandle(), alertPosition, static_cast<float>(level));
+    if (m_guardGroup != 0) {
+        AIManager::Instance().broadcastToGroup(static_cast<uint32_t>(m_guardGroup), alert);
+    } else {
+        AIManager::Instance().broadcastInRadius(entity->getPosition(), m_alertRadius, alert);
+    }
 }
\ No newline at end of file
@@ -4,97 +4,168 @@
 */
 
 #include "ai/behaviors/IdleBehavior.hpp"
+#include "managers/AIManager.hpp"
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+// AIRandom streams, one per kind of decision
+constexpr uint16_t STREAM_INIT = 1;
+constexpr uint16_t STREAM_UPDATE = 2;
+
+} // namespace
+
 IdleBehavior::IdleBehavior(IdleMode mode, float idleRadius)
     : m_idleMode(mode)
     , m_idleRadius(idleRadius)
 {
-    // Initialize random distributions based on mode
+    modeFrequencies(mode, m_movementFrequency, m_turnFrequency);
+}
+
+void IdleBehavior::modeFrequencies(IdleMode mode, float& movementFrequency, float& turnFrequency) {
     switch (mode) {
         case IdleMode::STATIONARY:
-            m_movementFrequency = 0.0f; // No movement
-            m_turnFrequency = 0.0f;     // No turning
+            movementFrequency = 0.0f; // No movement
+            turnFrequency = 0.0f;     // No turning
             break;
         case IdleMode::SUBTLE_SWAY:
-            m_movementFrequency = 2.0f; // Gentle swaying every 2 seconds
-            m_turnFrequency = 8.0f;     // Occasional turns
+            movementFrequency = 2.0f; // Gentle swaying every 2 seconds
+            turnFrequency = 8.0f;     // Occasional turns
             break;
         case IdleMode::OCCASIONAL_TURN:
-            m_movementFrequency = 0.0f; // No position movement
-            m_turnFrequency = 4.0f;     // Turn every 4 seconds
+            movementFrequency = 0.0f; // No position movement
+            turnFrequency = 4.0f;     // Turn every 4 seconds
             break;
         case IdleMode::LIGHT_FIDGET:
-            m_movementFrequency = 1.5f; // Light fidgeting
-            m_turnFrequency = 3.0f;     // More frequent turns
+            movementFrequency = 1.5f; // Light fidgeting
+            turnFrequency = 3.0f;     // More frequent turns
             break;
     }
 }
 
+void IdleBehavior::setEntityMode(EntityState& state, IdleMode mode) {
+    state.mode = mode;
+    modeFrequencies(mode, state.movementFrequency, state.turnFrequency);
+}
+
 void IdleBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    auto& state = m_entityStates[entity];
-    initializeEntityState(entity, state);
+    auto& state = m_entityStates[entity->getHandle()];
+    state.mode = m_idleMode;
+    state.movementFrequency = m_movementFrequency;
+    state.turnFrequency = m_turnFrequency;
+    const FrameContext context = AIManager::Instance().getFrameContext();
+    AIRandom rng(context, entity->getHandle(), STREAM_INIT);
+    initializeEntityState(entity, state, context.timeMs, rng);
 }
 
 void IdleBehavior::executeLogic(EntityPtr entity) {
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
+
+void IdleBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
     if (!entity || !isActive()) return;
 
-    auto it = m_entityStates.find(entity);
-    if (it == m_entityStates.end()) {
-        init(entity); // Initialize if not found
-        it = m_entityStates.find(entity);
-        if (it == m_entityStates.end()) return;
+    // States are created in init(); inserting here could race with other
+    // workers running this shared instance
+    auto it = m_entityStates.find(entity->getHandle());
+    if (it == m_entityStates.end()) return;
+
+    updateEntity(entity, it->second, context);
+}
+
+void IdleBehavior::executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) {
+    if (!isActive()) return;
+
+    for (const EntityPtr& entity : entities) {
+        if (!entity) continue;
+        auto it = m_entityStates.find(entity->getHandle());
+        if (it != m_entityStates.end()) {
+            updateEntity(entity, it->second, context);
+        }
     }
+}
+
+void IdleBehavior::updateEntity(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    // The frame's clock, so every entity of the frame sees the same time
+    const Uint64 currentTime = context.timeMs;
+    AIRandom rng(context, entity->getHandle(), STREAM_UPDATE);
 
-    EntityState& state = it->second;
-    
     if (!state.initialized) {
-        initializeEntityState(entity, state);
+        initializeEntityState(entity, state, currentTime, rng);
     }
 
-    // Execute behavior based on current mode
-    switch (m_idleMode) {
+    // Execute behavior based on the entity's current mode
+    switch (state.mode) {
         case IdleMode::STATIONARY:
             updateStationary(entity, state);
             break;
         case IdleMode::SUBTLE_SWAY:
-            updateSubtleSway(entity, state);
+            updateSubtleSway(entity, state, currentTime, rng);
             break;
         case IdleMode::OCCASIONAL_TURN:
-            updateOccasionalTurn(entity, state);
+            updateOccasionalTurn(entity, state, currentTime, rng);
             break;
         case IdleMode::LIGHT_FIDGET:
-            updateLightFidget(entity, state);
+            updateLightFidget(entity, state, currentTime, rng);
             break;
     }
 }
 
 void IdleBehavior::clean(EntityPtr entity) {
     if (entity) {
-        m_entityStates.erase(entity);
+        m_entityStates.erase(entity->getHandle());
     }
 }
 
-void IdleBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void IdleBehavior::cleanupEntity(EntityPtr entity) {
+    if (entity) {
+        m_entityStates.erase(entity->getHandle());
+    }
+}
+
+void IdleBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
-    // Handle mode changes via messages
-    if (message == "idle_stationary") {
-        setIdleMode(IdleMode::STATIONARY);
-    } else if (message == "idle_sway") {
-        setIdleMode(IdleMode::SUBTLE_SWAY);
-    } else if (message == "idle_turn") {
-        setIdleMode(IdleMode::OCCASIONAL_TURN);
-    } else if (message == "idle_fidget") {
-        setIdleMode(IdleMode::LIGHT_FIDGET);
-    } else if (message == "reset_position") {
-        auto it = m_entityStates.find(entity);
-        if (it != m_entityStates.end()) {
-            it->second.originalPosition = entity->getPosition();
-            it->second.currentOffset = Vector2D(0, 0);
-        }
+    auto it = m_entityStates.find(entity->getHandle());
+    if (it == m_entityStates.end()) return;
+    EntityState& state = it->second;
+
+    // Mode changes apply to the receiving entity only
+    switch (message.id) {
+        case AIMessages::IDLE_STATIONARY:
+            setEntityMode(state, IdleMode::STATIONARY);
+            break;
+        case AIMessages::IDLE_SWAY:
+            setEntityMode(state, IdleMode::SUBTLE_SWAY);
+            break;
+        case AIMessages::IDLE_TURN:
+            setEntityMode(state, IdleMode::OCCASIONAL_TURN);
+            break;
+        case AIMessages::IDLE_FIDGET:
+            setEntityMode(state, IdleMode::LIGHT_FIDGET);
+            break;
+        case AIMessages::RESET_POSITION:
+            state.originalPosition = entity->getPosition();
+            state.currentOffset = Vector2D(0, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+bool IdleBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::IDLE_STATIONARY:
+        case AIMessages::IDLE_SWAY:
+        case AIMessages::IDLE_TURN:
+        case AIMessages::IDLE_FIDGET:
+        case AIMessages::RESET_POSITION:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -104,25 +175,11 @@ std::string IdleBehavior::getName() const {
 
 void IdleBehavior::setIdleMode(IdleMode mode) {
     m_idleMode = mode;
-    
-    // Update timing parameters based on new mode
-    switch (mode) {
-        case IdleMode::STATIONARY:
-            m_movementFrequency = 0.0f;
-            m_turnFrequency = 0.0f;
-            break;
-        case IdleMode::SUBTLE_SWAY:
-            m_movementFrequency = 2.0f;
-            m_turnFrequency = 8.0f;
-            break;
-        case IdleMode::OCCASIONAL_TURN:
-            m_movementFrequency = 0.0f;
-            m_turnFrequency = 4.0f;
-            break;
-        case IdleMode::LIGHT_FIDGET:
-            m_movementFrequency = 1.5f;
-            m_turnFrequency = 3.0f;
-            break;
+    modeFrequencies(mode, m_movementFrequency, m_turnFrequency);
+
+    // Update all entity states
+    for (auto& pair : m_entityStates) {
+        setEntityMode(pair.second, mode);
     }
 }
 
@@ -132,10 +189,16 @@ void IdleBehavior::setIdleRadius(float radius) {
 
 void IdleBehavior::setMovementFrequency(float frequency) {
     m_movementFrequency = std::max(0.0f, frequency);
+    for (auto& pair : m_entityStates) {
+        pair.second.movementFrequency = m_movementFrequency;
+    }
 }
 
 void IdleBehavior::setTurnFrequency(float frequency) {
     m_turnFrequency = std::max(0.0f, frequency);
+    for (auto& pair : m_entityStates) {
+        pair.second.turnFrequency = m_turnFrequency;
+    }
 }
 
 IdleBehavior::IdleMode IdleBehavior::getIdleMode() const {
@@ -147,16 +210,20 @@ float IdleBehavior::getIdleRadius() const {
 }
 
 std::shared_ptr<AIBehavior> IdleBehavior::clone() const {
-    return std::make_shared<IdleBehavior>(m_idleMode, m_idleRadius);
+    auto cloned = std::make_shared<IdleBehavior>(m_idleMode, m_idleRadius);
+    cloned->setMovementFrequency(m_movementFrequency);
+    cloned->setTurnFrequency(m_turnFrequency);
+    cloned->setActive(m_active);
+    return cloned;
 }
 
-void IdleBehavior::initializeEntityState(EntityPtr entity, EntityState& state) {
+void IdleBehavior::initializeEntityState(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng) {
     state.originalPosition = entity->getPosition();
     state.currentOffset = Vector2D(0, 0);
-    state.lastMovementTime = SDL_GetTicks();
-    state.lastTurnTime = SDL_GetTicks();
-    state.nextMovementTime = state.lastMovementTime + getRandomMovementInterval();
-    state.nextTurnTime = state.lastTurnTime + getRandomTurnInterval();
+    state.lastMovementTime = currentTime;
+    state.lastTurnTime = currentTime;
+    state.nextMovementTime = state.lastMovementTime + getRandomMovementInterval(state, rng);
+    state.nextTurnTime = state.lastTurnTime + getRandomTurnInterval(state, rng);
     state.currentAngle = 0.0f;
     state.initialized = true;
 }
@@ -166,28 +233,24 @@ void IdleBehavior::updateStationary(EntityPtr entity, EntityState& /* state */)
     entity->setVelocity(Vector2D(0, 0));
 }
 
-void IdleBehavior::updateSubtleSway(EntityPtr entity, EntityState& state) {
-    Uint64 currentTime = SDL_GetTicks();
-    
-    if (m_movementFrequency > 0.0f && currentTime >= state.nextMovementTime) {
+void IdleBehavior::updateSubtleSway(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng) {
+    if (state.movementFrequency > 0.0f && currentTime >= state.nextMovementTime) {
         // Generate gentle swaying direction
-        Vector2D swayDirection = generateRandomOffset();
+        Vector2D swayDirection = generateRandomOffset(rng);
         swayDirection.normalize();
         entity->setVelocity(swayDirection * 20.0f); // Gentle sway speed
         state.lastMovementTime = currentTime;
-        state.nextMovementTime = currentTime + getRandomMovementInterval();
+        state.nextMovementTime = currentTime + getRandomMovementInterval(state, rng);
     }
     // Keep velocity applied for smooth animation - don't reset to zero
 }
 
-void IdleBehavior::updateOccasionalTurn(EntityPtr entity, EntityState& state) {
-    Uint64 currentTime = SDL_GetTicks();
-    
-    if (m_turnFrequency > 0.0f && currentTime >= state.nextTurnTime) {
+void IdleBehavior::updateOccasionalTurn(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng) {
+    if (state.turnFrequency > 0.0f && currentTime >= state.nextTurnTime) {
         // Change facing direction
-        state.currentAngle = m_angleDistribution(m_rng);
+        state.currentAngle = rng.angle();
         state.lastTurnTime = currentTime;
-        state.nextTurnTime = currentTime + getRandomTurnInterval();
+        state.nextTurnTime = currentTime + getRandomTurnInterval(state, rng);
         
         // Note: In a full implementation, you might set entity rotation here
         // entity->setRotation(state.currentAngle);
@@ -197,31 +260,29 @@ void IdleBehavior::updateOccasionalTurn(EntityPtr entity, EntityState& state) {
     entity->setVelocity(Vector2D(0, 0));
 }
 
-void IdleBehavior::updateLightFidget(EntityPtr entity, EntityState& state) {
-    Uint64 currentTime = SDL_GetTicks();
-    
+void IdleBehavior::updateLightFidget(EntityPtr entity, EntityState& state, Uint64 currentTime, AIRandom& rng) {
     // Handle movement fidgeting
-    if (m_movementFrequency > 0.0f && currentTime >= state.nextMovementTime) {
+    if (state.movementFrequency > 0.0f && currentTime >= state.nextMovementTime) {
         // Generate light fidgeting direction
-        Vector2D fidgetDirection = generateRandomOffset();
+        Vector2D fidgetDirection = generateRandomOffset(rng);
         fidgetDirection.normalize();
         entity->setVelocity(fidgetDirection * 25.0f); // Light fidget speed
         state.lastMovementTime = currentTime;
-        state.nextMovementTime = currentTime + getRandomMovementInterval();
+        state.nextMovementTime = currentTime + getRandomMovementInterval(state, rng);
     }
     // Keep velocity applied for smooth animation
     
     // Handle turning
-    if (m_turnFrequency > 0.0f && currentTime >= state.nextTurnTime) {
-        state.currentAngle = m_angleDistribution(m_rng);
+    if (state.turnFrequency > 0.0f && currentTime >= state.nextTurnTime) {
+        state.currentAngle = rng.angle();
         state.lastTurnTime = currentTime;
-        state.nextTurnTime = currentTime + getRandomTurnInterval();
+        state.nextTurnTime = currentTime + getRandomTurnInterval(state, rng);
     }
 }
 
-Vector2D IdleBehavior::generateRandomOffset() const {
-    float angle = m_angleDistribution(m_rng);
-    float radius = m_radiusDistribution(m_rng) * m_idleRadius;
+Vector2D IdleBehavior::generateRandomOffset(AIRandom& rng) const {
+    float angle = rng.angle();
+    float radius = rng.nextFloat() * m_idleRadius;
     
     return Vector2D(
         radius * std::cos(angle),
@@ -229,20 +290,20 @@ Vector2D IdleBehavior::generateRandomOffset() const {
     );
 }
 
-Uint64 IdleBehavior::getRandomMovementInterval() const {
-    if (m_movementFrequency <= 0.0f) return UINT64_MAX;
+Uint64 IdleBehavior::getRandomMovementInterval(const EntityState& state, AIRandom& rng) const {
+    if (state.movementFrequency <= 0.0f) return UINT64_MAX;
     
-    float baseInterval = 1000.0f / m_movementFrequency; // Convert to milliseconds
-    float variation = m_frequencyVariation(m_rng);
+    float baseInterval = 1000.0f / state.movementFrequency; // Convert to milliseconds
+    float variation = rng.range(0.5f, 1.5f);
     
     return static_cast<Uint64>(baseInterval * variation);
 }
 
-Uint64 IdleBehavior::getRandomTurnInterval() const {
-    if (m_turnFrequency <= 0.0f) return UINT64_MAX;
+Uint64 IdleBehavior::getRandomTurnInterval(const EntityState& state, AIRandom& rng) const {
+    if (state.turnFrequency <= 0.0f) return UINT64_MAX;
     
-    float baseInterval = 1000.0f / m_turnFrequency; // Convert to milliseconds
-    float variation = m_frequencyVariation(m_rng);
+    float baseInterval = 1000.0f / state.turnFrequency; // Convert to milliseconds
+    float variation = rng.range(0.5f, 1.5f);
     
     return static_cast<Uint64>(baseInterval * variation);
 }
\ No newline at end of file
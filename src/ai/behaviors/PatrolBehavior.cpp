@@ -9,7 +9,6 @@
 #include <algorithm>
 #include <cmath>
 #include <random>
-#include <chrono>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -24,7 +23,7 @@ PatrolBehavior::PatrolBehavior(const std::vector<Vector2D>& waypoints, float mov
       m_needsReset(false),
       m_screenWidth(1280.0f),
       m_screenHeight(720.0f),
-      m_rng(std::random_device{}()) {
+      m_randomSeed(std::random_device{}()) {
     // Reserve capacity for typical patrol routes (performance optimization)
     m_waypoints.reserve(10);
 
@@ -44,7 +43,7 @@ PatrolBehavior::PatrolBehavior(PatrolMode mode, float moveSpeed, bool includeOff
       m_needsReset(false),
       m_screenWidth(1280.0f),
       m_screenHeight(720.0f),
-      m_rng(std::random_device{}()) {
+      m_randomSeed(std::random_device{}()) {
     // Set up the behavior based on the mode
     setupModeDefaults(mode, m_screenWidth, m_screenHeight);
 }
@@ -100,7 +99,7 @@ void PatrolBehavior::executeLogic(EntityPtr entity) {
 
         // Check if we've completed a full cycle and need to regenerate waypoints
         if (m_currentWaypoint == 0 && m_autoRegenerate && m_patrolMode != PatrolMode::FIXED_WAYPOINTS) {
-            regenerateRandomWaypoints();
+            regenerateRandomWaypoints(entity->getHandle());
         }
 
         targetWaypoint = m_waypoints[m_currentWaypoint];
@@ -111,8 +110,9 @@ void PatrolBehavior::executeLogic(EntityPtr entity) {
         }
     }
 
-    // Get the direction to the current waypoint
-    Vector2D direction = targetWaypoint - position;
+    // Get the direction to the current waypoint, or to the next corner of
+    // the route around whatever is in the way
+    Vector2D direction = nextPathPoint(position, targetWaypoint) - position;
 
     // Normalize direction if not zero
     float length = direction.length();
@@ -147,32 +147,53 @@ void PatrolBehavior::clean(EntityPtr entity) {
 
     // Reset internal state
     m_needsReset = false;
+    resetPath();
 }
 
-void PatrolBehavior::onMessage(EntityPtr entity, const std::string& message) {
-    if (message == "pause") {
-        setActive(false);
-        if (entity) {
-            entity->setVelocity(Vector2D(0, 0));
-        }
-    } else if (message == "resume") {
-        setActive(true);
-    } else if (message == "reverse") {
-        reverseWaypoints();
-    } else if (message == "release_entities") {
-        // Stop the entity and clean up when asked to release entities
-        if (entity) {
-            entity->setVelocity(Vector2D(0, 0));
-
-            // Re-enable bounds checking
-            NPC* npc = dynamic_cast<NPC*>(entity.get());
-            if (npc) {
-                npc->setBoundsCheckEnabled(true);
+void PatrolBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
+    switch (message.id) {
+        case AIMessages::PAUSE:
+            setActive(false);
+            if (entity) {
+                entity->setVelocity(Vector2D(0, 0));
+            }
+            break;
+        case AIMessages::RESUME:
+            setActive(true);
+            break;
+        case AIMessages::REVERSE:
+            reverseWaypoints();
+            break;
+        case AIMessages::RELEASE_ENTITIES:
+            // Stop the entity and clean up when asked to release entities
+            if (entity) {
+                entity->setVelocity(Vector2D(0, 0));
+
+                // Re-enable bounds checking
+                NPC* npc = dynamic_cast<NPC*>(entity.get());
+                if (npc) {
+                    npc->setBoundsCheckEnabled(true);
+                }
             }
-        }
 
-        // Reset internal state
-        m_needsReset = false;
+            // Reset internal state
+            m_needsReset = false;
+            resetPath();
+            break;
+        default:
+            break;
+    }
+}
+
+bool PatrolBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::PAUSE:
+        case AIMessages::RESUME:
+        case AIMessages::REVERSE:
+        case AIMessages::RELEASE_ENTITIES:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -197,6 +218,8 @@ std::shared_ptr<AIBehavior> PatrolBehavior::clone() const {
     cloned->m_minWaypointDistance = m_minWaypointDistance;
     cloned->m_eventTarget = m_eventTarget;
     cloned->m_eventTargetRadius = m_eventTargetRadius;
+    cloned->m_randomSeed = m_randomSeed;
+    cloned->m_usePathfinding = m_usePathfinding;
 
     return cloned;
 }
@@ -253,6 +276,9 @@ bool PatrolBehavior::isWellOffscreen(const Vector2D& position) const {
 void PatrolBehavior::resetEntityPosition(EntityPtr entity) {
     if (!entity) return;
 
+    // Any route was planned from where the entity used to be
+    resetPath();
+
     // Find an onscreen waypoint to teleport to
     for (size_t i = 0; i < m_waypoints.size(); i++) {
         size_t index = (m_currentWaypoint + i) % m_waypoints.size();
@@ -323,14 +349,18 @@ void PatrolBehavior::updateEventTarget(const Vector2D& newTarget) {
 
 // Utility methods
 void PatrolBehavior::regenerateRandomWaypoints() {
+    regenerateRandomWaypoints(EntityHandle{});
+}
+
+void PatrolBehavior::regenerateRandomWaypoints(EntityHandle handle) {
     if (m_patrolMode == PatrolMode::RANDOM_AREA) {
         if (m_useCircularArea) {
-            generateRandomWaypointsInCircle();
+            generateRandomWaypointsInCircle(handle);
         } else {
-            generateRandomWaypointsInRectangle();
+            generateRandomWaypointsInRectangle(handle);
         }
     } else if (m_patrolMode == PatrolMode::EVENT_TARGET) {
-        generateWaypointsAroundTarget();
+        generateWaypointsAroundTarget(handle);
     }
     m_currentWaypoint = 0;
 }
@@ -348,13 +378,78 @@ void PatrolBehavior::setMinWaypointDistance(float distance) {
 }
 
 void PatrolBehavior::setRandomSeed(unsigned int seed) {
-    m_rng.seed(seed);
-    m_seedSet = true;
+    m_randomSeed = seed;
+    m_waypointGeneration = 0;
+}
+
+void PatrolBehavior::setUsePathfinding(bool usePathfinding) {
+    m_usePathfinding = usePathfinding;
+    if (!usePathfinding) {
+        resetPath();
+    }
+}
+
+Vector2D PatrolBehavior::nextPathPoint(const Vector2D& position, const Vector2D& waypoint) {
+    if (!m_usePathfinding) {
+        return waypoint;
+    }
+    PathfindingManager& pathfinding = PathfindingManager::Instance();
+    if (!pathfinding.hasGrid()) {
+        return waypoint;
+    }
+
+    // New leg: ask for a route and head straight for the waypoint until it arrives
+    if (!m_hasPathGoal || (waypoint - m_pathGoal).lengthSquared() > 1.0f) {
+        resetPath();
+        m_pathRequest = pathfinding.requestPath(position, waypoint);
+        m_pathGoal = waypoint;
+        m_hasPathGoal = true;
+    }
+
+    if (m_pathRequest.isValid()) {
+        PathStatus status = pathfinding.getPathStatus(m_pathRequest);
+        if (status == PathStatus::Pending) {
+            return waypoint;
+        }
+        // Ready, or Failed and walked in a straight line; either way the request is done
+        if (status == PathStatus::Ready) {
+            pathfinding.getPath(m_pathRequest, m_path);
+        }
+        pathfinding.releasePath(m_pathRequest);
+        m_pathRequest = PathRequestHandle{};
+    }
+
+    if (m_path.empty()) {
+        return waypoint;
+    }
+    // Corners are passed closer than waypoints so the entity does not clip them
+    const float cornerRadius = m_waypointRadius * 0.5f;
+    while (m_pathIndex + 1 < m_path.size() &&
+           (position - m_path[m_pathIndex]).lengthSquared() < cornerRadius * cornerRadius) {
+        ++m_pathIndex;
+    }
+    return m_path[m_pathIndex];
+}
+
+void PatrolBehavior::resetPath() {
+    if (m_pathRequest.isValid()) {
+        PathfindingManager::Instance().releasePath(m_pathRequest);
+        m_pathRequest = PathRequestHandle{};
+    }
+    m_path.clear();
+    m_pathIndex = 0;
+    m_hasPathGoal = false;
+}
+
+AIRandom PatrolBehavior::waypointRandom(EntityHandle handle) {
+    // Each set of waypoints gets a fresh sequence; regenerating for an
+    // entity keys it by that entity, so clones of one template diverge
+    return AIRandom(m_randomSeed, handle, m_waypointGeneration++, 0);
 }
 
 // Private helper methods
-void PatrolBehavior::generateRandomWaypointsInRectangle() {
-    ensureRandomSeed();
+void PatrolBehavior::generateRandomWaypointsInRectangle(EntityHandle handle) {
+    AIRandom rng = waypointRandom(handle);
     m_waypoints.clear();
 
     // Generate waypoints with minimum distance constraints
@@ -364,7 +459,7 @@ void PatrolBehavior::generateRandomWaypointsInRectangle() {
         const int maxAttempts = 50;
 
         do {
-            newPoint = generateRandomPointInRectangle();
+            newPoint = generateRandomPointInRectangle(rng);
             attempts++;
         } while (!isValidWaypointDistance(newPoint) && attempts < maxAttempts);
 
@@ -381,8 +476,8 @@ void PatrolBehavior::generateRandomWaypointsInRectangle() {
     }
 }
 
-void PatrolBehavior::generateRandomWaypointsInCircle() {
-    ensureRandomSeed();
+void PatrolBehavior::generateRandomWaypointsInCircle(EntityHandle handle) {
+    AIRandom rng = waypointRandom(handle);
     m_waypoints.clear();
 
     // Generate waypoints with minimum distance constraints
@@ -392,7 +487,7 @@ void PatrolBehavior::generateRandomWaypointsInCircle() {
         const int maxAttempts = 50;
 
         do {
-            newPoint = generateRandomPointInCircle();
+            newPoint = generateRandomPointInCircle(rng);
             attempts++;
         } while (!isValidWaypointDistance(newPoint) && attempts < maxAttempts);
 
@@ -407,8 +502,8 @@ void PatrolBehavior::generateRandomWaypointsInCircle() {
     }
 }
 
-void PatrolBehavior::generateWaypointsAroundTarget() {
-    ensureRandomSeed();
+void PatrolBehavior::generateWaypointsAroundTarget(EntityHandle handle) {
+    AIRandom rng = waypointRandom(handle);
     m_waypoints.clear();
 
     // Generate waypoints in a circle around the target
@@ -418,8 +513,7 @@ void PatrolBehavior::generateWaypointsAroundTarget() {
         float angle = i * angleStep;
 
         // Add some randomness to the radius (between 0.7 and 1.0 of target radius)
-        std::uniform_real_distribution<float> radiusDist(0.7f, 1.0f);
-        float randomRadius = m_eventTargetRadius * radiusDist(m_rng);
+        float randomRadius = m_eventTargetRadius * rng.range(0.7f, 1.0f);
 
         Vector2D waypoint = m_eventTarget + Vector2D(
             std::cos(angle) * randomRadius,
@@ -437,20 +531,16 @@ void PatrolBehavior::generateWaypointsAroundTarget() {
     }
 }
 
-Vector2D PatrolBehavior::generateRandomPointInRectangle() const {
-    std::uniform_real_distribution<float> xDist(m_areaTopLeft.getX(), m_areaBottomRight.getX());
-    std::uniform_real_distribution<float> yDist(m_areaTopLeft.getY(), m_areaBottomRight.getY());
-
-    return Vector2D(xDist(m_rng), yDist(m_rng));
+Vector2D PatrolBehavior::generateRandomPointInRectangle(AIRandom& rng) const {
+    float x = rng.range(m_areaTopLeft.getX(), m_areaBottomRight.getX());
+    float y = rng.range(m_areaTopLeft.getY(), m_areaBottomRight.getY());
+    return Vector2D(x, y);
 }
 
-Vector2D PatrolBehavior::generateRandomPointInCircle() const {
+Vector2D PatrolBehavior::generateRandomPointInCircle(AIRandom& rng) const {
     // Generate random point in circle using polar coordinates
-    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-    std::uniform_real_distribution<float> radiusDist(0.0f, 1.0f);
-
-    float angle = angleDist(m_rng);
-    float radius = std::sqrt(radiusDist(m_rng)) * m_areaRadius; // sqrt for uniform distribution
+    float angle = rng.angle();
+    float radius = std::sqrt(rng.nextFloat()) * m_areaRadius; // sqrt for uniform distribution
 
     return m_areaCenter + Vector2D(
         std::cos(angle) * radius,
@@ -466,13 +556,6 @@ bool PatrolBehavior::isValidWaypointDistance(const Vector2D& newPoint) const {
         });
 }
 
-void PatrolBehavior::ensureRandomSeed() const {
-    if (!m_seedSet) {
-        // Use a more deterministic seed for testing, but still random
-        m_rng.seed(std::chrono::steady_clock::now().time_since_epoch().count());
-    }
-}
-
 void PatrolBehavior::setupModeDefaults(PatrolMode mode, float screenWidth, float screenHeight) {
     m_patrolMode = mode;
     m_screenWidth = screenWidth;
@@ -4,14 +4,23 @@
 */
 
 #include "ai/behaviors/WanderBehavior.hpp"
+#include "managers/AIManager.hpp"
 
 #include <algorithm>
 #include <cmath>
 
+namespace {
+
+// AIRandom streams, one per kind of decision
+constexpr uint16_t STREAM_INIT = 1;
+constexpr uint16_t STREAM_UPDATE = 2;
+constexpr uint16_t STREAM_MESSAGE = 3;
+
+} // namespace
+
 WanderBehavior::WanderBehavior(float speed, float changeDirectionInterval, float areaRadius)
     : m_speed(speed), m_changeDirectionInterval(changeDirectionInterval), m_areaRadius(areaRadius),
       m_minimumFlipInterval(400) {
-    // Random number generators are already initialized in class definition
 }
 
 WanderBehavior::WanderBehavior(WanderMode mode, float speed)
@@ -23,55 +32,66 @@ WanderBehavior::WanderBehavior(WanderMode mode, float speed)
 void WanderBehavior::init(EntityPtr entity) {
     if (!entity) return;
 
-    // Store initial position as center point
-    m_centerPoint = entity->getPosition();
-
     // Create entity state if it doesn't exist
-    auto [it, inserted] = m_entityStates.try_emplace(entity, EntityState{});
+    auto [it, inserted] = m_entityStates.try_emplace(entity->getHandle(), EntityState{});
+    EntityState& state = it->second;
+    const FrameContext context = AIManager::Instance().getFrameContext();
+    AIRandom rng(context, entity->getHandle(), STREAM_INIT);
     if (inserted) {
         // Generate a random start delay between 0 and 5000 milliseconds
-        std::uniform_int_distribution<Uint64> delayDist(0, 5000);
-        it->second.startDelay = delayDist(m_rng);
-        it->second.movementStarted = false;
+        state.startDelay = rng.below(5001);
+        state.movementStarted = false;
     }
 
+    // Store initial position as this entity's center point
+    state.centerPoint = entity->getPosition();
+
     // Record start time for direction changes
-    m_entityStates[entity].lastDirectionChangeTime = SDL_GetTicks();
+    state.lastDirectionChangeTime = context.timeMs;
 
     // Set initial random direction but with zero velocity until delay expires
-    chooseNewDirection(entity);
-    if (m_entityStates[entity].startDelay > 0) {
+    chooseNewDirection(entity, state, rng);
+    if (state.startDelay > 0) {
         // Set zero velocity until delay expires
         entity->setVelocity(Vector2D(0, 0));
     }
 }
 
 void WanderBehavior::executeLogic(EntityPtr entity) {
-    if (!entity || !m_active) return;
-
+    executeLogic(entity, AIManager::Instance().getFrameContext());
+}
 
+void WanderBehavior::executeLogic(EntityPtr entity, const FrameContext& context) {
+    if (!entity || !m_active) return;
 
-    // Create entity state if it doesn't exist
-    auto [it, inserted] = m_entityStates.try_emplace(entity, EntityState{});
-    if (inserted) {
-        it->second.lastDirectionChangeTime = SDL_GetTicks();
+    // States are created in init(); inserting here could race with other
+    // workers running this shared instance
+    auto it = m_entityStates.find(entity->getHandle());
+    if (it == m_entityStates.end()) return;
 
-        // Generate a random start delay between 0 and 5000 milliseconds
-        std::uniform_int_distribution<Uint64> delayDist(0, 5000);
-        it->second.startDelay = delayDist(m_rng);
-        it->second.movementStarted = false;
+    updateEntity(entity, it->second, context);
+}
 
-        chooseNewDirection(entity);
-        // Set zero velocity until delay expires
-        entity->setVelocity(Vector2D(0, 0));
+void WanderBehavior::executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) {
+    if (!m_active) return;
 
+    for (const EntityPtr& entity : entities) {
+        if (!entity) continue;
+        auto it = m_entityStates.find(entity->getHandle());
+        if (it != m_entityStates.end()) {
+            updateEntity(entity, it->second, context);
+        }
     }
+}
+
+void WanderBehavior::updateEntity(EntityPtr entity, EntityState& state, const FrameContext& context) {
+    if (state.paused) return;
 
-    // Get entity-specific state
-    EntityState& state = m_entityStates[entity];
+    // The frame's clock, so every entity of the frame sees the same time
+    const Uint64 currentTime = context.timeMs;
+    AIRandom rng(context, entity->getHandle(), STREAM_UPDATE);
 
-    // Get current time
-    Uint64 currentTime = SDL_GetTicks();
+    const float speed = m_speed * state.speedMultiplier;
 
     // Check if we need to wait for the start delay
     if (!state.movementStarted) {
@@ -79,7 +99,7 @@ void WanderBehavior::executeLogic(EntityPtr entity) {
             // Delay expired, start moving
             state.movementStarted = true;
             // Apply the initial direction with proper velocity
-            entity->setVelocity(state.currentDirection * m_speed);
+            entity->setVelocity(state.currentDirection * speed);
         } else {
             // Still waiting for delay to expire
             return;
@@ -92,8 +112,8 @@ void WanderBehavior::executeLogic(EntityPtr entity) {
     // Check if it's time to change direction
     if (currentTime - state.lastDirectionChangeTime > m_changeDirectionInterval) {
         // Decide whether to wander offscreen or stay within bounds
-        bool wanderOffscreen = !state.resetScheduled && m_wanderOffscreenChance(m_rng) < m_offscreenProbability;
-        chooseNewDirection(entity, wanderOffscreen);
+        bool wanderOffscreen = !state.resetScheduled && rng.nextFloat() < m_offscreenProbability;
+        chooseNewDirection(entity, state, rng, wanderOffscreen);
         state.lastDirectionChangeTime = currentTime;
     }
 
@@ -105,13 +125,13 @@ void WanderBehavior::executeLogic(EntityPtr entity) {
         // Check if entity is far enough off screen to reset
         if (isWellOffscreen(position)) {
             // Reset to a random position near the opposite side of the screen
-            resetEntityPosition(entity);
+            resetEntityPosition(entity, state, rng);
             state.resetScheduled = false;
         }
     }
     else if (!state.currentlyWanderingOffscreen) {
         // Normal bounded wandering behavior
-        Vector2D toCenter = m_centerPoint - position;
+        Vector2D toCenter = state.centerPoint - position;
         float distanceFromCenter = toCenter.length();
 
         // If too far from center, adjust direction to return (unless we're wandering offscreen)
@@ -129,7 +149,7 @@ void WanderBehavior::executeLogic(EntityPtr entity) {
             state.currentDirection.normalize();
 
             // Apply the new direction
-            entity->setVelocity(state.currentDirection * m_speed);
+            entity->setVelocity(state.currentDirection * speed);
         }
     }
 
@@ -150,7 +170,7 @@ void WanderBehavior::executeLogic(EntityPtr entity) {
         // Create a new direction that doesn't cause a flip
         Vector2D stableVelocity(xDir * magnitude * 0.8f, yVal);
         stableVelocity.normalize();
-        stableVelocity = stableVelocity * m_speed;
+        stableVelocity = stableVelocity * speed;
 
         // Apply the stable velocity
         entity->setVelocity(stableVelocity);
@@ -166,41 +186,77 @@ void WanderBehavior::clean(EntityPtr entity) {
         entity->setVelocity(Vector2D(0, 0));
 
         // Remove entity state
-        m_entityStates.erase(entity);
+        m_entityStates.erase(entity->getHandle());
     } else {
         // If entity is null, clean up all entity states
         m_entityStates.clear();
     }
 }
 
-void WanderBehavior::onMessage(EntityPtr entity, const std::string& message) {
+void WanderBehavior::cleanupEntity(EntityPtr entity) {
+    if (entity) {
+        m_entityStates.erase(entity->getHandle());
+    }
+}
+
+void WanderBehavior::onMessage(EntityPtr entity, const AIMessage& message) {
     if (!entity) return;
 
+    auto it = m_entityStates.find(entity->getHandle());
+    if (it == m_entityStates.end()) return;
+    EntityState& state = it->second;
 
+    // Messages arrive with AIManager's entity lock held; only lock-free accessors here
+    const AIManager& aiMgr = AIManager::Instance();
+    AIRandom rng(aiMgr.getRandomSeed(), entity->getHandle(), aiMgr.getFrameNumber(), STREAM_MESSAGE);
 
-    if (message == "pause"){
-        setActive(false);
-        entity->setVelocity(Vector2D(0, 0));
-    } else if (message == "resume") {
-        setActive(true);
-        chooseNewDirection(entity);
-    } else if (message == "new_direction") {
-        chooseNewDirection(entity);
-    } else if (message == "increase_speed") {
-        m_speed *= 1.5f;
-        if (m_active && m_entityStates.find(entity) != m_entityStates.end()) {
-            entity->setVelocity(m_entityStates[entity].currentDirection * m_speed);
-        }
-    } else if (message == "decrease_speed") {
-        m_speed *= 0.75f;
-        if (m_active && m_entityStates.find(entity) != m_entityStates.end()) {
-            entity->setVelocity(m_entityStates[entity].currentDirection * m_speed);
-        }
-    } else if (message == "release_entities") {
-        // Clear all entity state when asked to release entities
-        entity->setVelocity(Vector2D(0, 0));
-        // Clean up entity state for this specific entity
-        m_entityStates.erase(entity);
+    // Messages only affect the receiving entity; other wanderers share this instance
+    switch (message.id) {
+        case AIMessages::PAUSE:
+            state.paused = true;
+            entity->setVelocity(Vector2D(0, 0));
+            break;
+        case AIMessages::RESUME:
+            state.paused = false;
+            chooseNewDirection(entity, state, rng);
+            break;
+        case AIMessages::NEW_DIRECTION:
+            chooseNewDirection(entity, state, rng);
+            break;
+        case AIMessages::INCREASE_SPEED:
+            state.speedMultiplier *= 1.5f;
+            if (m_active && !state.paused) {
+                entity->setVelocity(state.currentDirection * (m_speed * state.speedMultiplier));
+            }
+            break;
+        case AIMessages::DECREASE_SPEED:
+            state.speedMultiplier *= 0.75f;
+            if (m_active && !state.paused) {
+                entity->setVelocity(state.currentDirection * (m_speed * state.speedMultiplier));
+            }
+            break;
+        case AIMessages::RELEASE_ENTITIES:
+            // Stop the entity; its state goes with cleanupEntity(), since
+            // other workers may be reading the pool right now
+            state.paused = true;
+            entity->setVelocity(Vector2D(0, 0));
+            break;
+        default:
+            break;
+    }
+}
+
+bool WanderBehavior::acceptsMessage(AIMessageId id) const {
+    switch (id) {
+        case AIMessages::PAUSE:
+        case AIMessages::RESUME:
+        case AIMessages::NEW_DIRECTION:
+        case AIMessages::INCREASE_SPEED:
+        case AIMessages::DECREASE_SPEED:
+        case AIMessages::RELEASE_ENTITIES:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -220,6 +276,11 @@ std::shared_ptr<AIBehavior> WanderBehavior::clone() const {
 void WanderBehavior::setCenterPoint(const Vector2D& centerPoint) {
     m_centerPoint = centerPoint;
 
+    // Entities already wandering move to the new center too
+    for (auto& pair : m_entityStates) {
+        pair.second.centerPoint = centerPoint;
+    }
+
     // Estimate screen dimensions based on center point
     // (We'll assume the center is roughly in the middle of the screen)
     m_screenWidth = m_centerPoint.getX() * 2.0f;
@@ -255,12 +316,9 @@ bool WanderBehavior::isWellOffscreen(const Vector2D& position) const {
            position.getY() > m_screenHeight + buffer;
 }
 
-void WanderBehavior::resetEntityPosition(EntityPtr entity) {
+void WanderBehavior::resetEntityPosition(EntityPtr entity, EntityState& state, AIRandom& rng) {
     if (!entity) return;
 
-    // Ensure entity state exists
-    m_entityStates.try_emplace(entity, EntityState{});
-
     // Calculate entry point on the opposite side of the screen
     Vector2D position = entity->getPosition();
     Vector2D newPosition(0.0f, 0.0f);
@@ -269,32 +327,29 @@ void WanderBehavior::resetEntityPosition(EntityPtr entity) {
     if (position.getX() < 0) {
         // Went off left side, come in from right
         newPosition.setX(m_screenWidth - 50.0f);
-        newPosition.setY(m_wanderOffscreenChance(m_rng) * m_screenHeight);
+        newPosition.setY(rng.nextFloat() * m_screenHeight);
     } else if (position.getX() > m_screenWidth) {
         // Went off right side, come in from left
         newPosition.setX(50.0f);
-        newPosition.setY(m_wanderOffscreenChance(m_rng) * m_screenHeight);
+        newPosition.setY(rng.nextFloat() * m_screenHeight);
     } else if (position.getY() < 0) {
         // Went off top, come in from bottom
-        newPosition.setX(m_wanderOffscreenChance(m_rng) * m_screenWidth);
+        newPosition.setX(rng.nextFloat() * m_screenWidth);
         newPosition.setY(m_screenHeight - 50.0f);
     } else {
         // Went off bottom, come in from top
-        newPosition.setX(m_wanderOffscreenChance(m_rng) * m_screenWidth);
+        newPosition.setX(rng.nextFloat() * m_screenWidth);
         newPosition.setY(50.0f);
     }
 
     // Set new position and choose a new direction
     entity->setPosition(newPosition);
-    chooseNewDirection(entity, false);
+    chooseNewDirection(entity, state, rng, false);
 }
 
-void WanderBehavior::chooseNewDirection(EntityPtr entity, bool wanderOffscreen) {
+void WanderBehavior::chooseNewDirection(EntityPtr entity, EntityState& state, AIRandom& rng, bool wanderOffscreen) {
     if (!entity) return;
 
-    // Get entity-specific state
-    EntityState& state = m_entityStates[entity];
-
     // Track if we're currently wandering offscreen
     state.currentlyWanderingOffscreen = wanderOffscreen;
 
@@ -326,9 +381,9 @@ void WanderBehavior::chooseNewDirection(EntityPtr entity, bool wanderOffscreen)
         }
 
         // Add some randomness to the direction
-        float randomAngle = (m_angleDistribution(m_rng) - M_PI) * 0.2f; // Small angle variation
-        float x = state.currentDirection.getX() * std::cos(randomAngle) - state.currentDirection.getY() * std::sin(randomAngle);
-        float y = state.currentDirection.getX() * std::sin(randomAngle) + state.currentDirection.getY() * std::cos(randomAngle);
+        float angleJitter = (rng.angle() - M_PI) * 0.2f; // Small angle variation
+        float x = state.currentDirection.getX() * std::cos(angleJitter) - state.currentDirection.getY() * std::sin(angleJitter);
+        float y = state.currentDirection.getX() * std::sin(angleJitter) + state.currentDirection.getY() * std::cos(angleJitter);
         state.currentDirection = Vector2D(x, y);
         state.currentDirection.normalize();
 
@@ -336,7 +391,7 @@ void WanderBehavior::chooseNewDirection(EntityPtr entity, bool wanderOffscreen)
         state.resetScheduled = true;
     } else {
         // Generate a random angle
-        float angle = m_angleDistribution(m_rng);
+        float angle = rng.angle();
 
         // Convert angle to direction vector
         float x = std::cos(angle);
@@ -348,7 +403,7 @@ void WanderBehavior::chooseNewDirection(EntityPtr entity, bool wanderOffscreen)
 
     // Apply the new direction to the entity only if movement has started
     if (applyVelocity) {
-        entity->setVelocity(state.currentDirection * m_speed);
+        entity->setVelocity(state.currentDirection * (m_speed * state.speedMultiplier));
     }
 
     // NPC class now handles sprite flipping based on velocity
@@ -6,6 +6,7 @@
 #include "core/GameEngine.hpp"
 #include "core/Logger.hpp"
 #include "core/GameLoop.hpp" // IWYU pragma: keep - Required for GameLoop weak_ptr declaration
+#include "core/TraceRecorder.hpp"
 #include "core/WorkerBudget.hpp"
 #include <vector>
 #include <chrono>
@@ -16,6 +17,8 @@
 #include <thread>
 #include "SDL3/SDL_surface.h"
 #include "managers/AIManager.hpp"
+#include "managers/FormationManager.hpp"
+#include "managers/PathfindingManager.hpp"
 #include "gameStates/AIDemoState.hpp"
 #include "gameStates/AdvancedAIDemoState.hpp"
 #include "gameStates/EventDemoState.hpp"
@@ -410,6 +413,11 @@ texMgr.load(std::string(textureResPath), std::string(texturePrefix), mp_renderer
           return false;
         }
         GAMEENGINE_INFO("AI Manager initialized successfully");
+
+        // Behaviors request paths from here once a state sets a grid, and
+        // escorts share their formations through FormationManager
+        PathfindingManager::Instance().init();
+        FormationManager::Instance().init();
         return true;
       }));
 
@@ -572,33 +580,10 @@ float GameEngine::getCurrentFPS() const {
 }
 
 void GameEngine::update([[maybe_unused]] float deltaTime) {
+  HAMMER_TRACE_ZONE("GameEngine::update");
   // This method is now thread-safe and can be called from a worker thread
   std::lock_guard<std::mutex> lock(m_updateMutex);
 
-  // Use WorkerBudget system for coordinated task submission
-  if (Hammer::ThreadSystem::Exists()) {
-    auto& threadSystem = Hammer::ThreadSystem::Instance();
-
-    // Calculate worker budget for this frame
-    size_t availableWorkers = static_cast<size_t>(threadSystem.getThreadCount());
-    Hammer::WorkerBudget budget = Hammer::calculateWorkerBudget(availableWorkers);
-
-    // Submit engine coordination tasks respecting our worker budget
-    // Use high priority for engine tasks to ensure timely processing
-    threadSystem.enqueueTask([this, deltaTime]() {
-      // Critical game engine coordination
-      processEngineCoordination(deltaTime);
-    }, Hammer::TaskPriority::High, "GameEngine_Coordination");
-
-    // Only submit additional tasks if we have multiple workers allocated
-    if (budget.engineReserved > 1) {
-      threadSystem.enqueueTask([this]() {
-        // Secondary engine tasks (resource management, cleanup, etc.)
-        processEngineSecondaryTasks();
-      }, Hammer::TaskPriority::Normal, "GameEngine_Secondary");
-    }
-  }
-
   // Mark update as running with relaxed ordering (protected by mutex)
   m_updateRunning.store(true, std::memory_order_relaxed);
 
@@ -608,49 +593,20 @@ void GameEngine::update([[maybe_unused]] float deltaTime) {
   try {
     // HYBRID MANAGER UPDATE ARCHITECTURE
     // =====================================
-    // HYBRID MANAGER UPDATE ARCHITECTURE - Step 1: Global Updates (No Caching)
-    // =====================================
-    // Core engine systems are updated globally for optimal performance and consistency
-    // State-specific systems are updated by individual states for flexibility and efficiency
-
-    // GLOBAL SYSTEMS (Updated by GameEngine):
-    // - AIManager: World simulation with 10K+ entities, benefits from consistent global updates
-    // - EventManager: Global game events (weather, scene changes), batch processing optimization
-    // - InputManager: Handled in handleEvents() for proper SDL event polling architecture
-
-    // AI system - manages world entities across all states (cached reference access)
-    if (mp_aiManager) {
-      try {
-        mp_aiManager->update(deltaTime);
-      } catch (const std::exception& e) {
-        GAMEENGINE_ERROR("AIManager exception: " + std::string(e.what()));
-      } catch (...) {
-        GAMEENGINE_ERROR("AIManager unknown exception");
-      }
-    } else {
-      GAMEENGINE_ERROR("AIManager cache is null!");
+    // Core engine systems are updated globally through the frame task graph;
+    // state-specific systems are updated by individual states.
+    // Independent stages run concurrently on the ThreadSystem and execute()
+    // returns only when every stage of this frame has finished.
+    if (m_frameGraph.getStageCount() == 0) {
+      buildFrameGraph();
     }
+    m_frameGraph.execute(deltaTime);
 
-    // Event system - global game events and world simulation (cached reference access)
-    if (mp_eventManager) {
-      try {
-        mp_eventManager->update();
-      } catch (const std::exception& e) {
-        GAMEENGINE_ERROR("EventManager exception: " + std::string(e.what()));
-      } catch (...) {
-        GAMEENGINE_ERROR("EventManager unknown exception");
-      }
-    } else {
-      GAMEENGINE_ERROR("EventManager cache is null!");
+    // Feed this frame's measured AI/event load into the adaptive worker budget
+    if (Hammer::ThreadSystem::Exists()) {
+      Hammer::ThreadSystem::Instance().getWorkerBudgetController().endFrame();
     }
 
-    // STATE-MANAGED SYSTEMS (Updated by individual states):
-    // - UIManager: Optional, state-specific, only updated when UI is actually used
-    // See UIExampleState::update() for proper state-managed pattern
-
-    // Update game states - states handle their specific system needs
-    mp_gameStateManager->update(deltaTime);
-
     // Increment the frame counter atomically for thread-safe render synchronization
     m_lastUpdateFrame.fetch_add(1, std::memory_order_relaxed);
 
@@ -672,7 +628,86 @@ void GameEngine::update([[maybe_unused]] float deltaTime) {
   m_bufferCondition.notify_all();
 }
 
+void GameEngine::buildFrameGraph() {
+  // Resources shared between stages:
+  // - "Entities":    AI-managed world entities (and the player they track)
+  // - "Events":      EventManager event storage
+  // - "GameState":   active game states and state-managed systems (UI)
+  // - "EngineState": engine coordination bookkeeping
+
+  // Engine coordination tasks respect the WorkerBudget engine reservation
+  m_frameGraph.addStage("GameEngine_Coordination", [this](float deltaTime) {
+    processEngineCoordination(deltaTime);
+  }, {}, {"EngineState"}, Hammer::TaskPriority::High);
+
+  size_t availableWorkers = Hammer::ThreadSystem::Exists()
+      ? static_cast<size_t>(Hammer::ThreadSystem::Instance().getThreadCount()) : 0;
+  Hammer::WorkerBudget budget = Hammer::calculateWorkerBudget(availableWorkers);
+  if (budget.engineReserved > 1) {
+    m_frameGraph.addStage("GameEngine_Secondary", [this](float) {
+      processEngineSecondaryTasks();
+    }, {"EngineState"}, {}, Hammer::TaskPriority::Normal);
+  }
+
+  // AI system - world entities across all states (cached reference access)
+  m_frameGraph.addStage("AI_Update", [this](float deltaTime) {
+    if (!mp_aiManager) {
+      GAMEENGINE_ERROR("AIManager cache is null!");
+      return;
+    }
+    try {
+      // Dispatch path searches first so they run alongside the AI batches.
+      // The flow field follows the player and is shared by every chaser.
+      PathfindingManager& pathfinding = PathfindingManager::Instance();
+      if (EntityPtr player = mp_aiManager->getPlayerReference()) {
+        pathfinding.setFlowFieldGoal(player->getPosition());
+      } else {
+        pathfinding.clearFlowFieldGoal();
+      }
+      pathfinding.update();
+      mp_aiManager->setPlayerFlowField(pathfinding.getFlowField());
+      // Blocked cells also block sight in the AI perception pass
+      mp_aiManager->setPerceptionGrid(pathfinding.getGrid());
+      // Formation slots move with their leaders before any follower reads them
+      FormationManager& formations = FormationManager::Instance();
+      formations.update();
+      mp_aiManager->setFormations(formations.getSnapshot());
+      mp_aiManager->update(deltaTime);
+    } catch (const std::exception& e) {
+      GAMEENGINE_ERROR("AIManager exception: " + std::string(e.what()));
+    } catch (...) {
+      GAMEENGINE_ERROR("AIManager unknown exception");
+    }
+  }, {}, {"Entities"}, Hammer::TaskPriority::High);
+
+  // Event system - global game events, independent of the AI stage
+  m_frameGraph.addStage("Event_Update", [this](float) {
+    if (!mp_eventManager) {
+      GAMEENGINE_ERROR("EventManager cache is null!");
+      return;
+    }
+    try {
+      mp_eventManager->update();
+    } catch (const std::exception& e) {
+      GAMEENGINE_ERROR("EventManager exception: " + std::string(e.what()));
+    } catch (...) {
+      GAMEENGINE_ERROR("EventManager unknown exception");
+    }
+  }, {}, {"Events"}, Hammer::TaskPriority::High);
+
+  // Game states see this frame's AI and event results; kept on the update
+  // thread because states drive state-managed systems such as the UI
+  m_frameGraph.addStage("GameState_Update", [this](float deltaTime) {
+    mp_gameStateManager->update(deltaTime);
+  }, {"Events"}, {"Entities", "GameState"}, Hammer::TaskPriority::High, true);
+
+  m_frameGraph.compile();
+  GAMEENGINE_INFO("Frame task graph built: " + std::to_string(m_frameGraph.getStageCount()) +
+                  " stages, critical path depth " + std::to_string(m_frameGraph.getCriticalPathDepth()));
+}
+
 void GameEngine::render() {
+  HAMMER_TRACE_ZONE("GameEngine::render");
   // Always on MAIN thread as its an - SDL REQUIREMENT
   std::lock_guard<std::mutex> lock(m_renderMutex);
 
@@ -907,6 +942,12 @@ void GameEngine::clean() {
   GAMEENGINE_INFO("Cleaning up AI Manager...");
   aiMgr.clean();
 
+  GAMEENGINE_INFO("Cleaning up Pathfinding Manager...");
+  PathfindingManager::Instance().clean();
+
+  GAMEENGINE_INFO("Cleaning up Formation Manager...");
+  FormationManager::Instance().clean();
+
   GAMEENGINE_INFO("Cleaning up Save Game Manager...");
   saveMgr.clean();
 
@@ -25,7 +25,6 @@ NPC::NPC(const std::string& textureID, const Vector2D& startPosition, int frameW
     m_numFrames = 2;                    // Default to 2 frames for simple animation
     m_animSpeed = 100;                  // Default animation speed in milliseconds
     m_spriteSheetRows = 1;              // Default number of rows in the sprite sheet
-    m_lastFrameTime = SDL_GetTicks();   // Track when we last changed animation frame
     m_flip = SDL_FLIP_NONE;             // Default flip direction
 
     // Load dimensions from texture if not provided
@@ -150,15 +149,15 @@ void NPC::update(float deltaTime) {
         }
     }
 
-    // Update animation based on movement
-    Uint64 currentTime = SDL_GetTicks();
-
-    // Check if NPC is moving (velocity not close to zero)
+    // Update animation based on movement. Time since the last frame change
+    // is accumulated from deltaTime rather than read from the clock, so it
+    // covers frames skipped by the NPC's AI update tier and needs no syscall.
     if (m_velocity.length() > 0.1f) {
         // Only update animation frame if enough time has passed
-        if (currentTime > m_lastFrameTime + m_animSpeed) {
+        m_animElapsedMs += deltaTime * 1000.0f;
+        if (m_animElapsedMs > static_cast<float>(m_animSpeed)) {
             m_currentFrame = (m_currentFrame + 1) % m_numFrames;
-            m_lastFrameTime = currentTime;
+            m_animElapsedMs = 0.0f;
         }
     } else {
         // When not moving, reset to first frame
@@ -157,6 +157,14 @@ bool AdvancedAIDemoState::enter() {
         // Configure priority multiplier for proper advanced behavior progression
         aiMgr.configurePriorityMultiplier(1.2f); // Slightly higher for advanced behaviors
 
+        // Keep NPCs that follow, flee or attack together from stacking on one spot
+        CrowdSettings crowd;
+        crowd.enabled = true;
+        crowd.neighborRadius = 48.0f;
+        crowd.separationRadius = 32.0f;
+        crowd.maxPushSpeed = 60.0f;
+        aiMgr.setCrowdSettings(crowd);
+
         // Create NPCs with optimized counts for behavior showcasing
         createAdvancedNPCs();
 
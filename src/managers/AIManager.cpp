@@ -6,9 +6,18 @@
 #include "managers/AIManager.hpp"
 #include "core/Logger.hpp"
 #include "core/ThreadSystem.hpp"
+#include "core/TraceRecorder.hpp"
 #include "core/WorkerBudget.hpp"
+#include "ai/AIDistanceKernels.hpp"
+#include "entities/EntityRegistry.hpp"
 #include <algorithm>
-#include <cstring>
+#include <array>
+#include <bit>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <span>
+#include <limits>
 
 
 
@@ -20,6 +29,11 @@ bool AIManager::init() {
     }
 
     try {
+        if (!m_randomSeedSet.load(std::memory_order_relaxed)) {
+            std::random_device device;
+            m_randomSeed.store((static_cast<uint64_t>(device()) << 32) | device(), std::memory_order_relaxed);
+        }
+
         // Initialize behavior type mappings
         m_behaviorTypeMap["Wander"] = BehaviorType::Wander;
         m_behaviorTypeMap["Guard"] = BehaviorType::Guard;
@@ -34,15 +48,7 @@ bool AIManager::init() {
         constexpr size_t INITIAL_CAPACITY = 1000;
         m_storage.reserve(INITIAL_CAPACITY);
         m_entityToIndex.reserve(INITIAL_CAPACITY);
-
-        // Initialize double buffers
-        m_storage.doubleBuffer[0].reserve(INITIAL_CAPACITY);
-        m_storage.doubleBuffer[1].reserve(INITIAL_CAPACITY);
-
-        // Initialize lock-free message queue
-        for (auto& msg : m_lockFreeMessages) {
-            msg.ready.store(false, std::memory_order_relaxed);
-        }
+        m_updateList.reserve(INITIAL_CAPACITY);
 
         // Configure threading based on system capabilities
         if (Hammer::ThreadSystem::Exists()) {
@@ -79,30 +85,49 @@ void AIManager::clean() {
 
     // Clean up all entities and behaviors
     {
+        std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
         std::unique_lock<std::shared_mutex> entitiesLock(m_entitiesMutex);
         std::unique_lock<std::shared_mutex> behaviorsLock(m_behaviorsMutex);
         std::lock_guard<std::mutex> assignmentsLock(m_assignmentsMutex);
         std::lock_guard<std::mutex> messagesLock(m_messagesMutex);
 
         // Clear all storage
-        m_storage.hotData.clear();
-        m_storage.entities.clear();
-        m_storage.behaviors.clear();
-        m_storage.lastUpdateTimes.clear();
-        m_storage.doubleBuffer[0].clear();
-        m_storage.doubleBuffer[1].clear();
+        m_storage.clear();
 
         m_entityToIndex.clear();
+        m_entityPriorities.clear();
         m_behaviorTemplates.clear();
         m_pendingAssignments.clear();
         m_pendingAssignmentIndex.clear();
-        m_messageQueue.clear();
+        m_groupMembers.clear();
+        m_entityGroups.clear();
+        m_crowdSettings = CrowdSettings{};
+        drainMessageQueue(m_drainScratch);
+        m_drainScratch.clear();
+        clearFrameMessages();
+        clearPositionSnapshot();
     }
 
     // Reset all counters
     m_totalBehaviorExecutions.store(0, std::memory_order_relaxed);
     m_totalAssignmentCount.store(0, std::memory_order_relaxed);
+    m_droppedMessages.store(0, std::memory_order_relaxed);
+    m_deliveredMessages.store(0, std::memory_order_relaxed);
     m_frameCounter.store(0, std::memory_order_relaxed);
+    m_aiTime = 0.0;
+    m_frameTimeMs.store(0, std::memory_order_relaxed);
+    m_frameDeltaTime.store(0.0f, std::memory_order_relaxed);
+    m_playerFlowField.store(nullptr, std::memory_order_relaxed);
+    m_formations.store(nullptr, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> gridLock(m_perceptionGridMutex);
+        m_perceptionGrid.reset();
+    }
+    m_framePerceptionGrid.reset();
+    {
+        std::lock_guard<std::mutex> statsLock(m_statsMutex);
+        m_globalStats.reset();
+    }
 
     AI_LOG("AIManager shutdown complete");
 }
@@ -123,10 +148,16 @@ void AIManager::prepareForStateTransition() {
     {
         std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
         m_managedEntities.clear();
+        m_entityPriorities.clear();
+        m_groupMembers.clear();
+        m_entityGroups.clear();
+        m_crowdSettings = CrowdSettings{};   // Crowd steering is set up per state
     }
     
     // Reset behaviors
     resetBehaviors();
+    m_playerFlowField.store(nullptr, std::memory_order_relaxed);
+    m_formations.store(nullptr, std::memory_order_relaxed);
     
     // Reset pause state to false so next state starts unpaused
     m_globallyPaused.store(false, std::memory_order_release);
@@ -143,159 +174,152 @@ void AIManager::update([[maybe_unused]] float deltaTime) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
     try {
+        // One update at a time: the update list is per-frame scratch, and a
+        // worker helping in parallelFor may pick up another queued update.
+        // That worker already holds m_behaviorExecutionMutex shared, so the
+        // nested call must return before it takes any lock.
+        if (m_updateInProgress.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+        struct UpdateGuard {
+            std::atomic<bool>& flag;
+            ~UpdateGuard() { flag.store(false, std::memory_order_release); }
+        } updateGuard{m_updateInProgress};
+
         // Process pending assignments
         processPendingBehaviorAssignments();
-
-        // Get entity count without lock
-        size_t entityCount = m_storage.size();
-        if (entityCount == 0) return;
-
-        // Lock-free double buffer swap
-        int currentBuffer = m_storage.currentBuffer.load(std::memory_order_acquire);
-        int nextBuffer = 1 - currentBuffer;
+        m_aiTime += static_cast<double>(deltaTime);
+        const uint64_t frameTimeMs = static_cast<uint64_t>(m_aiTime * 1000.0);
+        m_frameTimeMs.store(frameTimeMs, std::memory_order_relaxed);
+        m_frameDeltaTime.store(deltaTime, std::memory_order_relaxed);
 
         // Get player position for distance calculations (only every 4th frame to reduce CPU usage)
         EntityPtr player = m_playerEntity.lock();
-        bool distancesUpdated = false;
         uint64_t currentFrame = m_frameCounter.load(std::memory_order_relaxed);
-        if (player && (currentFrame % 4 == 0)) {
-            Vector2D playerPos = player->getPosition();
-            
-            // Simple scalar distance updates (more efficient for scattered memory access)
-            updateDistancesScalar(playerPos);
-            distancesUpdated = true;
-        }
 
-        // Copy current state to next buffer only if we updated distances or have changes
-        bool entityCountChanged = (m_storage.doubleBuffer[nextBuffer].size() != m_storage.hotData.size());
-        
-        if (distancesUpdated || currentFrame % 60 == 0 || entityCountChanged) {
+        // Every behavior and entity this frame reads the clock and the player
+        // from here, whichever worker runs it
+        FrameContext frameContext{deltaTime, currentFrame, frameTimeMs};
+        frameContext.randomSeed = m_randomSeed.load(std::memory_order_relaxed);
+        if (player) {
+            frameContext.player = PlayerSnapshot{player->getHandle(), player->getPosition(),
+                                                 player->getVelocity(), true};
+        }
+        frameContext.playerField = m_playerFlowField.load(std::memory_order_acquire);
+        frameContext.formations = m_formations.load(std::memory_order_acquire);
+
+        // SIMD passes over the SoA hot data produce a compact list of the
+        // entities due this frame, so workers never touch skipped entities
+        size_t entityCount = 0;
+        size_t updateCount = 0;
+        {
             std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
-            m_storage.doubleBuffer[nextBuffer] = m_storage.hotData;
-        } else {
-            // Use current buffer data
-            nextBuffer = currentBuffer;
+            entityCount = m_storage.size() - m_storage.freeSlots.size();
+            if (entityCount == 0) {
+                // Nobody to deliver to; keep the inbox from filling up
+                collectFrameMessages();
+                return;
+            }
+
+            if (player && (currentFrame % 4 == 0)) {
+                updateDistances(player->getPosition());
+            }
+            updateCount = buildUpdateList(player != nullptr, currentFrame);
+            groupUpdateListByType();
+            m_frameCrowdSettings = m_crowdSettings;
+            {
+                std::lock_guard<std::mutex> gridLock(m_perceptionGridMutex);
+                m_framePerceptionGrid = m_perceptionGrid;
+            }
+
+            // Entities added since the last snapshot show up in this frame's
+            // queries; otherwise the one from the end of last frame is current
+            if (m_positionSnapshots.published().layoutVersion != m_storage.layoutVersion) {
+                commitPositionSnapshot(currentFrame);
+            }
+
+            // Everything queued before this frame goes out with its batches
+            collectFrameMessages();
         }
 
         // Determine threading strategy
-        bool useThreading = (entityCount >= THREADING_THRESHOLD && 
+        bool useThreading = (updateCount >= THREADING_THRESHOLD &&
                            m_useThreading.load(std::memory_order_acquire) &&
                            Hammer::ThreadSystem::Exists());
 
+        // Behaviors may be shared between entities; keep them from being
+        // initialized, cleaned or messaged immediately while batches run
+        std::shared_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
+
+        const size_t rangeCount = m_batchRanges.size();
+        auto processRanges = [this, &frameContext](size_t first, size_t last) {
+            for (size_t r = first; r < last; ++r) {
+                processBatch(m_batchRanges[r].start, m_batchRanges[r].end, frameContext);
+            }
+        };
+
         if (useThreading) {
             auto& threadSystem = Hammer::ThreadSystem::Instance();
-            size_t availableWorkers = static_cast<size_t>(threadSystem.getThreadCount());
-            
-            // Check queue pressure before submitting tasks
-            size_t queueSize = threadSystem.getQueueSize();
-            size_t queueCapacity = threadSystem.getQueueCapacity();
-            size_t pressureThreshold = (queueCapacity * 9) / 10; // 90% capacity threshold
-            
-            if (queueSize > pressureThreshold) {
-                // Graceful degradation: fallback to single-threaded processing
-                AI_DEBUG("Queue pressure detected (" + std::to_string(queueSize) + "/" + 
-                        std::to_string(queueCapacity) + "), using single-threaded processing");
-                processBatch(0, entityCount, deltaTime, nextBuffer);
-                
-                // Swap buffers atomically
-                if (nextBuffer != currentBuffer) {
-                    m_storage.currentBuffer.store(nextBuffer, std::memory_order_release);
-                }
-                
-                // Process message queue and continue with performance tracking
-                processMessageQueue();
-                
-                auto endTime = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-                currentFrame = m_frameCounter.fetch_add(1, std::memory_order_relaxed);
-                
-                // Periodic cleanup and stats
-                if (currentFrame % 300 == 0) {
-                    cleanupInactiveEntities();
-                    m_lastCleanupFrame.store(currentFrame, std::memory_order_relaxed);
-                    
-                    std::lock_guard<std::mutex> statsLock(m_statsMutex);
-                    m_globalStats.addSample(duration, entityCount);
-                    
-                    if (entityCount > 0) {
-                        double avgDuration = m_globalStats.updateCount > 0 ? 
-                            (m_globalStats.totalUpdateTime / m_globalStats.updateCount) : 0.0;
-                        AI_DEBUG("AI Summary - Entities: " + std::to_string(entityCount) + 
-                               ", Avg Update: " + std::to_string(avgDuration) + "ms" +
-                               ", Entities/sec: " + std::to_string(m_globalStats.entitiesPerSecond));
-                    }
-                }
-                return; // Exit early after single-threaded processing
-            }
-            
-            Hammer::WorkerBudget budget = Hammer::calculateWorkerBudget(availableWorkers);
-            
+            // Adaptive budget: the AI share follows measured AI vs event load
+            Hammer::WorkerBudget budget = threadSystem.getWorkerBudget();
+
             // Use WorkerBudget system properly with threshold-based buffer allocation
-            size_t optimalWorkerCount = budget.getOptimalWorkerCount(budget.aiAllocated, entityCount, 1000);
-            
-            // Dynamic batch sizing based on queue pressure for optimal performance
-            size_t minEntitiesPerBatch = 1000;
-            size_t maxBatches = 4;
-            
-            // Adjust batch strategy based on queue pressure
-            double queuePressure = static_cast<double>(queueSize) / queueCapacity;
-            if (queuePressure > 0.5) {
-                // High pressure: use fewer, larger batches to reduce queue overhead
-                minEntitiesPerBatch = 1500;
-                maxBatches = 2;
-                AI_DEBUG("High queue pressure (" + std::to_string(static_cast<int>(queuePressure * 100)) + 
-                        "%), using larger batches");
-            } else if (queuePressure < 0.25) {
-                // Low pressure: can use more batches for better parallelization
-                minEntitiesPerBatch = 800;
-                maxBatches = 4;
-            }
-            
-            size_t batchCount = std::min(optimalWorkerCount, entityCount / minEntitiesPerBatch);
-            batchCount = std::max(size_t(1), std::min(batchCount, maxBatches));
-            
-            size_t entitiesPerBatch = entityCount / batchCount;
-            size_t remainingEntities = entityCount % batchCount;
-            
-            // Submit optimized batches
-            for (size_t i = 0; i < batchCount; ++i) {
-                size_t start = i * entitiesPerBatch;
-                size_t end = start + entitiesPerBatch;
-                
-                // Add remaining entities to last batch
-                if (i == batchCount - 1) {
-                    end += remainingEntities;
-                }
-                
-                threadSystem.enqueueTask([this, start, end, deltaTime, nextBuffer]() {
-                    processBatch(start, end, deltaTime, nextBuffer);
-                }, Hammer::TaskPriority::High, "AI_OptimalBatch");
-            }
-            
+            size_t optimalWorkerCount = budget.getOptimalWorkerCount(budget.aiAllocated, updateCount, 1000);
+
+            // The update thread processes chunks too, and parallelFor returns only
+            // once every batch is done, so the update list stays valid for the
+            // whole pass. Chunks are made of whole batch ranges, so no batch
+            // mixes behavior types. Batch time is summed across threads and
+            // reported as this frame's AI work.
+            std::atomic<int64_t> workNs{0};
+            threadSystem.parallelFor(0, rangeCount, 1,
+                [&processRanges, &workNs](size_t first, size_t last) {
+                    auto batchStart = std::chrono::steady_clock::now();
+                    processRanges(first, last);
+                    workNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - batchStart).count(), std::memory_order_relaxed);
+                }, optimalWorkerCount, Hammer::TaskPriority::High, "AI_OptimalBatch");
+            threadSystem.reportSubsystemWork(Hammer::BudgetSubsystem::AI,
+                                             static_cast<double>(workNs.load(std::memory_order_relaxed)) / 1e6);
         } else {
             // Single-threaded processing
-            processBatch(0, entityCount, deltaTime, nextBuffer);
+            auto batchStart = std::chrono::steady_clock::now();
+            processRanges(0, rangeCount);
+            if (Hammer::ThreadSystem::Exists()) {
+                Hammer::ThreadSystem::Instance().reportSubsystemWork(Hammer::BudgetSubsystem::AI,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStart).count());
+            }
         }
 
-        // Swap buffers atomically only if we actually changed buffers
-        if (nextBuffer != currentBuffer) {
-            m_storage.currentBuffer.store(nextBuffer, std::memory_order_release);
+        // Messages for entities that were not due this frame
+        if (!m_frameInbox.empty() || !m_frameBroadcasts.empty()) {
+            std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+            deliverRemainingFrameMessages();
         }
-
-        // Process lock-free message queue
-        processMessageQueue();
+        executionLock.unlock();
 
         // Performance tracking
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        {
+            std::lock_guard<std::mutex> statsLock(m_statsMutex);
+            m_globalStats.addFrame(updateCount, entityCount);
+        }
 
         currentFrame = m_frameCounter.fetch_add(1, std::memory_order_relaxed);
         
-        // Periodic cleanup and stats (balanced frequency)
+        // Release a bounded share of inactive slots every frame, so a mass
+        // despawn never turns into one long exclusive pass
+        cleanupInactiveEntities(CLEANUP_SLOTS_PER_FRAME);
+
+        // Publish where this frame left everyone, for the next frame's queries
+        // and for readers between frames
+        {
+            std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+            commitPositionSnapshot(currentFrame);
+        }
+
         if (currentFrame % 300 == 0) {
-            cleanupInactiveEntities();
-            m_lastCleanupFrame.store(currentFrame, std::memory_order_relaxed);
-            
             std::lock_guard<std::mutex> statsLock(m_statsMutex);
             m_globalStats.addSample(duration, entityCount);
             
@@ -304,6 +328,7 @@ void AIManager::update([[maybe_unused]] float deltaTime) {
                     (m_globalStats.totalUpdateTime / m_globalStats.updateCount) : 0.0;
                 AI_DEBUG("AI Summary - Entities: " + std::to_string(entityCount) + 
                        ", Avg Update: " + std::to_string(avgDuration) + "ms" +
+                       ", Updates/frame: " + std::to_string(m_globalStats.updatesPerFrame) +
                        ", Entities/sec: " + std::to_string(m_globalStats.entitiesPerSecond));
             }
         }
@@ -353,52 +378,43 @@ void AIManager::assignBehaviorToEntity(EntityPtr entity, const std::string& beha
         behaviorTemplate = it->second;
     }
 
-    // Clone behavior for this entity
-    auto behavior = behaviorTemplate->clone();
+    // Shared behaviors keep per-entity state themselves and drive every
+    // entity from the registered instance; the rest get a clone each
+    auto behavior = behaviorTemplate->isShared() ? behaviorTemplate : behaviorTemplate->clone();
+
+    // init() may call back into AIManager, so it runs before m_entitiesMutex is taken
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
     behavior->init(entity);
 
     // Find or create entity entry
     std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
     
-    auto indexIt = m_entityToIndex.find(entity);
-    if (indexIt != m_entityToIndex.end()) {
+    if (const size_t* existing = m_entityToIndex.find(entity->getHandle())) {
         // Update existing entity
-        size_t index = indexIt->second;
+        size_t index = *existing;
         if (index < m_storage.size()) {
-            // Clean up old behavior
-            if (m_storage.behaviors[index]) {
+            // Clean up old behavior; a shared instance being reassigned just re-inits the entity
+            if (m_storage.behaviors[index] && m_storage.behaviors[index] != behavior) {
                 m_storage.behaviors[index]->clean(entity);
             }
             
             // Assign new behavior
             m_storage.behaviors[index] = behavior;
-            m_storage.hotData[index].behaviorType = static_cast<uint8_t>(inferBehaviorType(behaviorName));
-            m_storage.hotData[index].active = true;
+            m_storage.behaviorTypes[index] = static_cast<uint8_t>(inferBehaviorType(behaviorName));
+            m_storage.active[index] = 1;
             
             AI_LOG("Updated behavior for existing entity to: " + behaviorName);
         }
     } else {
-        // Add new entity
-        size_t newIndex = m_storage.size();
-        
-        // Add to hot data
-        AIEntityData::HotData hotData{};
-        hotData.position = entity->getPosition();
-        hotData.lastPosition = hotData.position;
-        hotData.distanceSquared = 0.0f;
-        hotData.frameCounter = 0;
-        hotData.priority = DEFAULT_PRIORITY;
-        hotData.behaviorType = static_cast<uint8_t>(inferBehaviorType(behaviorName));
-        hotData.active = true;
-        hotData.shouldUpdate = true;
-        
-        m_storage.hotData.push_back(hotData);
-        m_storage.entities.push_back(entity);
-        m_storage.behaviors.push_back(behavior);
-        m_storage.lastUpdateTimes.push_back(0.0f);
+        // Add hot and cold data for the new entity, at the priority it was
+        // registered with, in a released slot if there is one
+        const uint8_t* registeredPriority = m_entityPriorities.find(entity->getHandle());
+        size_t newIndex = m_storage.emplace(entity, behavior, entity->getPosition(),
+                           registeredPriority ? *registeredPriority : static_cast<uint8_t>(DEFAULT_PRIORITY),
+                           static_cast<uint8_t>(inferBehaviorType(behaviorName)));
         
         // Update index map
-        m_entityToIndex[entity] = newIndex;
+        m_entityToIndex.insert(entity->getHandle(), newIndex);
         
         AI_LOG("Added new entity with behavior: " + behaviorName);
     }
@@ -409,13 +425,13 @@ void AIManager::assignBehaviorToEntity(EntityPtr entity, const std::string& beha
 void AIManager::unassignBehaviorFromEntity(EntityPtr entity) {
     if (!entity) return;
 
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
     std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
     
-    auto it = m_entityToIndex.find(entity);
-    if (it != m_entityToIndex.end()) {
-        size_t index = it->second;
+    if (const size_t* slot = m_entityToIndex.find(entity->getHandle())) {
+        size_t index = *slot;
         if (index < m_storage.size()) {
-            m_storage.hotData[index].active = false;
+            m_storage.active[index] = 0;
             
             if (m_storage.behaviors[index]) {
                 m_storage.behaviors[index]->clean(entity);
@@ -429,9 +445,9 @@ bool AIManager::entityHasBehavior(EntityPtr entity) const {
 
     std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
     
-    auto it = m_entityToIndex.find(entity);
-    if (it != m_entityToIndex.end() && it->second < m_storage.size()) {
-        return m_storage.hotData[it->second].active && m_storage.behaviors[it->second] != nullptr;
+    const size_t* slot = m_entityToIndex.find(entity->getHandle());
+    if (slot && *slot < m_storage.size()) {
+        return m_storage.active[*slot] != 0 && m_storage.behaviors[*slot] != nullptr;
     }
     
     return false;
@@ -446,14 +462,13 @@ void AIManager::queueBehaviorAssignment(EntityPtr entity, const std::string& beh
     std::lock_guard<std::mutex> lock(m_assignmentsMutex);
     
     // Check for duplicate assignments
-    auto it = m_pendingAssignmentIndex.find(entity);
-    if (it != m_pendingAssignmentIndex.end()) {
-        // Update existing assignment
-        it->second = behaviorName;
+    if (const size_t* pending = m_pendingAssignmentIndex.find(entity->getHandle())) {
+        // Update existing assignment; the last request wins
+        m_pendingAssignments[*pending].behaviorName = behaviorName;
     } else {
         // Add new assignment
+        m_pendingAssignmentIndex.insert(entity->getHandle(), m_pendingAssignments.size());
         m_pendingAssignments.emplace_back(entity, behaviorName);
-        m_pendingAssignmentIndex[entity] = behaviorName;
     }
 }
 
@@ -499,6 +514,86 @@ Vector2D AIManager::getPlayerPosition() const {
     return Vector2D{0.0f, 0.0f};
 }
 
+uint64_t AIManager::getFrameTimeMs() const {
+    return m_frameTimeMs.load(std::memory_order_relaxed);
+}
+
+uint64_t AIManager::getFrameNumber() const {
+    return m_frameCounter.load(std::memory_order_relaxed);
+}
+
+FrameContext AIManager::getFrameContext() const {
+    FrameContext context;
+    context.deltaTime = m_frameDeltaTime.load(std::memory_order_relaxed);
+    context.frameNumber = m_frameCounter.load(std::memory_order_relaxed);
+    context.timeMs = getFrameTimeMs();
+    if (auto player = getPlayerReference()) {
+        context.player = PlayerSnapshot{player->getHandle(), player->getPosition(), player->getVelocity(), true};
+    }
+    context.randomSeed = m_randomSeed.load(std::memory_order_relaxed);
+    context.playerField = m_playerFlowField.load(std::memory_order_acquire);
+    context.formations = m_formations.load(std::memory_order_acquire);
+    return context;
+}
+
+void AIManager::setPlayerFlowField(const FlowField* field) {
+    m_playerFlowField.store(field, std::memory_order_release);
+}
+
+const FlowField* AIManager::getPlayerFlowField() const {
+    return m_playerFlowField.load(std::memory_order_acquire);
+}
+
+void AIManager::setFormations(const FormationSnapshot* formations) {
+    m_formations.store(formations, std::memory_order_release);
+}
+
+const FormationSnapshot* AIManager::getFormations() const {
+    return m_formations.load(std::memory_order_acquire);
+}
+
+void AIManager::setCrowdSettings(const CrowdSettings& settings) {
+    CrowdSettings clamped = settings;
+    clamped.neighborRadius = std::max(clamped.neighborRadius, 0.0f);
+    clamped.separationRadius = std::clamp(clamped.separationRadius, 0.0f, clamped.neighborRadius);
+    clamped.maxNeighbors = std::min<uint32_t>(clamped.maxNeighbors, CrowdSteering::MAX_NEIGHBORS);
+
+    std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
+    m_crowdSettings = clamped;
+}
+
+CrowdSettings AIManager::getCrowdSettings() const {
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    return m_crowdSettings;
+}
+
+void AIManager::setPerceptionGrid(std::shared_ptr<const NavigationGrid> grid) {
+    std::lock_guard<std::mutex> lock(m_perceptionGridMutex);
+    m_perceptionGrid = std::move(grid);
+}
+
+std::shared_ptr<const NavigationGrid> AIManager::getPerceptionGrid() const {
+    std::lock_guard<std::mutex> lock(m_perceptionGridMutex);
+    return m_perceptionGrid;
+}
+
+Awareness AIManager::getAwareness(EntityPtr entity) const {
+    if (!entity) return Awareness{};
+
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    const size_t* slot = m_entityToIndex.find(entity->getHandle());
+    return (slot && *slot < m_storage.size()) ? m_storage.awareness[*slot] : Awareness{};
+}
+
+void AIManager::setRandomSeed(uint64_t seed) {
+    m_randomSeed.store(seed, std::memory_order_relaxed);
+    m_randomSeedSet.store(true, std::memory_order_relaxed);
+}
+
+uint64_t AIManager::getRandomSeed() const {
+    return m_randomSeed.load(std::memory_order_relaxed);
+}
+
 bool AIManager::isPlayerValid() const {
     std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
     return !m_playerEntity.expired();
@@ -514,18 +609,19 @@ void AIManager::registerEntityForUpdates(EntityPtr entity, int priority) {
     priority = std::max(AI_MIN_PRIORITY, std::min(AI_MAX_PRIORITY, priority));
 
     std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
-    
+    m_entityPriorities.insert(entity->getHandle(), static_cast<uint8_t>(priority));
+
     // Check if entity already exists
-    auto it = m_entityToIndex.find(entity);
-    if (it != m_entityToIndex.end()) {
+    if (const size_t* slot = m_entityToIndex.find(entity->getHandle())) {
         // Update priority for existing entity
-        size_t index = it->second;
+        size_t index = *slot;
         if (index < m_storage.size()) {
-            m_storage.hotData[index].priority = static_cast<uint8_t>(priority);
+            m_storage.priorities[index] = static_cast<uint8_t>(priority);
         }
     } else {
         // Add managed entity info
         EntityUpdateInfo info;
+        info.handle = entity->getHandle();
         info.entityWeak = entity;
         info.priority = priority;
         info.frameCounter = 0;
@@ -540,20 +636,22 @@ void AIManager::unregisterEntityFromUpdates(EntityPtr entity) {
 
     std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
     
-    // Remove from managed entities
+    // Remove from managed entities, dropping expired ones on the way
+    const EntityHandle handle = entity->getHandle();
     m_managedEntities.erase(
         std::remove_if(m_managedEntities.begin(), m_managedEntities.end(),
-            [&entity](const EntityUpdateInfo& info) {
-                auto e = info.entityWeak.lock();
-                return !e || e == entity;
+            [handle](const EntityUpdateInfo& info) {
+                return info.handle == handle || info.entityWeak.expired();
             }),
         m_managedEntities.end()
     );
+    m_entityPriorities.erase(handle);
+    leaveGroup(handle);
     
     // Mark as inactive in main storage
-    auto it = m_entityToIndex.find(entity);
-    if (it != m_entityToIndex.end() && it->second < m_storage.size()) {
-        m_storage.hotData[it->second].active = false;
+    const size_t* slot = m_entityToIndex.find(handle);
+    if (slot && *slot < m_storage.size()) {
+        m_storage.active[*slot] = 0;
     }
 }
 
@@ -569,6 +667,7 @@ bool AIManager::isGloballyPaused() const {
 void AIManager::resetBehaviors() {
     AI_LOG("Resetting all AI behaviors");
 
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
     std::unique_lock<std::shared_mutex> entitiesLock(m_entitiesMutex);
     std::unique_lock<std::shared_mutex> behaviorsLock(m_behaviorsMutex);
     
@@ -580,17 +679,11 @@ void AIManager::resetBehaviors() {
     }
     
     // Clear all data
-    m_storage.hotData.clear();
-    m_storage.entities.clear();
-    m_storage.behaviors.clear();
-    m_storage.lastUpdateTimes.clear();
+    m_storage.clear();
     m_entityToIndex.clear();
     m_managedEntities.clear();
-    
-    // Clear double buffers to prevent stale data synchronization issues
-    m_storage.doubleBuffer[0].clear();
-    m_storage.doubleBuffer[1].clear();
-    m_storage.currentBuffer.store(0, std::memory_order_release);
+    m_entityPriorities.clear();
+    clearPositionSnapshot();
     
     // Reset counters
     m_totalBehaviorExecutions.store(0, std::memory_order_relaxed);
@@ -611,6 +704,31 @@ void AIManager::configurePriorityMultiplier(float multiplier) {
     m_priorityMultiplier.store(multiplier, std::memory_order_release);
 }
 
+void AIManager::setUpdateSchedule(int priority, const AIUpdateSchedule& schedule) {
+    auto roundInterval = [](uint32_t interval) {
+        return std::bit_ceil(std::clamp(interval, 1u, MAX_UPDATE_INTERVAL));
+    };
+    AIUpdateSchedule rounded;
+    rounded.nearInterval = roundInterval(schedule.nearInterval);
+    rounded.midInterval = roundInterval(schedule.midInterval);
+    rounded.farInterval = roundInterval(schedule.farInterval);
+    rounded.distantInterval = roundInterval(schedule.distantInterval);
+
+    std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
+    m_updateSchedules[static_cast<size_t>(std::clamp(priority, AI_MIN_PRIORITY, AI_MAX_PRIORITY))] = rounded;
+}
+
+AIUpdateSchedule AIManager::getUpdateSchedule(int priority) const {
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    return m_updateSchedules[static_cast<size_t>(std::clamp(priority, AI_MIN_PRIORITY, AI_MAX_PRIORITY))];
+}
+
+void AIManager::setUpdateDistances(float nearDistance, float midDistance, float farDistance) {
+    m_maxUpdateDistance.store(nearDistance, std::memory_order_relaxed);
+    m_mediumUpdateDistance.store(midDistance, std::memory_order_relaxed);
+    m_minUpdateDistance.store(farDistance, std::memory_order_relaxed);
+}
+
 AIPerformanceStats AIManager::getPerformanceStats() const {
     std::lock_guard<std::mutex> lock(m_statsMutex);
     return m_globalStats;
@@ -627,7 +745,7 @@ size_t AIManager::getManagedEntityCount() const {
     // Count only active entities
     size_t activeCount = 0;
     for (size_t i = 0; i < m_storage.size(); ++i) {
-        if (m_storage.hotData[i].active) {
+        if (m_storage.active[i]) {
             activeCount++;
         }
     }
@@ -643,72 +761,424 @@ size_t AIManager::getTotalAssignmentCount() const {
     return m_totalAssignmentCount.load(std::memory_order_relaxed);
 }
 
-void AIManager::sendMessageToEntity(EntityPtr entity, const std::string& message, bool immediate) {
-    if (!entity || message.empty()) return;
+namespace {
+
+// Depth of behavior code this thread is running for AIManager: a batch, or
+// a message handler. Such a thread holds m_behaviorExecutionMutex, so an
+// immediate message it sends would deadlock taking it again; it is queued
+// instead.
+thread_local int t_behaviorCallDepth = 0;
+
+struct BehaviorCallScope {
+    BehaviorCallScope() { ++t_behaviorCallDepth; }
+    ~BehaviorCallScope() { --t_behaviorCallDepth; }
+    BehaviorCallScope(const BehaviorCallScope&) = delete;
+    BehaviorCallScope& operator=(const BehaviorCallScope&) = delete;
+};
+
+// A throwing handler loses its message but not the rest of the batch
+bool deliverMessage(AIBehavior* behavior, const EntityPtr& entity, const AIMessage& message) {
+    BehaviorCallScope scope;
+    try {
+        behavior->onMessage(entity, message);
+        return true;
+    } catch (const std::exception& e) {
+        AI_ERROR("Exception in onMessage: " + std::string(e.what()));
+        return false;
+    }
+}
+
+} // namespace
 
-    if (immediate) {
+void AIManager::sendMessageToEntity(EntityPtr entity, const AIMessage& message, bool immediate) {
+    if (!entity || message.id == AI_MESSAGE_NONE) return;
+
+    // From inside a batch or a handler the lock is already held; queue it
+    if (immediate && t_behaviorCallDepth == 0) {
+        std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
         std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
-        auto it = m_entityToIndex.find(entity);
-        if (it != m_entityToIndex.end() && it->second < m_storage.size()) {
-            if (m_storage.behaviors[it->second]) {
-                m_storage.behaviors[it->second]->onMessage(entity, message);
+        const size_t* slot = m_entityToIndex.find(entity->getHandle());
+        if (slot && *slot < m_storage.size() && m_storage.behaviors[*slot]) {
+            if (deliverMessage(m_storage.behaviors[*slot].get(), entity, message)) {
+                m_deliveredMessages.fetch_add(1, std::memory_order_relaxed);
             }
         }
     } else {
-        // Use lock-free queue for non-immediate messages
-        size_t writeIndex = m_messageWriteIndex.fetch_add(1, std::memory_order_relaxed) % MESSAGE_QUEUE_SIZE;
-        auto& msg = m_lockFreeMessages[writeIndex];
-        
-        msg.target = entity;
-        std::strncpy(msg.message, message.c_str(), sizeof(msg.message) - 1);
-        msg.message[sizeof(msg.message) - 1] = '\0';
-        msg.ready.store(true, std::memory_order_release);
+        QueuedMessage queued;
+        queued.message = message;
+        queued.target = entity->getHandle();
+        queueMessage(queued);
     }
 }
 
-void AIManager::broadcastMessage(const std::string& message, bool immediate) {
-    if (message.empty()) return;
+void AIManager::sendMessageToEntity(EntityPtr entity, const std::string& message, bool immediate) {
+    sendMessageToEntity(std::move(entity), AIMessage(AIMessageRegistry::intern(message)), immediate);
+}
+
+void AIManager::broadcastMessage(const AIMessage& message, bool immediate) {
+    if (message.id == AI_MESSAGE_NONE) return;
 
-    if (immediate) {
+    if (immediate && t_behaviorCallDepth == 0) {
+        std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
         std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
-        
+
+        size_t delivered = 0;
         for (size_t i = 0; i < m_storage.size(); ++i) {
-            if (m_storage.hotData[i].active && m_storage.behaviors[i]) {
-                m_storage.behaviors[i]->onMessage(m_storage.entities[i], message);
+            AIBehavior* behavior = m_storage.behaviors[i].get();
+            if (m_storage.active[i] && behavior && behavior->acceptsMessage(message.id) &&
+                deliverMessage(behavior, m_storage.entities[i], message)) {
+                ++delivered;
             }
         }
+        m_deliveredMessages.fetch_add(delivered, std::memory_order_relaxed);
     } else {
-        // Queue broadcast for processing in next update
-        size_t writeIndex = m_messageWriteIndex.fetch_add(1, std::memory_order_relaxed) % MESSAGE_QUEUE_SIZE;
-        auto& msg = m_lockFreeMessages[writeIndex];
-        
-        msg.target.reset(); // No specific target for broadcast
-        std::strncpy(msg.message, message.c_str(), sizeof(msg.message) - 1);
-        msg.message[sizeof(msg.message) - 1] = '\0';
-        msg.ready.store(true, std::memory_order_release);
+        QueuedMessage queued;
+        queued.message = message;
+        queued.scope = MessageScope::All;
+        queueMessage(queued);
+    }
+}
+
+void AIManager::broadcastMessage(const std::string& message, bool immediate) {
+    broadcastMessage(AIMessage(AIMessageRegistry::intern(message)), immediate);
+}
+
+void AIManager::broadcastInRadius(const Vector2D& center, float radius, const AIMessage& message) {
+    if (message.id == AI_MESSAGE_NONE || !(radius >= 0.0f)) return;
+
+    QueuedMessage queued;
+    queued.message = message;
+    queued.center = center;
+    queued.radius = radius;
+    queued.scope = MessageScope::Radius;
+    queueMessage(queued);
+}
+
+void AIManager::broadcastInRadius(const Vector2D& center, float radius, const std::string& message) {
+    broadcastInRadius(center, radius, AIMessage(AIMessageRegistry::intern(message)));
+}
+
+void AIManager::broadcastToGroup(uint32_t groupId, const AIMessage& message) {
+    if (message.id == AI_MESSAGE_NONE || groupId == 0) return;
+
+    QueuedMessage queued;
+    queued.message = message;
+    queued.group = groupId;
+    queued.scope = MessageScope::Group;
+    queueMessage(queued);
+}
+
+void AIManager::broadcastToGroup(uint32_t groupId, const std::string& message) {
+    broadcastToGroup(groupId, AIMessage(AIMessageRegistry::intern(message)));
+}
+
+void AIManager::setEntityGroup(EntityPtr entity, uint32_t groupId) {
+    if (!entity) return;
+
+    std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
+    const EntityHandle handle = entity->getHandle();
+    const uint32_t* current = m_entityGroups.find(handle);
+    if (current && *current == groupId) {
+        return;
+    }
+    leaveGroup(handle);
+    if (groupId != 0) {
+        m_groupMembers[groupId].push_back(handle);
+        m_entityGroups.insert(handle, groupId);
+    }
+}
+
+uint32_t AIManager::getEntityGroup(EntityPtr entity) const {
+    if (!entity) return 0;
+
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    const uint32_t* group = m_entityGroups.find(entity->getHandle());
+    return group ? *group : 0;
+}
+
+size_t AIManager::getGroupSize(uint32_t groupId) const {
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    auto it = m_groupMembers.find(groupId);
+    return it != m_groupMembers.end() ? it->second.size() : 0;
+}
+
+void AIManager::leaveGroup(EntityHandle handle) {
+    // Caller holds m_entitiesMutex exclusively
+    const uint32_t* group = m_entityGroups.find(handle);
+    if (!group) {
+        return;
     }
+    auto it = m_groupMembers.find(*group);
+    if (it != m_groupMembers.end()) {
+        auto& members = it->second;
+        auto member = std::find(members.begin(), members.end(), handle);
+        if (member != members.end()) {
+            *member = members.back();
+            members.pop_back();
+        }
+        if (members.empty()) {
+            m_groupMembers.erase(it);
+        }
+    }
+    m_entityGroups.erase(handle);
+}
+
+void AIManager::pruneDeadGroupMembers() {
+    // Caller holds m_entitiesMutex exclusively. Entities destroyed without
+    // being unregistered leave their handles behind.
+    if (m_groupMembers.empty()) {
+        return;
+    }
+    const EntityRegistry& registry = EntityRegistry::Instance();
+    for (auto it = m_groupMembers.begin(); it != m_groupMembers.end();) {
+        auto& members = it->second;
+        for (size_t i = 0; i < members.size();) {
+            if (registry.isAlive(members[i])) {
+                ++i;
+                continue;
+            }
+            m_entityGroups.erase(members[i]);
+            members[i] = members.back();
+            members.pop_back();
+        }
+        it = members.empty() ? m_groupMembers.erase(it) : std::next(it);
+    }
+}
+
+void AIManager::queueMessage(const QueuedMessage& queued) {
+    if (!m_messageQueue.tryPush(queued)) {
+        // Full until the next drain; count it rather than overwrite older messages
+        if (m_droppedMessages.fetch_add(1, std::memory_order_relaxed) == 0) {
+            AI_WARN("AI message inbox full (" + std::to_string(MESSAGE_QUEUE_SIZE) + " messages), dropping messages");
+        }
+    }
+}
+
+size_t AIManager::drainMessageQueue(std::vector<QueuedMessage>& out) {
+    // Caller holds m_messagesMutex; it makes this the queue's only consumer
+    out.clear();
+    QueuedMessage queued;
+    while (m_messageQueue.tryPop(queued)) {
+        out.push_back(queued);
+    }
+    return out.size();
 }
 
 void AIManager::processMessageQueue() {
-    // Process lock-free message queue
-    size_t readIndex = m_messageReadIndex.load(std::memory_order_relaxed);
-    size_t writeIndex = m_messageWriteIndex.load(std::memory_order_acquire);
-    
-    while (readIndex != writeIndex) {
-        auto& msg = m_lockFreeMessages[readIndex % MESSAGE_QUEUE_SIZE];
-        
-        if (msg.ready.load(std::memory_order_acquire)) {
-            if (auto entity = msg.target.lock()) {
-                sendMessageToEntity(entity, msg.message, true);
+    std::vector<QueuedMessage> pending;
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    {
+        std::lock_guard<std::mutex> messagesLock(m_messagesMutex);
+        drainMessageQueue(pending);
+    }
+
+    size_t delivered = 0;
+    std::vector<uint32_t> indexScratch;
+    std::vector<InboxEntry> recipients;
+    for (const QueuedMessage& queued : pending) {
+        if (queued.scope == MessageScope::All) {
+            for (size_t i = 0; i < m_storage.size(); ++i) {
+                AIBehavior* behavior = m_storage.behaviors[i].get();
+                if (m_storage.active[i] && behavior && behavior->acceptsMessage(queued.message.id) &&
+                    deliverMessage(behavior, m_storage.entities[i], queued.message)) {
+                    ++delivered;
+                }
+            }
+            continue;
+        }
+        recipients.clear();
+        resolveRecipients(queued, indexScratch, recipients);
+        for (const InboxEntry& entry : recipients) {
+            if (m_storage.active[entry.slot] && m_storage.behaviors[entry.slot] &&
+                deliverMessage(m_storage.behaviors[entry.slot].get(), m_storage.entities[entry.slot], entry.message)) {
+                ++delivered;
             }
-            
-            msg.ready.store(false, std::memory_order_release);
         }
-        
-        readIndex++;
     }
-    
-    m_messageReadIndex.store(readIndex, std::memory_order_release);
+    m_deliveredMessages.fetch_add(delivered, std::memory_order_relaxed);
+}
+
+uint64_t AIManager::getDroppedMessageCount() const {
+    return m_droppedMessages.load(std::memory_order_relaxed);
+}
+
+uint64_t AIManager::getDeliveredMessageCount() const {
+    return m_deliveredMessages.load(std::memory_order_relaxed);
+}
+
+void AIManager::collectFrameMessages() {
+    // Caller holds m_entitiesMutex (shared) and is the thread running update()
+    clearFrameMessages();
+    {
+        std::lock_guard<std::mutex> messagesLock(m_messagesMutex);
+        if (drainMessageQueue(m_drainScratch) == 0) {
+            return;
+        }
+    }
+
+    // Scoped broadcasts become direct messages here, so their recipients
+    // get them from their own batches
+    for (const QueuedMessage& queued : m_drainScratch) {
+        if (queued.scope == MessageScope::All) {
+            m_frameBroadcasts.push_back(queued.message);
+        } else {
+            resolveRecipients(queued, m_recipientScratch, m_frameInbox);
+        }
+    }
+
+    // Workers post in whatever order they run; ordering by sender keeps each
+    // recipient's inbox the same between runs. A sender's own messages keep
+    // the order it sent them in.
+    std::stable_sort(m_frameInbox.begin(), m_frameInbox.end(), [](const InboxEntry& a, const InboxEntry& b) {
+        if (a.slot != b.slot) return a.slot < b.slot;
+        return a.message.sender.index < b.message.sender.index;
+    });
+    std::stable_sort(m_frameBroadcasts.begin(), m_frameBroadcasts.end(), [](const AIMessage& a, const AIMessage& b) {
+        return a.sender.index < b.sender.index;
+    });
+    m_frameInboxDelivered.assign(m_frameInbox.size(), 0);
+    if (!m_frameBroadcasts.empty()) {
+        m_broadcastReceived.assign(m_storage.size(), 0);
+    }
+}
+
+void AIManager::resolveRecipients(const QueuedMessage& queued, std::vector<uint32_t>& indexScratch,
+                                  std::vector<InboxEntry>& out) const {
+    // Caller holds m_entitiesMutex (shared). Recipients AIManager does not
+    // manage are skipped, and so is the sender of a scoped broadcast.
+    auto addRecipient = [this, &queued, &out](EntityHandle handle) {
+        const size_t* slot = m_entityToIndex.find(handle);
+        if (slot && *slot < m_storage.size()) {
+            out.push_back({static_cast<uint32_t>(*slot), handle, queued.message});
+        }
+    };
+
+    switch (queued.scope) {
+        case MessageScope::Entity:
+            addRecipient(queued.target);
+            break;
+        case MessageScope::Radius: {
+            // The snapshot's handles map its indices to entities, whether or
+            // not slots moved since it was published
+            PositionSnapshotView snapshot = m_positionSnapshots.acquire();
+            indexScratch.resize(snapshot->handles.size());
+            size_t found = snapshot->grid.queryRadius(queued.center.getX(), queued.center.getY(), queued.radius,
+                                                      indexScratch.data(), indexScratch.size());
+            for (size_t i = 0; i < found; ++i) {
+                EntityHandle handle = snapshot->handles[indexScratch[i]];
+                if (handle != queued.message.sender) {
+                    addRecipient(handle);
+                }
+            }
+            break;
+        }
+        case MessageScope::Group: {
+            auto it = m_groupMembers.find(queued.group);
+            if (it == m_groupMembers.end()) {
+                break;
+            }
+            for (EntityHandle handle : it->second) {
+                if (handle != queued.message.sender) {
+                    addRecipient(handle);
+                }
+            }
+            break;
+        }
+        case MessageScope::All:
+            break;
+    }
+}
+
+size_t AIManager::deliverFrameMessages(std::span<const uint32_t> slots, std::span<const EntityPtr> entities,
+                                       AIBehavior* behavior) {
+    // Runs inside the batch that owns these slots, so each flag below is
+    // written by one worker only
+    size_t delivered = 0;
+
+    if (!m_frameInbox.empty()) {
+        auto bySlot = [](const InboxEntry& a, const InboxEntry& b) { return a.slot < b.slot; };
+        for (size_t i = 0; i < slots.size(); ++i) {
+            InboxEntry key{slots[i], EntityHandle{}, AIMessage{}};
+            auto range = std::equal_range(m_frameInbox.begin(), m_frameInbox.end(), key, bySlot);
+            for (auto it = range.first; it != range.second; ++it) {
+                m_frameInboxDelivered[static_cast<size_t>(it - m_frameInbox.begin())] = 1;
+                if (entities[i] && entities[i]->getHandle() == it->target &&
+                    deliverMessage(behavior, entities[i], it->message)) {
+                    ++delivered;
+                }
+            }
+        }
+    }
+
+    if (!m_frameBroadcasts.empty()) {
+        for (uint32_t slot : slots) {
+            m_broadcastReceived[slot] = 1;
+        }
+        for (const AIMessage& message : m_frameBroadcasts) {
+            // One check covers the whole run: every entity in it shares the instance
+            if (!behavior->acceptsMessage(message.id)) {
+                continue;
+            }
+            for (const EntityPtr& entity : entities) {
+                if (entity && deliverMessage(behavior, entity, message)) {
+                    ++delivered;
+                }
+            }
+        }
+    }
+    return delivered;
+}
+
+void AIManager::deliverRemainingFrameMessages() {
+    // Caller holds m_behaviorExecutionMutex and m_entitiesMutex (shared) after
+    // the batches finished, so no behavior is running
+    size_t delivered = 0;
+    for (size_t e = 0; e < m_frameInbox.size(); ++e) {
+        const InboxEntry& entry = m_frameInbox[e];
+        if (m_frameInboxDelivered[e] || entry.slot >= m_storage.size() || !m_storage.active[entry.slot] ||
+            m_storage.handles[entry.slot] != entry.target || !m_storage.behaviors[entry.slot]) {
+            continue;
+        }
+        if (deliverMessage(m_storage.behaviors[entry.slot].get(), m_storage.entities[entry.slot], entry.message)) {
+            ++delivered;
+        }
+    }
+
+    if (!m_frameBroadcasts.empty()) {
+        // Neighbouring slots usually share an instance; filter once per change
+        AIBehavior* filteredFor = nullptr;
+        std::vector<const AIMessage*> accepted;
+        const size_t slotCount = std::min(m_storage.size(), m_broadcastReceived.size());
+        for (size_t slot = 0; slot < slotCount; ++slot) {
+            AIBehavior* behavior = m_storage.behaviors[slot].get();
+            if (m_broadcastReceived[slot] || !m_storage.active[slot] || !behavior) {
+                continue;
+            }
+            if (behavior != filteredFor) {
+                filteredFor = behavior;
+                accepted.clear();
+                for (const AIMessage& message : m_frameBroadcasts) {
+                    if (behavior->acceptsMessage(message.id)) {
+                        accepted.push_back(&message);
+                    }
+                }
+            }
+            for (const AIMessage* message : accepted) {
+                if (deliverMessage(behavior, m_storage.entities[slot], *message)) {
+                    ++delivered;
+                }
+            }
+        }
+    }
+    m_deliveredMessages.fetch_add(delivered, std::memory_order_relaxed);
+}
+
+void AIManager::clearFrameMessages() {
+    m_frameInbox.clear();
+    m_frameInboxDelivered.clear();
+    m_frameBroadcasts.clear();
+    m_broadcastReceived.clear();
 }
 
 BehaviorType AIManager::inferBehaviorType(const std::string& behaviorName) const {
@@ -716,160 +1186,504 @@ BehaviorType AIManager::inferBehaviorType(const std::string& behaviorName) const
     return (it != m_behaviorTypeMap.end()) ? it->second : BehaviorType::Custom;
 }
 
-void AIManager::processBatch(size_t start, size_t end, float deltaTime, int bufferIndex) {
-    // Work on the double buffer for lock-free operation
-    auto& workBuffer = m_storage.doubleBuffer[bufferIndex];
-    
-    // Get current player position
-    EntityPtr player = m_playerEntity.lock();
-    
+namespace {
+
+// processBatch() buffers, one set per thread that runs batches. They keep
+// their capacity between batches and frames, so steady frames allocate
+// nothing. A batch nested on a thread already inside one (a behavior
+// waiting on the thread pool) gets a set of its own.
+struct BatchScratch {
+    std::vector<uint32_t> slots;
+    std::vector<EntityPtr> entities;
+    std::vector<AIBehavior*> behaviors;
+    std::vector<float> deltaTimes;
+    std::vector<Vector2D> newPositions;
+    std::vector<Vector2D> newVelocities;
+    std::vector<uint8_t> failed;
+    std::vector<uint32_t> perceivers;
+    std::vector<uint32_t> perceiverSettings;
+    std::vector<Awareness> perceiverAwareness;
+    std::vector<PerceptionSettings> runSettings;
+    std::vector<Awareness> awareness;
+    std::vector<PerceptionObserver> observers;
+    bool inUse{false};
+
+    // Drops the batch's entity references; capacity stays
+    void clear() {
+        slots.clear();
+        entities.clear();
+        behaviors.clear();
+        deltaTimes.clear();
+        newPositions.clear();
+        newVelocities.clear();
+        failed.clear();
+        perceivers.clear();
+        perceiverSettings.clear();
+        perceiverAwareness.clear();
+        runSettings.clear();
+        awareness.clear();
+        observers.clear();
+    }
+};
+
+class BatchScratchLease {
+public:
+    BatchScratchLease() {
+        thread_local BatchScratch threadScratch;
+        m_scratch = threadScratch.inUse ? &m_nested : &threadScratch;
+        m_scratch->inUse = true;
+    }
+    ~BatchScratchLease() {
+        m_scratch->clear();
+        m_scratch->inUse = false;
+    }
+    BatchScratchLease(const BatchScratchLease&) = delete;
+    BatchScratchLease& operator=(const BatchScratchLease&) = delete;
+
+    BatchScratch& operator*() { return *m_scratch; }
+
+private:
+    BatchScratch* m_scratch{nullptr};
+    BatchScratch m_nested;
+};
+
+} // namespace
+
+void AIManager::processBatch(size_t start, size_t end, const FrameContext& context) {
+    HAMMER_TRACE_ZONE("AIManager::processBatch");
+
     size_t batchExecutions = 0;
-    
-    // Pre-calculate common values once per batch to reduce per-entity overhead
-    float maxDist = m_maxUpdateDistance.load(std::memory_order_relaxed);
-    float maxDistSquared = maxDist * maxDist;
-    bool hasPlayer = (player != nullptr);
-    
-    // Pre-cache entities and behaviors for the entire batch to reduce lock contention
-    std::vector<EntityPtr> batchEntities;
-    std::vector<std::shared_ptr<AIBehavior>> batchBehaviors;
-    batchEntities.reserve(end - start);
-    batchBehaviors.reserve(end - start);
-    
+    size_t batchMessages = 0;
+    const size_t batchSize = end - start;
+    BehaviorCallScope behaviorScope;
+    BatchScratchLease lease;
+    BatchScratch& scratch = *lease;
+
+    // Pre-cache entities and behaviors for the listed slots. Scheduling already
+    // happened in buildUpdateList(), so everything here gets updated. The
+    // caller holds m_behaviorExecutionMutex, so no slot's behavior can be
+    // replaced and raw pointers avoid contending on a shared instance's
+    // reference count.
+    std::vector<uint32_t>& batchSlots = scratch.slots;
+    std::vector<EntityPtr>& batchEntities = scratch.entities;
+    std::vector<AIBehavior*>& batchBehaviors = scratch.behaviors;
+    std::vector<float>& batchDeltaTimes = scratch.deltaTimes;
+    batchSlots.reserve(batchSize);
+    batchEntities.reserve(batchSize);
+    batchBehaviors.reserve(batchSize);
+    batchDeltaTimes.reserve(batchSize);
+
+    // Entities whose behavior perceives: their index in the batch, the
+    // settings of their run, and their awareness from the last update
+    std::vector<uint32_t>& perceivers = scratch.perceivers;
+    std::vector<uint32_t>& perceiverSettings = scratch.perceiverSettings;
+    std::vector<Awareness>& perceiverAwareness = scratch.perceiverAwareness;
+    std::vector<PerceptionSettings>& runSettings = scratch.runSettings;
+
     // Single lock acquisition for the entire batch
     {
         std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
-        for (size_t i = start; i < end && i < m_storage.size(); ++i) {
-            batchEntities.push_back(m_storage.entities[i]);
-            batchBehaviors.push_back(m_storage.behaviors[i]);
+        const AIBehavior* lastBehavior = nullptr;
+        bool lastPerceives = false;
+        for (size_t k = start; k < end; ++k) {
+            uint32_t slot = m_updateList[k];
+            // Storage may have been cleared or the entity unassigned since culling
+            if (slot < m_storage.size() && m_storage.active[slot]) {
+                AIBehavior* behavior = m_storage.behaviors[slot].get();
+                if (behavior != lastBehavior) {
+                    // Asked once per run of entities sharing an instance
+                    PerceptionSettings settings;
+                    lastBehavior = behavior;
+                    lastPerceives = behavior && behavior->getPerceptionSettings(settings);
+                    if (lastPerceives) {
+                        runSettings.push_back(settings);
+                    }
+                }
+                if (lastPerceives) {
+                    perceivers.push_back(static_cast<uint32_t>(batchSlots.size()));
+                    perceiverSettings.push_back(static_cast<uint32_t>(runSettings.size() - 1));
+                    perceiverAwareness.push_back(m_storage.awareness[slot]);
+                }
+                batchSlots.push_back(slot);
+                batchEntities.push_back(m_storage.entities[slot]);
+                batchBehaviors.push_back(behavior);
+                // Time since the slot last updated, covering frames its tier skipped
+                double lastUpdate = m_storage.lastUpdateTimes[slot];
+                batchDeltaTimes.push_back(lastUpdate < 0.0 ? context.deltaTime
+                                                           : static_cast<float>(m_aiTime - lastUpdate));
+            }
         }
     }
-    
-    // Process entities without locks
-    for (size_t idx = 0; idx < batchEntities.size(); ++idx) {
-        size_t i = start + idx;
-        if (i >= workBuffer.size()) break;
-        
-        auto& hotData = workBuffer[i];
-        if (!hotData.active) continue;
-        
-        EntityPtr entity = batchEntities[idx];
-        std::shared_ptr<AIBehavior> behavior = batchBehaviors[idx];
-        
-        if (!entity || !behavior) {
-            hotData.active = false;
-            continue;
+
+    // Perception for the whole batch before any behavior runs: range and
+    // view cone per entity, then every sight line traced together
+    std::vector<Awareness>& batchAwareness = scratch.awareness;
+    if (!perceivers.empty()) {
+        if (context.player.valid) {
+            std::vector<PerceptionObserver>& observers = scratch.observers;
+            observers.assign(perceivers.size(), PerceptionObserver{});
+            for (size_t p = 0; p < perceivers.size(); ++p) {
+                const uint32_t idx = perceivers[p];
+                PerceptionObserver& observer = observers[p];
+                observer.settings = &runSettings[perceiverSettings[p]];
+                observer.facing = perceiverAwareness[p].facing;
+                const EntityPtr& entity = batchEntities[idx];
+                if (!entity) {
+                    continue;
+                }
+                observer.position = entity->getPosition();
+                Vector2D facing;
+                if (batchBehaviors[idx]->getFacing(*entity, facing)) {
+                    observer.facing = facing;
+                } else if (entity->getVelocity().lengthSquared() > 0.0001f) {
+                    observer.facing = entity->getVelocity().normalized();
+                }
+            }
+            Perception::sense(m_framePerceptionGrid.get(), context.player.position, context.timeMs,
+                              observers, perceiverAwareness);
+        } else {
+            Perception::loseTarget(perceiverAwareness);
+        }
+        batchAwareness.resize(batchSlots.size());
+        for (size_t p = 0; p < perceivers.size(); ++p) {
+            batchAwareness[perceivers[p]] = perceiverAwareness[p];
+        }
+    }
+
+    // Process entities without locks, recording where each one ended up.
+    // Consecutive entities sharing a behavior instance go to it in one
+    // executeBatch() call; an exception from it fails that whole run.
+    std::vector<Vector2D>& newPositions = scratch.newPositions;
+    std::vector<Vector2D>& newVelocities = scratch.newVelocities;
+    std::vector<uint8_t>& failed = scratch.failed;
+    newPositions.resize(batchSlots.size());
+    newVelocities.resize(batchSlots.size());
+    failed.assign(batchSlots.size(), 0);
+
+    // Crowd steering reads neighbors from the snapshot published at the end
+    // of last frame, so results do not depend on which batch runs first
+    const CrowdSettings& crowd = m_frameCrowdSettings;
+    PositionSnapshotView crowdSnapshot;
+    if (crowd.enabled) {
+        crowdSnapshot = m_positionSnapshots.acquire();
+    }
+    const bool resolveCrowd = crowd.enabled && crowdSnapshot->grid.getEntryCount() > 0;
+    size_t nextPerceiver = 0;
+    size_t runStart = 0;
+    while (runStart < batchSlots.size()) {
+        AIBehavior* behavior = batchBehaviors[runStart];
+        size_t runEnd = runStart + 1;
+        while (runEnd < batchSlots.size() && batchBehaviors[runEnd] == behavior) {
+            ++runEnd;
         }
-        
-        try {
-            // Update position
-            hotData.position = entity->getPosition();
-            
-            // Simple distance-based culling - no frame counting needed
-            bool shouldUpdate = true;
-            if (hasPlayer) {
-                // Use pre-calculated values from batch level
-                float priorityMultiplier = 1.0f + hotData.priority * 0.1f;
-                float effectiveMaxDistSquared = maxDistSquared * priorityMultiplier * priorityMultiplier;
-                
-                // Pure distance-based culling - entities too far away don't update
-                shouldUpdate = (hotData.distanceSquared <= effectiveMaxDistSquared);
-                
 
+        bool runFailed = (behavior == nullptr);
+        FrameContext runContext = context;
+        runContext.entityDeltaTimes = std::span<const float>(batchDeltaTimes.data() + runStart, runEnd - runStart);
+        // Perceivers come in whole runs, so a run's first entity speaks for it
+        while (nextPerceiver < perceivers.size() && perceivers[nextPerceiver] < runStart) {
+            ++nextPerceiver;
+        }
+        if (nextPerceiver < perceivers.size() && perceivers[nextPerceiver] == runStart) {
+            runContext.entityAwareness = std::span<const Awareness>(batchAwareness.data() + runStart, runEnd - runStart);
+        }
+        if (!runFailed && (!m_frameInbox.empty() || !m_frameBroadcasts.empty())) {
+            // Queued messages land just before the entities they are for update
+            batchMessages += deliverFrameMessages(
+                std::span<const uint32_t>(batchSlots.data() + runStart, runEnd - runStart),
+                std::span<const EntityPtr>(batchEntities.data() + runStart, runEnd - runStart), behavior);
+        }
+        if (!runFailed) {
+            try {
+                behavior->executeBatch(
+                    std::span<const EntityPtr>(batchEntities.data() + runStart, runEnd - runStart), runContext);
+                batchExecutions += runEnd - runStart;
+            } catch (const std::exception& e) {
+                AI_ERROR("Error in batch processing: " + std::string(e.what()));
+                runFailed = true;
             }
-            
-            if (shouldUpdate) {
-                // Execute behavior
-                behavior->executeLogic(entity);
-                batchExecutions++;
-                
-                // Update entity
-                entity->update(deltaTime);
-                
-                // Update position after behavior execution
-                hotData.lastPosition = hotData.position;
-                hotData.position = entity->getPosition();
+        }
+
+        for (size_t idx = runStart; idx < runEnd; ++idx) {
+            EntityPtr& entity = batchEntities[idx];
+            if (runFailed || !entity) {
+                failed[idx] = 1;
+                continue;
+            }
+            try {
+                if (resolveCrowd) {
+                    // The behavior's velocity is what the entity wants; move it with what the crowd allows
+                    const AIPositionSnapshot& snapshot = *crowdSnapshot;
+                    entity->setVelocity(CrowdSteering::resolve(
+                        snapshot.grid, snapshot.velocityX.data(), snapshot.velocityY.data(), batchSlots[idx],
+                        entity->getPosition(), entity->getVelocity(), crowd));
+                }
+                entity->update(runContext.forEntity(idx - runStart));
+                newPositions[idx] = entity->getPosition();
+                newVelocities[idx] = entity->getVelocity();
+            } catch (const std::exception& e) {
+                AI_ERROR("Error in batch processing: " + std::string(e.what()));
+                failed[idx] = 1;
             }
-            
-        } catch (const std::exception& e) {
-            AI_ERROR("Error in batch processing: " + std::string(e.what()));
-            hotData.active = false;
         }
+        runStart = runEnd;
     }
-    
+
+    // Write positions back for the next distance pass. Slots are unique per
+    // batch, so concurrent batches never write the same element.
+    {
+        std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+        for (size_t idx = 0; idx < batchSlots.size(); ++idx) {
+            uint32_t slot = batchSlots[idx];
+            if (slot >= m_storage.size() || !batchEntities[idx] ||
+                m_storage.handles[slot] != batchEntities[idx]->getHandle()) {
+                continue;
+            }
+            if (failed[idx]) {
+                m_storage.active[slot] = 0;
+            } else {
+                m_storage.positionX[slot] = newPositions[idx].getX();
+                m_storage.positionY[slot] = newPositions[idx].getY();
+                m_storage.velocityX[slot] = newVelocities[idx].getX();
+                m_storage.velocityY[slot] = newVelocities[idx].getY();
+                m_storage.lastUpdateTimes[slot] = m_aiTime;
+            }
+        }
+        for (size_t p = 0; p < perceivers.size(); ++p) {
+            const uint32_t idx = perceivers[p];
+            const uint32_t slot = batchSlots[idx];
+            if (slot < m_storage.size() && batchEntities[idx] &&
+                m_storage.handles[slot] == batchEntities[idx]->getHandle()) {
+                m_storage.awareness[slot] = perceiverAwareness[p];
+            }
+        }
+    }
+
     if (batchExecutions > 0) {
         m_totalBehaviorExecutions.fetch_add(batchExecutions, std::memory_order_relaxed);
     }
+    if (batchMessages > 0) {
+        m_deliveredMessages.fetch_add(batchMessages, std::memory_order_relaxed);
+    }
 }
 
-void AIManager::updateDistancesScalar(const Vector2D& playerPos) {
-    size_t entityCount = m_storage.hotData.size();
-    
-    // Simple scalar implementation - only update active entities
-    // Skip inactive entities to reduce CPU usage significantly
-    size_t updatedCount = 0;
-    for (size_t i = 0; i < entityCount; ++i) {
-        auto& hotData = m_storage.hotData[i];
-        if (hotData.active) {
-            Vector2D diff = hotData.position - playerPos;
-            hotData.distanceSquared = diff.lengthSquared();
-            updatedCount++;
+void AIManager::updateDistances(const Vector2D& playerPos) {
+    // Caller holds m_entitiesMutex (shared); only the update thread writes distances
+    AIDistanceKernels::distancesSquared(m_storage.positionX.data(), m_storage.positionY.data(),
+                                        m_storage.size(), playerPos.getX(), playerPos.getY(),
+                                        m_storage.distanceSquared.data());
+}
+
+size_t AIManager::buildUpdateList(bool hasPlayer, uint64_t frame) {
+    // Caller holds m_entitiesMutex (shared)
+    using AIDistanceKernels::PRIORITY_THRESHOLD_COUNT;
+    AIDistanceKernels::UpdateSchedule schedule;
+    if (hasPlayer) {
+        // Each tier reaches at least as far as the one before it
+        float nearDist = m_maxUpdateDistance.load(std::memory_order_relaxed);
+        float midDist = std::max(nearDist, m_mediumUpdateDistance.load(std::memory_order_relaxed));
+        float farDist = std::max(midDist, m_minUpdateDistance.load(std::memory_order_relaxed));
+        AIDistanceKernels::buildPriorityThresholds(nearDist * nearDist, 0.1f, schedule.tierLimits[0]);
+        AIDistanceKernels::buildPriorityThresholds(midDist * midDist, 0.1f, schedule.tierLimits[1]);
+        AIDistanceKernels::buildPriorityThresholds(farDist * farDist, 0.1f, schedule.tierLimits[2]);
+    } else {
+        // No player to measure against: every entity is in the near tier
+        for (auto& limits : schedule.tierLimits) {
+            std::fill(std::begin(limits), std::end(limits), std::numeric_limits<float>::infinity());
         }
     }
-    
-    // Optional: Early exit if no entities were active
-    if (updatedCount == 0) {
+    for (size_t p = 0; p < PRIORITY_THRESHOLD_COUNT; ++p) {
+        const AIUpdateSchedule& intervals = m_updateSchedules[std::min(p, static_cast<size_t>(AI_MAX_PRIORITY))];
+        schedule.intervalMasks[0][p] = intervals.nearInterval - 1;
+        schedule.intervalMasks[1][p] = intervals.midInterval - 1;
+        schedule.intervalMasks[2][p] = intervals.farInterval - 1;
+        schedule.intervalMasks[3][p] = intervals.distantInterval - 1;
+    }
+
+    const size_t entityCount = m_storage.size();
+    m_updateList.resize(entityCount);
+    size_t updateCount = AIDistanceKernels::buildScheduledUpdateList(
+        m_storage.distanceSquared.data(), m_storage.active.data(), m_storage.priorities.data(),
+        m_storage.updatePhases.data(), entityCount, schedule, static_cast<uint32_t>(frame),
+        m_updateList.data());
+    m_updateList.resize(updateCount);
+    return updateCount;
+}
+
+void AIManager::groupUpdateListByType() {
+    // Caller holds m_entitiesMutex (shared). Stable counting sort on the
+    // slot's BehaviorType, so slots keep their order within a type and runs
+    // sharing one behavior instance stay contiguous.
+    constexpr size_t TYPE_COUNT = static_cast<size_t>(BehaviorType::COUNT);
+    std::array<uint32_t, TYPE_COUNT + 1> typeStart{};
+    for (uint32_t slot : m_updateList) {
+        ++typeStart[std::min<size_t>(m_storage.behaviorTypes[slot], TYPE_COUNT - 1) + 1];
+    }
+    for (size_t t = 0; t < TYPE_COUNT; ++t) {
+        typeStart[t + 1] += typeStart[t];
+    }
+
+    m_groupedUpdateList.resize(m_updateList.size());
+    std::array<uint32_t, TYPE_COUNT> cursor;
+    std::copy(typeStart.begin(), typeStart.end() - 1, cursor.begin());
+    for (uint32_t slot : m_updateList) {
+        m_groupedUpdateList[cursor[std::min<size_t>(m_storage.behaviorTypes[slot], TYPE_COUNT - 1)]++] = slot;
+    }
+    m_updateList.swap(m_groupedUpdateList);
+
+    // Split each type's run into batches of at most BATCH_SIZE
+    m_batchRanges.clear();
+    for (size_t t = 0; t < TYPE_COUNT; ++t) {
+        for (uint32_t start = typeStart[t]; start < typeStart[t + 1]; start += BATCH_SIZE) {
+            m_batchRanges.push_back({start, std::min<uint32_t>(start + BATCH_SIZE, typeStart[t + 1])});
+        }
+    }
+}
+
+void AIManager::commitPositionSnapshot(uint64_t frame) {
+    // Caller holds m_entitiesMutex (see m_positionSnapshots)
+    AIPositionSnapshot* snapshot = m_positionSnapshots.beginWrite();
+    if (!snapshot) {
+        // Readers still pin both older snapshots; the current one stays up
         return;
     }
+
+    // The grid writes each position once, into its entries; with its slot
+    // indices and the velocities that is about 32 bytes per entity a frame
+    float cellSize = m_spatialCellSize.load(std::memory_order_relaxed);
+    if (snapshot->grid.getCellSize() != cellSize) {
+        snapshot->grid.setCellSize(cellSize);
+    }
+    snapshot->grid.rebuild(m_storage.positionX.data(), m_storage.positionY.data(), m_storage.active.data(),
+                           m_storage.size(), m_useThreading.load(std::memory_order_acquire));
+    snapshot->velocityX.assign(m_storage.velocityX.begin(), m_storage.velocityX.end());
+    snapshot->velocityY.assign(m_storage.velocityY.begin(), m_storage.velocityY.end());
+
+    // Handles only change with the layout
+    if (snapshot->layoutVersion != m_storage.layoutVersion) {
+        snapshot->handles.assign(m_storage.handles.begin(), m_storage.handles.end());
+        snapshot->layoutVersion = m_storage.layoutVersion;
+    }
+    snapshot->frameNumber = frame;
+    m_positionSnapshots.publish();
 }
 
-void AIManager::cleanupInactiveEntities() {
-    std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
-    
-    // Find all inactive entities
-    std::vector<size_t> toRemove;
-    for (size_t i = 0; i < m_storage.size(); ++i) {
-        if (!m_storage.hotData[i].active) {
-            toRemove.push_back(i);
+void AIManager::clearPositionSnapshot() {
+    // Caller holds m_entitiesMutex exclusively
+    AIPositionSnapshot* snapshot = m_positionSnapshots.beginWrite();
+    if (!snapshot) {
+        return;
+    }
+    snapshot->grid.clear();
+    snapshot->velocityX.clear();
+    snapshot->velocityY.clear();
+    snapshot->handles.clear();
+    snapshot->layoutVersion = m_storage.layoutVersion;
+    snapshot->frameNumber = m_frameCounter.load(std::memory_order_relaxed);
+    m_positionSnapshots.publish();
+}
+
+AIManager::PositionSnapshotView AIManager::getPositionSnapshot() const {
+    return m_positionSnapshots.acquire();
+}
+
+size_t AIManager::queryEntitiesInRadius(const Vector2D& center, float radius,
+                                       uint32_t* outIndices, size_t capacity) const {
+    PositionSnapshotView snapshot = m_positionSnapshots.acquire();
+    return snapshot->grid.queryRadius(center.getX(), center.getY(), radius, outIndices, capacity);
+}
+
+size_t AIManager::queryEntitiesInRect(const Vector2D& minCorner, const Vector2D& maxCorner,
+                                     uint32_t* outIndices, size_t capacity) const {
+    PositionSnapshotView snapshot = m_positionSnapshots.acquire();
+    return snapshot->grid.queryRect(minCorner.getX(), minCorner.getY(), maxCorner.getX(), maxCorner.getY(),
+                                    outIndices, capacity);
+}
+
+Vector2D AIManager::getSpatialEntityPosition(uint32_t index) const {
+    PositionSnapshotView snapshot = m_positionSnapshots.acquire();
+    if (!snapshot->grid.contains(index)) {
+        return Vector2D(0, 0);
+    }
+    return Vector2D(snapshot->grid.getPositionX(index), snapshot->grid.getPositionY(index));
+}
+
+EntityPtr AIManager::getSpatialEntity(uint32_t index) const {
+    std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+    return index < m_storage.size() ? m_storage.entities[index] : nullptr;
+}
+
+void AIManager::setSpatialCellSize(float cellSize) {
+    if (cellSize > 0.0f) {
+        m_spatialCellSize.store(cellSize, std::memory_order_relaxed);
+    }
+}
+
+float AIManager::getSpatialCellSize() const {
+    return m_spatialCellSize.load(std::memory_order_relaxed);
+}
+
+void AIManager::cleanupInactiveEntities(size_t slotBudget) {
+    // Called from update() only; the cursor and scratch belong to the update thread.
+    // Find candidates under the shared lock so readers are not blocked on
+    // frames where the sweep finds nothing.
+    bool sweepFinished = false;
+    m_cleanupScratch.clear();
+    {
+        std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
+        const size_t slotCount = m_storage.size();
+        if (m_cleanupCursor >= slotCount) {
+            m_cleanupCursor = 0;
+        }
+        const size_t end = std::min(slotCount, m_cleanupCursor + slotBudget);
+        for (size_t i = m_cleanupCursor; i < end; ++i) {
+            if (!m_storage.active[i] && !m_storage.isFree(i)) {
+                m_cleanupScratch.push_back(static_cast<uint32_t>(i));
+            }
         }
+        m_cleanupCursor = end;
+        sweepFinished = (end == slotCount);
     }
-    
-    // Remove in reverse order to maintain indices
-    for (auto it = toRemove.rbegin(); it != toRemove.rend(); ++it) {
-        size_t index = *it;
-        
-        // Remove from entity map
-        if (index < m_storage.entities.size()) {
-            m_entityToIndex.erase(m_storage.entities[index]);
+
+    // Group lists are pruned at the end of a sweep, at most every 300 frames
+    const uint64_t frame = m_frameCounter.load(std::memory_order_relaxed);
+    const bool pruneGroups = sweepFinished &&
+        frame - m_lastCleanupFrame.load(std::memory_order_relaxed) >= 300;
+    if (m_cleanupScratch.empty() && !pruneGroups) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
+    std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
+
+    size_t released = 0;
+    for (uint32_t index : m_cleanupScratch) {
+        // Storage may have been cleared or the slot reactivated since the scan
+        if (index >= m_storage.size() || m_storage.active[index] || m_storage.isFree(index)) {
+            continue;
         }
-        
-        // Swap with last element and pop
-        if (index < m_storage.size() - 1) {
-            size_t lastIndex = m_storage.size() - 1;
-            
-            // Update hot data
-            m_storage.hotData[index] = m_storage.hotData[lastIndex];
-            
-            // Update cold data
-            m_storage.entities[index] = m_storage.entities[lastIndex];
-            m_storage.behaviors[index] = m_storage.behaviors[lastIndex];
-            m_storage.lastUpdateTimes[index] = m_storage.lastUpdateTimes[lastIndex];
-            
-            // Update index map
-            m_entityToIndex[m_storage.entities[index]] = index;
+
+        // Drop any state a shared behavior still keeps for the entity
+        if (m_storage.behaviors[index] && m_storage.entities[index]) {
+            m_storage.behaviors[index]->cleanupEntity(m_storage.entities[index]);
         }
-        
-        // Remove last element
-        m_storage.hotData.pop_back();
-        m_storage.entities.pop_back();
-        m_storage.behaviors.pop_back();
-        m_storage.lastUpdateTimes.pop_back();
+        m_entityToIndex.erase(m_storage.handles[index]);
+        m_storage.release(index);
+        ++released;
+    }
+
+    if (pruneGroups) {
+        pruneDeadGroupMembers();
+        m_lastCleanupFrame.store(frame, std::memory_order_relaxed);
+    }
+
+    if (released > 0) {
+        AI_DEBUG("Released " + std::to_string(released) + " inactive entity slots");
     }
-    
-    AI_DEBUG("Cleaned up " + std::to_string(toRemove.size()) + " inactive entities");
 }
 
 void AIManager::cleanupAllEntities() {
+    std::unique_lock<std::shared_mutex> executionLock(m_behaviorExecutionMutex);
     std::unique_lock<std::shared_mutex> lock(m_entitiesMutex);
     
     // Clean all behaviors
@@ -884,11 +1698,9 @@ void AIManager::cleanupAllEntities() {
     }
     
     // Clear all storage
-    m_storage.hotData.clear();
-    m_storage.entities.clear();
-    m_storage.behaviors.clear();
-    m_storage.lastUpdateTimes.clear();
+    m_storage.clear();
     m_entityToIndex.clear();
+    clearPositionSnapshot();
     
     AI_DEBUG("Cleaned up all entities for state transition");
 }
@@ -912,9 +1724,9 @@ int AIManager::getEntityPriority(EntityPtr entity) const {
     if (!entity) return DEFAULT_PRIORITY;
     
     std::shared_lock<std::shared_mutex> lock(m_entitiesMutex);
-    auto it = m_entityToIndex.find(entity);
-    if (it != m_entityToIndex.end() && it->second < m_storage.size()) {
-        return m_storage.hotData[it->second].priority;
+    const size_t* slot = m_entityToIndex.find(entity->getHandle());
+    if (slot && *slot < m_storage.size()) {
+        return m_storage.priorities[*slot];
     }
     return DEFAULT_PRIORITY;
 }
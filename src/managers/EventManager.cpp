@@ -11,10 +11,11 @@
 #include "events/NPCSpawnEvent.hpp"
 #include "events/EventFactory.hpp"
 #include "core/ThreadSystem.hpp"
+#include "core/TraceRecorder.hpp"
 #include "core/WorkerBudget.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <future>
 
 bool EventManager::init() {
     if (m_initialized.load()) {
@@ -128,6 +129,7 @@ void EventManager::update() {
     if (!m_initialized.load()) {
         return;
     }
+    HAMMER_TRACE_ZONE("EventManager::update");
 
     auto startTime = getCurrentTimeNanos();
 
@@ -463,97 +465,39 @@ void EventManager::updateEventTypeBatchThreaded(EventTypeId typeId) {
         return;
     }
 
-    // Proper WorkerBudget calculation with architectural respect
-    size_t availableWorkers = static_cast<size_t>(threadSystem.getThreadCount());
-    Hammer::WorkerBudget budget = Hammer::calculateWorkerBudget(availableWorkers);
+    // Adaptive WorkerBudget: the event share follows measured AI vs event load
+    Hammer::WorkerBudget budget = threadSystem.getWorkerBudget();
     size_t eventWorkerBudget = budget.eventAllocated;
 
-    // Check queue pressure before submitting tasks
-    size_t queueSize = threadSystem.getQueueSize();
-    size_t queueCapacity = threadSystem.getQueueCapacity();
-    size_t pressureThreshold = (queueCapacity * 9) / 10; // 90% capacity threshold
-    
-    if (queueSize > pressureThreshold) {
-        // Graceful degradation: fallback to single-threaded processing
-        EVENT_DEBUG("Queue pressure detected (" + std::to_string(queueSize) + "/" +
-                   std::to_string(queueCapacity) + "), using single-threaded processing");
-        for (auto& eventData : localEvents) {
-            if (eventData.event) {
-                eventData.event->update();
-            }
-        }
-        
-        // Record performance and return early
-        auto endTime = getCurrentTimeNanos();
-        double timeMs = (endTime - startTime) / 1000000.0;
-        if (timeMs > 1.0 || localEvents.size() > 50) {
-            recordPerformance(typeId, timeMs);
-        }
-        return;
-    }
-
     // Use buffer capacity for high workloads
     size_t optimalWorkerCount = budget.getOptimalWorkerCount(eventWorkerBudget, localEvents.size(), 100);
 
-    // Dynamic batch sizing based on queue pressure for optimal performance
-    size_t minEventsPerBatch = 10;
-    size_t maxBatches = 4;
-    
-    // Adjust batch strategy based on queue pressure
-    double queuePressure = static_cast<double>(queueSize) / queueCapacity;
-    if (queuePressure > 0.5) {
-        // High pressure: use fewer, larger batches to reduce queue overhead
-        minEventsPerBatch = 15;
-        maxBatches = 2;
-        EVENT_DEBUG("High queue pressure (" + std::to_string(static_cast<int>(queuePressure * 100)) +
-                   "%), using larger batches");
-    } else if (queuePressure < 0.25) {
-        // Low pressure: can use more batches for better parallelization
-        minEventsPerBatch = 8;
-        maxBatches = 4;
-    }
-
-    // Simple batch processing without complex spin-wait
-    if (optimalWorkerCount > 1 && localEvents.size() > 20) {
-        size_t batchCount = std::min(optimalWorkerCount, localEvents.size() / minEventsPerBatch);
-        batchCount = std::max(size_t(1), std::min(batchCount, maxBatches));
-        
-        size_t batchSize = localEvents.size() / batchCount;
-        size_t remainingEvents = localEvents.size() % batchCount;
-        
-        std::vector<std::future<void>> futures;
-        futures.reserve(batchCount);
-
-        // Submit optimized batches using futures for simpler synchronization
-        for (size_t i = 0; i < batchCount; ++i) {
-            size_t start = i * batchSize;
-            size_t end = start + batchSize;
-            
-            // Add remaining events to last batch
-            if (i == batchCount - 1) {
-                end += remainingEvents;
-            }
-
-            futures.push_back(threadSystem.enqueueTaskWithResult([&localEvents, start, end]() {
-                for (size_t j = start; j < end; ++j) {
-                    if (localEvents[j].event) {
-                        localEvents[j].event->update();
+    if (optimalWorkerCount > 0 && localEvents.size() > 20) {
+        // Calling thread joins in; returns once every batch has been updated.
+        // Batch time is summed across threads and reported as event work.
+        std::atomic<uint64_t> workNs{0};
+        threadSystem.parallelFor(0, localEvents.size(), MIN_EVENTS_PER_BATCH,
+            [this, &localEvents, &workNs](size_t begin, size_t end) {
+                uint64_t batchStart = getCurrentTimeNanos();
+                for (size_t i = begin; i < end; ++i) {
+                    if (localEvents[i].event) {
+                        localEvents[i].event->update();
                     }
                 }
-            }, Hammer::TaskPriority::Normal, "Event_OptimalBatch"));
-        }
-
-        // Wait for all batches to complete
-        for (auto& future : futures) {
-            future.wait();
-        }
+                workNs.fetch_add(getCurrentTimeNanos() - batchStart, std::memory_order_relaxed);
+            }, optimalWorkerCount, Hammer::TaskPriority::Normal, "Event_OptimalBatch");
+        threadSystem.reportSubsystemWork(Hammer::BudgetSubsystem::Events,
+                                         static_cast<double>(workNs.load(std::memory_order_relaxed)) / 1e6);
     } else {
         // Process single-threaded for small event counts
+        uint64_t batchStart = getCurrentTimeNanos();
         for (auto& eventData : localEvents) {
             if (eventData.event) {
                 eventData.event->update();
             }
         }
+        threadSystem.reportSubsystemWork(Hammer::BudgetSubsystem::Events,
+                                         static_cast<double>(getCurrentTimeNanos() - batchStart) / 1e6);
     }
 
     // Simplified performance recording
@@ -0,0 +1,340 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "managers/FormationManager.hpp"
+#include "core/Logger.hpp"
+#include "entities/Entity.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Leaders slower than this keep their last heading, so a formation does not
+// spin while its leader stands still
+constexpr float HEADING_MIN_SPEED = 1.0f;
+
+Vector2D rotate(const Vector2D& offset, float cosHeading, float sinHeading) {
+    return Vector2D(offset.getX() * cosHeading - offset.getY() * sinHeading,
+                    offset.getX() * sinHeading + offset.getY() * cosHeading);
+}
+
+} // namespace
+
+bool FormationManager::init() {
+    if (m_initialized.load(std::memory_order_acquire)) {
+        return true;
+    }
+    m_initialized.store(true, std::memory_order_release);
+    FORMATION_INFO("FormationManager initialized");
+    return true;
+}
+
+void FormationManager::clean() {
+    if (!m_initialized.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dropFormations();
+    m_stats = FormationStats{};
+    m_initialized.store(false, std::memory_order_release);
+    FORMATION_INFO("FormationManager cleaned");
+}
+
+void FormationManager::prepareForStateTransition() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dropFormations();
+}
+
+void FormationManager::dropFormations() {
+    m_formations.clear();
+    ++m_membershipVersion;
+    m_currentSnapshot.store(nullptr, std::memory_order_release);
+    m_frameSnapshot = {};
+}
+
+void FormationManager::update() {
+    if (!m_initialized.load(std::memory_order_acquire)) {
+        return;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_formations.empty()) {
+        m_currentSnapshot.store(nullptr, std::memory_order_release);
+        m_frameSnapshot = {};
+        return;
+    }
+
+    // A full ring means readers still hold two older snapshots; matching
+    // still runs and the current snapshot stays published one more frame
+    FormationSnapshot* snapshot = m_snapshots.beginWrite();
+    if (snapshot) {
+        snapshot->slotPositions.clear();
+    }
+
+    const EntityRegistry& registry = EntityRegistry::Instance();
+    for (size_t i = 0; i < m_formations.size();) {
+        Formation& formation = m_formations[i];
+        EntityPtr leader = registry.resolve(formation.leader);
+        if (!leader) {
+            FORMATION_DEBUG("Dropping formation " + std::to_string(formation.id) + ": leader is gone");
+            m_formations.erase(m_formations.begin() + static_cast<std::ptrdiff_t>(i));
+            ++m_membershipVersion;
+            continue;
+        }
+
+        const Vector2D leaderPosition = leader->getPosition();
+        const Vector2D leaderVelocity = leader->getVelocity();
+        if (leaderVelocity.lengthSquared() > HEADING_MIN_SPEED * HEADING_MIN_SPEED) {
+            formation.heading = std::atan2(leaderVelocity.getY(), leaderVelocity.getX());
+        }
+        if (formation.dirty) {
+            matchSlots(formation, leaderPosition);
+        }
+
+        if (snapshot) {
+            const bool turns = FormationLayout::turnsWithLeader(formation.shape);
+            const float cosHeading = turns ? std::cos(formation.heading) : 1.0f;
+            const float sinHeading = turns ? std::sin(formation.heading) : 0.0f;
+            for (const Vector2D& offset : formation.offsets) {
+                snapshot->slotPositions.push_back(leaderPosition + rotate(offset, cosHeading, sinHeading));
+            }
+        }
+        ++i;
+    }
+
+    if (snapshot) {
+        if (snapshot->membershipVersion != m_membershipVersion) {
+            snapshot->memberSlots.clear();
+            uint32_t slot = 0;
+            for (const Formation& formation : m_formations) {
+                for (const EntityHandle& member : formation.members) {
+                    snapshot->memberSlots.insert(member, slot++);
+                }
+            }
+            snapshot->membershipVersion = m_membershipVersion;
+        }
+        m_snapshots.publish();
+        ++m_stats.publishes;
+    }
+
+    if (m_formations.empty()) {
+        m_currentSnapshot.store(nullptr, std::memory_order_release);
+        m_frameSnapshot = {};
+    } else if (snapshot) {
+        // Pin the new snapshot before letting go of last frame's
+        auto pinned = m_snapshots.acquire();
+        m_currentSnapshot.store(&*pinned, std::memory_order_release);
+        m_frameSnapshot = std::move(pinned);
+    }
+
+    m_stats.updateTimeMs += std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+void FormationManager::matchSlots(Formation& formation, const Vector2D& leaderPosition) {
+    const EntityRegistry& registry = EntityRegistry::Instance();
+    std::vector<Vector2D> memberPositions;
+    memberPositions.reserve(formation.members.size());
+
+    // Members destroyed without leaving give up their slots here
+    size_t kept = 0;
+    for (const EntityHandle& member : formation.members) {
+        if (EntityPtr entity = registry.resolve(member)) {
+            memberPositions.push_back(entity->getPosition());
+            formation.members[kept++] = member;
+        }
+    }
+    formation.members.resize(kept);
+
+    const uint32_t count = static_cast<uint32_t>(kept);
+    formation.offsets.resize(count);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        formation.offsets[slot] = FormationLayout::slotOffset(formation.shape, slot, count, formation.spacing);
+    }
+    formation.dirty = false;
+    ++m_membershipVersion;
+    ++m_stats.rematches;
+    if (count < 2 || count > MAX_MATCHED_MEMBERS) {
+        return;
+    }
+
+    const bool turns = FormationLayout::turnsWithLeader(formation.shape);
+    const float cosHeading = turns ? std::cos(formation.heading) : 1.0f;
+    const float sinHeading = turns ? std::sin(formation.heading) : 0.0f;
+    std::vector<Vector2D> slotPositions(count);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        slotPositions[slot] = leaderPosition + rotate(formation.offsets[slot], cosHeading, sinHeading);
+    }
+
+    // Greedy: the closest free member and free slot pair up first
+    struct Pair {
+        float distanceSquared;
+        uint16_t member;
+        uint16_t slot;
+    };
+    std::vector<Pair> pairs;
+    pairs.reserve(static_cast<size_t>(count) * count);
+    for (uint32_t member = 0; member < count; ++member) {
+        for (uint32_t slot = 0; slot < count; ++slot) {
+            pairs.push_back({(memberPositions[member] - slotPositions[slot]).lengthSquared(),
+                             static_cast<uint16_t>(member), static_cast<uint16_t>(slot)});
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+        if (a.distanceSquared != b.distanceSquared) {
+            return a.distanceSquared < b.distanceSquared;
+        }
+        return a.member != b.member ? a.member < b.member : a.slot < b.slot;
+    });
+
+    std::vector<EntityHandle> bySlot(count);
+    std::vector<bool> memberTaken(count, false);
+    std::vector<bool> slotTaken(count, false);
+    uint32_t assigned = 0;
+    for (const Pair& pair : pairs) {
+        if (memberTaken[pair.member] || slotTaken[pair.slot]) {
+            continue;
+        }
+        memberTaken[pair.member] = true;
+        slotTaken[pair.slot] = true;
+        bySlot[pair.slot] = formation.members[pair.member];
+        if (++assigned == count) {
+            break;
+        }
+    }
+    formation.members.swap(bySlot);
+}
+
+FormationId FormationManager::createFormation(EntityHandle leader, FormationShape shape, float spacing,
+                                              uint32_t maxMembers) {
+    if (!m_initialized.load(std::memory_order_acquire) || !leader.isValid()) {
+        return INVALID_FORMATION;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Formation formation;
+    formation.id = m_nextId++;
+    formation.leader = leader;
+    formation.shape = shape;
+    formation.spacing = std::max(spacing, 0.0f);
+    formation.maxMembers = maxMembers;
+    m_formations.push_back(std::move(formation));
+    return m_formations.back().id;
+}
+
+FormationId FormationManager::findOrCreateFormation(EntityHandle leader, FormationShape shape, float spacing) {
+    if (!m_initialized.load(std::memory_order_acquire) || !leader.isValid()) {
+        return INVALID_FORMATION;
+    }
+    spacing = std::max(spacing, 0.0f);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const Formation& formation : m_formations) {
+        if (formation.shared && formation.leader == leader && formation.shape == shape &&
+            formation.spacing == spacing) {
+            return formation.id;
+        }
+    }
+    Formation formation;
+    formation.id = m_nextId++;
+    formation.leader = leader;
+    formation.shape = shape;
+    formation.spacing = spacing;
+    formation.shared = true;
+    m_formations.push_back(std::move(formation));
+    return m_formations.back().id;
+}
+
+bool FormationManager::destroyFormation(FormationId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_formations.begin(), m_formations.end(),
+                           [id](const Formation& formation) { return formation.id == id; });
+    if (it == m_formations.end()) {
+        return false;
+    }
+    m_formations.erase(it);
+    ++m_membershipVersion;
+    return true;
+}
+
+bool FormationManager::setFormationShape(FormationId id, FormationShape shape, float spacing) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Formation* formation = findFormation(id);
+    if (!formation) {
+        return false;
+    }
+    formation->shape = shape;
+    formation->spacing = std::max(spacing, 0.0f);
+    formation->dirty = true;
+    return true;
+}
+
+bool FormationManager::joinFormation(FormationId id, EntityHandle member) {
+    if (!member.isValid()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Formation* formation = findFormation(id);
+    if (!formation) {
+        return false;
+    }
+    if (std::find(formation->members.begin(), formation->members.end(), member) != formation->members.end()) {
+        return true;
+    }
+    if (formation->maxMembers != 0 && formation->members.size() >= formation->maxMembers) {
+        return false;
+    }
+    formation->members.push_back(member);
+    formation->dirty = true;
+    return true;
+}
+
+void FormationManager::leaveFormation(FormationId id, EntityHandle member) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Formation* formation = findFormation(id);
+    if (!formation) {
+        return;
+    }
+    auto it = std::find(formation->members.begin(), formation->members.end(), member);
+    if (it != formation->members.end()) {
+        formation->members.erase(it);
+        formation->dirty = true;
+    }
+}
+
+size_t FormationManager::getFormationCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_formations.size();
+}
+
+size_t FormationManager::getMemberCount(FormationId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Formation* formation = findFormation(id);
+    return formation ? formation->members.size() : 0;
+}
+
+EntityHandle FormationManager::getLeader(FormationId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Formation* formation = findFormation(id);
+    return formation ? formation->leader : EntityHandle{};
+}
+
+FormationStats FormationManager::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+FormationManager::Formation* FormationManager::findFormation(FormationId id) {
+    for (Formation& formation : m_formations) {
+        if (formation.id == id) {
+            return &formation;
+        }
+    }
+    return nullptr;
+}
+
+const FormationManager::Formation* FormationManager::findFormation(FormationId id) const {
+    return const_cast<FormationManager*>(this)->findFormation(id);
+}
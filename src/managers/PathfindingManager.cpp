@@ -0,0 +1,666 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#include "managers/PathfindingManager.hpp"
+#include "core/Logger.hpp"
+#include "core/ThreadSystem.hpp"
+#include "core/WorkerBudget.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// Counts a search task as running for as long as the task exists. The
+// count drops exactly once, when the body finishes or when the task is
+// destroyed unrun (rejected, or discarded at shutdown), so waitForSearches()
+// never waits on a task that will not run.
+class RunningTask {
+public:
+    explicit RunningTask(std::atomic<size_t>& counter) noexcept : m_counter(&counter) {
+        counter.fetch_add(1, std::memory_order_acq_rel);
+    }
+    RunningTask(RunningTask&& other) noexcept : m_counter(other.m_counter) {
+        other.m_counter = nullptr;
+    }
+    RunningTask(const RunningTask&) = delete;
+    RunningTask& operator=(const RunningTask&) = delete;
+    RunningTask& operator=(RunningTask&&) = delete;
+
+    ~RunningTask() {
+        release();
+    }
+
+    void release() noexcept {
+        if (std::atomic<size_t>* counter = m_counter) {
+            m_counter = nullptr;
+            counter->fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+private:
+    std::atomic<size_t>* m_counter;
+};
+
+// Holds m_flowFieldBuilding, which update() sets before handing the build
+// off, and clears it exactly once: when the build returns or throws, or
+// when its task is destroyed unrun. Otherwise the flag would stay set and
+// update() would never build the field again.
+class FlowFieldBuild {
+public:
+    explicit FlowFieldBuild(std::atomic<bool>& building) noexcept : m_building(&building) {}
+    FlowFieldBuild(FlowFieldBuild&& other) noexcept : m_building(other.m_building) {
+        other.m_building = nullptr;
+    }
+    FlowFieldBuild(const FlowFieldBuild&) = delete;
+    FlowFieldBuild& operator=(const FlowFieldBuild&) = delete;
+    FlowFieldBuild& operator=(FlowFieldBuild&&) = delete;
+
+    ~FlowFieldBuild() {
+        release();
+    }
+
+    void release() noexcept {
+        if (std::atomic<bool>* building = m_building) {
+            m_building = nullptr;
+            building->store(false, std::memory_order_release);
+        }
+    }
+
+private:
+    std::atomic<bool>* m_building;
+};
+
+} // namespace
+
+bool PathfindingManager::init() {
+    if (m_initialized.load(std::memory_order_acquire)) {
+        return true;
+    }
+    m_initialized.store(true, std::memory_order_release);
+    PATHFINDING_INFO("PathfindingManager initialized");
+    return true;
+}
+
+void PathfindingManager::clean() {
+    if (!m_initialized.load(std::memory_order_acquire)) {
+        return;
+    }
+    waitForSearches();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Slots are kept so released generations are never handed out again
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i].status != PathStatus::Invalid) {
+            retireSlot(i);
+        }
+    }
+    m_queue.clear();
+    m_cache.clear();
+    m_cacheOrder.clear();
+    m_hasFlowGoal = false;
+    m_flowFieldRadius = 0.0f;
+    m_flowFieldBuilding.store(false, std::memory_order_release);
+    resetFlowField();
+    m_frameFlowField = {};
+    m_grid.reset();
+    ++m_gridVersion;
+    m_hasGrid.store(false, std::memory_order_release);
+    m_stats = PathfindingStats{};
+    {
+        std::lock_guard<std::mutex> poolLock(m_poolMutex);
+        m_searchPool.clear();
+    }
+    m_initialized.store(false, std::memory_order_release);
+    PATHFINDING_INFO("PathfindingManager cleaned");
+}
+
+void PathfindingManager::prepareForStateTransition() {
+    waitForSearches();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i].status != PathStatus::Invalid) {
+            retireSlot(i);
+        }
+    }
+    m_queue.clear();
+    invalidateCache();
+    m_hasFlowGoal = false;
+    m_flowFieldBuilding.store(false, std::memory_order_release);
+    resetFlowField();
+    m_frameFlowField = {};
+}
+
+void PathfindingManager::update() {
+    if (!m_initialized.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::vector<SearchJob> jobs;
+    std::shared_ptr<const NavigationGrid> grid;
+    uint64_t gridVersion = 0;
+    bool buildField = false;
+    uint32_t fieldGoal = NavigationGrid::INVALID_CELL;
+    float fieldMaxCost = 0.0f;
+    uint64_t fieldGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t budget = m_requestsPerFrame.load(std::memory_order_relaxed);
+        while (!m_queue.empty() && jobs.size() < budget) {
+            const SearchJob job = m_queue.front();
+            m_queue.pop_front();
+            // Released while it waited
+            if (job.slot < m_slots.size() && m_slots[job.slot].generation == job.generation &&
+                m_slots[job.slot].status == PathStatus::Pending) {
+                jobs.push_back(job);
+            }
+        }
+        grid = m_grid;
+        gridVersion = m_gridVersion;
+
+        // Rebuild only when the goal changed cell or the grid changed
+        if (m_hasFlowGoal && m_grid && !m_flowFieldBuilding.load(std::memory_order_acquire)) {
+            fieldGoal = m_grid->nearestWalkable(m_grid->cellAt(m_flowGoal), ENDPOINT_SNAP_RINGS);
+            if (fieldGoal != NavigationGrid::INVALID_CELL &&
+                (fieldGoal != m_flowBuiltCell || m_gridVersion != m_flowBuiltVersion)) {
+                buildField = true;
+                fieldMaxCost = m_flowFieldRadius / m_grid->getCellSize();
+                fieldGeneration = m_flowGeneration;
+                m_flowFieldBuilding.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    if (buildField) {
+        bool queued = false;
+        if (Hammer::ThreadSystem::Exists()) {
+            queued = Hammer::ThreadSystem::Instance().enqueueTask(
+                [this, grid, fieldGoal, gridVersion, fieldMaxCost, fieldGeneration,
+                 building = FlowFieldBuild(m_flowFieldBuilding),
+                 running = RunningTask(m_runningTasks)]() mutable {
+                    buildFlowField(grid, fieldGoal, gridVersion, fieldMaxCost, fieldGeneration);
+                    building.release();
+                    running.release();
+                },
+                Hammer::TaskPriority::Normal, "Pathfinding_FlowField");
+        }
+        if (!queued) {
+            // The rejected task has cleared the flag; build here under a guard of our own
+            m_flowFieldBuilding.store(true, std::memory_order_release);
+            FlowFieldBuild building(m_flowFieldBuilding);
+            buildFlowField(grid, fieldGoal, gridVersion, fieldMaxCost, fieldGeneration);
+        }
+    }
+
+    if (!jobs.empty() && grid) {
+        dispatchSearches(std::move(jobs), std::move(grid), gridVersion);
+    }
+    pinFlowField();
+}
+
+void PathfindingManager::dispatchSearches(std::vector<SearchJob> jobs, std::shared_ptr<const NavigationGrid> grid,
+                                          uint64_t gridVersion) {
+    if (!Hammer::ThreadSystem::Exists()) {
+        runSearches(std::move(jobs), std::move(grid), gridVersion);
+        return;
+    }
+
+    // A few searches per task: enough to amortize the task, small enough
+    // that one long search does not hold up the rest of the frame's budget
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    for (size_t first = 0; first < jobs.size(); first += SEARCHES_PER_TASK) {
+        const size_t last = std::min(jobs.size(), first + SEARCHES_PER_TASK);
+        std::vector<SearchJob> taskJobs(jobs.begin() + static_cast<std::ptrdiff_t>(first),
+                                        jobs.begin() + static_cast<std::ptrdiff_t>(last));
+        bool queued = threadSystem.enqueueTask(
+            [this, taskJobs = std::move(taskJobs), grid, gridVersion,
+             running = RunningTask(m_runningTasks)]() mutable {
+                runSearches(std::move(taskJobs), std::move(grid), gridVersion);
+                running.release();
+            },
+            Hammer::TaskPriority::Normal, "Pathfinding_Search");
+        if (!queued) {
+            // Queue full or shutting down: the rejected task has already
+            // dropped its count; search here rather than lose the requests
+            runSearches(std::vector<SearchJob>(jobs.begin() + static_cast<std::ptrdiff_t>(first),
+                                               jobs.begin() + static_cast<std::ptrdiff_t>(last)),
+                        grid, gridVersion);
+        }
+    }
+}
+
+void PathfindingManager::buildFlowField(std::shared_ptr<const NavigationGrid> grid, uint32_t goalCell,
+                                        uint64_t gridVersion, float maxCost, uint64_t generation) {
+    auto start = std::chrono::steady_clock::now();
+    // Null only while frames still pin both older fields; the next update() retries
+    FlowField* field = m_flowFields.beginWrite();
+    if (field) {
+        field->build(*grid, goalCell, maxCost);
+    }
+    const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (field && generation == m_flowGeneration) {
+            m_flowFields.publish();
+            m_flowBuiltCell = goalCell;
+            m_flowBuiltVersion = gridVersion;
+            m_flowFieldReady = true;
+            ++m_stats.flowFieldBuilds;
+            m_stats.flowFieldTimeMs += buildMs;
+        }
+    }
+    if (Hammer::ThreadSystem::Exists()) {
+        Hammer::ThreadSystem::Instance().reportSubsystemWork(Hammer::BudgetSubsystem::AI, buildMs);
+    }
+}
+
+void PathfindingManager::pinFlowField() {
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ready = m_flowFieldReady;
+    }
+    if (!ready) {
+        m_currentFlowField.store(nullptr, std::memory_order_release);
+        m_frameFlowField = {};
+        return;
+    }
+    // Pin the new field before letting go of last frame's
+    auto pinned = m_flowFields.acquire();
+    m_currentFlowField.store(&*pinned, std::memory_order_release);
+    m_frameFlowField = std::move(pinned);
+}
+
+void PathfindingManager::resetFlowField() {
+    ++m_flowGeneration;
+    m_flowBuiltCell = NavigationGrid::INVALID_CELL;
+    m_flowFieldReady = false;
+    m_currentFlowField.store(nullptr, std::memory_order_release);
+}
+
+void PathfindingManager::setFlowFieldGoal(const Vector2D& position) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasFlowGoal = true;
+    m_flowGoal = position;
+}
+
+void PathfindingManager::clearFlowFieldGoal() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_hasFlowGoal) {
+        m_hasFlowGoal = false;
+        resetFlowField();
+    }
+}
+
+void PathfindingManager::setFlowFieldRadius(float radius) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    radius = std::max(radius, 0.0f);
+    if (radius != m_flowFieldRadius) {
+        m_flowFieldRadius = radius;
+        // Rebuild at the new radius; the current field is served until then
+        m_flowBuiltCell = NavigationGrid::INVALID_CELL;
+    }
+}
+
+void PathfindingManager::runSearches(std::vector<SearchJob> jobs, std::shared_ptr<const NavigationGrid> grid,
+                                     uint64_t gridVersion) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<AStarPathfinder> pathfinder = acquirePathfinder();
+
+    std::vector<SearchResult> results;
+    results.reserve(jobs.size());
+    uint64_t expanded = 0;
+    for (const SearchJob& job : jobs) {
+        results.push_back({job, search(*pathfinder, *grid, job.startCell, job.goalCell, expanded)});
+    }
+    returnPathfinder(std::move(pathfinder));
+
+    const double searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    publish(results, gridVersion, expanded, searchMs);
+    if (Hammer::ThreadSystem::Exists()) {
+        Hammer::ThreadSystem::Instance().reportSubsystemWork(Hammer::BudgetSubsystem::AI, searchMs);
+    }
+}
+
+PathfindingManager::PathPtr PathfindingManager::search(AStarPathfinder& pathfinder, const NavigationGrid& grid,
+                                                       uint32_t startCell, uint32_t goalCell,
+                                                       uint64_t& expanded) const {
+    thread_local std::vector<uint32_t> cells;
+    AStarPathfinder::Result result =
+        pathfinder.findPath(grid, startCell, goalCell, cells, m_maxExpansions.load(std::memory_order_relaxed));
+    expanded += pathfinder.getLastExpansions();
+    if (result != AStarPathfinder::Result::Found) {
+        return nullptr;
+    }
+
+    AStarPathfinder::smoothPath(grid, cells);
+    auto path = std::make_shared<Path>();
+    path->reserve(cells.size());
+    // The requester is already in the start cell
+    for (size_t i = 1; i < cells.size(); ++i) {
+        path->push_back(grid.cellCenter(cells[i]));
+    }
+    return path;
+}
+
+void PathfindingManager::publish(std::vector<SearchResult>& results, uint64_t gridVersion, uint64_t expanded,
+                                 double searchMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.searches += results.size();
+    m_stats.cellsExpanded += expanded;
+    m_stats.searchTimeMs += searchMs;
+
+    for (SearchResult& result : results) {
+        if (!result.path) {
+            ++m_stats.failures;
+        } else if (gridVersion == m_gridVersion) {
+            cachePath(cacheKey(result.job.startCell, result.job.goalCell), result.path);
+        }
+
+        if (result.job.slot >= m_slots.size()) {
+            continue;
+        }
+        RequestSlot& slot = m_slots[result.job.slot];
+        if (slot.generation == result.job.generation && slot.status == PathStatus::Pending) {
+            slot.status = result.path ? PathStatus::Ready : PathStatus::Failed;
+            slot.path = std::move(result.path);
+        }
+    }
+}
+
+void PathfindingManager::setGrid(uint32_t width, uint32_t height, float cellSize, const Vector2D& origin) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_grid = std::make_shared<NavigationGrid>(width, height, cellSize, origin);
+    ++m_gridVersion;
+    invalidateCache();
+
+    // Queued cells belong to the old layout
+    for (const SearchJob& job : m_queue) {
+        if (job.slot < m_slots.size() && m_slots[job.slot].generation == job.generation) {
+            m_slots[job.slot].status = PathStatus::Failed;
+            ++m_stats.failures;
+        }
+    }
+    m_queue.clear();
+    m_hasGrid.store(!m_grid->empty(), std::memory_order_release);
+    PATHFINDING_DEBUG("Navigation grid set to " + std::to_string(width) + "x" + std::to_string(height));
+}
+
+void PathfindingManager::setCellBlocked(const Vector2D& position, bool blocked) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_grid) {
+        return;
+    }
+    const uint32_t cell = m_grid->cellAt(position);
+    if (cell == NavigationGrid::INVALID_CELL || m_grid->isBlocked(cell) == blocked) {
+        return;
+    }
+    editableGrid().setBlocked(cell, blocked);
+    ++m_gridVersion;
+    invalidateCache();
+}
+
+void PathfindingManager::setAreaBlocked(const Vector2D& minCorner, const Vector2D& maxCorner, bool blocked) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_grid) {
+        return;
+    }
+    if (editableGrid().setBlockedArea(minCorner, maxCorner, blocked) > 0) {
+        ++m_gridVersion;
+        invalidateCache();
+    }
+}
+
+bool PathfindingManager::isBlocked(const Vector2D& position) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_grid) {
+        return false;
+    }
+    const uint32_t cell = m_grid->cellAt(position);
+    return cell == NavigationGrid::INVALID_CELL || m_grid->isBlocked(cell);
+}
+
+uint64_t PathfindingManager::getGridVersion() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_gridVersion;
+}
+
+std::shared_ptr<const NavigationGrid> PathfindingManager::getGrid() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_grid;
+}
+
+PathRequestHandle PathfindingManager::requestPath(const Vector2D& start, const Vector2D& goal) {
+    if (!m_initialized.load(std::memory_order_acquire) || !hasGrid()) {
+        return PathRequestHandle{};
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_grid) {
+        return PathRequestHandle{};
+    }
+    const NavigationGrid& grid = *m_grid;
+    const uint32_t startCell = grid.nearestWalkable(grid.cellAt(start), ENDPOINT_SNAP_RINGS);
+    const uint32_t requestedGoalCell = grid.cellAt(goal);
+    const uint32_t goalCell = grid.nearestWalkable(requestedGoalCell, ENDPOINT_SNAP_RINGS);
+
+    uint32_t index;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    RequestSlot& slot = m_slots[index];
+    const PathRequestHandle handle{index, slot.generation};
+    ++m_stats.requests;
+
+    if (startCell == NavigationGrid::INVALID_CELL || goalCell == NavigationGrid::INVALID_CELL) {
+        slot.status = PathStatus::Failed;
+        ++m_stats.failures;
+        return handle;
+    }
+    slot.exactGoal = (goalCell == requestedGoalCell);
+    slot.goal = slot.exactGoal ? goal : grid.cellCenter(goalCell);
+
+    auto cached = m_cache.find(cacheKey(startCell, goalCell));
+    if (cached != m_cache.end()) {
+        slot.status = PathStatus::Ready;
+        slot.path = cached->second;
+        ++m_stats.cacheHits;
+        return handle;
+    }
+
+    slot.status = PathStatus::Pending;
+    m_queue.push_back({index, slot.generation, startCell, goalCell});
+    return handle;
+}
+
+PathStatus PathfindingManager::getPathStatus(PathRequestHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation) {
+        return PathStatus::Invalid;
+    }
+    return m_slots[handle.index].status;
+}
+
+bool PathfindingManager::getPath(PathRequestHandle handle, std::vector<Vector2D>& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle.index >= m_slots.size()) {
+        return false;
+    }
+    const RequestSlot& slot = m_slots[handle.index];
+    if (slot.generation != handle.generation || slot.status != PathStatus::Ready || !slot.path) {
+        return false;
+    }
+    out.assign(slot.path->begin(), slot.path->end());
+    // The cached route ends at the goal cell's center; end it where asked
+    if (out.empty()) {
+        out.push_back(slot.goal);
+    } else {
+        out.back() = slot.goal;
+    }
+    return true;
+}
+
+void PathfindingManager::releasePath(PathRequestHandle handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation ||
+        m_slots[handle.index].status == PathStatus::Invalid) {
+        return;
+    }
+    retireSlot(handle.index);
+}
+
+PathStatus PathfindingManager::findPathNow(const Vector2D& start, const Vector2D& goal, std::vector<Vector2D>& out) {
+    out.clear();
+    std::shared_ptr<const NavigationGrid> grid = getGrid();
+    if (!grid) {
+        return PathStatus::Failed;
+    }
+    const uint32_t startCell = grid->nearestWalkable(grid->cellAt(start), ENDPOINT_SNAP_RINGS);
+    const uint32_t requestedGoalCell = grid->cellAt(goal);
+    const uint32_t goalCell = grid->nearestWalkable(requestedGoalCell, ENDPOINT_SNAP_RINGS);
+    if (startCell == NavigationGrid::INVALID_CELL || goalCell == NavigationGrid::INVALID_CELL) {
+        return PathStatus::Failed;
+    }
+
+    auto searchStart = std::chrono::steady_clock::now();
+    std::unique_ptr<AStarPathfinder> pathfinder = acquirePathfinder();
+    uint64_t expanded = 0;
+    PathPtr path = search(*pathfinder, *grid, startCell, goalCell, expanded);
+    returnPathfinder(std::move(pathfinder));
+    const double searchMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.searches;
+        m_stats.cellsExpanded += expanded;
+        m_stats.searchTimeMs += searchMs;
+        m_stats.failures += path ? 0 : 1;
+    }
+    if (!path) {
+        return PathStatus::Failed;
+    }
+
+    out.assign(path->begin(), path->end());
+    const Vector2D end = (goalCell == requestedGoalCell) ? goal : grid->cellCenter(goalCell);
+    if (out.empty()) {
+        out.push_back(end);
+    } else {
+        out.back() = end;
+    }
+    return PathStatus::Ready;
+}
+
+void PathfindingManager::setRequestsPerFrame(size_t requests) {
+    m_requestsPerFrame.store(std::max<size_t>(requests, 1), std::memory_order_relaxed);
+}
+
+void PathfindingManager::setMaxExpansions(uint32_t expansions) {
+    m_maxExpansions.store(expansions, std::memory_order_relaxed);
+}
+
+void PathfindingManager::setCacheCapacity(size_t paths) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cacheCapacity = paths;
+    while (m_cacheOrder.size() > m_cacheCapacity) {
+        m_cache.erase(m_cacheOrder.front());
+        m_cacheOrder.pop_front();
+    }
+}
+
+size_t PathfindingManager::getQueuedRequestCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+size_t PathfindingManager::getCachedPathCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cache.size();
+}
+
+bool PathfindingManager::isIdle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.empty() && m_runningTasks.load(std::memory_order_acquire) == 0;
+}
+
+PathfindingStats PathfindingManager::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void PathfindingManager::resetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = PathfindingStats{};
+}
+
+void PathfindingManager::retireSlot(uint32_t index) {
+    // Generation 0 is never handed out, so no handle is valid by accident
+    const uint32_t generation = m_slots[index].generation + 1;
+    m_slots[index] = RequestSlot{};
+    m_slots[index].generation = (generation == 0) ? 1 : generation;
+    m_freeSlots.push_back(index);
+}
+
+NavigationGrid& PathfindingManager::editableGrid() {
+    // Searches and getGrid() callers keep the old copy; they never see a cell change
+    if (m_grid.use_count() > 1) {
+        m_grid = std::make_shared<NavigationGrid>(*m_grid);
+    }
+    return *m_grid;
+}
+
+void PathfindingManager::invalidateCache() {
+    m_cache.clear();
+    m_cacheOrder.clear();
+}
+
+void PathfindingManager::cachePath(uint64_t key, PathPtr path) {
+    if (m_cacheCapacity == 0) {
+        return;
+    }
+    auto [it, inserted] = m_cache.try_emplace(key, std::move(path));
+    if (!inserted) {
+        return;
+    }
+    m_cacheOrder.push_back(key);
+    if (m_cacheOrder.size() > m_cacheCapacity) {
+        m_cache.erase(m_cacheOrder.front());
+        m_cacheOrder.pop_front();
+    }
+}
+
+void PathfindingManager::waitForSearches() const {
+    // A task the ThreadSystem discards unrun drops its count when it is
+    // destroyed, so this only waits on tasks that are running or will run.
+    // The deadline guards against a task stuck mid-search at shutdown.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (m_runningTasks.load(std::memory_order_acquire) > 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            PATHFINDING_WARN("Gave up waiting for " + std::to_string(m_runningTasks.load()) + " path searches");
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::unique_ptr<AStarPathfinder> PathfindingManager::acquirePathfinder() {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    if (m_searchPool.empty()) {
+        return std::make_unique<AStarPathfinder>();
+    }
+    std::unique_ptr<AStarPathfinder> pathfinder = std::move(m_searchPool.back());
+    m_searchPool.pop_back();
+    return pathfinder;
+}
+
+void PathfindingManager::returnPathfinder(std::unique_ptr<AStarPathfinder> pathfinder) {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_searchPool.push_back(std::move(pathfinder));
+}
@@ -20,7 +20,16 @@
 #include <thread>
 
 #include "managers/AIManager.hpp"
+#include "ai/AIDistanceKernels.hpp"
+#include "ai/AStarPathfinder.hpp"
+#include "ai/CrowdSteering.hpp"
+#include "ai/FlowField.hpp"
+#include "ai/NavigationGrid.hpp"
+#include "ai/behaviors/ChaseBehavior.hpp"
+#include "ai/behaviors/PatrolBehavior.hpp"
+#include "ai/behaviors/WanderBehavior.hpp"
 #include "core/ThreadSystem.hpp"
+#include <SDL3/SDL.h>
 
 // Global state to track initialization status
 namespace {
@@ -133,6 +142,53 @@ private:
     std::mt19937 m_rng{std::random_device{}()};
 };
 
+// Shared behavior that only reacts to coordinate_attack, counting how many
+// entities each broadcast wakes up
+class CoordinationListenerBehavior : public AIBehavior {
+public:
+    void executeLogic(EntityPtr /* entity */) override {}
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+
+    std::string getName() const override { return "CoordinationListener"; }
+    bool isShared() const override { return true; }
+
+    std::shared_ptr<AIBehavior> clone() const override {
+        return std::make_shared<CoordinationListenerBehavior>();
+    }
+
+    bool acceptsMessage(AIMessageId id) const override {
+        return id == AIMessages::COORDINATE_ATTACK;
+    }
+
+    void onMessage(EntityPtr /* entity */, const AIMessage& /* message */) override {
+        m_deliveries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t getDeliveries() const { return m_deliveries.load(std::memory_order_relaxed); }
+    void resetDeliveries() { m_deliveries.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_deliveries{0};
+};
+
+// WanderBehavior as it ran before the frame clock: every entity reads
+// SDL_GetTicks() itself and goes through executeLogic() on its own
+class PerEntityClockWander : public WanderBehavior {
+public:
+    using WanderBehavior::WanderBehavior;
+
+    void executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) override {
+        for (size_t i = 0; i < entities.size(); ++i) {
+            FrameContext entityContext = context.forEntity(i);
+            entityContext.timeMs = SDL_GetTicks();
+            executeLogic(entities[i], entityContext);
+        }
+    }
+
+    std::string getName() const override { return "TickWander"; }
+};
+
 // Global fixture for the entire test suite
 struct GlobalFixture {
     GlobalFixture() {
@@ -784,6 +840,562 @@ BOOST_AUTO_TEST_CASE(TestExtremeEntityCount) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(TestDistancePassSIMDComparison) {
+    std::cout << "\n===== DISTANCE PASS: SCALAR VS SIMD (100K ENTITIES) =====" << std::endl;
+    std::cout << "Kernel backend: " << AIDistanceKernels::backendName(AIDistanceKernels::ACTIVE_BACKEND) << std::endl;
+
+    // Same layout AIManager keeps: contiguous x/y, active flags and priorities
+    const size_t numEntities = 100000;
+    const int timingRuns = 20;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> posDist(0.0f, 20000.0f);
+    std::uniform_int_distribution<int> priorityDist(0, 9);
+    std::uniform_int_distribution<int> activeDist(0, 9);
+
+    std::vector<float> posX(numEntities), posY(numEntities);
+    std::vector<uint8_t> active(numEntities), priorities(numEntities);
+    for (size_t i = 0; i < numEntities; ++i) {
+        posX[i] = posDist(rng);
+        posY[i] = posDist(rng);
+        active[i] = activeDist(rng) != 0 ? 1 : 0; // ~10% inactive
+        priorities[i] = static_cast<uint8_t>(priorityDist(rng));
+    }
+
+    const float playerX = 10000.0f, playerY = 10000.0f;
+    std::vector<float> thresholds(AIDistanceKernels::PRIORITY_THRESHOLD_COUNT);
+    AIDistanceKernels::buildPriorityThresholds(4000.0f * 4000.0f, 0.1f, thresholds.data());
+
+    std::vector<float> scalarDist(numEntities), simdDist(numEntities);
+    std::vector<uint32_t> scalarList(numEntities), simdList(numEntities);
+    size_t scalarCount = 0, simdCount = 0;
+
+    // Best of several runs for each variant
+    auto bestMicros = [timingRuns](auto&& pass) {
+        double best = 0.0;
+        for (int run = 0; run < timingRuns; ++run) {
+            auto start = std::chrono::high_resolution_clock::now();
+            pass();
+            double us = std::chrono::duration<double, std::micro>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            best = (run == 0) ? us : std::min(best, us);
+        }
+        return best;
+    };
+
+    double scalarDistUs = bestMicros([&]() {
+        AIDistanceKernels::distancesSquaredScalar(posX.data(), posY.data(), numEntities,
+                                                  playerX, playerY, scalarDist.data());
+    });
+    double simdDistUs = bestMicros([&]() {
+        AIDistanceKernels::distancesSquared(posX.data(), posY.data(), numEntities,
+                                            playerX, playerY, simdDist.data());
+    });
+    // Both list builders read the same distances so they must agree exactly
+    double scalarListUs = bestMicros([&]() {
+        scalarCount = AIDistanceKernels::buildUpdateListScalar(simdDist.data(), active.data(), priorities.data(),
+                                                               numEntities, thresholds.data(), scalarList.data());
+    });
+    double simdListUs = bestMicros([&]() {
+        simdCount = AIDistanceKernels::buildUpdateList(simdDist.data(), active.data(), priorities.data(),
+                                                       numEntities, thresholds.data(), simdList.data());
+    });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Distance squared:  scalar " << scalarDistUs << "us, SIMD " << simdDistUs << "us ("
+              << std::setprecision(2) << (scalarDistUs / std::max(simdDistUs, 0.001)) << "x)" << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "  Range test + list: scalar " << scalarListUs << "us, SIMD " << simdListUs << "us ("
+              << std::setprecision(2) << (scalarListUs / std::max(simdListUs, 0.001)) << "x)" << std::endl;
+    std::cout << "  Entities to update: " << simdCount << "/" << numEntities << std::endl;
+
+    // SIMD distances match scalar up to FMA contraction, update lists exactly
+    for (size_t i = 0; i < numEntities; ++i) {
+        if (std::abs(scalarDist[i] - simdDist[i]) > scalarDist[i] * 1e-6f) {
+            BOOST_FAIL("SIMD distance mismatch at entity " << i);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(simdCount, scalarCount);
+    BOOST_CHECK(std::equal(simdList.begin(), simdList.begin() + static_cast<std::ptrdiff_t>(simdCount),
+                           scalarList.begin()));
+    BOOST_CHECK_GT(simdCount, 0);
+    BOOST_CHECK_LT(simdCount, numEntities);
+
+    // Tiered schedule: near/mid/far bounds and 1/2/4/16 frame intervals.
+    // Entities beyond the far bound still come up every 16th frame.
+    AIDistanceKernels::UpdateSchedule schedule;
+    AIDistanceKernels::buildPriorityThresholds(4000.0f * 4000.0f, 0.1f, schedule.tierLimits[0]);
+    AIDistanceKernels::buildPriorityThresholds(6000.0f * 6000.0f, 0.1f, schedule.tierLimits[1]);
+    AIDistanceKernels::buildPriorityThresholds(10000.0f * 10000.0f, 0.1f, schedule.tierLimits[2]);
+    const uint32_t intervalMasks[AIDistanceKernels::UPDATE_TIER_COUNT] = {0, 1, 3, 15};
+    for (size_t tier = 0; tier < AIDistanceKernels::UPDATE_TIER_COUNT; ++tier) {
+        std::fill(std::begin(schedule.intervalMasks[tier]), std::end(schedule.intervalMasks[tier]),
+                  intervalMasks[tier]);
+    }
+    std::vector<uint32_t> phases(numEntities);
+    for (size_t i = 0; i < numEntities; ++i) {
+        phases[i] = static_cast<uint32_t>(rng());
+    }
+
+    uint32_t frame = 0;
+    double scalarScheduleUs = bestMicros([&]() {
+        scalarCount = AIDistanceKernels::buildScheduledUpdateListScalar(
+            simdDist.data(), active.data(), priorities.data(), phases.data(), numEntities,
+            schedule, frame, scalarList.data());
+    });
+    double simdScheduleUs = bestMicros([&]() {
+        simdCount = AIDistanceKernels::buildScheduledUpdateList(
+            simdDist.data(), active.data(), priorities.data(), phases.data(), numEntities,
+            schedule, frame, simdList.data());
+    });
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Tiered schedule:   scalar " << scalarScheduleUs << "us, SIMD " << simdScheduleUs << "us ("
+              << std::setprecision(2) << (scalarScheduleUs / std::max(simdScheduleUs, 0.001)) << "x)" << std::endl;
+
+    // Both builders agree on every frame of the longest interval
+    size_t scheduledTotal = 0;
+    for (frame = 0; frame < 16; ++frame) {
+        scalarCount = AIDistanceKernels::buildScheduledUpdateListScalar(
+            simdDist.data(), active.data(), priorities.data(), phases.data(), numEntities,
+            schedule, frame, scalarList.data());
+        simdCount = AIDistanceKernels::buildScheduledUpdateList(
+            simdDist.data(), active.data(), priorities.data(), phases.data(), numEntities,
+            schedule, frame, simdList.data());
+        BOOST_REQUIRE_EQUAL(simdCount, scalarCount);
+        BOOST_CHECK(std::equal(simdList.begin(), simdList.begin() + static_cast<std::ptrdiff_t>(simdCount),
+                               scalarList.begin()));
+        scheduledTotal += simdCount;
+    }
+    std::cout << "  Scheduled updates/frame: " << std::setprecision(1)
+              << static_cast<double>(scheduledTotal) / 16.0 << "/" << numEntities << std::endl;
+    BOOST_CHECK_GT(scheduledTotal, 0);
+
+    std::cout << "\n===== DISTANCE PASS COMPARISON COMPLETED =====\n" << std::endl;
+}
+
+// Behaviors used to read SDL_GetTicks() for every entity they updated; they
+// now share FrameContext::timeMs, taken once per frame. Times AIManager::update()
+// over real Wander and Patrol entities both ways.
+BOOST_AUTO_TEST_CASE(TestFrameClockVsPerEntityTicks) {
+    std::cout << "\n===== CLOCK READS: PER-ENTITY SDL_GetTicks VS FRAME CONTEXT =====" << std::endl;
+
+    if (g_shutdownInProgress.load()) {
+        return;
+    }
+
+    const int numWanderers = 8000;
+    const int numPatrols = 2000;
+    const int numFrames = 60;
+    const float worldSize = 2000.0f;
+
+    AIManager& aiManager = AIManager::Instance();
+    aiManager.registerBehavior("Wander", std::make_shared<WanderBehavior>(2.0f, 2000.0f, 300.0f));
+    aiManager.registerBehavior("TickWander", std::make_shared<PerEntityClockWander>(2.0f, 2000.0f, 300.0f));
+    aiManager.registerBehavior("Patrol", std::make_shared<PatrolBehavior>(
+        std::vector<Vector2D>{Vector2D(100.0f, 100.0f), Vector2D(1900.0f, 100.0f),
+                              Vector2D(1900.0f, 1900.0f), Vector2D(100.0f, 1900.0f)}, 2.0f));
+    auto player = BenchmarkEntity::create(-1, Vector2D(worldSize * 0.5f, worldSize * 0.5f));
+    aiManager.setPlayerForDistanceOptimization(player);
+
+    // Average update time with the wanderers on the given behavior
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(0.0f, worldSize);
+    auto timeFrames = [&](const std::string& wanderBehavior, int& updated) {
+        for (int i = 0; i < numWanderers + numPatrols; ++i) {
+            auto entity = BenchmarkEntity::create(i, Vector2D(coordinate(rng), coordinate(rng)));
+            entities.push_back(entity);
+            aiManager.registerEntityForUpdates(entity, 9, i < numWanderers ? wanderBehavior : "Patrol");
+        }
+        aiManager.processPendingBehaviorAssignments();
+        aiManager.update(0.016f);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < numFrames; ++frame) {
+            aiManager.update(0.016f);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / numFrames;
+
+        updated = 0;
+        for (const auto& entity : entities) {
+            updated += (entity->getUpdateCount() > 1) ? 1 : 0;
+        }
+        for (auto& entity : entities) {
+            aiManager.unregisterEntityFromUpdates(entity);
+            aiManager.unassignBehaviorFromEntity(entity);
+        }
+        entities.clear();
+        aiManager.processPendingBehaviorAssignments();
+        return ms;
+    };
+    int updatedPerEntity = 0;
+    int updatedFrameContext = 0;
+    const double perEntityMs = timeFrames("TickWander", updatedPerEntity);
+    const double frameContextMs = timeFrames("Wander", updatedFrameContext);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  " << numWanderers << " Wander + " << numPatrols << " Patrol entities, "
+              << numFrames << " frames" << std::endl;
+    std::cout << "  Per-entity SDL_GetTicks: " << perEntityMs << "ms/frame ("
+              << numWanderers << " clock calls)" << std::endl;
+    std::cout << "  FrameContext::timeMs:    " << frameContextMs << "ms/frame (1 clock call)" << std::endl;
+    std::cout << "  Speedup: " << std::setprecision(2) << perEntityMs / std::max(frameContextMs, 0.001)
+              << "x" << std::endl;
+
+    // A clock call is a small part of an entity's update, so the timings are
+    // reported rather than compared; both runs must update every entity
+    BOOST_CHECK_EQUAL(updatedPerEntity, numWanderers + numPatrols);
+    BOOST_CHECK_EQUAL(updatedFrameContext, numWanderers + numPatrols);
+
+    aiManager.setPlayerForDistanceOptimization(nullptr);
+    aiManager.resetBehaviors();
+
+    std::cout << "\n===== CLOCK READ COMPARISON COMPLETED =====\n" << std::endl;
+}
+
+// AttackBehavior and GuardBehavior used to broadcast to every managed entity;
+// they now reach only the entities in range or in the sender's group
+BOOST_AUTO_TEST_CASE(TestScopedBroadcastVsGlobal) {
+    std::cout << "\n===== BROADCAST SCOPE: GLOBAL VS RADIUS VS GROUP =====" << std::endl;
+
+    if (g_shutdownInProgress.load()) {
+        return;
+    }
+
+    const int numEntities = 10000;
+    const int gridWidth = 100;
+    const float spacing = 20.0f;
+    const int numFrames = 300;                 // 5 seconds at 60 FPS
+    const double broadcastsPerSecond = 100.0;
+    const float radius = 200.0f;
+    const uint32_t groupCount = 200;           // 50 entities per group
+
+    AIManager& aiManager = AIManager::Instance();
+    auto listener = std::make_shared<CoordinationListenerBehavior>();
+    aiManager.registerBehavior("CoordinationListener", listener);
+
+    for (int i = 0; i < numEntities; ++i) {
+        Vector2D position((i % gridWidth) * spacing, (i / gridWidth) * spacing);
+        auto entity = BenchmarkEntity::create(i, position);
+        entities.push_back(entity);
+        aiManager.registerEntityForUpdates(entity, 5, "CoordinationListener");
+        aiManager.setEntityGroup(entity, static_cast<uint32_t>(i) % groupCount + 1);
+    }
+    aiManager.processPendingBehaviorAssignments();
+    aiManager.update(0.016f);
+
+    enum class Scope { Global, Radius, Group };
+    auto runScope = [&](Scope scope, double& msPerFrame) {
+        listener->resetDeliveries();
+        std::mt19937 rng(42);   // Same attackers for every scope
+        std::uniform_int_distribution<int> pickAttacker(0, numEntities - 1);
+        double pending = 0.0;
+        int broadcasts = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < numFrames; ++frame) {
+            pending += broadcastsPerSecond / 60.0;
+            for (; pending >= 1.0; pending -= 1.0, ++broadcasts) {
+                const auto& attacker = entities[pickAttacker(rng)];
+                AIMessage message(AIMessages::COORDINATE_ATTACK, attacker->getHandle(), attacker->getPosition());
+                switch (scope) {
+                    case Scope::Global:
+                        aiManager.broadcastMessage(message);
+                        break;
+                    case Scope::Radius:
+                        aiManager.broadcastInRadius(attacker->getPosition(), radius, message);
+                        break;
+                    case Scope::Group:
+                        aiManager.broadcastToGroup(aiManager.getEntityGroup(attacker), message);
+                        break;
+                }
+            }
+            aiManager.update(0.016f);
+        }
+        msPerFrame = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / numFrames;
+        return std::make_pair(broadcasts, listener->getDeliveries());
+    };
+
+    double globalMs = 0.0, radiusMs = 0.0, groupMs = 0.0;
+    auto [globalSent, globalDeliveries] = runScope(Scope::Global, globalMs);
+    auto [radiusSent, radiusDeliveries] = runScope(Scope::Radius, radiusMs);
+    auto [groupSent, groupDeliveries] = runScope(Scope::Group, groupMs);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  " << numEntities << " entities, " << globalSent << " broadcasts over "
+              << numFrames << " frames" << std::endl;
+    // Frame times are reported, not checked: at 100 broadcasts per second the
+    // entity updates themselves dominate the frame
+    std::cout << "  Global broadcast: " << globalMs << "ms/frame, "
+              << globalDeliveries << " deliveries" << std::endl;
+    std::cout << "  Radius " << std::setprecision(0) << radius << ":       " << std::setprecision(2) << radiusMs << "ms/frame, "
+              << radiusDeliveries << " deliveries" << std::endl;
+    std::cout << "  Group of " << numEntities / groupCount << ":      " << groupMs << "ms/frame, "
+              << groupDeliveries << " deliveries" << std::endl;
+
+    BOOST_CHECK_EQUAL(radiusSent, globalSent);
+    BOOST_CHECK_EQUAL(groupSent, globalSent);
+    BOOST_CHECK_LT(radiusDeliveries * 10, globalDeliveries);
+    BOOST_CHECK_LT(groupDeliveries * 10, globalDeliveries);
+
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    entities.clear();
+    aiManager.resetBehaviors();
+
+    std::cout << "\n===== BROADCAST SCOPE COMPARISON COMPLETED =====\n" << std::endl;
+}
+
+// One flow field from the player's cell steers every chaser around walls;
+// the alternative is one A* search per chaser whenever the player moves
+BOOST_AUTO_TEST_CASE(TestFlowFieldChasers) {
+    std::cout << "\n===== CHASE NAVIGATION: SHARED FLOW FIELD VS PER-ENTITY A* =====" << std::endl;
+
+    if (g_shutdownInProgress.load()) {
+        return;
+    }
+
+    const int numEntities = 10000;
+    const uint32_t gridSize = 200;
+    const float cellSize = 16.0f;
+    const int numFrames = 60;
+    const int astarSamples = 100;
+
+    // Vertical walls every 25 cells, each with one gap at alternating ends
+    NavigationGrid grid(gridSize, gridSize, cellSize);
+    for (uint32_t x = 12; x < gridSize; x += 25) {
+        const bool gapAtTop = ((x / 25) % 2) == 0;
+        for (uint32_t y = 0; y < gridSize; ++y) {
+            const bool inGap = gapAtTop ? (y < 8) : (y >= gridSize - 8);
+            if (!inGap) {
+                grid.setBlocked(grid.cellIndex(x, y), true);
+            }
+        }
+    }
+    const Vector2D playerPosition(1600.0f + cellSize * 0.5f, 1600.0f + cellSize * 0.5f);
+    const uint32_t playerCell = grid.cellAt(playerPosition);
+    BOOST_REQUIRE(!grid.isBlocked(playerCell));
+
+    AIManager& aiManager = AIManager::Instance();
+    aiManager.registerBehavior("FlowChase", std::make_shared<ChaseBehavior>(2.0f, 10000.0f, 10.0f));
+    auto player = BenchmarkEntity::create(-1, playerPosition);
+    aiManager.setPlayerForDistanceOptimization(player);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coordinate(0.0f, gridSize * cellSize);
+    std::vector<uint32_t> chaserCells;
+    while (static_cast<int>(entities.size()) < numEntities) {
+        Vector2D position(coordinate(rng), coordinate(rng));
+        const uint32_t cell = grid.cellAt(position);
+        if (grid.isBlocked(cell) || cell == playerCell) {
+            continue;
+        }
+        auto entity = BenchmarkEntity::create(static_cast<int>(entities.size()), position);
+        entities.push_back(entity);
+        chaserCells.push_back(cell);
+        aiManager.registerEntityForUpdates(entity, 9, "FlowChase");
+    }
+    aiManager.processPendingBehaviorAssignments();
+    aiManager.update(0.016f);
+
+    // Build cost: best of a few, as the manager would on a worker
+    FlowField field;
+    double buildMs = 0.0;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::high_resolution_clock::now();
+        field.build(grid, playerCell);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        buildMs = (run == 0) ? ms : std::min(buildMs, ms);
+    }
+
+    // A* cost for a sample of chasers, extrapolated to all of them
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+    int found = 0;
+    auto astarStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < astarSamples; ++i) {
+        if (pathfinder.findPath(grid, chaserCells[static_cast<size_t>(i)], playerCell, cells) ==
+            AStarPathfinder::Result::Found) {
+            ++found;
+        }
+    }
+    const double astarMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - astarStart).count() * (numEntities / astarSamples);
+
+    auto runFrames = [&](const FlowField* playerField) {
+        aiManager.setPlayerFlowField(playerField);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < numFrames; ++frame) {
+            aiManager.update(0.016f);
+        }
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / numFrames;
+    };
+    const double straightMs = runFrames(nullptr);
+    const double fieldMs = runFrames(&field);
+
+    // Chasers on the far side of a wall now head for its gap, not into it
+    size_t followingField = 0;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        Vector2D expected;
+        if (field.sampleToward(entities[i]->getPosition(), expected) &&
+            (entities[i]->getVelocity() - expected * 2.0f).length() < 0.01f) {
+            ++followingField;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  " << numEntities << " chasers on a " << gridSize << "x" << gridSize << " grid, "
+              << field.getReachedCellCount() << " cells reached" << std::endl;
+    std::cout << "  Flow field build: " << buildMs << "ms once per player cell change" << std::endl;
+    std::cout << "  Per-entity A*:    " << astarMs << "ms per player move (extrapolated from "
+              << astarSamples << " searches, " << found << " found)" << std::endl;
+    std::cout << "  AI frame, straight chase: " << straightMs << "ms" << std::endl;
+    std::cout << "  AI frame, field chase:    " << fieldMs << "ms (" << followingField << "/"
+              << numEntities << " chasers on the field)" << std::endl;
+
+    BOOST_CHECK_EQUAL(found, astarSamples);
+    BOOST_CHECK_GT(followingField, static_cast<size_t>(numEntities / 2));
+    BOOST_CHECK_LT(buildMs * 10.0, astarMs);
+
+    aiManager.setPlayerFlowField(nullptr);
+    aiManager.setPlayerForDistanceOptimization(nullptr);
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    entities.clear();
+    aiManager.resetBehaviors();
+
+    std::cout << "\n===== CHASE NAVIGATION COMPARISON COMPLETED =====\n" << std::endl;
+}
+
+// Crowd steering resolves every agent against its neighbors inside the AI
+// batches; target is 20K agents in 4ms on 8 threads
+BOOST_AUTO_TEST_CASE(TestCrowdSteering20K) {
+    std::cout << "\n===== CROWD STEERING: 20K AGENTS =====" << std::endl;
+
+    if (g_shutdownInProgress.load()) {
+        return;
+    }
+
+    const int numEntities = 20000;
+    const float worldSize = 4250.0f;   // About 8 neighbors within 48 units of each agent
+    const int timingRuns = 10;
+    const int numFrames = 30;
+    const size_t targetThreads = 8;
+    const double targetMs = 4.0;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coordinate(0.0f, worldSize);
+    std::uniform_real_distribution<float> velocity(-60.0f, 60.0f);
+    std::vector<float> x(numEntities), y(numEntities), vx(numEntities), vy(numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        x[i] = coordinate(rng);
+        y[i] = coordinate(rng);
+        vx[i] = velocity(rng);
+        vy[i] = velocity(rng);
+    }
+    AISpatialGrid grid;
+    grid.rebuild(x.data(), y.data(), nullptr, x.size(), false);
+
+    CrowdSettings crowd;
+    crowd.enabled = true;
+    crowd.neighborRadius = 48.0f;
+    crowd.separationRadius = 32.0f;
+    crowd.alignmentWeight = 0.2f;
+    crowd.cohesionWeight = 0.1f;
+
+    // The resolve pass on its own, on one thread and spread over the workers
+    std::vector<Vector2D> resolved(numEntities);
+    auto resolveRange = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            resolved[i] = CrowdSteering::resolve(grid, vx.data(), vy.data(), static_cast<uint32_t>(i),
+                                                 Vector2D(x[i], y[i]), Vector2D(vx[i], vy[i]), crowd);
+        }
+    };
+    auto bestMs = [timingRuns](auto&& pass) {
+        double best = 0.0;
+        for (int run = 0; run < timingRuns; ++run) {
+            auto start = std::chrono::high_resolution_clock::now();
+            pass();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            best = (run == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    };
+    const double serialMs = bestMs([&]() { resolveRange(0, numEntities); });
+    const size_t workers = Hammer::ThreadSystem::Instance().getThreadCount();
+    const double parallelMs = bestMs([&]() {
+        Hammer::ThreadSystem::Instance().parallelFor(0, numEntities, 256, resolveRange, workers);
+    });
+    size_t pushed = 0;
+    for (int i = 0; i < numEntities; ++i) {
+        pushed += (resolved[i].getX() != vx[i] || resolved[i].getY() != vy[i]) ? 1 : 0;
+    }
+
+    // The same agents chasing a player through AIManager, crowd off and on
+    AIManager& aiManager = AIManager::Instance();
+    aiManager.registerBehavior("CrowdChase", std::make_shared<ChaseBehavior>(60.0f, 10000.0f, 10.0f));
+    auto player = BenchmarkEntity::create(-1, Vector2D(worldSize * 0.5f, worldSize * 0.5f));
+    aiManager.setPlayerForDistanceOptimization(player);
+    for (int i = 0; i < numEntities; ++i) {
+        auto entity = BenchmarkEntity::create(i, Vector2D(x[i], y[i]));
+        entities.push_back(entity);
+        aiManager.registerEntityForUpdates(entity, 9, "CrowdChase");
+    }
+    aiManager.processPendingBehaviorAssignments();
+    aiManager.update(0.016f);
+
+    auto runFrames = [&](const CrowdSettings& settings) {
+        aiManager.setCrowdSettings(settings);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < numFrames; ++frame) {
+            aiManager.update(0.016f);
+        }
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / numFrames;
+    };
+    const double plainFrameMs = runFrames(CrowdSettings{});
+    const double crowdFrameMs = runFrames(crowd);
+    // What the crowd pass adds to AIManager::update(): the velocity
+    // snapshot, the neighbor queries and the resolve for every agent
+    const double crowdPassMs = std::max(0.0, crowdFrameMs - plainFrameMs);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  " << numEntities << " agents, " << pushed << " steered by neighbors" << std::endl;
+    std::cout << "  Resolve pass, 1 thread:  " << serialMs << "ms" << std::endl;
+    std::cout << "  Resolve pass, " << workers << " workers: " << parallelMs << "ms" << std::endl;
+    std::cout << "  AI frame, crowd off: " << plainFrameMs << "ms" << std::endl;
+    std::cout << "  AI frame, crowd on:  " << crowdFrameMs << "ms" << std::endl;
+    std::cout << "  Crowd pass in AIManager: " << crowdPassMs << "ms" << std::endl;
+
+    BOOST_CHECK_GT(pushed, static_cast<size_t>(numEntities / 2));
+
+    // The budget is for a machine with the target worker count; fewer
+    // workers cannot meet it, so only measure there
+    if (workers >= targetThreads) {
+        BOOST_CHECK_LT(parallelMs, targetMs);
+        BOOST_CHECK_LT(crowdPassMs, targetMs);
+    } else {
+        std::cout << "  Budget check skipped: " << workers << " workers, the " << targetMs << "ms budget assumes "
+                  << targetThreads << std::endl;
+    }
+
+    aiManager.setCrowdSettings(CrowdSettings{});
+    aiManager.setPlayerForDistanceOptimization(nullptr);
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    entities.clear();
+    aiManager.resetBehaviors();
+
+    std::cout << "\n===== CROWD STEERING COMPLETED =====\n" << std::endl;
+}
+
 BOOST_AUTO_TEST_CASE(TestThreadSystemQueueLoad) {
     std::cout << "\n===== THREAD SYSTEM QUEUE LOAD MONITORING =====" << std::endl;
     std::cout << "DEFENSIVE TEST: Monitoring ThreadSystem queue to prevent future overload issues" << std::endl;
@@ -854,6 +1466,9 @@ BOOST_AUTO_TEST_CASE(TestThreadSystemQueueLoad) {
         std::cout << "    Average queue size: " << std::fixed << std::setprecision(1) << avgQueueSize << std::endl;
         std::cout << "    Non-zero queue samples: " << nonZeroSamples << "/" << queueSnapshots.size() << std::endl;
         std::cout << "    Queue overflow risk: " << (queueOverflow ? "CRITICAL" : "SAFE") << std::endl;
+        std::cout << "    Global queue contention: " << threadSystem.getQueueContentionCount()
+                  << ", worker-local tasks: " << threadSystem.getTotalLocalTasks()
+                  << ", stolen: " << threadSystem.getTotalTasksStolen() << std::endl;
         
         // DEFENSIVE ASSERTIONS - Will fail if future changes break queue management
         BOOST_CHECK_LT(maxQueueSize, 4000); // Critical: Must stay below ThreadSystem limit
@@ -0,0 +1,378 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE AISpatialGridTests
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ai/AISpatialGrid.hpp"
+#include "ai/CrowdSteering.hpp"
+#include "core/SnapshotRing.hpp"
+#include "core/ThreadSystem.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PositionSet {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<uint8_t> active;
+
+    size_t size() const { return x.size(); }
+};
+
+PositionSet makePositions(size_t count, float minCoord, float maxCoord, uint32_t seed, int inactiveEvery = 0) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(minCoord, maxCoord);
+    PositionSet set;
+    set.x.resize(count);
+    set.y.resize(count);
+    set.active.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        set.x[i] = coord(rng);
+        set.y[i] = coord(rng);
+        set.active[i] = (inactiveEvery > 0 && i % inactiveEvery == 0) ? 0 : 1;
+    }
+    return set;
+}
+
+std::vector<uint32_t> bruteForceRadius(const PositionSet& set, float cx, float cy, float radius) {
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < set.size(); ++i) {
+        float dx = set.x[i] - cx;
+        float dy = set.y[i] - cy;
+        if (set.active[i] && dx * dx + dy * dy <= radius * radius) {
+            result.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> bruteForceRect(const PositionSet& set, float minX, float minY, float maxX, float maxY) {
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < set.size(); ++i) {
+        if (set.active[i] && set.x[i] >= minX && set.x[i] <= maxX && set.y[i] >= minY && set.y[i] <= maxY) {
+            result.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestRadiusQueryMatchesBruteForce) {
+    PositionSet set = makePositions(5000, -2000.0f, 2000.0f, 1, 7);
+    AISpatialGrid grid(64.0f);
+    grid.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), false);
+    BOOST_CHECK_EQUAL(grid.getEntryCount(), std::count(set.active.begin(), set.active.end(), 1));
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> coord(-2100.0f, 2100.0f);
+    std::uniform_real_distribution<float> radiusDist(0.0f, 300.0f);
+    std::vector<uint32_t> buffer(set.size());
+    for (int q = 0; q < 500; ++q) {
+        float cx = coord(rng), cy = coord(rng), radius = radiusDist(rng);
+        size_t found = grid.queryRadius(cx, cy, radius, buffer.data(), buffer.size());
+        std::vector<uint32_t> result(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(found));
+        BOOST_REQUIRE(sorted(result) == bruteForceRadius(set, cx, cy, radius));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRectQueryMatchesBruteForce) {
+    PositionSet set = makePositions(5000, -2000.0f, 2000.0f, 3, 5);
+    AISpatialGrid grid(50.0f);
+    grid.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), false);
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> coord(-2100.0f, 2100.0f);
+    std::uniform_real_distribution<float> extent(0.0f, 400.0f);
+    std::vector<uint32_t> buffer(set.size());
+    for (int q = 0; q < 500; ++q) {
+        float minX = coord(rng), minY = coord(rng);
+        float maxX = minX + extent(rng), maxY = minY + extent(rng);
+        size_t found = grid.queryRect(minX, minY, maxX, maxY, buffer.data(), buffer.size());
+        std::vector<uint32_t> result(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(found));
+        BOOST_REQUIRE(sorted(result) == bruteForceRect(set, minX, minY, maxX, maxY));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestSparseWorldHashCollisionsHaveNoDuplicates) {
+    // Few entities spread over a huge world: distinct cells share buckets
+    PositionSet set = makePositions(3000, -1.0e6f, 1.0e6f, 5);
+    AISpatialGrid grid(32.0f);
+    grid.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), false);
+
+    std::vector<uint32_t> buffer(set.size());
+    for (size_t i = 0; i < set.size(); i += 10) {
+        size_t found = grid.queryRadius(set.x[i], set.y[i], 200.0f, buffer.data(), buffer.size());
+        std::vector<uint32_t> result = sorted({buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(found)});
+        BOOST_REQUIRE(std::adjacent_find(result.begin(), result.end()) == result.end());
+        BOOST_REQUIRE(result == bruteForceRadius(set, set.x[i], set.y[i], 200.0f));
+    }
+
+    // A query covering more cells than entries falls back to a linear scan
+    size_t found = grid.queryRect(-2.0e6f, -2.0e6f, 2.0e6f, 2.0e6f, buffer.data(), buffer.size());
+    BOOST_CHECK_EQUAL(found, set.size());
+}
+
+BOOST_AUTO_TEST_CASE(TestCapacityAndEdgeCases) {
+    PositionSet set = makePositions(1000, 0.0f, 100.0f, 6);
+    AISpatialGrid grid;
+    grid.rebuild(set.x.data(), set.y.data(), nullptr, set.size(), false);
+
+    // Stops at capacity
+    std::vector<uint32_t> buffer(16);
+    BOOST_CHECK_EQUAL(grid.queryRadius(50.0f, 50.0f, 1000.0f, buffer.data(), buffer.size()), 16);
+    BOOST_CHECK_EQUAL(grid.queryRadius(50.0f, 50.0f, 1000.0f, buffer.data(), 0), 0);
+
+    // Invalid inputs return nothing
+    BOOST_CHECK_EQUAL(grid.queryRadius(50.0f, 50.0f, -1.0f, buffer.data(), buffer.size()), 0);
+    BOOST_CHECK_EQUAL(grid.queryRect(10.0f, 10.0f, 0.0f, 0.0f, buffer.data(), buffer.size()), 0);
+    BOOST_CHECK_EQUAL(grid.queryRadius(std::numeric_limits<float>::quiet_NaN(), 0.0f, 10.0f,
+                                       buffer.data(), buffer.size()), 0);
+
+    // Positions are looked up by slot
+    BOOST_CHECK(grid.contains(10));
+    BOOST_CHECK_EQUAL(grid.getPositionX(10), set.x[10]);
+    BOOST_CHECK(!grid.contains(static_cast<uint32_t>(set.size())));
+
+    // Boundary points on a cell edge are found from both sides
+    float edgeX[] = {64.0f, 63.999f};
+    float edgeY[] = {0.0f, 0.0f};
+    grid.rebuild(edgeX, edgeY, nullptr, 2, false);
+    BOOST_CHECK_EQUAL(grid.queryRadius(64.0f, 0.0f, 0.01f, buffer.data(), buffer.size()), 2);
+    BOOST_CHECK_EQUAL(grid.queryRect(64.0f, 0.0f, 64.0f, 0.0f, buffer.data(), buffer.size()), 1);
+
+    grid.clear();
+    BOOST_CHECK_EQUAL(grid.queryRadius(64.0f, 0.0f, 100.0f, buffer.data(), buffer.size()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelRebuildMatchesSerial) {
+    BOOST_REQUIRE(Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4));
+
+    PositionSet set = makePositions(50000, 0.0f, 8000.0f, 7, 11);
+    AISpatialGrid serial, parallel;
+    serial.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), false);
+    parallel.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), true);
+    BOOST_CHECK_EQUAL(serial.getEntryCount(), parallel.getEntryCount());
+
+    std::vector<uint32_t> a(1024), b(1024);
+    for (size_t i = 0; i < set.size(); i += 97) {
+        size_t foundA = serial.queryRadius(set.x[i], set.y[i], 128.0f, a.data(), a.size());
+        size_t foundB = parallel.queryRadius(set.x[i], set.y[i], 128.0f, b.data(), b.size());
+        BOOST_REQUIRE_EQUAL(foundA, foundB);
+        BOOST_REQUIRE(std::equal(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(foundA), b.begin()));
+    }
+
+    Hammer::ThreadSystem::Instance().clean();
+}
+
+// Readers of published grids always see one whole rebuild, never a mix of two
+BOOST_AUTO_TEST_CASE(TestCrowdSteeringTerms) {
+    // Slot 0 alone, 1 and 2 overlapping, 3 and 4 stacked exactly, 5 in
+    // neighbor range of 6 but outside its separation radius
+    std::vector<float> x = {0.0f, 1000.0f, 1010.0f, 2000.0f, 2000.0f, 3000.0f, 3040.0f};
+    std::vector<float> y = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    std::vector<float> vx = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 50.0f};
+    std::vector<float> vy = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 20.0f};
+    AISpatialGrid grid(64.0f);
+    grid.rebuild(x.data(), y.data(), nullptr, x.size(), false);
+
+    CrowdSettings settings;
+    settings.enabled = true;
+    settings.neighborRadius = 48.0f;
+    settings.separationRadius = 32.0f;
+    settings.maxPushSpeed = 100.0f;
+    auto resolve = [&](uint32_t slot, const Vector2D& desired) {
+        return CrowdSteering::resolve(grid, vx.data(), vy.data(), slot, Vector2D(x[slot], y[slot]), desired, settings);
+    };
+
+    // No neighbors: the behavior's velocity goes through untouched
+    const Vector2D alone = resolve(0, Vector2D(3.0f, 4.0f));
+    BOOST_CHECK_EQUAL(alone.getX(), 3.0f);
+    BOOST_CHECK_EQUAL(alone.getY(), 4.0f);
+
+    // Overlapping pair: equal and opposite pushes, scaled by the overlap
+    const Vector2D left = resolve(1, Vector2D(0.0f, 0.0f));
+    const Vector2D right = resolve(2, Vector2D(0.0f, 0.0f));
+    BOOST_CHECK_CLOSE(left.getX(), -100.0f * 22.0f / 32.0f, 0.01);
+    BOOST_CHECK_CLOSE(right.getX(), 100.0f * 22.0f / 32.0f, 0.01);
+    BOOST_CHECK_SMALL(left.getY(), 0.001f);
+
+    // Avoidance never speeds an agent past max(|desired|, maxPushSpeed)
+    settings.separationWeight = 10.0f;
+    BOOST_CHECK_LE(resolve(1, Vector2D(0.0f, 0.0f)).length(), 100.001f);
+    BOOST_CHECK_LE(resolve(1, Vector2D(0.0f, 150.0f)).length(), 150.001f);
+    settings.separationWeight = 1.0f;
+
+    // Exactly stacked agents split in opposite directions
+    const Vector2D first = resolve(3, Vector2D(0.0f, 0.0f));
+    const Vector2D second = resolve(4, Vector2D(0.0f, 0.0f));
+    BOOST_CHECK_GT(first.length(), 90.0f);
+    BOOST_CHECK_SMALL((first + second).length(), 0.01f);
+
+    // Outside the separation radius only alignment and cohesion act
+    BOOST_CHECK_SMALL(resolve(5, Vector2D(0.0f, 0.0f)).length(), 0.001f);
+    settings.alignmentWeight = 1.0f;
+    const Vector2D aligned = resolve(5, Vector2D(0.0f, 0.0f));
+    BOOST_CHECK_CLOSE(aligned.getX(), 50.0f, 0.01);
+    BOOST_CHECK_CLOSE(aligned.getY(), 20.0f, 0.01);
+    settings.alignmentWeight = 0.0f;
+    settings.cohesionWeight = 0.5f;
+    const Vector2D pulled = resolve(5, Vector2D(0.0f, 0.0f));
+    BOOST_CHECK_CLOSE(pulled.getX(), 50.0f, 0.01);
+    BOOST_CHECK_SMALL(pulled.getY(), 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE(TestSnapshotRingPublishesWholeGrids) {
+    struct GridSnapshot {
+        AISpatialGrid grid;
+        uint64_t version{0};
+    };
+    Hammer::SnapshotRing<GridSnapshot> ring;
+
+    constexpr size_t slotCount = 2000;
+    constexpr uint64_t publishCount = 500;
+    std::vector<float> x(slotCount), y(slotCount, 0.0f);
+    std::atomic<bool> done{false};
+    std::atomic<int> tornReads{0};
+    std::atomic<int> reads{0};
+
+    // Every slot of version v sits at x = slot * 4 + v
+    auto reader = [&]() {
+        uint64_t lastVersion = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto snapshot = ring.acquire();
+            const uint64_t version = snapshot->version;
+            if (version < lastVersion) {
+                tornReads.fetch_add(1, std::memory_order_relaxed);
+            }
+            lastVersion = version;
+            for (uint32_t slot = 0; slot < snapshot->grid.getSlotCount(); slot += 37) {
+                if (snapshot->grid.getPositionX(slot) != static_cast<float>(slot * 4 + version)) {
+                    tornReads.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back(reader);
+    }
+
+    uint64_t published = 0;
+    for (uint64_t version = 1; version <= publishCount; ++version) {
+        GridSnapshot* snapshot = ring.beginWrite();
+        if (!snapshot) {
+            continue; // Readers pinned both older slots; try again next frame
+        }
+        for (size_t slot = 0; slot < slotCount; ++slot) {
+            x[slot] = static_cast<float>(slot * 4 + version);
+        }
+        snapshot->grid.rebuild(x.data(), y.data(), nullptr, slotCount, false);
+        snapshot->version = version;
+        ring.publish();
+        ++published;
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    BOOST_CHECK_EQUAL(tornReads.load(), 0);
+    BOOST_CHECK_GT(reads.load(), 0);
+    BOOST_CHECK_GT(published, 0u);
+    BOOST_CHECK_EQUAL(ring.acquire()->grid.getSlotCount(), slotCount);
+
+    // Readers pinning both slots the writer could use stop it instead of
+    // having their snapshots overwritten
+    auto first = ring.acquire();
+    GridSnapshot* next = ring.beginWrite();
+    BOOST_REQUIRE(next);
+    next->version = publishCount + 1;
+    ring.publish();
+    auto second = ring.acquire();
+    BOOST_CHECK_EQUAL(second->version, publishCount + 1);
+    next = ring.beginWrite();
+    BOOST_REQUIRE(next);
+    next->version = publishCount + 2;
+    ring.publish();
+    BOOST_CHECK(ring.beginWrite() == nullptr);
+    BOOST_CHECK_EQUAL(ring.acquire()->version, publishCount + 2);
+    first = {};
+    BOOST_CHECK(ring.beginWrite() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestFiftyThousandEntityQueryPerformance) {
+    // 50k entities over 8000x8000 px, about 10 neighbors per 64 px radius
+    const size_t entityCount = 50000;
+    const int timingRuns = 5;
+    PositionSet set = makePositions(entityCount, 0.0f, 8000.0f, 8);
+    AISpatialGrid grid(64.0f);
+
+    double bestBuildUs = 0.0;
+    for (int run = 0; run < timingRuns; ++run) {
+        auto start = Clock::now();
+        grid.rebuild(set.x.data(), set.y.data(), set.active.data(), set.size(), false);
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        bestBuildUs = (run == 0) ? us : std::min(bestBuildUs, us);
+    }
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> coord(0.0f, 8000.0f);
+    const size_t queryCount = 100000;
+    std::vector<float> qx(queryCount), qy(queryCount);
+    for (size_t q = 0; q < queryCount; ++q) {
+        qx[q] = coord(rng);
+        qy[q] = coord(rng);
+    }
+
+    uint32_t buffer[256];
+    double bestRadiusNs = 0.0, bestRectNs = 0.0;
+    size_t totalFound = 0;
+    for (int run = 0; run < timingRuns; ++run) {
+        totalFound = 0;
+        auto start = Clock::now();
+        for (size_t q = 0; q < queryCount; ++q) {
+            totalFound += grid.queryRadius(qx[q], qy[q], 64.0f, buffer, 256);
+        }
+        double radiusNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queryCount;
+
+        start = Clock::now();
+        for (size_t q = 0; q < queryCount; ++q) {
+            totalFound += grid.queryRect(qx[q] - 64.0f, qy[q] - 64.0f, qx[q] + 64.0f, qy[q] + 64.0f, buffer, 256);
+        }
+        double rectNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queryCount;
+
+        bestRadiusNs = (run == 0) ? radiusNs : std::min(bestRadiusNs, radiusNs);
+        bestRectNs = (run == 0) ? rectNs : std::min(bestRectNs, rectNs);
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Spatial grid, " << entityCount << " entities: rebuild " << bestBuildUs << "us, radius query "
+              << bestRadiusNs << "ns, rect query " << bestRectNs << "ns ("
+              << static_cast<double>(totalFound) / (2.0 * queryCount) << " results avg)" << std::endl;
+
+    BOOST_CHECK_GT(totalFound, 0);
+    BOOST_CHECK_LT(bestRadiusNs, 1000.0);
+    BOOST_CHECK_LT(bestRectNs, 1000.0);
+}
@@ -9,6 +9,7 @@
 #include "managers/AIManager.hpp"
 #include "ai/AIBehaviors.hpp"
 #include "entities/Entity.hpp"
+#include "managers/FormationManager.hpp"
 #include <memory>
 #include <vector>
 #include <thread>
@@ -376,6 +377,51 @@ BOOST_AUTO_TEST_CASE(TestFollowBehavior) {
     AIManager::Instance().unregisterEntityFromUpdates(entity);
 }
 
+BOOST_AUTO_TEST_CASE(TestEscortsShareOneFormation) {
+    FormationManager& formations = FormationManager::Instance();
+    formations.init();
+    AIManager& aiMgr = AIManager::Instance();
+    auto testPlayer = std::static_pointer_cast<Entity>(TestEntity::create(500.0f, 500.0f));
+    aiMgr.setPlayerForDistanceOptimization(testPlayer);
+
+    // Every clone of FollowFormation joins the same ring around the player
+    for (auto& entity : testEntities) {
+        aiMgr.assignBehaviorToEntity(entity, "FollowFormation");
+        aiMgr.registerEntityForUpdates(entity, 7);
+    }
+    for (int i = 0; i < 5; ++i) {
+        formations.update();
+        aiMgr.setFormations(formations.getSnapshot());
+        aiMgr.update(0.016f);
+    }
+    BOOST_CHECK_EQUAL(formations.getFormationCount(), 1u);
+
+    const FormationSnapshot* snapshot = formations.getSnapshot();
+    BOOST_REQUIRE(snapshot != nullptr);
+    BOOST_CHECK_EQUAL(snapshot->slotPositions.size(), testEntities.size());
+    std::vector<Vector2D> slots;
+    for (auto& entity : testEntities) {
+        Vector2D slot;
+        BOOST_REQUIRE(snapshot->slotPosition(entity->getHandle(), slot));
+        BOOST_CHECK_CLOSE((slot - testPlayer->getPosition()).length(), 100.0f, 0.1f);
+        for (const Vector2D& other : slots) {
+            BOOST_CHECK_GT((slot - other).length(), 50.0f);
+        }
+        slots.push_back(slot);
+    }
+
+    // Leaving the behavior gives the slot back
+    for (auto& entity : testEntities) {
+        aiMgr.unassignBehaviorFromEntity(entity);
+        aiMgr.unregisterEntityFromUpdates(entity);
+    }
+    formations.update();
+    BOOST_CHECK(formations.getSnapshot() == nullptr || formations.getSnapshot()->slotPositions.empty());
+
+    aiMgr.setFormations(nullptr);
+    formations.clean();
+}
+
 BOOST_AUTO_TEST_CASE(TestGuardBehavior) {
     auto entity = testEntities[0];
     Vector2D guardPos(200, 200);
@@ -690,6 +736,36 @@ BOOST_AUTO_TEST_CASE(TestPatrolBehaviorWithWaypoints) {
     BOOST_CHECK_GT(distanceMoved, 1.5f); // Reduced expectation to match actual PatrolBehavior speed
 }
 
+BOOST_AUTO_TEST_CASE(TestPatrolRoutesAroundWall) {
+    PathfindingManager& pathfinding = PathfindingManager::Instance();
+    pathfinding.init();
+    pathfinding.setGrid(40, 40, 10.0f);
+    // Wall between the two waypoints, open below y = 300
+    pathfinding.setAreaBlocked(Vector2D(200, 0), Vector2D(209, 299), true);
+
+    auto entity = testEntities[0];
+    entity->setPosition(Vector2D(50, 50));
+    std::vector<Vector2D> waypoints = {Vector2D(350, 50), Vector2D(50, 50)};
+    auto patrolBehavior = std::make_shared<PatrolBehavior>(waypoints, 2.0f);
+    AIManager::Instance().registerBehavior("WallPatrol", patrolBehavior);
+    AIManager::Instance().assignBehaviorToEntity(entity, "WallPatrol");
+    AIManager::Instance().registerEntityForUpdates(entity, 6);
+
+    // Straight at the waypoint until the route arrives, then down towards the gap
+    bool detoured = false;
+    for (int i = 0; i < 30 && !detoured; ++i) {
+        pathfinding.update();
+        AIManager::Instance().update(0.016f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        Vector2D velocity = entity->getVelocity();
+        detoured = velocity.getY() > velocity.getX();
+    }
+    BOOST_CHECK(detoured);
+
+    AIManager::Instance().unassignBehaviorFromEntity(entity);
+    pathfinding.clean();
+}
+
 BOOST_AUTO_TEST_CASE(TestGuardAlertSystem) {
     auto entity = testEntities[0];
     Vector2D guardPos(300, 300);
@@ -718,6 +794,48 @@ BOOST_AUTO_TEST_CASE(TestGuardAlertSystem) {
     BOOST_CHECK(true); // Main test is that no crashes occur
 }
 
+BOOST_AUTO_TEST_CASE(TestGuardsSeeAroundWalls) {
+    // Wall at x = 600 between the player and one of two guards
+    auto grid = std::make_shared<NavigationGrid>(40, 40, 20.0f);
+    grid->setBlockedArea(Vector2D(600, 0), Vector2D(619, 799), true);
+    AIManager::Instance().setPerceptionGrid(grid);
+    playerEntity->setPosition(Vector2D(500, 500));
+
+    auto guardBehavior = std::make_shared<GuardBehavior>(Vector2D(500, 500), 150.0f, 200.0f);
+    guardBehavior->setFieldOfView(360.0f);
+    AIManager::Instance().registerBehavior("SightGuard", guardBehavior);
+    auto openGuard = testEntities[0];
+    auto walledGuard = testEntities[1];
+    openGuard->setPosition(Vector2D(310, 510));
+    walledGuard->setPosition(Vector2D(690, 510));
+    for (const auto& guard : {openGuard, walledGuard}) {
+        AIManager::Instance().assignBehaviorToEntity(guard, "SightGuard");
+        AIManager::Instance().registerEntityForUpdates(guard, 8);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        AIManager::Instance().update(0.016f);
+    }
+
+    Awareness open = AIManager::Instance().getAwareness(openGuard);
+    Awareness walled = AIManager::Instance().getAwareness(walledGuard);
+    BOOST_CHECK(open.inRange());
+    BOOST_CHECK(open.canSee());
+    BOOST_CHECK(open.hasSeen());
+    BOOST_CHECK(walled.inRange());
+    BOOST_CHECK(!walled.canSee());
+    BOOST_CHECK(!walled.hasSeen());
+
+    // Without the grid nothing blocks sight
+    AIManager::Instance().setPerceptionGrid(nullptr);
+    AIManager::Instance().update(0.016f);
+    BOOST_CHECK(AIManager::Instance().getAwareness(walledGuard).canSee());
+
+    for (const auto& guard : {openGuard, walledGuard}) {
+        AIManager::Instance().unassignBehaviorFromEntity(guard);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // Global test summary
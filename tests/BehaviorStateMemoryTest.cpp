@@ -0,0 +1,201 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE BehaviorStateMemoryTest
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "ai/BehaviorStatePool.hpp"
+#include "ai/behaviors/WanderBehavior.hpp"
+#include "core/ThreadSystem.hpp"
+#include "entities/Entity.hpp"
+#include "managers/AIManager.hpp"
+
+// Count live heap bytes so behavior memory can be measured per entity.
+// Each block carries its size in a max-aligned header.
+namespace {
+
+std::atomic<int64_t> g_liveBytes{0};
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size + HEADER_SIZE);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    g_liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    void* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    g_liveBytes.fetch_sub(static_cast<int64_t>(*static_cast<size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+constexpr size_t ENTITY_COUNT = 10000;
+constexpr size_t THREADED_ENTITY_COUNT = 2000;   // Above AIManager's threading threshold
+
+class MemoryTestEntity : public Entity {
+public:
+    explicit MemoryTestEntity(const Vector2D& pos) { setPosition(pos); }
+    void update(float deltaTime) override { setPosition(getPosition() + getVelocity() * deltaTime); }
+    void render() override {}
+    void clean() override {}
+};
+
+std::vector<EntityPtr> makeEntities(size_t count) {
+    std::vector<EntityPtr> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        float x = static_cast<float>(i % 100) * 12.0f;
+        float y = static_cast<float>(i / 100) * 12.0f;
+        entities.push_back(std::make_shared<MemoryTestEntity>(Vector2D(x, y)));
+    }
+    return entities;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestStatePoolMatchesMapSemantics) {
+    struct State {
+        int value{0};
+    };
+    BehaviorStatePool<State> pool;
+    auto entities = makeEntities(32);
+
+    // Crosses the small-pool threshold, so both lookup paths run
+    for (size_t i = 0; i < entities.size(); ++i) {
+        pool[entities[i]->getHandle()].value = static_cast<int>(i);
+    }
+    BOOST_CHECK_EQUAL(pool.size(), entities.size());
+    BOOST_CHECK(!pool.try_emplace(entities[3]->getHandle(), State{99}).second);
+    BOOST_CHECK_EQUAL(pool.at(entities[3]->getHandle()).value, 3);
+
+    // Swap-and-pop keeps every remaining entity reachable
+    BOOST_CHECK_EQUAL(pool.erase(entities[0]->getHandle()), 1);
+    BOOST_CHECK_EQUAL(pool.erase(entities[0]->getHandle()), 0);
+    BOOST_CHECK_EQUAL(pool.erase(entities[17]->getHandle()), 1);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        auto it = pool.find(entities[i]->getHandle());
+        if (i == 0 || i == 17) {
+            BOOST_CHECK(it == pool.end());
+        } else {
+            BOOST_REQUIRE(it != pool.end());
+            BOOST_CHECK_EQUAL(it->second.value, static_cast<int>(i));
+        }
+    }
+
+    // A destroyed entity's handle never matches the entity reusing its slot
+    EntityHandle stale = entities[5]->getHandle();
+    entities[5].reset();
+    auto reused = std::make_shared<MemoryTestEntity>(Vector2D(0, 0));
+    BOOST_REQUIRE_EQUAL(reused->getHandle().index, stale.index);
+    BOOST_CHECK_EQUAL(pool.count(reused->getHandle()), 0);
+    BOOST_CHECK_EQUAL(pool.count(stale), 1);
+
+    pool.clear();
+    BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestWanderMemoryPerEntity) {
+    auto entities = makeEntities(ENTITY_COUNT);
+    auto wanderTemplate = std::make_shared<WanderBehavior>(WanderBehavior::WanderMode::MEDIUM_AREA);
+
+    // One clone per entity, the way every behavior used to be assigned
+    int64_t before = g_liveBytes.load();
+    std::vector<std::shared_ptr<AIBehavior>> clones;
+    clones.reserve(ENTITY_COUNT);
+    int64_t vectorBytes = g_liveBytes.load() - before;
+    for (const auto& entity : entities) {
+        auto clone = wanderTemplate->clone();
+        clone->init(entity);
+        clones.push_back(std::move(clone));
+    }
+    double clonedPerEntity = static_cast<double>(g_liveBytes.load() - before - vectorBytes) / ENTITY_COUNT;
+    clones.clear();
+    clones.shrink_to_fit();
+
+    // One shared instance with every entity's state in its pool
+    before = g_liveBytes.load();
+    for (const auto& entity : entities) {
+        wanderTemplate->init(entity);
+    }
+    double sharedPerEntity = static_cast<double>(g_liveBytes.load() - before) / ENTITY_COUNT;
+
+    std::cout << std::fixed << std::setprecision(1) << ENTITY_COUNT << " wanderers: "
+              << clonedPerEntity << " bytes/entity cloned, " << sharedPerEntity
+              << " bytes/entity shared (" << clonedPerEntity / sharedPerEntity << "x)" << std::endl;
+
+    // A pooled state plus its share of the sparse table; no per-entity
+    // instance, control block or map node
+    BOOST_CHECK_GT(sharedPerEntity, 0.0);
+    BOOST_CHECK_LT(sharedPerEntity, clonedPerEntity);
+    BOOST_CHECK_LT(sharedPerEntity, 512.0);
+
+    wanderTemplate->clean(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestSharedBehaviorAcrossThreadedUpdates) {
+    BOOST_REQUIRE(Hammer::ThreadSystem::Instance().init());
+    AIManager& aiManager = AIManager::Instance();
+    BOOST_REQUIRE(aiManager.init());
+    aiManager.configureThreading(true);
+
+    auto wanderTemplate = std::make_shared<WanderBehavior>(WanderBehavior::WanderMode::LARGE_AREA);
+    aiManager.registerBehavior("Wander", wanderTemplate);
+    const long baseUseCount = wanderTemplate.use_count();
+
+    auto entities = makeEntities(THREADED_ENTITY_COUNT);
+    for (const auto& entity : entities) {
+        aiManager.registerEntityForUpdates(entity, 5, "Wander");
+    }
+    aiManager.processPendingBehaviorAssignments();
+
+    // Every entity runs the registered instance rather than a clone of it
+    BOOST_CHECK_EQUAL(aiManager.getManagedEntityCount(), THREADED_ENTITY_COUNT);
+    BOOST_CHECK_EQUAL(wanderTemplate.use_count(), baseUseCount + static_cast<long>(THREADED_ENTITY_COUNT));
+
+    // Batches on several workers run the one instance concurrently, while
+    // per-entity messages land between frames
+    for (int frame = 0; frame < 30; ++frame) {
+        aiManager.sendMessageToEntity(entities[static_cast<size_t>(frame)], "pause");
+        aiManager.update(0.016f);
+    }
+    BOOST_CHECK_GT(aiManager.getBehaviorUpdateCount(), THREADED_ENTITY_COUNT);
+
+    // Reassigning the same shared behavior keeps a single reference per entity
+    aiManager.assignBehaviorToEntity(entities[0], "Wander");
+    BOOST_CHECK_EQUAL(wanderTemplate.use_count(), baseUseCount + static_cast<long>(THREADED_ENTITY_COUNT));
+
+    for (const auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    BOOST_CHECK_EQUAL(aiManager.getManagedEntityCount(), 0);
+
+    aiManager.configureThreading(false);
+    aiManager.clean();
+    Hammer::ThreadSystem::Instance().clean();
+}
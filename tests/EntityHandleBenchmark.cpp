@@ -0,0 +1,214 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE EntityHandleBenchmark
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "entities/Entity.hpp"
+#include "entities/EntityHandle.hpp"
+#include "entities/EntityRegistry.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t ENTITY_COUNT = 50000;
+constexpr size_t LOOKUP_ROUNDS = 10;
+constexpr int TIMING_RUNS = 5;
+
+class HandleTestEntity : public Entity {
+public:
+    void update(float deltaTime) override { (void)deltaTime; }
+    void render() override {}
+    void clean() override {}
+};
+
+double elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+struct Throughput {
+    double assignNs{0.0};
+    double lookupNs{0.0};
+    double unassignNs{0.0};
+    size_t checksum{0};
+
+    void keepBest(const Throughput& run, bool first) {
+        assignNs = first ? run.assignNs : std::min(assignNs, run.assignNs);
+        lookupNs = first ? run.lookupNs : std::min(lookupNs, run.lookupNs);
+        unassignNs = first ? run.unassignNs : std::min(unassignNs, run.unassignNs);
+        checksum = run.checksum;
+    }
+};
+
+// Assign, look up and unassign every entity the way AIManager's index map is used
+template<typename Map, typename KeyOf, typename Insert, typename Find, typename Erase>
+Throughput measure(const std::vector<EntityPtr>& entities, const std::vector<uint32_t>& lookupOrder,
+                   KeyOf&& keyOf, Insert&& insert, Find&& find, Erase&& erase) {
+    Throughput best;
+    for (int run = 0; run < TIMING_RUNS; ++run) {
+        Map map;
+        Throughput result;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < entities.size(); ++i) {
+            insert(map, keyOf(entities[i]), i);
+        }
+        result.assignNs = elapsedNs(start, Clock::now()) / static_cast<double>(entities.size());
+
+        start = Clock::now();
+        for (size_t round = 0; round < LOOKUP_ROUNDS; ++round) {
+            for (uint32_t i : lookupOrder) {
+                result.checksum += find(map, keyOf(entities[i]));
+            }
+        }
+        result.lookupNs = elapsedNs(start, Clock::now()) /
+                          static_cast<double>(LOOKUP_ROUNDS * lookupOrder.size());
+
+        start = Clock::now();
+        for (uint32_t i : lookupOrder) {
+            erase(map, keyOf(entities[i]));
+        }
+        result.unassignNs = elapsedNs(start, Clock::now()) / static_cast<double>(lookupOrder.size());
+
+        best.keepBest(result, run == 0);
+    }
+    return best;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestRegistryIssuesGenerationalHandles) {
+    auto& registry = EntityRegistry::Instance();
+    const size_t liveBefore = registry.getLiveCount();
+
+    EntityHandle firstHandle;
+    {
+        auto entity = std::make_shared<HandleTestEntity>();
+        firstHandle = entity->getHandle();
+        BOOST_CHECK(firstHandle.isValid());
+        BOOST_CHECK(registry.isAlive(firstHandle));
+        BOOST_CHECK(registry.resolve(firstHandle) == entity);
+        BOOST_CHECK_EQUAL(registry.getLiveCount(), liveBefore + 1);
+    }
+
+    // Destroyed: the handle goes stale and no longer resolves
+    BOOST_CHECK(!registry.isAlive(firstHandle));
+    BOOST_CHECK(registry.resolve(firstHandle) == nullptr);
+    BOOST_CHECK_EQUAL(registry.getLiveCount(), liveBefore);
+
+    // The slot is reused under a new generation, so the old handle cannot alias it
+    auto reused = std::make_shared<HandleTestEntity>();
+    BOOST_CHECK_EQUAL(reused->getHandle().index, firstHandle.index);
+    BOOST_CHECK_NE(reused->getHandle().generation, firstHandle.generation);
+    BOOST_CHECK(reused->getHandle() != firstHandle);
+    BOOST_CHECK(registry.resolve(firstHandle) == nullptr);
+
+    // A default handle is never valid
+    BOOST_CHECK(!EntityHandle{}.isValid());
+    BOOST_CHECK(!registry.isAlive(EntityHandle{}));
+}
+
+BOOST_AUTO_TEST_CASE(TestHandleMapRejectsStaleHandles) {
+    EntityHandleMap<size_t> map;
+    EntityHandle staleHandle;
+    {
+        auto entity = std::make_shared<HandleTestEntity>();
+        staleHandle = entity->getHandle();
+        map.insert(staleHandle, 7);
+        BOOST_REQUIRE(map.find(staleHandle));
+        BOOST_CHECK_EQUAL(*map.find(staleHandle), 7);
+    }
+
+    auto reused = std::make_shared<HandleTestEntity>();
+    BOOST_REQUIRE_EQUAL(reused->getHandle().index, staleHandle.index);
+    BOOST_CHECK(!map.find(reused->getHandle()));
+
+    // A new generation replaces the stale entry without growing the map
+    map.insert(reused->getHandle(), 9);
+    BOOST_CHECK_EQUAL(map.size(), 1);
+    BOOST_CHECK(!map.find(staleHandle));
+    BOOST_CHECK(!map.erase(staleHandle));
+    BOOST_CHECK(map.erase(reused->getHandle()));
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(!map.find(EntityHandle{}));
+}
+
+BOOST_AUTO_TEST_CASE(TestAssignUnassignLookupThroughput) {
+    std::vector<EntityPtr> entities;
+    entities.reserve(ENTITY_COUNT);
+    for (size_t i = 0; i < ENTITY_COUNT; ++i) {
+        entities.push_back(std::make_shared<HandleTestEntity>());
+    }
+    std::vector<uint32_t> lookupOrder(ENTITY_COUNT);
+    for (size_t i = 0; i < ENTITY_COUNT; ++i) {
+        lookupOrder[i] = static_cast<uint32_t>(i);
+    }
+    std::shuffle(lookupOrder.begin(), lookupOrder.end(), std::mt19937(42));
+
+    // The previous AIManager bookkeeping: shared_ptr keys in a hash map
+    using PointerMap = std::unordered_map<EntityPtr, size_t>;
+    Throughput pointer = measure<PointerMap>(entities, lookupOrder,
+        [](const EntityPtr& entity) -> const EntityPtr& { return entity; },
+        [](PointerMap& map, const EntityPtr& key, size_t slot) { map[key] = slot; },
+        [](const PointerMap& map, const EntityPtr& key) {
+            auto it = map.find(key);
+            return it != map.end() ? it->second : 0;
+        },
+        [](PointerMap& map, const EntityPtr& key) { map.erase(key); });
+
+    // Handle keys, hashed: what the behaviors' per-entity state maps use
+    using HashedHandleMap = std::unordered_map<EntityHandle, size_t>;
+    Throughput hashed = measure<HashedHandleMap>(entities, lookupOrder,
+        [](const EntityPtr& entity) { return entity->getHandle(); },
+        [](HashedHandleMap& map, EntityHandle key, size_t slot) { map[key] = slot; },
+        [](const HashedHandleMap& map, EntityHandle key) {
+            auto it = map.find(key);
+            return it != map.end() ? it->second : 0;
+        },
+        [](HashedHandleMap& map, EntityHandle key) { map.erase(key); });
+
+    // Handle-indexed array with a generation check: AIManager's index maps
+    using IndexedMap = EntityHandleMap<size_t>;
+    Throughput indexed = measure<IndexedMap>(entities, lookupOrder,
+        [](const EntityPtr& entity) { return entity->getHandle(); },
+        [](IndexedMap& map, EntityHandle key, size_t slot) { map.insert(key, slot); },
+        [](const IndexedMap& map, EntityHandle key) {
+            const size_t* slot = map.find(key);
+            return slot ? *slot : 0;
+        },
+        [](IndexedMap& map, EntityHandle key) { map.erase(key); });
+
+    auto report = [](const char* name, const Throughput& t) {
+        std::cout << std::fixed << std::setprecision(1) << std::setw(36) << std::left << name
+                  << " assign " << std::setw(6) << std::right << t.assignNs << "ns"
+                  << "  lookup " << std::setw(6) << t.lookupNs << "ns"
+                  << "  unassign " << std::setw(6) << t.unassignNs << "ns" << std::endl;
+    };
+    std::cout << "Entity bookkeeping, " << ENTITY_COUNT << " entities (per operation, best of "
+              << TIMING_RUNS << "):" << std::endl;
+    report("unordered_map<EntityPtr, size_t>", pointer);
+    report("unordered_map<EntityHandle, size_t>", hashed);
+    report("EntityHandleMap<size_t>", indexed);
+    std::cout << std::setprecision(2) << "EntityHandleMap speedup: assign "
+              << pointer.assignNs / indexed.assignNs << "x, lookup " << pointer.lookupNs / indexed.lookupNs
+              << "x, unassign " << pointer.unassignNs / indexed.unassignNs << "x" << std::endl;
+
+    // Every variant resolved the same slots
+    BOOST_CHECK_EQUAL(pointer.checksum, indexed.checksum);
+    BOOST_CHECK_EQUAL(hashed.checksum, indexed.checksum);
+
+    // An index and a compare against a hash, a bucket walk and a pointer compare
+    BOOST_CHECK_LT(indexed.lookupNs, pointer.lookupNs);
+}
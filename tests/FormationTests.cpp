@@ -0,0 +1,315 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE FormationTests
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ai/Formation.hpp"
+#include "entities/Entity.hpp"
+#include "managers/FormationManager.hpp"
+
+namespace {
+
+class TestEntity : public Entity {
+public:
+    static std::shared_ptr<TestEntity> create(float x, float y) {
+        auto entity = std::make_shared<TestEntity>();
+        entity->setPosition(Vector2D(x, y));
+        return entity;
+    }
+
+    void update(float) override {}
+    void render() override {}
+    void clean() override {}
+};
+
+struct FormationFixture {
+    FormationFixture() { FormationManager::Instance().init(); }
+    ~FormationFixture() { FormationManager::Instance().clean(); }
+};
+
+Vector2D slotOf(EntityHandle member) {
+    const FormationSnapshot* snapshot = FormationManager::Instance().getSnapshot();
+    BOOST_REQUIRE(snapshot != nullptr);
+    Vector2D position;
+    BOOST_REQUIRE(snapshot->slotPosition(member, position));
+    return position;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FormationLayoutTests)
+
+BOOST_AUTO_TEST_CASE(TestShapesLayOutDistinctSlots) {
+    const float spacing = 40.0f;
+
+    // Ring: evenly around the leader at the spacing while it is not crowded
+    for (uint32_t slot = 0; slot < 4; ++slot) {
+        Vector2D offset = FormationLayout::slotOffset(FormationShape::Ring, slot, 4, spacing);
+        BOOST_CHECK_CLOSE(offset.length(), spacing, 0.01f);
+    }
+    // A crowded ring widens so neighbors stay a spacing apart
+    Vector2D first = FormationLayout::slotOffset(FormationShape::Ring, 0, 32, spacing);
+    Vector2D second = FormationLayout::slotOffset(FormationShape::Ring, 1, 32, spacing);
+    BOOST_CHECK_GE((first - second).length(), spacing * 0.99f);
+
+    // Column: single file behind the leader
+    for (uint32_t slot = 0; slot < 5; ++slot) {
+        Vector2D offset = FormationLayout::slotOffset(FormationShape::Column, slot, 5, spacing);
+        BOOST_CHECK_CLOSE(offset.getX(), -spacing * static_cast<float>(slot + 1), 0.01f);
+        BOOST_CHECK_SMALL(offset.getY(), 0.001f);
+    }
+
+    // Line: abreast and centered behind the leader
+    float sumY = 0.0f;
+    for (uint32_t slot = 0; slot < 5; ++slot) {
+        Vector2D offset = FormationLayout::slotOffset(FormationShape::Line, slot, 5, spacing);
+        BOOST_CHECK_CLOSE(offset.getX(), -spacing, 0.01f);
+        sumY += offset.getY();
+    }
+    BOOST_CHECK_SMALL(sumY, 0.001f);
+
+    // Wedge: mirrored pairs, each row further back
+    Vector2D left = FormationLayout::slotOffset(FormationShape::Wedge, 2, 6, spacing);
+    Vector2D right = FormationLayout::slotOffset(FormationShape::Wedge, 3, 6, spacing);
+    BOOST_CHECK_CLOSE(left.getX(), right.getX(), 0.01f);
+    BOOST_CHECK_CLOSE(left.getY(), -right.getY(), 0.01f);
+    BOOST_CHECK_LT(left.getX(), FormationLayout::slotOffset(FormationShape::Wedge, 0, 6, spacing).getX());
+
+    BOOST_CHECK(!FormationLayout::turnsWithLeader(FormationShape::Ring));
+    BOOST_CHECK(FormationLayout::turnsWithLeader(FormationShape::Column));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(FormationManagerTests, FormationFixture)
+
+BOOST_AUTO_TEST_CASE(TestJoinMatchesNearestSlots) {
+    FormationManager& manager = FormationManager::Instance();
+    auto leader = TestEntity::create(0.0f, 0.0f);
+    leader->setVelocity(Vector2D(10.0f, 0.0f));   // Heading +x, so the line forms at x = -50
+
+    // Members already stand near the line's slots, but join in scrambled order
+    const float spacing = 50.0f;
+    std::vector<std::shared_ptr<TestEntity>> members;
+    const int order[] = {3, 0, 4, 1, 2};
+    FormationId id = manager.createFormation(leader->getHandle(), FormationShape::Line, spacing);
+    BOOST_REQUIRE(id != INVALID_FORMATION);
+    for (int index : order) {
+        auto member = TestEntity::create(-spacing + 3.0f, (static_cast<float>(index) - 2.0f) * spacing + 2.0f);
+        BOOST_CHECK(manager.joinFormation(id, member->getHandle()));
+        members.push_back(member);
+    }
+    BOOST_CHECK(manager.joinFormation(id, members[0]->getHandle()));   // Joining twice keeps one slot
+    BOOST_CHECK_EQUAL(manager.getMemberCount(id), 5u);
+
+    manager.update();
+    for (const auto& member : members) {
+        BOOST_CHECK_LT((slotOf(member->getHandle()) - member->getPosition()).length(), 5.0f);
+    }
+    BOOST_CHECK_EQUAL(manager.getSnapshot()->slotPositions.size(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(TestSlotsFollowLeaderWithoutRematching) {
+    FormationManager& manager = FormationManager::Instance();
+    auto leader = TestEntity::create(100.0f, 100.0f);
+    leader->setVelocity(Vector2D(10.0f, 0.0f));
+    auto member = TestEntity::create(60.0f, 100.0f);
+
+    FormationId id = manager.createFormation(leader->getHandle(), FormationShape::Column, 40.0f);
+    BOOST_REQUIRE(manager.joinFormation(id, member->getHandle()));
+    manager.update();
+    Vector2D slot = slotOf(member->getHandle());
+    BOOST_CHECK_CLOSE(slot.getX(), 60.0f, 0.01f);
+    BOOST_CHECK_CLOSE(slot.getY(), 100.0f, 0.01f);
+    const uint64_t rematches = manager.getStats().rematches;
+
+    // Leader moves and turns toward +y; the column swings behind it
+    leader->setPosition(Vector2D(200.0f, 300.0f));
+    leader->setVelocity(Vector2D(0.0f, 25.0f));
+    manager.update();
+    slot = slotOf(member->getHandle());
+    BOOST_CHECK_SMALL(slot.getX() - 200.0f, 0.01f);
+    BOOST_CHECK_CLOSE(slot.getY(), 260.0f, 0.01f);
+
+    // A leader that stops keeps its heading
+    leader->setVelocity(Vector2D(0.0f, 0.0f));
+    manager.update();
+    BOOST_CHECK_CLOSE(slotOf(member->getHandle()).getY(), 260.0f, 0.01f);
+    BOOST_CHECK_EQUAL(manager.getStats().rematches, rematches);
+}
+
+BOOST_AUTO_TEST_CASE(TestLeaveClosesRanksAndLeaderLossDropsFormation) {
+    FormationManager& manager = FormationManager::Instance();
+    auto leader = TestEntity::create(0.0f, 0.0f);
+    std::vector<std::shared_ptr<TestEntity>> members;
+    FormationId id = manager.createFormation(leader->getHandle(), FormationShape::Ring, 30.0f, 3);
+    for (int i = 0; i < 3; ++i) {
+        members.push_back(TestEntity::create(static_cast<float>(i) * 10.0f, 0.0f));
+        BOOST_CHECK(manager.joinFormation(id, members.back()->getHandle()));
+    }
+    auto extra = TestEntity::create(0.0f, 0.0f);
+    BOOST_CHECK(!manager.joinFormation(id, extra->getHandle()));   // Full
+
+    manager.update();
+    BOOST_CHECK_EQUAL(manager.getSnapshot()->slotPositions.size(), 3u);
+
+    // Two left: the ring lays out two slots, opposite each other
+    manager.leaveFormation(id, members[1]->getHandle());
+    manager.update();
+    const FormationSnapshot* snapshot = manager.getSnapshot();
+    BOOST_REQUIRE(snapshot != nullptr);
+    BOOST_CHECK_EQUAL(snapshot->slotPositions.size(), 2u);
+    Vector2D position;
+    BOOST_CHECK(!snapshot->slotPosition(members[1]->getHandle(), position));
+    Vector2D a = slotOf(members[0]->getHandle());
+    Vector2D b = slotOf(members[2]->getHandle());
+    BOOST_CHECK_CLOSE((a - b).length(), 60.0f, 0.01f);
+
+    // A member destroyed without leaving gives its slot up at the next match
+    members[2].reset();
+    manager.setFormationShape(id, FormationShape::Ring, 30.0f);
+    manager.update();
+    BOOST_CHECK_EQUAL(manager.getMemberCount(id), 1u);
+
+    leader.reset();
+    manager.update();
+    BOOST_CHECK_EQUAL(manager.getFormationCount(), 0u);
+    BOOST_CHECK(manager.getSnapshot() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestSharedFormationPerLeaderAndShape) {
+    FormationManager& manager = FormationManager::Instance();
+    auto leader = TestEntity::create(0.0f, 0.0f);
+    auto other = TestEntity::create(500.0f, 0.0f);
+
+    FormationId ring = manager.findOrCreateFormation(leader->getHandle(), FormationShape::Ring, 100.0f);
+    BOOST_CHECK_EQUAL(manager.findOrCreateFormation(leader->getHandle(), FormationShape::Ring, 100.0f), ring);
+    BOOST_CHECK(manager.findOrCreateFormation(leader->getHandle(), FormationShape::Wedge, 100.0f) != ring);
+    BOOST_CHECK(manager.findOrCreateFormation(other->getHandle(), FormationShape::Ring, 100.0f) != ring);
+    // Explicit formations are never handed out as shared ones
+    FormationId own = manager.createFormation(leader->getHandle(), FormationShape::Column, 20.0f);
+    BOOST_CHECK(manager.findOrCreateFormation(leader->getHandle(), FormationShape::Column, 20.0f) != own);
+    BOOST_CHECK_EQUAL(manager.getFormationCount(), 5u);
+    BOOST_CHECK(manager.getLeader(ring) == leader->getHandle());
+
+    BOOST_CHECK(manager.findOrCreateFormation(EntityHandle{}, FormationShape::Ring, 100.0f) == INVALID_FORMATION);
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrentJoinsWhileFollowersRead) {
+    FormationManager& manager = FormationManager::Instance();
+    auto leader = TestEntity::create(0.0f, 0.0f);
+    FormationId id = manager.createFormation(leader->getHandle(), FormationShape::Ring, 40.0f);
+
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 50;
+    std::vector<std::shared_ptr<TestEntity>> members;
+    for (int i = 0; i < THREADS * PER_THREAD; ++i) {
+        members.push_back(TestEntity::create(static_cast<float>(i), 0.0f));
+    }
+    manager.update();
+
+    // Joins and leaves from several threads while a reader walks the pinned
+    // snapshot, as followers do during AI batches
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        const FormationSnapshot* snapshot = manager.getSnapshot();
+        size_t found = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            Vector2D position;
+            for (const auto& member : members) {
+                found += snapshot && snapshot->slotPosition(member->getHandle(), position) ? 1 : 0;
+            }
+        }
+        BOOST_TEST_MESSAGE("Reader saw " << found << " slots");
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREADS; ++t) {
+        writers.emplace_back([&, t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                EntityHandle handle = members[t * PER_THREAD + i]->getHandle();
+                manager.joinFormation(id, handle);
+                if (i % 5 == 0) {
+                    manager.leaveFormation(id, handle);
+                }
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    manager.update();
+    const size_t expected = THREADS * (PER_THREAD - PER_THREAD / 5);
+    BOOST_CHECK_EQUAL(manager.getMemberCount(id), expected);
+    BOOST_CHECK_EQUAL(manager.getSnapshot()->memberSlots.size(), expected);
+    BOOST_CHECK_EQUAL(manager.getSnapshot()->slotPositions.size(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(TestPublishCostForManyFollowers) {
+    FormationManager& manager = FormationManager::Instance();
+    constexpr int FORMATIONS = 100;
+    constexpr int MEMBERS = 100;
+    std::vector<std::shared_ptr<TestEntity>> leaders;
+    std::vector<std::shared_ptr<TestEntity>> members;
+    for (int f = 0; f < FORMATIONS; ++f) {
+        leaders.push_back(TestEntity::create(static_cast<float>(f) * 1000.0f, 0.0f));
+        leaders.back()->setVelocity(Vector2D(1.0f, 1.0f));
+        FormationId id = manager.createFormation(leaders.back()->getHandle(), FormationShape::Wedge, 32.0f);
+        for (int m = 0; m < MEMBERS; ++m) {
+            members.push_back(TestEntity::create(static_cast<float>(f) * 1000.0f, static_cast<float>(m)));
+            manager.joinFormation(id, members.back()->getHandle());
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    manager.update();   // Matches every formation once
+    double firstMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    constexpr int FRAMES = 100;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (auto& leader : leaders) {
+            leader->setPosition(leader->getPosition() + Vector2D(1.0f, 1.0f));
+        }
+        manager.update();
+    }
+    double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+
+    // Followers' reads: one map lookup and one load each
+    start = std::chrono::steady_clock::now();
+    const FormationSnapshot* snapshot = manager.getSnapshot();
+    Vector2D sum(0.0f, 0.0f);
+    for (const auto& member : members) {
+        Vector2D position;
+        if (snapshot->slotPosition(member->getHandle(), position)) {
+            sum += position;
+        }
+    }
+    double readMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Formations: " << FORMATIONS << " x " << MEMBERS << " members\n"
+              << "  First update (matching): " << firstMs << " ms\n"
+              << "  Update per frame: " << frameMs << " ms\n"
+              << "  All followers' slot reads: " << readMs << " ms\n";
+
+    BOOST_CHECK_EQUAL(snapshot->slotPositions.size(), static_cast<size_t>(FORMATIONS * MEMBERS));
+    BOOST_CHECK_EQUAL(manager.getStats().rematches, static_cast<uint64_t>(FORMATIONS));
+    BOOST_CHECK(sum.length() > 0.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,219 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE FrameTaskGraphTests
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/FrameTaskGraph.hpp"
+#include "core/ThreadSystem.hpp"
+
+// GCC flags free() on memory from the replaced operator new once both are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count heap allocations made by the current thread (see TaskAllocationBenchmark)
+namespace {
+    thread_local size_t t_allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++t_allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    ++t_allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+struct ThreadSystemFixture {
+    ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4);
+    }
+    ~ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().clean();
+    }
+};
+
+// Records the order in which stages finish
+struct OrderLog {
+    std::mutex mutex;
+    std::vector<int> order;
+
+    void record(int stage) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(stage);
+    }
+
+    size_t position(int stage) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (order[i] == stage) {
+                return i;
+            }
+        }
+        return order.size();
+    }
+};
+
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSystemFixture);
+
+BOOST_AUTO_TEST_CASE(TestDependencyEdges) {
+    Hammer::FrameTaskGraph graph;
+    auto noop = [](float) {};
+    size_t ai = graph.addStage("AI", noop, {}, {"Entities"});
+    size_t events = graph.addStage("Events", noop, {}, {"Events"});
+    size_t collision = graph.addStage("Collision", noop, {"Entities"}, {"Contacts"});
+    size_t ui = graph.addStage("UI", noop, {"Entities", "Events"}, {});
+    size_t cleanup = graph.addStage("Cleanup", noop, {}, {"Entities"});
+    graph.compile();
+
+    // Read-after-write
+    auto aiSucc = graph.getSuccessors(ai);
+    BOOST_CHECK(std::find(aiSucc.begin(), aiSucc.end(), collision) != aiSucc.end());
+    BOOST_CHECK(std::find(aiSucc.begin(), aiSucc.end(), ui) != aiSucc.end());
+    auto eventSucc = graph.getSuccessors(events);
+    BOOST_CHECK(std::find(eventSucc.begin(), eventSucc.end(), ui) != eventSucc.end());
+
+    // Write-after-read: Cleanup waits for every earlier reader of Entities
+    auto collisionSucc = graph.getSuccessors(collision);
+    BOOST_CHECK(std::find(collisionSucc.begin(), collisionSucc.end(), cleanup) != collisionSucc.end());
+    auto uiSucc = graph.getSuccessors(ui);
+    BOOST_CHECK(std::find(uiSucc.begin(), uiSucc.end(), cleanup) != uiSucc.end());
+
+    // Independent stages share no edge
+    BOOST_CHECK(std::find(aiSucc.begin(), aiSucc.end(), events) == aiSucc.end());
+    BOOST_CHECK(graph.getSuccessors(events).size() == 1);
+
+    BOOST_CHECK_EQUAL(graph.getCriticalPathDepth(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(TestExecutionOrder) {
+    Hammer::FrameTaskGraph graph;
+    OrderLog log;
+    std::atomic<int> concurrentWriters{0};
+    std::atomic<bool> overlap{false};
+
+    auto writer = [&](int id) {
+        return [&, id](float) {
+            if (concurrentWriters.fetch_add(1) != 0) {
+                overlap.store(true);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            concurrentWriters.fetch_sub(1);
+            log.record(id);
+        };
+    };
+
+    graph.addStage("A", writer(0), {}, {"Shared"});
+    graph.addStage("B", [&](float) { log.record(1); }, {"Shared"}, {"Other"});
+    graph.addStage("C", [&](float) { log.record(2); }, {"Shared"}, {});
+    graph.addStage("D", writer(3), {"Other"}, {"Shared"});
+
+    for (int frame = 0; frame < 50; ++frame) {
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            log.order.clear();
+        }
+        graph.execute(0.016f);
+
+        BOOST_REQUIRE_EQUAL(log.order.size(), 4);
+        BOOST_CHECK_LT(log.position(0), log.position(1));
+        BOOST_CHECK_LT(log.position(0), log.position(2));
+        BOOST_CHECK_LT(log.position(1), log.position(3));
+        BOOST_CHECK_LT(log.position(2), log.position(3));
+    }
+    BOOST_CHECK(!overlap.load());
+}
+
+BOOST_AUTO_TEST_CASE(TestCallerAffinityAndExceptions) {
+    Hammer::FrameTaskGraph graph;
+    const auto callerId = std::this_thread::get_id();
+    std::atomic<bool> callerStageOnCaller{true};
+    std::atomic<int> afterThrowRuns{0};
+
+    graph.addStage("Throws", [](float) { throw std::runtime_error("stage failure"); }, {}, {"World"});
+    graph.addStage("AfterThrow", [&](float) { afterThrowRuns.fetch_add(1); }, {"World"}, {});
+    graph.addStage("CallerOnly", [&](float) {
+        if (std::this_thread::get_id() != callerId) {
+            callerStageOnCaller.store(false);
+        }
+    }, {"World"}, {"Ui"}, Hammer::TaskPriority::High, true);
+
+    for (int frame = 0; frame < 20; ++frame) {
+        graph.execute(0.016f);
+    }
+
+    BOOST_CHECK(callerStageOnCaller.load());
+    BOOST_CHECK_EQUAL(afterThrowRuns.load(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(TestCriticalPath) {
+    Hammer::FrameTaskGraph graph;
+    auto sleepFor = [](int ms) {
+        return [ms](float) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+    };
+
+    size_t slow = graph.addStage("Slow", sleepFor(20), {}, {"A"});
+    graph.addStage("Fast", sleepFor(2), {}, {"B"});
+    size_t join = graph.addStage("Join", sleepFor(2), {"A", "B"}, {});
+
+    graph.execute(0.016f);
+
+    const auto& path = graph.getCriticalPath();
+    BOOST_REQUIRE_EQUAL(path.size(), 2);
+    BOOST_CHECK_EQUAL(path[0], slow);
+    BOOST_CHECK_EQUAL(path[1], join);
+    BOOST_CHECK_GE(graph.getCriticalPathMs(), 22.0);
+    BOOST_CHECK_GE(graph.getStageTimeMs(slow), 20.0);
+    BOOST_CHECK_GE(graph.getLastFrameTimeMs(), graph.getCriticalPathMs() * 0.9);
+}
+
+BOOST_AUTO_TEST_CASE(TestReplayDoesNotAllocate) {
+    Hammer::FrameTaskGraph graph;
+    std::atomic<size_t> work{0};
+    auto stage = [&](float) { work.fetch_add(1, std::memory_order_relaxed); };
+
+    graph.addStage("AI", stage, {}, {"Entities"});
+    graph.addStage("Events", stage, {}, {"Events"});
+    graph.addStage("Collision", stage, {"Entities"}, {"Contacts"});
+    graph.addStage("GameState", stage, {"Events", "Contacts"}, {"Entities"},
+                   Hammer::TaskPriority::High, true);
+
+    graph.execute(0.016f); // First frame compiles the graph
+
+    size_t before = t_allocationCount;
+    for (int frame = 0; frame < 100; ++frame) {
+        graph.execute(0.016f);
+    }
+    BOOST_CHECK_EQUAL(t_allocationCount - before, 0);
+    BOOST_CHECK_EQUAL(work.load(), 4 * 101);
+}
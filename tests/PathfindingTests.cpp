@@ -0,0 +1,576 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE PathfindingTests
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ai/AStarPathfinder.hpp"
+#include "ai/FlowField.hpp"
+#include "ai/NavigationGrid.hpp"
+#include "core/ThreadSystem.hpp"
+#include "managers/PathfindingManager.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float DIAGONAL = 1.41421356f;
+
+void blockRandomCells(NavigationGrid& grid, float density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+    for (uint32_t cell = 0; cell < grid.getCellCount(); ++cell) {
+        grid.setBlocked(cell, roll(rng) < density);
+    }
+}
+
+// Plain Dijkstra with the same moves as AStarPathfinder; infinity if unreachable
+float referenceCost(const NavigationGrid& grid, uint32_t start, uint32_t goal) {
+    using Entry = std::pair<float, uint32_t>;
+    std::vector<float> cost(grid.getCellCount(), std::numeric_limits<float>::infinity());
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    cost[start] = 0.0f;
+    open.push({0.0f, start});
+    while (!open.empty()) {
+        auto [g, cell] = open.top();
+        open.pop();
+        if (g > cost[cell]) {
+            continue;
+        }
+        if (cell == goal) {
+            return g;
+        }
+        const int32_t x = static_cast<int32_t>(grid.cellX(cell));
+        const int32_t y = static_cast<int32_t>(grid.cellY(cell));
+        for (int32_t dy = -1; dy <= 1; ++dy) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                if ((dx == 0 && dy == 0) || !grid.isWalkable(x + dx, y + dy)) {
+                    continue;
+                }
+                if (dx != 0 && dy != 0 && (!grid.isWalkable(x + dx, y) || !grid.isWalkable(x, y + dy))) {
+                    continue;
+                }
+                const uint32_t next = grid.cellIndex(static_cast<uint32_t>(x + dx), static_cast<uint32_t>(y + dy));
+                const float nextCost = g + ((dx != 0 && dy != 0) ? DIAGONAL : 1.0f);
+                if (nextCost < cost[next]) {
+                    cost[next] = nextCost;
+                    open.push({nextCost, next});
+                }
+            }
+        }
+    }
+    return std::numeric_limits<float>::infinity();
+}
+
+// Steps the manager until every request is answered, workers included
+void drainRequests(PathfindingManager& manager) {
+    auto deadline = Clock::now() + std::chrono::seconds(30);
+    while (!manager.isIdle() && Clock::now() < deadline) {
+        manager.update();
+        std::this_thread::yield();
+    }
+}
+
+// The ThreadSystem cannot start again once cleaned, so the worker tests
+// share one that lives until the module ends
+void startWorkers() {
+    static bool started = Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4);
+    BOOST_REQUIRE(started);
+}
+
+struct ThreadSystemTeardown {
+    ~ThreadSystemTeardown() {
+        if (Hammer::ThreadSystem::Exists()) {
+            Hammer::ThreadSystem::Instance().clean();
+        }
+    }
+};
+
+struct PathfindingFixture {
+    PathfindingFixture() {
+        PathfindingManager::Instance().init();
+    }
+    ~PathfindingFixture() {
+        PathfindingManager::Instance().clean();
+    }
+};
+
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSystemTeardown);
+
+BOOST_AUTO_TEST_CASE(TestOpenGridPathIsOptimal) {
+    NavigationGrid grid(32, 32, 16.0f);
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+
+    BOOST_REQUIRE(pathfinder.findPath(grid, grid.cellIndex(2, 3), grid.cellIndex(20, 10), cells) ==
+                  AStarPathfinder::Result::Found);
+    // 7 diagonal steps and 11 straight ones
+    BOOST_CHECK_CLOSE(pathfinder.getLastPathCost(), 11.0f + 7.0f * DIAGONAL, 0.01);
+    BOOST_CHECK_EQUAL(cells.front(), grid.cellIndex(2, 3));
+    BOOST_CHECK_EQUAL(cells.back(), grid.cellIndex(20, 10));
+    BOOST_CHECK_EQUAL(cells.size(), 19u);
+
+    // Nothing in the way, so smoothing leaves only the endpoints
+    AStarPathfinder::smoothPath(grid, cells);
+    BOOST_CHECK_EQUAL(cells.size(), 2u);
+
+    // Start and goal in one cell
+    BOOST_REQUIRE(pathfinder.findPath(grid, grid.cellIndex(5, 5), grid.cellIndex(5, 5), cells) ==
+                  AStarPathfinder::Result::Found);
+    BOOST_CHECK_EQUAL(cells.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(TestPathGoesThroughGapInWall) {
+    NavigationGrid grid(40, 40, 10.0f);
+    // Wall down x = 20 with a single gap at y = 35
+    for (uint32_t y = 0; y < 40; ++y) {
+        grid.setBlocked(grid.cellIndex(20, y), y != 35);
+    }
+
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+    BOOST_REQUIRE(pathfinder.findPath(grid, grid.cellIndex(5, 5), grid.cellIndex(35, 5), cells) ==
+                  AStarPathfinder::Result::Found);
+    bool usedGap = false;
+    for (uint32_t cell : cells) {
+        BOOST_REQUIRE(!grid.isBlocked(cell));
+        usedGap = usedGap || cell == grid.cellIndex(20, 35);
+    }
+    BOOST_CHECK(usedGap);
+
+    AStarPathfinder::smoothPath(grid, cells);
+    BOOST_CHECK_GE(cells.size(), 3u);
+    for (size_t i = 1; i < cells.size(); ++i) {
+        BOOST_CHECK(grid.hasLineOfSight(cells[i - 1], cells[i]));
+    }
+
+    // Close the gap: the far side is unreachable
+    grid.setBlocked(grid.cellIndex(20, 35), true);
+    BOOST_CHECK(pathfinder.findPath(grid, grid.cellIndex(5, 5), grid.cellIndex(35, 5), cells) ==
+                AStarPathfinder::Result::NoPath);
+    BOOST_CHECK(cells.empty());
+
+    // Blocked endpoints and a tight budget
+    BOOST_CHECK(pathfinder.findPath(grid, grid.cellIndex(20, 0), grid.cellIndex(5, 5), cells) ==
+                AStarPathfinder::Result::InvalidEndpoints);
+    BOOST_CHECK(pathfinder.findPath(grid, grid.cellIndex(0, 0), grid.cellIndex(19, 39), cells, 10) ==
+                AStarPathfinder::Result::BudgetExceeded);
+}
+
+BOOST_AUTO_TEST_CASE(TestNoDiagonalSqueezeBetweenBlockedCells) {
+    NavigationGrid grid(4, 4, 1.0f);
+    grid.setBlocked(grid.cellIndex(1, 0), true);
+    grid.setBlocked(grid.cellIndex(0, 1), true);
+    grid.setBlocked(grid.cellIndex(2, 1), true);
+    grid.setBlocked(grid.cellIndex(1, 2), true);
+
+    // (1,1) is boxed in on all four sides, only diagonals touch it
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+    BOOST_CHECK(pathfinder.findPath(grid, grid.cellIndex(0, 0), grid.cellIndex(1, 1), cells) ==
+                AStarPathfinder::Result::NoPath);
+    BOOST_CHECK(!grid.hasLineOfSight(grid.cellIndex(0, 0), grid.cellIndex(2, 2)));
+    BOOST_CHECK(grid.hasLineOfSight(grid.cellIndex(3, 0), grid.cellIndex(3, 3)));
+}
+
+BOOST_AUTO_TEST_CASE(TestCostMatchesDijkstraOnRandomGrids) {
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+    std::mt19937 rng(21);
+    int found = 0;
+    int unreachable = 0;
+
+    for (uint32_t layout = 0; layout < 10; ++layout) {
+        NavigationGrid grid(48, 48, 8.0f);
+        blockRandomCells(grid, 0.3f, 100 + layout);
+        std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(grid.getCellCount() - 1));
+
+        for (int query = 0; query < 20; ++query) {
+            uint32_t start = grid.nearestWalkable(pick(rng), 8);
+            uint32_t goal = grid.nearestWalkable(pick(rng), 8);
+            BOOST_REQUIRE(start != NavigationGrid::INVALID_CELL && goal != NavigationGrid::INVALID_CELL);
+
+            const float expected = referenceCost(grid, start, goal);
+            AStarPathfinder::Result result = pathfinder.findPath(grid, start, goal, cells);
+            if (std::isinf(expected)) {
+                BOOST_CHECK(result == AStarPathfinder::Result::NoPath);
+                ++unreachable;
+                continue;
+            }
+            BOOST_REQUIRE(result == AStarPathfinder::Result::Found);
+            BOOST_CHECK_CLOSE(pathfinder.getLastPathCost(), expected, 0.01);
+            ++found;
+        }
+    }
+    BOOST_CHECK_GT(found, 100);
+    BOOST_TEST_MESSAGE("Dijkstra comparison: " << found << " paths, " << unreachable << " unreachable");
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRequestsCacheAndInvalidation, PathfindingFixture) {
+    PathfindingManager& manager = PathfindingManager::Instance();
+    BOOST_CHECK(!manager.requestPath(Vector2D(5, 5), Vector2D(100, 100)).isValid());
+
+    manager.setGrid(64, 64, 10.0f);
+    manager.setAreaBlocked(Vector2D(300, 0), Vector2D(309, 500), true);   // Wall at x cells 30
+
+    const Vector2D start(25.0f, 25.0f);
+    const Vector2D goal(555.0f, 45.0f);
+    PathRequestHandle first = manager.requestPath(start, goal);
+    BOOST_REQUIRE(first.isValid());
+    BOOST_CHECK(manager.getPathStatus(first) == PathStatus::Pending);
+    drainRequests(manager);
+    BOOST_REQUIRE(manager.getPathStatus(first) == PathStatus::Ready);
+
+    std::vector<Vector2D> path;
+    BOOST_REQUIRE(manager.getPath(first, path));
+    BOOST_REQUIRE_GE(path.size(), 2u);
+    BOOST_CHECK_CLOSE(path.back().getX(), goal.getX(), 0.001);
+    BOOST_CHECK_CLOSE(path.back().getY(), goal.getY(), 0.001);
+    for (const Vector2D& point : path) {
+        BOOST_CHECK(!manager.isBlocked(point));
+    }
+    // The wall ends at y = 500, so the route turns below it
+    bool passesBelowWall = false;
+    for (const Vector2D& point : path) {
+        passesBelowWall = passesBelowWall || point.getY() > 500.0f;
+    }
+    BOOST_CHECK(passesBelowWall);
+
+    // Same cells again: answered from the cache without a search
+    PathfindingStats before = manager.getStats();
+    PathRequestHandle second = manager.requestPath(Vector2D(22.0f, 28.0f), Vector2D(552.0f, 41.0f));
+    BOOST_CHECK(manager.getPathStatus(second) == PathStatus::Ready);
+    BOOST_CHECK_EQUAL(manager.getStats().cacheHits, before.cacheHits + 1);
+    BOOST_CHECK_EQUAL(manager.getStats().searches, before.searches);
+
+    // Released handles never match a reused slot
+    manager.releasePath(first);
+    BOOST_CHECK(manager.getPathStatus(first) == PathStatus::Invalid);
+    BOOST_CHECK(!manager.getPath(first, path));
+    PathRequestHandle reused = manager.requestPath(start, goal);
+    BOOST_CHECK_EQUAL(reused.index, first.index);
+    BOOST_CHECK(reused != first);
+    BOOST_CHECK(manager.getPathStatus(first) == PathStatus::Invalid);
+
+    // Sealing the wall empties the cache; the next request searches and fails
+    const uint64_t version = manager.getGridVersion();
+    manager.setAreaBlocked(Vector2D(300, 0), Vector2D(309, 639), true);
+    BOOST_CHECK_GT(manager.getGridVersion(), version);
+    BOOST_CHECK_EQUAL(manager.getCachedPathCount(), 0u);
+    PathRequestHandle sealed = manager.requestPath(start, goal);
+    BOOST_CHECK(manager.getPathStatus(sealed) == PathStatus::Pending);
+    drainRequests(manager);
+    BOOST_CHECK(manager.getPathStatus(sealed) == PathStatus::Failed);
+
+    // An edit that changes nothing keeps the cache and version
+    const uint64_t sealedVersion = manager.getGridVersion();
+    manager.setAreaBlocked(Vector2D(300, 0), Vector2D(309, 639), true);
+    BOOST_CHECK_EQUAL(manager.getGridVersion(), sealedVersion);
+
+    // A goal inside the wall is moved to the nearest open cell
+    manager.setAreaBlocked(Vector2D(300, 0), Vector2D(309, 639), false);
+    manager.setAreaBlocked(Vector2D(300, 200), Vector2D(309, 209), true);
+    std::vector<Vector2D> direct;
+    BOOST_CHECK(manager.findPathNow(start, Vector2D(305.0f, 205.0f), direct) == PathStatus::Ready);
+    BOOST_REQUIRE(!direct.empty());
+    BOOST_CHECK(!manager.isBlocked(direct.back()));
+
+    manager.releasePath(second);
+    manager.releasePath(reused);
+    manager.releasePath(sealed);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestPerFrameRequestBudget, PathfindingFixture) {
+    PathfindingManager& manager = PathfindingManager::Instance();
+    manager.setGrid(128, 128, 8.0f);
+    manager.setRequestsPerFrame(16);
+
+    std::vector<PathRequestHandle> handles;
+    for (int i = 0; i < 100; ++i) {
+        const float offset = static_cast<float>(i) * 8.0f;
+        handles.push_back(manager.requestPath(Vector2D(4.0f, 4.0f + offset), Vector2D(1000.0f, 1000.0f - offset)));
+    }
+    BOOST_CHECK_EQUAL(manager.getQueuedRequestCount(), 100u);
+
+    manager.update();
+    BOOST_CHECK_EQUAL(manager.getQueuedRequestCount(), 84u);
+    BOOST_CHECK_EQUAL(manager.getStats().searches, 16u);
+
+    // Released while queued: dropped without a search
+    for (size_t i = 16; i < 32; ++i) {
+        manager.releasePath(handles[i]);
+    }
+    manager.update();
+    BOOST_CHECK_EQUAL(manager.getQueuedRequestCount(), 52u);
+    BOOST_CHECK_EQUAL(manager.getStats().searches, 32u);
+
+    drainRequests(manager);
+    for (size_t i = 0; i < handles.size(); ++i) {
+        const bool released = i >= 16 && i < 32;
+        BOOST_CHECK(manager.getPathStatus(handles[i]) == (released ? PathStatus::Invalid : PathStatus::Ready));
+    }
+
+    // A state change drops everything still held
+    manager.prepareForStateTransition();
+    BOOST_CHECK(manager.getPathStatus(handles[0]) == PathStatus::Invalid);
+    BOOST_CHECK(manager.hasGrid());
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWorkerSearchesUnderConcurrentEdits, PathfindingFixture) {
+    startWorkers();
+    PathfindingManager& manager = PathfindingManager::Instance();
+    manager.setGrid(128, 128, 8.0f);
+    manager.setRequestsPerFrame(32);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(0.0f, 1023.0f);
+    std::vector<PathRequestHandle> handles;
+    for (int frame = 0; frame < 30; ++frame) {
+        for (int i = 0; i < 20; ++i) {
+            handles.push_back(manager.requestPath(Vector2D(coord(rng), coord(rng)), Vector2D(coord(rng), coord(rng))));
+        }
+        // Toggle a block while searches are running on the previous grid
+        const float x = coord(rng);
+        const float y = coord(rng);
+        manager.setAreaBlocked(Vector2D(x, y), Vector2D(x + 40.0f, y + 40.0f), frame % 2 == 0);
+        manager.update();
+    }
+    drainRequests(manager);
+
+    size_t answered = 0;
+    for (PathRequestHandle handle : handles) {
+        PathStatus status = manager.getPathStatus(handle);
+        answered += (status == PathStatus::Ready || status == PathStatus::Failed) ? 1 : 0;
+        manager.releasePath(handle);
+    }
+    BOOST_CHECK_EQUAL(answered, handles.size());
+
+}
+
+BOOST_FIXTURE_TEST_CASE(TestThroughputOn512Grid, PathfindingFixture) {
+    constexpr uint32_t gridSize = 512;
+    constexpr size_t pathCount = 400;
+    NavigationGrid grid(gridSize, gridSize, 16.0f);
+    blockRandomCells(grid, 0.2f, 77);
+
+    std::mt19937 rng(78);
+    std::uniform_int_distribution<uint32_t> pick(0, gridSize * gridSize - 1);
+    std::vector<std::pair<uint32_t, uint32_t>> queries;
+    for (size_t i = 0; i < pathCount; ++i) {
+        queries.emplace_back(grid.nearestWalkable(pick(rng), 8), grid.nearestWalkable(pick(rng), 8));
+    }
+
+    // Single thread, one reused pathfinder
+    AStarPathfinder pathfinder;
+    std::vector<uint32_t> cells;
+    size_t found = 0;
+    uint64_t expanded = 0;
+    auto start = Clock::now();
+    for (const auto& [from, to] : queries) {
+        found += pathfinder.findPath(grid, from, to, cells) == AStarPathfinder::Result::Found ? 1 : 0;
+        expanded += pathfinder.getLastExpansions();
+    }
+    const double serialSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Through the manager on ThreadSystem workers; the cache is off so every request searches
+    startWorkers();
+    PathfindingManager& manager = PathfindingManager::Instance();
+    manager.setGrid(gridSize, gridSize, 16.0f);
+    for (uint32_t cell = 0; cell < grid.getCellCount(); ++cell) {
+        if (grid.isBlocked(cell)) {
+            manager.setCellBlocked(grid.cellCenter(cell), true);
+        }
+    }
+    manager.setCacheCapacity(0);
+    manager.setRequestsPerFrame(128);
+
+    std::vector<PathRequestHandle> handles;
+    start = Clock::now();
+    for (const auto& [from, to] : queries) {
+        handles.push_back(manager.requestPath(grid.cellCenter(from), grid.cellCenter(to)));
+    }
+    drainRequests(manager);
+    const double asyncSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t asyncFound = 0;
+    for (PathRequestHandle handle : handles) {
+        asyncFound += manager.getPathStatus(handle) == PathStatus::Ready ? 1 : 0;
+        manager.releasePath(handle);
+    }
+
+    std::cout << std::fixed << std::setprecision(0) << "A* on " << gridSize << "x" << gridSize
+              << " grid (20% blocked): " << static_cast<double>(pathCount) / serialSeconds
+              << " paths/s single thread (" << expanded / pathCount << " cells expanded avg), "
+              << static_cast<double>(pathCount) / asyncSeconds << " paths/s through PathfindingManager on "
+              << Hammer::ThreadSystem::Instance().getThreadCount() << " workers" << std::endl;
+
+    BOOST_CHECK_EQUAL(asyncFound, found);
+    BOOST_CHECK_GT(found, pathCount / 2);
+    BOOST_CHECK_GT(static_cast<double>(pathCount) / serialSeconds, 20.0);
+
+}
+
+BOOST_AUTO_TEST_CASE(TestFlowFieldFollowsCheapestRoutes) {
+    NavigationGrid grid(48, 48, 8.0f);
+    blockRandomCells(grid, 0.3f, 300);
+    const uint32_t goal = grid.nearestWalkable(grid.cellIndex(24, 24), 8);
+    BOOST_REQUIRE(goal != NavigationGrid::INVALID_CELL);
+
+    FlowField field;
+    field.build(grid, goal);
+    BOOST_CHECK_EQUAL(field.getGoalCell(), goal);
+    BOOST_CHECK_EQUAL(field.getCost(goal), 0.0f);
+    BOOST_CHECK(field.getTowardCode(goal) == FlowField::NO_DIRECTION);
+
+    // Moves are symmetric, so the cost from the goal is the cost to it
+    std::mt19937 rng(301);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(grid.getCellCount() - 1));
+    for (int sample = 0; sample < 60; ++sample) {
+        const uint32_t cell = pick(rng);
+        if (grid.isBlocked(cell)) {
+            BOOST_CHECK(std::isinf(field.getCost(cell)));
+            continue;
+        }
+        const float expected = referenceCost(grid, goal, cell);
+        if (std::isinf(expected)) {
+            BOOST_CHECK(std::isinf(field.getCost(cell)));
+        } else {
+            BOOST_CHECK_CLOSE(field.getCost(cell), expected, 0.01);
+        }
+    }
+
+    // From every reached cell the toward steps strictly descend to the goal;
+    // every away step climbs
+    size_t reached = 0;
+    for (uint32_t cell = 0; cell < grid.getCellCount(); ++cell) {
+        if (std::isinf(field.getCost(cell))) {
+            BOOST_REQUIRE(field.getTowardCode(cell) == FlowField::NO_DIRECTION);
+            continue;
+        }
+        ++reached;
+        uint32_t at = cell;
+        for (int steps = 0; at != goal; ++steps) {
+            const uint8_t code = field.getTowardCode(at);
+            BOOST_REQUIRE(code != FlowField::NO_DIRECTION);
+            BOOST_REQUIRE_LT(steps, 48 * 48);
+            const uint32_t next = grid.cellIndex(grid.cellX(at) + FlowField::STEP_X[code],
+                                                 grid.cellY(at) + FlowField::STEP_Y[code]);
+            BOOST_REQUIRE(!grid.isBlocked(next));
+            BOOST_REQUIRE_LT(field.getCost(next), field.getCost(at));
+            at = next;
+        }
+
+        const uint8_t away = field.getAwayCode(cell);
+        if (away != FlowField::NO_DIRECTION) {
+            const uint32_t next = grid.cellIndex(grid.cellX(cell) + FlowField::STEP_X[away],
+                                                 grid.cellY(cell) + FlowField::STEP_Y[away]);
+            BOOST_CHECK_GT(field.getCost(next), field.getCost(cell));
+        }
+    }
+    BOOST_CHECK_EQUAL(reached, field.getReachedCellCount());
+
+    // Sampling converts world positions and returns unit steps
+    Vector2D direction;
+    BOOST_CHECK(!field.sampleToward(grid.cellCenter(goal), direction));
+    BOOST_CHECK(!field.sampleToward(Vector2D(-5.0f, 10.0f), direction));
+    for (uint32_t cell = 0; cell < grid.getCellCount(); cell += 37) {
+        if (field.getTowardCode(cell) != FlowField::NO_DIRECTION) {
+            BOOST_REQUIRE(field.sampleToward(grid.cellCenter(cell), direction));
+            BOOST_CHECK_CLOSE(direction.length(), 1.0f, 0.01);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFlowFieldAroundWallAndRadius) {
+    NavigationGrid grid(40, 40, 10.0f);
+    // Wall down x = 20 with a gap at the bottom
+    for (uint32_t y = 0; y < 36; ++y) {
+        grid.setBlocked(grid.cellIndex(20, y), true);
+    }
+
+    FlowField field;
+    field.build(grid, grid.cellIndex(30, 5));
+    // Straight toward the goal would hit the wall; the field heads for the gap
+    Vector2D direction;
+    BOOST_REQUIRE(field.sampleToward(grid.cellCenter(grid.cellIndex(10, 5)), direction));
+    BOOST_CHECK_GT(direction.getY(), 0.0f);
+
+    // Fleeing from the far side of the wall runs away from the gap
+    BOOST_REQUIRE(field.sampleAway(grid.cellCenter(grid.cellIndex(10, 30)), direction));
+    BOOST_CHECK_LT(direction.getY(), 0.0f);
+
+    // A radius leaves far cells unreached; the edge flees outward
+    field.build(grid, grid.cellIndex(30, 5), 6.0f);
+    BOOST_CHECK(std::isinf(field.getCost(grid.cellIndex(30, 20))));
+    BOOST_CHECK_LE(field.getCost(grid.cellIndex(30, 11)), 6.0f);
+    BOOST_CHECK_LT(field.getReachedCellCount(), 200u);
+    BOOST_REQUIRE(field.sampleAway(grid.cellCenter(grid.cellIndex(30, 10)), direction));
+    BOOST_CHECK_GT(direction.getY(), 0.0f);
+    BOOST_CHECK(!field.sampleToward(grid.cellCenter(grid.cellIndex(30, 20)), direction));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestFlowFieldRebuildsOnlyWhenGoalChangesCell, PathfindingFixture) {
+    startWorkers();
+    PathfindingManager& manager = PathfindingManager::Instance();
+    // Starts a build if one is due, waits for it, then pins the result
+    auto settle = [&manager]() {
+        manager.update();
+        drainRequests(manager);
+        manager.update();
+    };
+
+    manager.setGrid(64, 64, 10.0f);
+    manager.update();
+    BOOST_CHECK(manager.getFlowField() == nullptr);
+
+    manager.setFlowFieldGoal(Vector2D(315.0f, 315.0f));
+    settle();
+    const FlowField* field = manager.getFlowField();
+    BOOST_REQUIRE(field != nullptr);
+    BOOST_CHECK_EQUAL(field->getGoalCell(), 31u * 64u + 31u);
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 1u);
+
+    // Moving inside the cell costs nothing
+    for (int frame = 0; frame < 10; ++frame) {
+        manager.setFlowFieldGoal(Vector2D(311.0f + frame * 0.5f, 317.0f));
+        settle();
+    }
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 1u);
+
+    // A new cell or a grid edit rebuilds
+    manager.setFlowFieldGoal(Vector2D(325.0f, 315.0f));
+    settle();
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 2u);
+    BOOST_CHECK_EQUAL(manager.getFlowField()->getGoalCell(), 31u * 64u + 32u);
+    manager.setAreaBlocked(Vector2D(100, 100), Vector2D(150, 150), true);
+    settle();
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 3u);
+    BOOST_CHECK(std::isinf(manager.getFlowField()->getCost(12u * 64u + 12u)));
+
+    // The radius limits the build
+    manager.setFlowFieldRadius(100.0f);
+    settle();
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 4u);
+    BOOST_CHECK_LT(manager.getFlowField()->getReachedCellCount(), 500u);
+
+    manager.clearFlowFieldGoal();
+    BOOST_CHECK(manager.getFlowField() == nullptr);
+    settle();
+    BOOST_CHECK(manager.getFlowField() == nullptr);
+    BOOST_CHECK_EQUAL(manager.getStats().flowFieldBuilds, 4u);
+}
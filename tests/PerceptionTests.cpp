@@ -0,0 +1,262 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE PerceptionTests
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/NavigationGrid.hpp"
+#include "ai/Perception.hpp"
+
+namespace {
+
+// Randomly blocked grid, the same for every run
+NavigationGrid makeRandomGrid(uint32_t width, uint32_t height, float blockedShare, uint32_t seed) {
+    NavigationGrid grid(width, height, 32.0f);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+    for (uint32_t cell = 0; cell < grid.getCellCount(); ++cell) {
+        grid.setBlocked(cell, roll(rng) < blockedShare);
+    }
+    return grid;
+}
+
+Awareness senseOne(const NavigationGrid* grid, const Vector2D& observerPos, const Vector2D& facing,
+                   const PerceptionSettings& settings, const Vector2D& target, uint64_t timeMs = 100,
+                   Awareness previous = Awareness{}) {
+    PerceptionObserver observer{observerPos, facing, &settings};
+    Perception::sense(grid, target, timeMs, std::span<const PerceptionObserver>(&observer, 1),
+                      std::span<Awareness>(&previous, 1));
+    return previous;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(LineOfSightTests)
+
+BOOST_AUTO_TEST_CASE(TestBatchedTracesMatchGrid) {
+    // Straight, diagonal and corner-grazing lines of every length, with
+    // traces of different lengths sharing lanes
+    for (uint32_t seed = 1; seed <= 4; ++seed) {
+        NavigationGrid grid = makeRandomGrid(48, 40, 0.15f * static_cast<float>(seed), seed);
+        std::mt19937 rng(seed * 7919u);
+        std::uniform_int_distribution<uint32_t> pickCell(0, static_cast<uint32_t>(grid.getCellCount() - 1));
+
+        const size_t count = 3001;   // Not a multiple of the lane count
+        std::vector<uint32_t> from(count);
+        std::vector<uint32_t> to(count);
+        for (size_t i = 0; i < count; ++i) {
+            from[i] = pickCell(rng);
+            to[i] = (i % 10 == 0) ? from[i] : pickCell(rng);
+        }
+        std::vector<uint8_t> visible(count, 2);
+        Perception::traceLineOfSight(grid, from.data(), to.data(), count, visible.data());
+
+        size_t mismatches = 0;
+        size_t seen = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t expected = grid.hasLineOfSight(from[i], to[i]) ? 1 : 0;
+            mismatches += (visible[i] != expected) ? 1 : 0;
+            seen += expected;
+        }
+        BOOST_CHECK_EQUAL(mismatches, 0u);
+        BOOST_TEST_MESSAGE("Seed " << seed << ": " << seen << " of " << count << " lines clear");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCornerNeedsBothSidesOpen) {
+    NavigationGrid grid(4, 4, 32.0f);
+    const uint32_t from = grid.cellIndex(0, 0);
+    const uint32_t to = grid.cellIndex(1, 1);
+    uint8_t visible = 0;
+
+    Perception::traceLineOfSight(grid, &from, &to, 1, &visible);
+    BOOST_CHECK_EQUAL(visible, 1);
+
+    grid.setBlocked(grid.cellIndex(1, 0), true);
+    Perception::traceLineOfSight(grid, &from, &to, 1, &visible);
+    BOOST_CHECK_EQUAL(visible, 0);
+    BOOST_CHECK(!grid.hasLineOfSight(from, to));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(AwarenessTests)
+
+BOOST_AUTO_TEST_CASE(TestRangeAndViewCone) {
+    PerceptionSettings settings;
+    settings.range = 200.0f;
+    settings.fieldOfView = 90.0f;
+    settings.requireLineOfSight = false;
+    const Vector2D observer(500.0f, 500.0f);
+    const Vector2D east(1.0f, 0.0f);
+
+    // Ahead and within 45 degrees of the facing
+    Awareness ahead = senseOne(nullptr, observer, east, settings, Vector2D(600.0f, 560.0f));
+    BOOST_CHECK(ahead.inRange());
+    BOOST_CHECK(ahead.inView());
+    BOOST_CHECK(ahead.canSee());
+    BOOST_CHECK_CLOSE(ahead.distance, std::sqrt(100.0f * 100.0f + 60.0f * 60.0f), 0.01f);
+
+    // Outside the cone: in range but unseen
+    Awareness beside = senseOne(nullptr, observer, east, settings, Vector2D(540.0f, 620.0f));
+    BOOST_CHECK(beside.inRange());
+    BOOST_CHECK(!beside.inView());
+    BOOST_CHECK(!beside.canSee());
+
+    Awareness behind = senseOne(nullptr, observer, east, settings, Vector2D(400.0f, 500.0f));
+    BOOST_CHECK(behind.inRange());
+    BOOST_CHECK(!behind.inView());
+
+    // Out of range straight ahead
+    Awareness far = senseOne(nullptr, observer, east, settings, Vector2D(750.0f, 500.0f));
+    BOOST_CHECK(!far.inRange());
+    BOOST_CHECK(!far.canSee());
+
+    // A full circle sees behind too
+    settings.fieldOfView = 360.0f;
+    BOOST_CHECK(senseOne(nullptr, observer, east, settings, Vector2D(400.0f, 500.0f)).canSee());
+
+    // Turning toward the target brings it into view
+    settings.fieldOfView = 90.0f;
+    BOOST_CHECK(senseOne(nullptr, observer, Vector2D(-1.0f, 0.0f), settings, Vector2D(400.0f, 500.0f)).canSee());
+}
+
+BOOST_AUTO_TEST_CASE(TestWallsHideTarget) {
+    // A wall down column 5 of an open grid
+    NavigationGrid grid(12, 12, 32.0f);
+    for (uint32_t y = 0; y < 12; ++y) {
+        grid.setBlocked(grid.cellIndex(5, y), true);
+    }
+    PerceptionSettings settings;
+    settings.range = 1000.0f;
+    const Vector2D observer = grid.cellCenter(grid.cellIndex(2, 6));
+    const Vector2D hidden = grid.cellCenter(grid.cellIndex(9, 6));
+    const Vector2D open = grid.cellCenter(grid.cellIndex(2, 1));
+    const Vector2D east(1.0f, 0.0f);
+
+    Awareness behindWall = senseOne(&grid, observer, east, settings, hidden);
+    BOOST_CHECK(behindWall.inView());
+    BOOST_CHECK(!behindWall.canSee());
+    BOOST_CHECK(!behindWall.hasSeen());
+
+    BOOST_CHECK(senseOne(&grid, observer, east, settings, open).canSee());
+
+    // Behaviors that sense by range alone ignore the wall
+    settings.requireLineOfSight = false;
+    BOOST_CHECK(senseOne(&grid, observer, east, settings, hidden).canSee());
+
+    // So does an observer off the grid, and every observer without one
+    settings.requireLineOfSight = true;
+    BOOST_CHECK(senseOne(&grid, Vector2D(-50.0f, 200.0f), east, settings, hidden).canSee());
+    BOOST_CHECK(senseOne(nullptr, observer, east, settings, hidden).canSee());
+}
+
+BOOST_AUTO_TEST_CASE(TestLastSightingIsKept) {
+    PerceptionSettings settings;
+    settings.range = 300.0f;
+    settings.requireLineOfSight = false;
+    const Vector2D observer(0.0f, 0.0f);
+    const Vector2D east(1.0f, 0.0f);
+
+    Awareness awareness = senseOne(nullptr, observer, east, settings, Vector2D(100.0f, 0.0f), 250);
+    BOOST_REQUIRE(awareness.canSee());
+    BOOST_CHECK(awareness.hasSeen());
+    BOOST_CHECK_EQUAL(awareness.lastSeenMs, 250u);
+
+    // Target walks out of range: the sighting stays, the flags go
+    awareness = senseOne(nullptr, observer, east, settings, Vector2D(900.0f, 0.0f), 400, awareness);
+    BOOST_CHECK(!awareness.inRange());
+    BOOST_CHECK(awareness.hasSeen());
+    BOOST_CHECK_EQUAL(awareness.lastSeenMs, 250u);
+    BOOST_CHECK_CLOSE(awareness.lastSeenPosition.getX(), 100.0f, 0.01f);
+
+    awareness = senseOne(nullptr, observer, east, settings, Vector2D(50.0f, 0.0f), 500, awareness);
+    Perception::loseTarget(std::span<Awareness>(&awareness, 1));
+    BOOST_CHECK(!awareness.inRange());
+    BOOST_CHECK(!awareness.canSee());
+    BOOST_CHECK(awareness.hasSeen());
+    BOOST_CHECK_EQUAL(awareness.lastSeenMs, 500u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(PerceptionThroughputTests)
+
+BOOST_AUTO_TEST_CASE(TestBatchedSenseThroughput) {
+    // Guards spread over a walled map, all watching for one player; the
+    // per-entity version is what GuardBehavior did in executeLogic()
+    NavigationGrid grid = makeRandomGrid(128, 128, 0.03f, 42);
+    const size_t guardCount = 10000;
+    const Vector2D player = grid.cellCenter(grid.cellIndex(64, 64));
+    PerceptionSettings settings;
+    settings.range = 1200.0f;
+    settings.fieldOfView = 120.0f;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(0.0f, 128.0f * 32.0f);
+    std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+    std::vector<PerceptionObserver> observers(guardCount);
+    for (PerceptionObserver& observer : observers) {
+        const float heading = angle(rng);
+        observer.position = Vector2D(coordinate(rng), coordinate(rng));
+        observer.facing = Vector2D(std::cos(heading), std::sin(heading));
+        observer.settings = &settings;
+    }
+
+    const int frames = 20;
+    std::vector<Awareness> awareness(guardCount);
+    auto batchedStart = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        Perception::sense(&grid, player, static_cast<uint64_t>(frame + 1), observers, awareness);
+    }
+    const double batchedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - batchedStart).count() / frames;
+
+    std::vector<uint8_t> scalarVisible(guardCount);
+    const float halfView = settings.fieldOfView * 0.5f * 3.14159265f / 180.0f;
+    const uint32_t playerCell = grid.cellAt(player);
+    auto scalarStart = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < guardCount; ++i) {
+            const Vector2D toPlayer = player - observers[i].position;
+            bool sees = toPlayer.length() <= settings.range;
+            if (sees) {
+                float diff = std::atan2(toPlayer.getY(), toPlayer.getX()) -
+                             std::atan2(observers[i].facing.getY(), observers[i].facing.getX());
+                diff = std::remainder(diff, 2.0f * 3.14159265f);
+                sees = std::abs(diff) <= halfView;
+            }
+            if (sees) {
+                sees = grid.hasLineOfSight(grid.cellAt(observers[i].position), playerCell);
+            }
+            scalarVisible[i] = sees ? 1 : 0;
+        }
+    }
+    const double scalarMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - scalarStart).count() / frames;
+
+    // Cone edges may round differently between the two; everything else agrees
+    size_t disagreements = 0;
+    size_t visible = 0;
+    for (size_t i = 0; i < guardCount; ++i) {
+        disagreements += (awareness[i].canSee() != (scalarVisible[i] != 0)) ? 1 : 0;
+        visible += awareness[i].canSee() ? 1 : 0;
+    }
+    BOOST_CHECK_LE(disagreements, guardCount / 1000);
+    BOOST_CHECK_GT(visible, 0u);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Perception for " << guardCount << " guards: batched " << batchedMs
+              << "ms/frame, per entity " << scalarMs << "ms/frame, " << visible << " see the player\n";
+}
+
+BOOST_AUTO_TEST_SUITE_END()
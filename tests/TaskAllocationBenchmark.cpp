@@ -0,0 +1,249 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE TaskAllocationBenchmark
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "core/ThreadSystem.hpp"
+
+// GCC flags free() on memory from the replaced operator new once both are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count heap allocations made by the current thread. Each thread only ever
+// reads its own counter, so worker-side allocations never pollute a
+// measurement taken on the submitting thread (and vice versa).
+namespace {
+    thread_local size_t t_allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++t_allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    ++t_allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+// Mirrors the task node the job system used before Hammer::Task
+struct LegacyPrioritizedTask {
+    std::function<void()> task;
+    Hammer::TaskPriority priority;
+    std::chrono::steady_clock::time_point enqueueTime;
+    std::string description;
+
+    LegacyPrioritizedTask(std::function<void()> t, Hammer::TaskPriority p, std::string desc)
+        : task(std::move(t)), priority(p),
+          enqueueTime(std::chrono::steady_clock::now()), description(std::move(desc)) {}
+};
+
+// Same capture layout as AIManager's batch lambda: this, start, end, deltaTime, buffer
+struct BatchOwner {
+    std::atomic<size_t> processed{0};
+    void processBatch(size_t start, size_t end, float deltaTime, int buffer) {
+        (void)deltaTime; (void)buffer;
+        processed.fetch_add(end - start, std::memory_order_relaxed);
+    }
+};
+
+constexpr size_t TASKS_PER_ROUND = 256; // Well below one priority ring
+constexpr int MEASURED_ROUNDS = 8;
+const std::string LONG_DESCRIPTION = "AIManager_OptimalBatch_Description";
+
+void printResult(const std::string& label, size_t allocations, size_t tasks) {
+    std::cout << std::left << std::setw(44) << label
+              << std::fixed << std::setprecision(3)
+              << static_cast<double>(allocations) / static_cast<double>(tasks)
+              << " allocations/enqueue" << std::endl;
+}
+
+template<typename Predicate>
+void waitUntil(Predicate&& done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+struct ThreadSystemFixture {
+    ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4);
+    }
+    ~ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().clean();
+    }
+};
+
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSystemFixture);
+
+BOOST_AUTO_TEST_CASE(LegacyStdFunctionBaseline) {
+    BatchOwner owner;
+    float deltaTime = 0.016f;
+    int nextBuffer = 1;
+
+    size_t before = t_allocationCount;
+    for (size_t i = 0; i < TASKS_PER_ROUND; ++i) {
+        size_t start = i * 32;
+        size_t end = start + 32;
+        // Old submit path: std::function wraps the lambda, the description is
+        // copied into a std::string, and worker-local tasks got a new node
+        auto* node = new LegacyPrioritizedTask([&owner, start, end, deltaTime, nextBuffer]() {
+            owner.processBatch(start, end, deltaTime, nextBuffer);
+        }, Hammer::TaskPriority::High, LONG_DESCRIPTION);
+        node->task();
+        delete node;
+    }
+    size_t allocations = t_allocationCount - before;
+
+    printResult("std::function + std::string + node (before)", allocations, TASKS_PER_ROUND);
+    BOOST_CHECK_GE(allocations, TASKS_PER_ROUND * 2);
+}
+
+BOOST_AUTO_TEST_CASE(TaskInlineStorage) {
+    BatchOwner owner;
+    float deltaTime = 0.016f;
+    int nextBuffer = 1;
+
+    size_t before = t_allocationCount;
+    Hammer::Task task([&owner, deltaTime, nextBuffer]() {
+        owner.processBatch(0, 64, deltaTime, nextBuffer);
+    });
+    Hammer::Task moved(std::move(task));
+    moved();
+    BOOST_CHECK_EQUAL(t_allocationCount - before, 0);
+    BOOST_CHECK(moved.isInline());
+    BOOST_CHECK(!task);
+    BOOST_CHECK_EQUAL(owner.processed.load(), 64);
+
+    // Captures larger than the inline buffer fall back to one heap allocation
+    std::array<char, Hammer::Task::INLINE_CAPACITY * 2> large{};
+    large[0] = 7;
+    int observed = 0;
+    before = t_allocationCount;
+    Hammer::Task largeTask([large, &observed]() { observed = large[0]; });
+    BOOST_CHECK_EQUAL(t_allocationCount - before, 1);
+    BOOST_CHECK(!largeTask.isInline());
+    Hammer::Task largeMoved(std::move(largeTask));
+    largeMoved();
+    BOOST_CHECK_EQUAL(observed, 7);
+
+    // Runtime descriptions are interned once and then reused without allocating
+    const char* first = Hammer::internTaskDescription(LONG_DESCRIPTION);
+    before = t_allocationCount;
+    const char* second = Hammer::internTaskDescription(LONG_DESCRIPTION);
+    BOOST_CHECK_EQUAL(t_allocationCount - before, 0);
+    BOOST_CHECK_EQUAL(first, second);
+}
+
+BOOST_AUTO_TEST_CASE(ExternalEnqueueAllocations) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    BatchOwner owner;
+    float deltaTime = 0.016f;
+    int nextBuffer = 1;
+    size_t expected = 0;
+
+    auto submitRound = [&]() {
+        for (size_t i = 0; i < TASKS_PER_ROUND; ++i) {
+            size_t start = i * 32;
+            size_t end = start + 32;
+            threadSystem.enqueueTask([&owner, start, end, deltaTime, nextBuffer]() {
+                owner.processBatch(start, end, deltaTime, nextBuffer);
+            }, Hammer::TaskPriority::High, LONG_DESCRIPTION);
+        }
+        expected += TASKS_PER_ROUND * 32;
+        waitUntil([&]() { return owner.processed.load() >= expected; });
+    };
+
+    submitRound(); // Warm-up (interns the description)
+
+    size_t allocations = 0;
+    for (int round = 0; round < MEASURED_ROUNDS; ++round) {
+        size_t before = t_allocationCount;
+        submitRound();
+        allocations += t_allocationCount - before;
+    }
+
+    printResult("Hammer::Task, global queue (after)", allocations, TASKS_PER_ROUND * MEASURED_ROUNDS);
+    BOOST_CHECK_EQUAL(owner.processed.load(), expected);
+    BOOST_CHECK_EQUAL(allocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(WorkerLocalEnqueueAllocations) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    BatchOwner owner;
+    std::atomic<size_t> measuredAllocations{0};
+    std::atomic<bool> parentDone{false};
+    float deltaTime = 0.016f;
+    int nextBuffer = 1;
+
+    // Half the pre-filled node pool, so stolen-but-not-yet-returned nodes
+    // never force the pool to grow
+    constexpr size_t LOCAL_TASKS_PER_ROUND = Hammer::ThreadPool::LOCAL_NODE_PREALLOC / 2;
+
+    // A single parent task submits from inside a worker so every child goes
+    // through that worker's deque and node pool
+    threadSystem.enqueueTask([&]() {
+        size_t expected = 0;
+        auto submitRound = [&]() {
+            for (size_t i = 0; i < LOCAL_TASKS_PER_ROUND; ++i) {
+                size_t start = i * 32;
+                size_t end = start + 32;
+                threadSystem.enqueueTask([&owner, start, end, deltaTime, nextBuffer]() {
+                    owner.processBatch(start, end, deltaTime, nextBuffer);
+                }, Hammer::TaskPriority::High, "AI_OptimalBatch");
+            }
+            expected += LOCAL_TASKS_PER_ROUND * 32;
+            // Other workers steal the children while this one waits
+            waitUntil([&]() { return owner.processed.load() >= expected; });
+        };
+
+        submitRound(); // Warm-up grows the node pool
+
+        size_t allocations = 0;
+        for (int round = 0; round < MEASURED_ROUNDS; ++round) {
+            size_t before = t_allocationCount;
+            submitRound();
+            allocations += t_allocationCount - before;
+        }
+        measuredAllocations.store(allocations);
+        parentDone.store(true);
+    }, Hammer::TaskPriority::Normal, "AllocationBenchmarkParent");
+
+    waitUntil([&]() { return parentDone.load(); });
+    BOOST_REQUIRE(parentDone.load());
+
+    printResult("Hammer::Task, worker-local deque (after)", measuredAllocations.load(),
+                LOCAL_TASKS_PER_ROUND * MEASURED_ROUNDS);
+    BOOST_CHECK_EQUAL(measuredAllocations.load(), 0);
+}
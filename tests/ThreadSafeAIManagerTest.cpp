@@ -25,10 +25,19 @@
 #include <string>
 #include <functional>
 #include <mutex>
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
 
 #include "managers/AIManager.hpp"
 #include "core/ThreadSystem.hpp"
 #include "entities/Entity.hpp"
+#include "ai/behaviors/GuardBehavior.hpp"
+#include "ai/behaviors/IdleBehavior.hpp"
+#include "ai/behaviors/WanderBehavior.hpp"
 
 // Simple test entity
 class TestEntity : public Entity {
@@ -176,6 +185,245 @@ public: // Make these public for test access
 // Define static member
 std::atomic<int> ThreadTestBehavior::s_sharedMessageCount{0};
 
+// Shared behavior that records the runs AIManager hands to executeBatch()
+class BatchRecordingBehavior : public AIBehavior {
+public:
+    void executeLogic(EntityPtr /* entity */) override {
+        m_singleCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void executeBatch(std::span<const EntityPtr> entities, const FrameContext& context) override {
+        m_batchCalls.fetch_add(1, std::memory_order_relaxed);
+        m_batchedEntities.fetch_add(static_cast<int>(entities.size()), std::memory_order_relaxed);
+        if (context.deltaTime <= 0.0f || context.entityDeltaTimes.size() != entities.size()) {
+            m_badContexts.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "BatchRecording"; }
+    bool isShared() const override { return true; }
+    std::shared_ptr<AIBehavior> clone() const override { return std::make_shared<BatchRecordingBehavior>(); }
+
+    std::atomic<int> m_singleCalls{0};
+    std::atomic<int> m_batchCalls{0};
+    std::atomic<int> m_batchedEntities{0};
+    std::atomic<int> m_badContexts{0};
+};
+
+// Cloned behavior relying on the default executeBatch() fallback
+class SingleEntityBehavior : public AIBehavior {
+public:
+    explicit SingleEntityBehavior(std::shared_ptr<std::atomic<int>> calls) : m_calls(std::move(calls)) {}
+
+    void executeLogic(EntityPtr /* entity */) override {
+        m_calls->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "SingleEntity"; }
+    std::shared_ptr<AIBehavior> clone() const override { return std::make_shared<SingleEntityBehavior>(m_calls); }
+
+private:
+    std::shared_ptr<std::atomic<int>> m_calls;
+};
+
+// Shared behavior using the default executeBatch(), which hands each entity
+// the frame's context; tracks the range of clock values seen in a frame
+class ClockProbeBehavior : public AIBehavior {
+public:
+    void executeLogic(EntityPtr /* entity */) override {
+        m_legacyCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void executeLogic(EntityPtr /* entity */, const FrameContext& context) override {
+        m_calls.fetch_add(1, std::memory_order_relaxed);
+        uint64_t seen = m_minTimeMs.load(std::memory_order_relaxed);
+        while (context.timeMs < seen && !m_minTimeMs.compare_exchange_weak(seen, context.timeMs)) {}
+        seen = m_maxTimeMs.load(std::memory_order_relaxed);
+        while (context.timeMs > seen && !m_maxTimeMs.compare_exchange_weak(seen, context.timeMs)) {}
+        if (context.player.valid != m_expectPlayer.load(std::memory_order_relaxed) ||
+            (context.player.valid && (context.player.position - m_expectedPlayerPos).length() > 0.0f) ||
+            !context.entityDeltaTimes.empty() || context.deltaTime <= 0.0f) {
+            m_badContexts.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void resetFrame() {
+        m_minTimeMs.store(std::numeric_limits<uint64_t>::max());
+        m_maxTimeMs.store(0);
+    }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "ClockProbe"; }
+    bool isShared() const override { return true; }
+    std::shared_ptr<AIBehavior> clone() const override { return std::make_shared<ClockProbeBehavior>(); }
+
+    std::atomic<int> m_calls{0};
+    std::atomic<int> m_legacyCalls{0};
+    std::atomic<int> m_badContexts{0};
+    std::atomic<uint64_t> m_minTimeMs{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> m_maxTimeMs{0};
+    std::atomic<bool> m_expectPlayer{false};
+    Vector2D m_expectedPlayerPos{0.0f, 0.0f};   // Set between frames only
+};
+
+// Keeps the clock of the last context update it received
+class ClockedEntity : public Entity {
+public:
+    explicit ClockedEntity(const Vector2D& pos) { setPosition(pos); }
+
+    void update(float /* deltaTime */) override { ++floatUpdates; }
+    void update(const FrameContext& context) override { lastTimeMs = context.timeMs; }
+
+    void render() override {}
+    void clean() override {}
+
+    uint64_t lastTimeMs{0};
+    int floatUpdates{0};
+};
+
+// Records the deltaTime of every update it receives; each entity is only
+// updated by one worker per frame
+class ScheduledEntity : public Entity {
+public:
+    explicit ScheduledEntity(const Vector2D& pos) { setPosition(pos); }
+
+    void update(float deltaTime) override {
+        ++updates;
+        elapsed += deltaTime;
+    }
+
+    void render() override {}
+    void clean() override {}
+
+    int updates{0};
+    double elapsed{0.0};
+};
+
+// Steps one unit along x per update
+class SteppingEntity : public Entity {
+public:
+    explicit SteppingEntity(const Vector2D& pos) { setPosition(pos); }
+    void update(float /* deltaTime */) override { setPosition(getPosition() + Vector2D(1.0f, 0.0f)); }
+    void render() override {}
+    void clean() override {}
+};
+
+// Moves by its velocity each update, the way NPCs do
+class DriftingEntity : public Entity {
+public:
+    explicit DriftingEntity(const Vector2D& pos) { setPosition(pos); }
+    void update(float deltaTime) override { setPosition(getPosition() + getVelocity() * deltaTime); }
+    void render() override {}
+    void clean() override {}
+};
+
+// Shared behavior that wants its entities to stand still every frame
+class HoldPositionBehavior : public AIBehavior {
+public:
+    void executeLogic(EntityPtr entity) override {
+        entity->setVelocity(Vector2D(0.0f, 0.0f));
+    }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "HoldPosition"; }
+    bool isShared() const override { return true; }
+    std::shared_ptr<AIBehavior> clone() const override { return std::make_shared<HoldPositionBehavior>(); }
+};
+
+// Shared behavior that only accepts one message id and checks each entity's
+// messages arrive before its own update in the same frame
+class InboxBehavior : public AIBehavior {
+public:
+    static constexpr AIMessageId PING = aiMessageId("inbox_ping");
+    static constexpr AIMessageId SCOPED_PING = aiMessageId("inbox_scoped_ping");
+
+    struct Tracker {
+        std::atomic<int> direct{0};
+        std::atomic<int> broadcast{0};
+        std::atomic<int> scoped{0};
+        std::atomic<int> pending{0};
+        std::atomic<int> badPayloads{0};
+    };
+
+    explicit InboxBehavior(size_t handleCount) : m_trackers(handleCount) {}
+
+    void executeLogic(EntityPtr entity) override {
+        if (m_trackers[entity->getHandle().index].pending.exchange(0, std::memory_order_relaxed) > 0) {
+            m_deliveredBeforeUpdate.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void onMessage(EntityPtr entity, const AIMessage& message) override {
+        if (message.id == SCOPED_PING) {
+            m_trackers[entity->getHandle().index].scoped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (message.id != PING) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Tracker& tracker = m_trackers[entity->getHandle().index];
+        if (message.sender.isValid()) {
+            tracker.direct.fetch_add(1, std::memory_order_relaxed);
+            // Direct pings carry the recipient's handle index
+            if (message.value != static_cast<float>(entity->getHandle().index)) {
+                tracker.badPayloads.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            tracker.broadcast.fetch_add(1, std::memory_order_relaxed);
+        }
+        tracker.pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool acceptsMessage(AIMessageId id) const override { return id == PING || id == SCOPED_PING; }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "Inbox"; }
+    bool isShared() const override { return true; }
+    std::shared_ptr<AIBehavior> clone() const override {
+        return std::make_shared<InboxBehavior>(m_trackers.size());
+    }
+
+    std::vector<Tracker> m_trackers;
+    std::atomic<int> m_deliveredBeforeUpdate{0};
+    std::atomic<int> m_rejected{0};
+};
+
+// Shared behavior that sends its own entity an immediate message from
+// executeLogic(), which runs with the execution lock held
+class ImmediateSenderBehavior : public AIBehavior {
+public:
+    static constexpr AIMessageId POKE = aiMessageId("immediate_poke");
+
+    void executeLogic(EntityPtr entity) override {
+        if (m_sending.load(std::memory_order_relaxed)) {
+            AIManager::Instance().sendMessageToEntity(entity, AIMessage(POKE), true);
+        }
+    }
+
+    void onMessage(EntityPtr /* entity */, const AIMessage& message) override {
+        if (message.id == POKE) {
+            m_received.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void init(EntityPtr /* entity */) override {}
+    void clean(EntityPtr /* entity */) override {}
+    std::string getName() const override { return "ImmediateSender"; }
+    bool isShared() const override { return true; }
+    std::shared_ptr<AIBehavior> clone() const override { return std::make_shared<ImmediateSenderBehavior>(); }
+
+    std::atomic<bool> m_sending{true};
+    std::atomic<int> m_received{0};
+};
+
 // Global state for ensuring proper initialization/cleanup
 namespace {
     // Remove unused mutex variable
@@ -895,6 +1143,786 @@ BOOST_FIXTURE_TEST_CASE(TestConcurrentBehaviorProcessing, ThreadedAITestFixture)
     std::cout << "TestConcurrentBehaviorProcessing completed" << std::endl;
 }
 
+// Entities are bucketed by BehaviorType so shared behaviors get whole runs
+BOOST_FIXTURE_TEST_CASE(TestBatchedExecutionByBehaviorType, ThreadedAITestFixture) {
+    std::cout << "Starting TestBatchedExecutionByBehaviorType..." << std::endl;
+    const int NUM_PER_BEHAVIOR = 600; // Both together cross the threading threshold
+    const int NUM_UPDATES = 10;
+
+    auto batched = std::make_shared<BatchRecordingBehavior>();
+    auto singleCalls = std::make_shared<std::atomic<int>>(0);
+    auto single = std::make_shared<SingleEntityBehavior>(singleCalls);
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(batched);
+        g_allBehaviors.push_back(single);
+    }
+    // Names that map to distinct BehaviorTypes
+    AIManager::Instance().registerBehavior("Wander", batched);
+    AIManager::Instance().registerBehavior("Idle", single);
+
+    // Interleave the two behaviors in slot order
+    std::vector<std::shared_ptr<TestEntity>> entities;
+    for (int i = 0; i < NUM_PER_BEHAVIOR * 2; ++i) {
+        auto entity = std::make_shared<TestEntity>(Vector2D(i * 2.0f, 0.0f));
+        entities.push_back(entity);
+        AIManager::Instance().assignBehaviorToEntity(entity, (i % 2 == 0) ? "Wander" : "Idle");
+    }
+
+    for (int i = 0; i < NUM_UPDATES; ++i) {
+        AIManager::Instance().update(0.016f);
+    }
+
+    // Every entity ran once per frame through its behavior's entry point
+    BOOST_CHECK_EQUAL(batched->m_batchedEntities.load(), NUM_PER_BEHAVIOR * NUM_UPDATES);
+    BOOST_CHECK_EQUAL(batched->m_singleCalls.load(), 0);
+    BOOST_CHECK_EQUAL(batched->m_badContexts.load(), 0);
+    BOOST_CHECK_EQUAL(singleCalls->load(), NUM_PER_BEHAVIOR * NUM_UPDATES);
+
+    // Without grouping every run would hold one entity
+    double averageRun = static_cast<double>(batched->m_batchedEntities.load()) /
+                        std::max(1, batched->m_batchCalls.load());
+    std::cout << "Average executeBatch run: " << averageRun << " entities" << std::endl;
+    BOOST_CHECK_GT(averageRun, 32.0);
+
+    for (auto& entity : entities) {
+        AIManager::Instance().unassignBehaviorFromEntity(entity);
+    }
+    AIManager::Instance().resetBehaviors();
+
+    std::cout << "TestBatchedExecutionByBehaviorType completed" << std::endl;
+}
+
+// Distance tiers update at their own intervals, staggered across frames, and
+// skipped frames arrive as accumulated deltaTime
+BOOST_FIXTURE_TEST_CASE(TestDistanceTieredUpdateSchedule, ThreadedAITestFixture) {
+    std::cout << "Starting TestDistanceTieredUpdateSchedule..." << std::endl;
+    const int NUM_PER_TIER = 512;          // Due updates per frame cross the threading threshold
+    const int WARMUP_FRAMES = 32;          // Distances refresh and every tier settles into its phase
+    const int MEASURED_FRAMES = 64;        // A multiple of every interval
+    const float DELTA_TIME = 0.01f;
+    const std::array<float, 4> TIER_DISTANCES{500.0f, 1500.0f, 2500.0f, 5000.0f};
+    const std::array<int, 4> TIER_INTERVALS{1, 2, 4, 16};
+
+    AIManager& aiManager = AIManager::Instance();
+
+    // Intervals round up to powers of two and clamp to the supported range
+    aiManager.setUpdateSchedule(AIManager::AI_MAX_PRIORITY, AIUpdateSchedule{0, 3, 5, 1000});
+    AIUpdateSchedule rounded = aiManager.getUpdateSchedule(AIManager::AI_MAX_PRIORITY);
+    BOOST_CHECK_EQUAL(rounded.nearInterval, 1u);
+    BOOST_CHECK_EQUAL(rounded.midInterval, 4u);
+    BOOST_CHECK_EQUAL(rounded.farInterval, 8u);
+    BOOST_CHECK_EQUAL(rounded.distantInterval, AIManager::MAX_UPDATE_INTERVAL);
+    aiManager.setUpdateSchedule(AIManager::AI_MAX_PRIORITY, AIUpdateSchedule{});
+
+    auto batched = std::make_shared<BatchRecordingBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(batched);
+    }
+    aiManager.registerBehavior("Wander", batched);
+
+    // Priority 0 has a range multiplier of 1, so tier bounds are the distances as set
+    auto player = std::make_shared<ScheduledEntity>(Vector2D(0.0f, 0.0f));
+    aiManager.setPlayerForDistanceOptimization(player);
+    aiManager.setUpdateDistances(1000.0f, 2000.0f, 3000.0f);
+    aiManager.setUpdateSchedule(0, AIUpdateSchedule{1, 2, 4, 16});
+
+    std::vector<std::shared_ptr<ScheduledEntity>> entities;
+    for (size_t tier = 0; tier < TIER_DISTANCES.size(); ++tier) {
+        for (int i = 0; i < NUM_PER_TIER; ++i) {
+            auto entity = std::make_shared<ScheduledEntity>(Vector2D(TIER_DISTANCES[tier], static_cast<float>(i)));
+            entities.push_back(entity);
+            aiManager.registerEntityForUpdates(entity, 0, "Wander");
+        }
+    }
+
+    for (int frame = 0; frame < WARMUP_FRAMES; ++frame) {
+        aiManager.update(DELTA_TIME);
+    }
+    for (auto& entity : entities) {
+        entity->updates = 0;
+        entity->elapsed = 0.0;
+    }
+
+    AIPerformanceStats before = aiManager.getPerformanceStats();
+    uint64_t minFrameUpdates = std::numeric_limits<uint64_t>::max();
+    uint64_t maxFrameUpdates = 0;
+    for (int frame = 0; frame < MEASURED_FRAMES; ++frame) {
+        aiManager.update(DELTA_TIME);
+        uint64_t frameUpdates = aiManager.getPerformanceStats().lastFrameUpdates;
+        minFrameUpdates = std::min(minFrameUpdates, frameUpdates);
+        maxFrameUpdates = std::max(maxFrameUpdates, frameUpdates);
+    }
+    AIPerformanceStats after = aiManager.getPerformanceStats();
+
+    // Each tier updates once per interval and receives the time of every
+    // frame in between, so all entities see the same total time
+    int wrongCounts = 0;
+    int wrongElapsed = 0;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const int expected = MEASURED_FRAMES / TIER_INTERVALS[i / NUM_PER_TIER];
+        wrongCounts += (entities[i]->updates != expected) ? 1 : 0;
+        wrongElapsed += (std::abs(entities[i]->elapsed - MEASURED_FRAMES * DELTA_TIME) > 1e-3) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(wrongCounts, 0);
+    BOOST_CHECK_EQUAL(wrongElapsed, 0);
+    BOOST_CHECK_EQUAL(batched->m_badContexts.load(), 0);
+
+    // Effective updates/frame: 512 * (1 + 1/2 + 1/4 + 1/16)
+    const double expectedPerFrame = NUM_PER_TIER * (1.0 + 0.5 + 0.25 + 0.0625);
+    const uint64_t measuredFrames = after.frameCount - before.frameCount;
+    BOOST_REQUIRE_EQUAL(measuredFrames, static_cast<uint64_t>(MEASURED_FRAMES));
+    BOOST_CHECK_CLOSE(static_cast<double>(after.scheduledUpdates - before.scheduledUpdates) / measuredFrames,
+                      expectedPerFrame, 0.01);
+    BOOST_CHECK_EQUAL(after.lastFrameEntities, entities.size());
+
+    // Staggering keeps the per-frame load flat instead of spiking when a slow tier comes due
+    std::cout << "Updates/frame: " << expectedPerFrame << " expected, " << minFrameUpdates << "-"
+              << maxFrameUpdates << " measured" << std::endl;
+    BOOST_CHECK_LT(static_cast<double>(maxFrameUpdates), expectedPerFrame * 1.25);
+    BOOST_CHECK_GT(static_cast<double>(minFrameUpdates), expectedPerFrame * 0.75);
+
+    aiManager.setPlayerForDistanceOptimization(nullptr);
+    aiManager.setUpdateDistances(4000.0f, 6000.0f, 10000.0f);
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestDistanceTieredUpdateSchedule completed" << std::endl;
+}
+
+// Every behavior and entity in a frame reads the same clock and player,
+// however the frame is split across workers
+BOOST_FIXTURE_TEST_CASE(TestFrameContextClockAndPlayer, ThreadedAITestFixture) {
+    std::cout << "Starting TestFrameContextClockAndPlayer..." << std::endl;
+    const int NUM_ENTITIES = 1500;
+    const int NUM_FRAMES = 40;
+    const float DELTA_TIME = 0.016f;
+
+    AIManager& aiManager = AIManager::Instance();
+    auto probe = std::make_shared<ClockProbeBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(probe);
+    }
+    aiManager.registerBehavior("Wander", probe);
+
+    std::vector<std::shared_ptr<ClockedEntity>> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        auto entity = std::make_shared<ClockedEntity>(Vector2D(i * 2.0f, 0.0f));
+        entities.push_back(entity);
+        aiManager.assignBehaviorToEntity(entity, "Wander");
+    }
+    auto player = std::make_shared<ScheduledEntity>(Vector2D(123.0f, 456.0f));
+
+    int clockMismatches = 0;
+    int wrongEntityTime = 0;
+    int badSteps = 0;
+    uint64_t previousTimeMs = aiManager.getFrameTimeMs();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        // Second half runs with a player; the snapshot carries its position
+        if (frame == NUM_FRAMES / 2) {
+            aiManager.setPlayerForDistanceOptimization(player);
+            probe->m_expectedPlayerPos = player->getPosition();
+            probe->m_expectPlayer.store(true);
+        }
+        probe->resetFrame();
+        aiManager.update(DELTA_TIME);
+
+        const uint64_t frameTimeMs = aiManager.getFrameTimeMs();
+        if (probe->m_minTimeMs.load() != frameTimeMs || probe->m_maxTimeMs.load() != frameTimeMs) {
+            ++clockMismatches;
+        }
+        for (const auto& entity : entities) {
+            wrongEntityTime += (entity->lastTimeMs != frameTimeMs) ? 1 : 0;
+        }
+        // Whole milliseconds of an accumulated float clock: 15-17 per frame
+        if (frameTimeMs - previousTimeMs < 15 || frameTimeMs - previousTimeMs > 17) {
+            ++badSteps;
+        }
+        previousTimeMs = frameTimeMs;
+    }
+
+    int floatUpdates = 0;
+    for (const auto& entity : entities) {
+        floatUpdates += entity->floatUpdates;
+    }
+    BOOST_CHECK_EQUAL(probe->m_calls.load(), NUM_ENTITIES * NUM_FRAMES);
+    BOOST_CHECK_EQUAL(probe->m_legacyCalls.load(), 0);
+    BOOST_CHECK_EQUAL(probe->m_badContexts.load(), 0);
+    BOOST_CHECK_EQUAL(clockMismatches, 0);
+    BOOST_CHECK_EQUAL(badSteps, 0);
+    BOOST_CHECK_EQUAL(wrongEntityTime, 0);
+    BOOST_CHECK_EQUAL(floatUpdates, 0);
+
+    aiManager.setPlayerForDistanceOptimization(nullptr);
+    for (auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestFrameContextClockAndPlayer completed" << std::endl;
+}
+
+namespace {
+
+// Runs the same world from the same start and returns where every entity
+// ended up. Behavior randomness comes from AIRandom, so the result depends on
+// the seed but not on how many workers ran the batches.
+std::vector<Vector2D> runSeededWorld(const std::vector<std::shared_ptr<DriftingEntity>>& entities,
+                                     uint64_t seed, bool threaded, int frames) {
+    AIManager& aiManager = AIManager::Instance();
+
+    // A fresh clock and frame counter, so both runs key AIRandom identically
+    aiManager.clean();
+    BOOST_REQUIRE(aiManager.init());
+    aiManager.setGlobalPause(false);   // clean() leaves the AI paused
+    aiManager.setRandomSeed(seed);
+    aiManager.configureThreading(threaded, threaded ? std::thread::hardware_concurrency() : 0);
+
+    auto wander = std::make_shared<WanderBehavior>(60.0f, 250.0f, 200.0f);
+    auto idle = std::make_shared<IdleBehavior>(IdleBehavior::IdleMode::LIGHT_FIDGET, 30.0f);
+    auto guard = std::make_shared<GuardBehavior>(GuardBehavior::GuardMode::ROAMING_GUARD, Vector2D(600.0f, 400.0f));
+    guard->setGuardArea(Vector2D(600.0f, 400.0f), 300.0f);
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(wander);
+        g_allBehaviors.push_back(idle);
+        g_allBehaviors.push_back(guard);
+    }
+    aiManager.registerBehavior("Wander", wander);
+    aiManager.registerBehavior("Idle", idle);
+    aiManager.registerBehavior("Guard", guard);
+
+    static const char* const BEHAVIORS[] = {"Wander", "Idle", "Guard"};
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entities[i]->setPosition(Vector2D(static_cast<float>(i % 50) * 24.0f, static_cast<float>(i / 50) * 24.0f));
+        entities[i]->setVelocity(Vector2D(0.0f, 0.0f));
+        aiManager.registerEntityForUpdates(entities[i], 5, BEHAVIORS[i % 3]);
+    }
+    aiManager.processPendingBehaviorAssignments();
+
+    for (int frame = 0; frame < frames; ++frame) {
+        aiManager.update(0.016f);
+    }
+
+    std::vector<Vector2D> positions;
+    positions.reserve(entities.size());
+    for (const auto& entity : entities) {
+        positions.push_back(entity->getPosition());
+        aiManager.unregisterEntityFromUpdates(entity);
+    }
+    aiManager.resetBehaviors();
+    return positions;
+}
+
+size_t countMismatches(const std::vector<Vector2D>& a, const std::vector<Vector2D>& b) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        // Bit-for-bit: the same operations on the same inputs
+        if (a[i].getX() != b[i].getX() || a[i].getY() != b[i].getY()) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+// The same seed gives the same world on one thread and on many
+BOOST_FIXTURE_TEST_CASE(TestSeededRunsMatchAcrossThreadCounts, ThreadedAITestFixture) {
+    std::cout << "Starting TestSeededRunsMatchAcrossThreadCounts..." << std::endl;
+    const int NUM_ENTITIES = 2000;   // Above the threading threshold
+    const int NUM_FRAMES = 300;
+    const uint64_t SEED = 0x5EEDF00Dull;
+
+    std::vector<std::shared_ptr<DriftingEntity>> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(std::make_shared<DriftingEntity>(Vector2D(0.0f, 0.0f)));
+    }
+
+    const uint64_t previousSeed = AIManager::Instance().getRandomSeed();
+    auto singleThreaded = runSeededWorld(entities, SEED, false, NUM_FRAMES);
+    auto multiThreaded = runSeededWorld(entities, SEED, true, NUM_FRAMES);
+    auto reseeded = runSeededWorld(entities, SEED + 1, true, NUM_FRAMES);
+    AIManager::Instance().setRandomSeed(previousSeed);
+
+    size_t threadMismatches = countMismatches(singleThreaded, multiThreaded);
+    size_t seedMismatches = countMismatches(singleThreaded, reseeded);
+    std::cout << "1 vs " << std::thread::hardware_concurrency() << " threads: " << threadMismatches
+              << " of " << NUM_ENTITIES << " positions differ; another seed: " << seedMismatches
+              << " differ" << std::endl;
+
+    BOOST_CHECK_EQUAL(threadMismatches, 0u);
+    // The seed really drives the behaviors
+    BOOST_CHECK_GT(seedMismatches, static_cast<size_t>(NUM_ENTITIES / 2));
+
+    AIManager::Instance().configureThreading(true, std::thread::hardware_concurrency());
+    std::cout << "TestSeededRunsMatchAcrossThreadCounts completed" << std::endl;
+}
+
+// Queued messages reach their recipients inside the threaded update, without
+// string compares, and a full inbox drops and counts instead of overwriting
+BOOST_FIXTURE_TEST_CASE(TestQueuedMessageInboxes, ThreadedAITestFixture) {
+    std::cout << "Starting TestQueuedMessageInboxes..." << std::endl;
+    const int NUM_ENTITIES = 1200;   // Above the threading threshold
+    const int NUM_IGNORED_BROADCASTS = 50;
+    const int FLOOD_MESSAGES = 6000; // More than the inbox holds
+
+    AIManager& aiManager = AIManager::Instance();
+    std::vector<std::shared_ptr<TestEntity>> entities;
+    uint32_t maxIndex = 0;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(std::make_shared<TestEntity>(Vector2D(static_cast<float>(i), 0.0f)));
+        maxIndex = std::max(maxIndex, entities.back()->getHandle().index);
+    }
+
+    auto inbox = std::make_shared<InboxBehavior>(maxIndex + 1);
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(inbox);
+    }
+    aiManager.registerBehavior("Inbox", inbox);
+    for (auto& entity : entities) {
+        aiManager.assignBehaviorToEntity(entity, "Inbox");
+    }
+    aiManager.update(0.016f);
+
+    // One direct ping each from a neighbour, one accepted broadcast and a
+    // run of broadcasts the behavior does not accept
+    const uint64_t deliveredBefore = aiManager.getDeliveredMessageCount();
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        EntityHandle sender = entities[static_cast<size_t>((i + 1) % NUM_ENTITIES)]->getHandle();
+        aiManager.sendMessageToEntity(entities[static_cast<size_t>(i)],
+            AIMessage(InboxBehavior::PING, sender, Vector2D(0.0f, 0.0f),
+                      static_cast<float>(entities[static_cast<size_t>(i)]->getHandle().index)));
+    }
+    for (int i = 0; i < NUM_IGNORED_BROADCASTS; ++i) {
+        aiManager.broadcastMessage(AIMessage(AIMessages::COORDINATE_ATTACK));
+    }
+    aiManager.broadcastMessage(AIMessage(InboxBehavior::PING));
+    aiManager.update(0.016f);
+
+    int wrongCounts = 0;
+    int badPayloads = 0;
+    for (auto& entity : entities) {
+        const InboxBehavior::Tracker& tracker = inbox->m_trackers[entity->getHandle().index];
+        if (tracker.direct.load() != 1 || tracker.broadcast.load() != 1) {
+            ++wrongCounts;
+        }
+        badPayloads += tracker.badPayloads.load();
+    }
+    BOOST_CHECK_EQUAL(wrongCounts, 0);
+    BOOST_CHECK_EQUAL(badPayloads, 0);
+    BOOST_CHECK_EQUAL(inbox->m_rejected.load(), 0);
+    // Every entity was due, so its batch delivered before updating it
+    BOOST_CHECK_EQUAL(inbox->m_deliveredBeforeUpdate.load(), NUM_ENTITIES);
+    BOOST_CHECK_EQUAL(aiManager.getDeliveredMessageCount() - deliveredBefore,
+                      static_cast<uint64_t>(NUM_ENTITIES * 2));
+
+    // Flood the inbox between frames: what does not fit is counted, and
+    // everything that fit is delivered by the next update
+    const uint64_t droppedBefore = aiManager.getDroppedMessageCount();
+    const uint64_t deliveredBeforeFlood = aiManager.getDeliveredMessageCount();
+    for (int i = 0; i < FLOOD_MESSAGES; ++i) {
+        aiManager.sendMessageToEntity(entities[static_cast<size_t>(i % NUM_ENTITIES)], "inbox_ping");
+    }
+    aiManager.update(0.016f);
+    const uint64_t dropped = aiManager.getDroppedMessageCount() - droppedBefore;
+    const uint64_t delivered = aiManager.getDeliveredMessageCount() - deliveredBeforeFlood;
+    std::cout << "Flood of " << FLOOD_MESSAGES << ": " << delivered << " delivered, " << dropped
+              << " dropped" << std::endl;
+    BOOST_CHECK_GT(dropped, 0u);
+    BOOST_CHECK_EQUAL(dropped + delivered, static_cast<uint64_t>(FLOOD_MESSAGES));
+
+    // The drained inbox takes messages again
+    aiManager.sendMessageToEntity(entities[0], "inbox_ping");
+    aiManager.update(0.016f);
+    BOOST_CHECK_EQUAL(aiManager.getDroppedMessageCount(), droppedBefore + dropped);
+
+    for (auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestQueuedMessageInboxes completed" << std::endl;
+}
+
+// An immediate message sent from inside a batch cannot wait for the batch to
+// finish; it is queued and arrives with the next update
+BOOST_FIXTURE_TEST_CASE(TestImmediateMessageFromBatch, ThreadedAITestFixture) {
+    std::cout << "Starting TestImmediateMessageFromBatch..." << std::endl;
+    const int NUM_ENTITIES = 1200;   // Above the threading threshold
+
+    AIManager& aiManager = AIManager::Instance();
+    std::vector<std::shared_ptr<TestEntity>> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(std::make_shared<TestEntity>(Vector2D(static_cast<float>(i), 0.0f)));
+    }
+
+    auto sender = std::make_shared<ImmediateSenderBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(sender);
+    }
+    aiManager.registerBehavior("ImmediateSender", sender);
+    for (auto& entity : entities) {
+        aiManager.assignBehaviorToEntity(entity, "ImmediateSender");
+    }
+
+    // Would deadlock if the sends took the execution lock
+    aiManager.update(0.016f);
+    BOOST_CHECK_EQUAL(sender->m_received.load(), 0);
+
+    sender->m_sending.store(false, std::memory_order_relaxed);
+    aiManager.update(0.016f);
+    BOOST_CHECK_EQUAL(sender->m_received.load(), NUM_ENTITIES);
+
+    for (auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestImmediateMessageFromBatch completed" << std::endl;
+}
+
+// Radius and group broadcasts reach exactly the entities in scope, minus the
+// sender, and group membership follows unregistration
+BOOST_FIXTURE_TEST_CASE(TestScopedBroadcasts, ThreadedAITestFixture) {
+    std::cout << "Starting TestScopedBroadcasts..." << std::endl;
+    const int NUM_ENTITIES = 1200;   // Above the threading threshold
+    const float SPACING = 10.0f;
+    const uint32_t GROUP = 7;
+
+    AIManager& aiManager = AIManager::Instance();
+    std::vector<std::shared_ptr<TestEntity>> entities;
+    uint32_t maxIndex = 0;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(std::make_shared<TestEntity>(Vector2D(static_cast<float>(i) * SPACING, 0.0f)));
+        maxIndex = std::max(maxIndex, entities.back()->getHandle().index);
+    }
+
+    auto inbox = std::make_shared<InboxBehavior>(maxIndex + 1);
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(inbox);
+    }
+    aiManager.registerBehavior("Inbox", inbox);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        aiManager.registerEntityForUpdates(entities[static_cast<size_t>(i)], 5, "Inbox");
+        if (i % 10 == 0) {
+            aiManager.setEntityGroup(entities[static_cast<size_t>(i)], GROUP);
+        }
+    }
+    aiManager.processPendingBehaviorAssignments();
+    aiManager.update(0.016f);   // Publishes the positions radius queries run against
+    BOOST_CHECK_EQUAL(aiManager.getGroupSize(GROUP), static_cast<size_t>(NUM_ENTITIES / 10));
+
+    auto scopedCounts = [&]() {
+        std::vector<int> counts;
+        for (auto& entity : entities) {
+            counts.push_back(inbox->m_trackers[entity->getHandle().index].scoped.exchange(0));
+        }
+        return counts;
+    };
+
+    // Entity 100 calls out to everyone within 95 units: entities 91..109
+    const size_t sender = 100;
+    aiManager.broadcastInRadius(entities[sender]->getPosition(), 95.0f,
+                                AIMessage(InboxBehavior::SCOPED_PING, entities[sender]->getHandle()));
+    aiManager.update(0.016f);
+    std::vector<int> counts = scopedCounts();
+    int radiusWrong = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        int expected = (i >= 91 && i <= 109 && i != sender) ? 1 : 0;
+        radiusWrong += (counts[i] != expected) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(radiusWrong, 0);
+
+    // Group 7 holds every tenth entity
+    aiManager.broadcastToGroup(GROUP, AIMessage(InboxBehavior::SCOPED_PING, entities[sender]->getHandle()));
+    aiManager.update(0.016f);
+    counts = scopedCounts();
+    int groupWrong = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        int expected = (i % 10 == 0 && i != sender) ? 1 : 0;
+        groupWrong += (counts[i] != expected) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(groupWrong, 0);
+
+    // Unregistering leaves the group
+    aiManager.unregisterEntityFromUpdates(entities[0]);
+    BOOST_CHECK_EQUAL(aiManager.getEntityGroup(entities[0]), 0u);
+    BOOST_CHECK_EQUAL(aiManager.getGroupSize(GROUP), static_cast<size_t>(NUM_ENTITIES / 10 - 1));
+
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    BOOST_CHECK_EQUAL(aiManager.getGroupSize(GROUP), 0u);
+    aiManager.resetBehaviors();
+
+    std::cout << "TestScopedBroadcasts completed" << std::endl;
+}
+
+// Despawning most of a large population spreads slot releases over several
+// frames instead of stalling one, and later spawns reuse the released slots
+BOOST_FIXTURE_TEST_CASE(TestIncrementalCleanupFrameTimes, ThreadedAITestFixture) {
+    std::cout << "Starting TestIncrementalCleanupFrameTimes..." << std::endl;
+    const int NUM_ENTITIES = 20000;
+    const int WARMUP_FRAMES = 10;
+    const int MEASURED_FRAMES = 60;   // The sweep visits every slot within the first 20
+    const int TRIALS = 3;             // Each frame keeps its best time, to ride out scheduler noise
+
+    AIManager& aiManager = AIManager::Instance();
+    auto behavior = std::make_shared<BatchRecordingBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(behavior);
+    }
+    aiManager.registerBehavior("CleanupLoad", behavior);
+
+    std::vector<std::shared_ptr<TestEntity>> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(TestEntity::create(Vector2D(static_cast<float>(i % 200) * 16.0f,
+                                                       static_cast<float>(i / 200) * 16.0f)));
+        aiManager.registerEntityForUpdates(entities.back(), 5, "CleanupLoad");
+    }
+    aiManager.processPendingBehaviorAssignments();
+
+    // Four in five entities despawn, scattered through storage
+    auto despawns = [](int i) { return i % 5 != 0; };
+    auto storedSlots = [&aiManager]() { return aiManager.getPositionSnapshot()->handles.size(); };
+    auto liveSlots = [&aiManager]() {
+        auto snapshot = aiManager.getPositionSnapshot();
+        return static_cast<size_t>(std::count_if(snapshot->handles.begin(), snapshot->handles.end(),
+            [](const EntityHandle& handle) { return handle.isValid(); }));
+    };
+
+    std::vector<double> frameMs(MEASURED_FRAMES, std::numeric_limits<double>::max());
+    for (int trial = 0; trial < TRIALS; ++trial) {
+        if (trial > 0) {
+            // Respawn into the slots the previous trial released
+            for (int i = 0; i < NUM_ENTITIES; ++i) {
+                if (despawns(i)) {
+                    aiManager.assignBehaviorToEntity(entities[static_cast<size_t>(i)], "CleanupLoad");
+                }
+            }
+        }
+        for (int frame = 0; frame < WARMUP_FRAMES; ++frame) {
+            aiManager.update(0.016f);
+        }
+        BOOST_CHECK_EQUAL(storedSlots(), static_cast<size_t>(NUM_ENTITIES));
+        BOOST_CHECK_EQUAL(liveSlots(), static_cast<size_t>(NUM_ENTITIES));
+
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            if (despawns(i)) {
+                aiManager.unassignBehaviorFromEntity(entities[static_cast<size_t>(i)]);
+            }
+        }
+
+        for (int frame = 0; frame < MEASURED_FRAMES; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            aiManager.update(0.016f);
+            frameMs[static_cast<size_t>(frame)] = std::min(frameMs[static_cast<size_t>(frame)],
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        BOOST_CHECK_EQUAL(liveSlots(), static_cast<size_t>(NUM_ENTITIES / 5));
+    }
+
+    // A release stall shows up in every trial; a preempted frame does not
+    std::vector<double> sorted = frameMs;
+    std::nth_element(sorted.begin(), sorted.begin() + MEASURED_FRAMES / 2, sorted.end());
+    const double median = sorted[MEASURED_FRAMES / 2];
+    const double worst = *std::max_element(frameMs.begin(), frameMs.end());
+    std::cout << "Mass despawn frames: median " << median << "ms, worst " << worst << "ms" << std::endl;
+    BOOST_CHECK_LE(worst, 2.0 * median);
+
+    for (auto& entity : entities) {
+        aiManager.unregisterEntityFromUpdates(entity);
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestIncrementalCleanupFrameTimes completed" << std::endl;
+}
+
+// A render-side reader gets whole position snapshots without locking while
+// update() keeps publishing new ones
+BOOST_FIXTURE_TEST_CASE(TestLockFreePositionSnapshot, ThreadedAITestFixture) {
+    std::cout << "Starting TestLockFreePositionSnapshot..." << std::endl;
+    const int NUM_ENTITIES = 1500;
+    const int NUM_UPDATES = 200;
+
+    AIManager& aiManager = AIManager::Instance();
+    auto batched = std::make_shared<BatchRecordingBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(batched);
+    }
+    aiManager.registerBehavior("Wander", batched);
+
+    // No player: every entity updates every frame, so all of a snapshot's
+    // entities have moved the same distance from where they started
+    std::vector<std::shared_ptr<SteppingEntity>> entities;
+    std::unordered_map<EntityHandle, float> startX;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        auto entity = std::make_shared<SteppingEntity>(Vector2D(i * 10.0f, 0.0f));
+        startX[entity->getHandle()] = i * 10.0f;
+        entities.push_back(entity);
+        aiManager.assignBehaviorToEntity(entity, "Wander");
+    }
+    aiManager.update(0.016f);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> snapshotsRead{0};
+    std::thread renderThread([&]() {
+        uint64_t lastFrame = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto snapshot = aiManager.getPositionSnapshot();
+            const AISpatialGrid& grid = snapshot->grid;
+            if (snapshot->frameNumber < lastFrame || snapshot->handles.size() != grid.getSlotCount()) {
+                inconsistent.fetch_add(1, std::memory_order_relaxed);
+            }
+            lastFrame = snapshot->frameNumber;
+
+            bool haveStep = false;
+            float step = 0.0f;
+            for (uint32_t slot = 0; slot < grid.getSlotCount(); ++slot) {
+                auto it = startX.find(snapshot->handles[slot]);
+                if (!grid.contains(slot) || it == startX.end()) {
+                    continue;
+                }
+                float moved = grid.getPositionX(slot) - it->second;
+                if (!haveStep) {
+                    step = moved;
+                    haveStep = true;
+                } else if (moved != step) {
+                    inconsistent.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            snapshotsRead.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (int i = 0; i < NUM_UPDATES; ++i) {
+        aiManager.update(0.016f);
+    }
+    done.store(true, std::memory_order_release);
+    renderThread.join();
+
+    // The latest snapshot is the end of the last update
+    {
+        auto snapshot = aiManager.getPositionSnapshot();
+        BOOST_REQUIRE_EQUAL(snapshot->handles.size(), entities.size());
+        uint32_t slot = 0;
+        BOOST_REQUIRE(snapshot->grid.contains(slot));
+        BOOST_CHECK_EQUAL(snapshot->grid.getPositionX(slot) - startX[snapshot->handles[slot]],
+                          static_cast<float>(NUM_UPDATES + 1));
+    }
+    std::cout << "Render thread read " << snapshotsRead.load() << " snapshots" << std::endl;
+    BOOST_CHECK_EQUAL(inconsistent.load(), 0);
+    BOOST_CHECK_GT(snapshotsRead.load(), 0);
+
+    for (auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestLockFreePositionSnapshot completed" << std::endl;
+}
+
+// Entities stacked on one spot stay there without crowd steering and spread
+// apart with it, even though their behavior keeps asking to stand still
+BOOST_FIXTURE_TEST_CASE(TestCrowdSteeringSpreadsStackedEntities, ThreadedAITestFixture) {
+    std::cout << "Starting TestCrowdSteeringSpreadsStackedEntities..." << std::endl;
+    const int NUM_CLUSTERS = 100;
+    const int CLUSTER_SIZE = 10;      // 1000 entities, above the threading threshold
+    const float CLUSTER_SPACING = 500.0f;
+
+    AIManager& aiManager = AIManager::Instance();
+    auto hold = std::make_shared<HoldPositionBehavior>();
+    {
+        std::lock_guard<std::mutex> lock(g_behaviorMutex);
+        g_allBehaviors.push_back(hold);
+    }
+    aiManager.registerBehavior("HoldPosition", hold);
+
+    std::vector<std::shared_ptr<DriftingEntity>> entities;
+    std::vector<Vector2D> centers;
+    for (int c = 0; c < NUM_CLUSTERS; ++c) {
+        centers.emplace_back(static_cast<float>(c % 10) * CLUSTER_SPACING, static_cast<float>(c / 10) * CLUSTER_SPACING);
+        for (int i = 0; i < CLUSTER_SIZE; ++i) {
+            entities.push_back(std::make_shared<DriftingEntity>(centers.back()));
+            aiManager.assignBehaviorToEntity(entities.back(), "HoldPosition");
+        }
+    }
+
+    auto closestPair = [&]() {
+        float closest = std::numeric_limits<float>::max();
+        for (int c = 0; c < NUM_CLUSTERS; ++c) {
+            for (int i = 0; i < CLUSTER_SIZE; ++i) {
+                for (int j = i + 1; j < CLUSTER_SIZE; ++j) {
+                    const Vector2D a = entities[static_cast<size_t>(c * CLUSTER_SIZE + i)]->getPosition();
+                    const Vector2D b = entities[static_cast<size_t>(c * CLUSTER_SIZE + j)]->getPosition();
+                    closest = std::min(closest, (a - b).length());
+                }
+            }
+        }
+        return closest;
+    };
+
+    // Off by default
+    BOOST_CHECK(!aiManager.getCrowdSettings().enabled);
+    for (int frame = 0; frame < 10; ++frame) {
+        aiManager.update(0.016f);
+    }
+    BOOST_CHECK_EQUAL(closestPair(), 0.0f);
+
+    CrowdSettings crowd;
+    crowd.enabled = true;
+    crowd.neighborRadius = 48.0f;
+    crowd.separationRadius = 32.0f;
+    crowd.maxPushSpeed = 120.0f;
+    crowd.maxNeighbors = 1000;   // Clamped to what one query holds
+    aiManager.setCrowdSettings(crowd);
+    BOOST_CHECK_EQUAL(aiManager.getCrowdSettings().maxNeighbors, static_cast<uint32_t>(CrowdSteering::MAX_NEIGHBORS));
+
+    for (int frame = 0; frame < 120; ++frame) {
+        aiManager.update(0.016f);
+    }
+    const float spread = closestPair();
+    std::cout << "Closest pair after 120 crowd frames: " << spread << std::endl;
+    BOOST_CHECK_GT(spread, 8.0f);
+
+    // Pushed apart, not away: every entity stays near its cluster
+    float farthest = 0.0f;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        farthest = std::max(farthest, (entities[i]->getPosition() - centers[i / CLUSTER_SIZE]).length());
+    }
+    BOOST_CHECK_LT(farthest, 100.0f);
+
+    // Snapshots carry the velocities alignment reads
+    {
+        auto snapshot = aiManager.getPositionSnapshot();
+        BOOST_CHECK_EQUAL(snapshot->velocityX.size(), snapshot->grid.getSlotCount());
+        BOOST_CHECK_EQUAL(snapshot->velocityY.size(), snapshot->grid.getSlotCount());
+    }
+
+    aiManager.setCrowdSettings(CrowdSettings{});
+    for (auto& entity : entities) {
+        aiManager.unassignBehaviorFromEntity(entity);
+    }
+    aiManager.resetBehaviors();
+
+    std::cout << "TestCrowdSteeringSpreadsStackedEntities completed" << std::endl;
+}
+
 // Stress test for the thread-safe AIManager
 BOOST_FIXTURE_TEST_CASE(StressTestThreadSafeAIManager, ThreadedAITestFixture) {
     std::cout << "Starting StressTestThreadSafeAIManager..." << std::endl;
@@ -539,6 +539,162 @@ BOOST_AUTO_TEST_CASE(TestBurstTaskSubmission) {
     std::cout << "Burst testing completed successfully" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(TestQueueOverflowPolicies) {
+    // Standalone queue with no consumers so ring fullness is deterministic
+    Hammer::TaskQueue queue(64, false, Hammer::QueueOverflowPolicy::Reject);
+    const size_t ringCapacity = queue.ringCapacity();
+    int executed = 0;
+
+    for (size_t i = 0; i < ringCapacity; ++i) {
+        BOOST_CHECK(queue.push([&executed]() { executed++; }, Hammer::TaskPriority::Normal));
+    }
+    // Ring is full - Reject policy drops the task and accounts for it
+    BOOST_CHECK(!queue.push([&executed]() { executed++; }, Hammer::TaskPriority::Normal));
+    BOOST_CHECK_EQUAL(queue.getTaskStats(Hammer::TaskPriority::Normal).rejected, 1);
+    BOOST_CHECK_EQUAL(queue.size(), ringCapacity);
+
+    // Spill policy keeps accepting and preserves FIFO order across ring + overflow
+    queue.setOverflowPolicy(Hammer::QueueOverflowPolicy::Spill);
+    std::vector<int> order;
+    const int spilledTasks = 10;
+    for (int i = 0; i < spilledTasks; ++i) {
+        BOOST_CHECK(queue.push([&order, i]() { order.push_back(i); }, Hammer::TaskPriority::Normal));
+    }
+    BOOST_CHECK_EQUAL(queue.getTaskStats(Hammer::TaskPriority::Normal).spilled, static_cast<size_t>(spilledTasks));
+    BOOST_CHECK_EQUAL(queue.size(), ringCapacity + spilledTasks);
+
+    Hammer::Task task;
+    while (queue.tryPop(task)) {
+        task();
+    }
+    BOOST_CHECK(queue.isEmpty());
+    BOOST_CHECK_EQUAL(executed, static_cast<int>(ringCapacity));
+    BOOST_REQUIRE_EQUAL(order.size(), static_cast<size_t>(spilledTasks));
+    for (int i = 0; i < spilledTasks; ++i) {
+        BOOST_CHECK_EQUAL(order[i], i);
+    }
+
+    // Pop latency percentiles are populated and monotonic
+    auto stats = queue.getTaskStats(Hammer::TaskPriority::Normal);
+    BOOST_CHECK_EQUAL(stats.completed, ringCapacity + spilledTasks);
+    BOOST_CHECK_GT(stats.p50PopLatencyUs, 0.0);
+    BOOST_CHECK_LE(stats.p50PopLatencyUs, stats.p90PopLatencyUs);
+    BOOST_CHECK_LE(stats.p90PopLatencyUs, stats.p99PopLatencyUs);
+    BOOST_CHECK_LE(stats.p99PopLatencyUs, stats.maxPopLatencyUs);
+    std::cout << "Pop latency p50/p90/p99: " << stats.p50PopLatencyUs << "/"
+              << stats.p90PopLatencyUs << "/" << stats.p99PopLatencyUs << " us" << std::endl;
+
+    queue.stop();
+}
+
+BOOST_AUTO_TEST_CASE(TestWorkStealingNestedSubmission) {
+    // Tasks spawned from inside a worker go to that worker's own deque and
+    // must still all run (either locally or stolen by idle workers)
+    const int parentTasks = 8;
+    const int childrenPerParent = 64;
+    std::atomic<int> childrenCompleted{0};
+
+    size_t localBefore = Hammer::ThreadSystem::Instance().getTotalLocalTasks();
+    size_t contentionBefore = Hammer::ThreadSystem::Instance().getQueueContentionCount();
+
+    std::vector<std::future<void>> parents;
+    for (int p = 0; p < parentTasks; ++p) {
+        parents.push_back(Hammer::ThreadSystem::Instance().enqueueTaskWithResult(
+            [&childrenCompleted]() -> void {
+                for (int c = 0; c < childrenPerParent; ++c) {
+                    Hammer::ThreadSystem::Instance().enqueueTask([&childrenCompleted]() {
+                        volatile float work = 0.0f;
+                        for (int j = 0; j < 50; ++j) {
+                            work = work + std::sqrt(static_cast<float>(j + 1));
+                        }
+                        childrenCompleted.fetch_add(1, std::memory_order_relaxed);
+                    }, Hammer::TaskPriority::Normal, "Nested child task");
+                }
+            },
+            Hammer::TaskPriority::Normal,
+            "Nested parent task"
+        ));
+    }
+
+    for (auto& parent : parents) {
+        parent.wait();
+    }
+
+    // Wait for children with a bounded timeout
+    const int expected = parentTasks * childrenPerParent;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (childrenCompleted.load() < expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    BOOST_CHECK_EQUAL(childrenCompleted.load(), expected);
+
+    // Every child was submitted from a worker, so none touched the global queue
+    size_t localAfter = Hammer::ThreadSystem::Instance().getTotalLocalTasks();
+    BOOST_CHECK_GE(localAfter - localBefore, static_cast<size_t>(expected));
+
+    std::cout << "Worker-local tasks: " << (localAfter - localBefore)
+              << ", stolen: " << Hammer::ThreadSystem::Instance().getTotalTasksStolen()
+              << ", global queue contention: "
+              << (Hammer::ThreadSystem::Instance().getQueueContentionCount() - contentionBefore)
+              << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelFor) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    const size_t count = 10000;
+
+    // Every index is visited exactly once and all work is done on return
+    std::vector<std::atomic<int>> visits(count);
+    threadSystem.parallelFor(0, count, 64, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    bool allVisitedOnce = true;
+    for (const auto& visit : visits) {
+        allVisitedOnce = allVisitedOnce && visit.load() == 1;
+    }
+    BOOST_CHECK(allVisitedOnce);
+
+    // parallelForEach over a sub-range, with an explicit worker count
+    std::vector<int> values(count, 1);
+    threadSystem.parallelForEach(values.begin() + 100, values.end(), 128,
+                                 [](int& value) { value *= 3; }, 2);
+    long long sum = 0;
+    for (int value : values) {
+        sum += value;
+    }
+    BOOST_CHECK_EQUAL(sum, 100 + static_cast<long long>(count - 100) * 3);
+
+    // Zero workers runs the whole range inline on the caller
+    std::thread::id caller = std::this_thread::get_id();
+    bool allInline = true;
+    threadSystem.parallelFor(0, count, 16, [&](size_t, size_t) {
+        allInline = allInline && std::this_thread::get_id() == caller;
+    }, 0);
+    BOOST_CHECK(allInline);
+
+    // Nested calls from inside workers complete without deadlocking
+    std::atomic<size_t> nestedTotal{0};
+    threadSystem.parallelFor(0, 8, 1, [&](size_t outerBegin, size_t outerEnd) {
+        for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+            Hammer::ThreadSystem::Instance().parallelFor(0, 1000, 50,
+                [&nestedTotal](size_t begin, size_t end) {
+                    nestedTotal.fetch_add(end - begin, std::memory_order_relaxed);
+                }, 4);
+        }
+    }, 4);
+    BOOST_CHECK_EQUAL(nestedTotal.load(), 8000);
+
+    // The first exception thrown by a chunk reaches the caller
+    BOOST_CHECK_THROW(threadSystem.parallelFor(0, count, 10, [](size_t begin, size_t end) {
+        if (begin <= 5000 && 5000 < end) {
+            throw std::runtime_error("chunk failure");
+        }
+    }, 4), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(TestThreadSystemReinitialization) {
     // Clean up the current thread system
     performSafeCleanup();
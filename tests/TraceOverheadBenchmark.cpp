@@ -0,0 +1,190 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE TraceOverheadBenchmark
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "core/ThreadSystem.hpp"
+#include "core/TraceRecorder.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t ZONE_ITERATIONS = 10'000'000;
+constexpr size_t TASK_COUNT = 20'000;
+constexpr int TIMING_RUNS = 5;
+
+// Keeps the measured loops from being optimized away
+std::atomic<uint64_t> g_sink{0};
+
+double elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+// Best of several runs to filter scheduler noise
+template<typename Body>
+double bestNsPerIteration(size_t iterations, Body&& body) {
+    double best = 0.0;
+    for (int run = 0; run < TIMING_RUNS; ++run) {
+        auto start = Clock::now();
+        body();
+        double ns = elapsedNs(start, Clock::now()) / static_cast<double>(iterations);
+        best = (run == 0) ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+// Submit tiny tasks one by one and help until all have run
+void runTinyTasks(size_t count) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    std::atomic<size_t> completed{0};
+    for (size_t i = 0; i < count; ++i) {
+        threadSystem.enqueueTask([&completed]() {
+            g_sink.fetch_add(1, std::memory_order_relaxed);
+            completed.fetch_add(1, std::memory_order_release);
+        }, Hammer::TaskPriority::Normal, "TraceBench_Task");
+    }
+    while (completed.load(std::memory_order_acquire) < count) {
+        if (!threadSystem.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct ThreadSystemFixture {
+    ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4);
+    }
+    ~ThreadSystemFixture() {
+        Hammer::TraceRecorder::Instance().stop();
+        Hammer::ThreadSystem::Instance().clean();
+    }
+};
+
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSystemFixture);
+
+BOOST_AUTO_TEST_CASE(DisabledZoneOverhead) {
+    auto& recorder = Hammer::TraceRecorder::Instance();
+    recorder.stop();
+
+    double baselineNs = bestNsPerIteration(ZONE_ITERATIONS, [] {
+        for (size_t i = 0; i < ZONE_ITERATIONS; ++i) {
+            g_sink.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    double zoneNs = bestNsPerIteration(ZONE_ITERATIONS, [] {
+        for (size_t i = 0; i < ZONE_ITERATIONS; ++i) {
+            HAMMER_TRACE_ZONE("TraceBench_Zone");
+            g_sink.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Disabled zone: " << zoneNs << "ns/iteration vs " << baselineNs
+              << "ns without zone (+" << (zoneNs - baselineNs) << "ns)" << std::endl;
+
+    // A disabled zone is two relaxed loads and two branches
+    BOOST_CHECK_LT(zoneNs - baselineNs, 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(TaskTracingOverhead) {
+    auto& recorder = Hammer::TraceRecorder::Instance();
+    recorder.stop();
+    runTinyTasks(TASK_COUNT); // Warm up pools and deques
+
+    double disabledNs = bestNsPerIteration(TASK_COUNT, [] { runTinyTasks(TASK_COUNT); });
+
+    recorder.start(TASK_COUNT * TIMING_RUNS);
+    double enabledNs = bestNsPerIteration(TASK_COUNT, [] {
+        runTinyTasks(TASK_COUNT);
+    });
+    recorder.stop();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Tiny task: " << disabledNs << "ns/task tracing off, "
+              << enabledNs << "ns/task tracing on" << std::endl;
+
+    // Every executed task was recorded (capacity is large enough for all runs);
+    // the last task's event may land just after its completion is observed
+    BOOST_CHECK_GE(recorder.getEventCount() + 1, TASK_COUNT * TIMING_RUNS);
+    BOOST_CHECK_EQUAL(recorder.getDroppedEventCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ChromeTraceOutput) {
+    auto& recorder = Hammer::TraceRecorder::Instance();
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+
+    recorder.start();
+    std::atomic<int> done{0};
+    for (int i = 0; i < 8; ++i) {
+        threadSystem.enqueueTask([&done]() {
+            HAMMER_TRACE_ZONE("TraceBench_InnerZone");
+            done.fetch_add(1);
+        }, Hammer::TaskPriority::High, "TraceBench_Task");
+    }
+    threadSystem.enqueueTask([&done]() { done.fetch_add(1); },
+                             Hammer::TaskPriority::Low, std::string("TraceBench \"quoted\""));
+    {
+        HAMMER_TRACE_ZONE("TraceBench_CallerZone");
+        while (done.load() < 9) {
+            threadSystem.runPendingTask();
+        }
+    }
+    // Workers record after the task body returns; give them a moment
+    auto deadline = Clock::now() + std::chrono::seconds(2);
+    while (recorder.getEventCount() < 18 && Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    recorder.stop();
+
+    const std::string json = recorder.toChromeTraceJson();
+    BOOST_CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"TraceBench_Task\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"TraceBench_InnerZone\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"TraceBench_CallerZone\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"priority\":\"High\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"priority\":\"Low\"") != std::string::npos);
+    BOOST_CHECK(json.find("TraceBench \\\"quoted\\\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"thread_name\"") != std::string::npos);
+    BOOST_CHECK_EQUAL(std::count(json.begin(), json.end(), '{'), std::count(json.begin(), json.end(), '}'));
+
+    const std::string path = "trace_overhead_benchmark.json";
+    BOOST_REQUIRE(recorder.writeChromeTrace(path));
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    BOOST_CHECK_EQUAL(static_cast<size_t>(file.tellg()), json.size());
+    file.close();
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(FullBufferDropsNewEvents) {
+    auto& recorder = Hammer::TraceRecorder::Instance();
+    recorder.start(16);
+    for (int i = 0; i < 100; ++i) {
+        HAMMER_TRACE_ZONE("TraceBench_Overflow");
+    }
+    recorder.stop();
+
+    BOOST_CHECK_EQUAL(recorder.getEventCount(), 16);
+    BOOST_CHECK_EQUAL(recorder.getDroppedEventCount(), 84);
+
+    // Recording while stopped is a no-op
+    for (int i = 0; i < 10; ++i) {
+        HAMMER_TRACE_ZONE("TraceBench_Stopped");
+    }
+    BOOST_CHECK_EQUAL(recorder.getEventCount(), 16);
+}
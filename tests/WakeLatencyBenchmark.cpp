@@ -0,0 +1,180 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE WakeLatencyBenchmark
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/ThreadSystem.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned int WORKER_COUNT = 4;
+constexpr int SINGLE_TASK_SAMPLES = 200;
+constexpr int BURST_SAMPLES = 50;
+constexpr size_t BURST_SIZE = 64;
+
+template<typename Predicate>
+bool waitUntil(Predicate&& done, std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+    auto deadline = Clock::now() + timeout;
+    while (!done()) {
+        if (Clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// Start every sample from a fully parked pool so we measure a real wakeup
+bool waitForAllParked() {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    return waitUntil([&]() {
+        return threadSystem.getParkedWorkerCount() == threadSystem.getThreadCount();
+    }, std::chrono::seconds(2));
+}
+
+double percentileUs(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+    return samples[index];
+}
+
+void printLatency(const std::string& label, const std::vector<double>& samples) {
+    std::cout << std::left << std::setw(36) << label << std::fixed << std::setprecision(1)
+              << "p50 " << percentileUs(samples, 0.50) << "us, "
+              << "p99 " << percentileUs(samples, 0.99) << "us, "
+              << "max " << percentileUs(samples, 1.0) << "us" << std::endl;
+}
+
+double elapsedUs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+struct ThreadSystemFixture {
+    ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, WORKER_COUNT);
+    }
+    ~ThreadSystemFixture() {
+        Hammer::ThreadSystem::Instance().clean();
+    }
+};
+
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSystemFixture);
+
+BOOST_AUTO_TEST_CASE(IdleWorkersPark) {
+    // With nothing queued every worker must end up parked rather than polling
+    BOOST_CHECK(waitForAllParked());
+    BOOST_CHECK_EQUAL(Hammer::ThreadSystem::Instance().getParkedWorkerCount(), WORKER_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(SingleTaskWakeLatency) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    std::vector<double> samples;
+    samples.reserve(SINGLE_TASK_SAMPLES);
+    size_t extraWakeups = 0;
+
+    for (int sample = 0; sample < SINGLE_TASK_SAMPLES; ++sample) {
+        BOOST_REQUIRE(waitForAllParked());
+        const size_t wakeupsBefore = threadSystem.getTotalWorkerWakeups();
+
+        std::atomic<bool> ran{false};
+        Clock::time_point executed{};
+        const auto submitted = Clock::now();
+        threadSystem.enqueueTask([&]() {
+            executed = Clock::now();
+            ran.store(true, std::memory_order_release);
+        }, Hammer::TaskPriority::High, "WakeLatency_Single");
+
+        BOOST_REQUIRE(waitUntil([&]() { return ran.load(std::memory_order_acquire); }));
+        samples.push_back(elapsedUs(submitted, executed));
+
+        // One task must wake exactly one of the parked workers
+        const size_t wakeups = threadSystem.getTotalWorkerWakeups() - wakeupsBefore;
+        extraWakeups += wakeups > 1 ? wakeups - 1 : 0;
+        BOOST_CHECK_EQUAL(wakeups, 1);
+    }
+
+    printLatency("Single task wake-to-execute", samples);
+    BOOST_CHECK_EQUAL(extraWakeups, 0);
+    // Generous bound: the old backoff alone could add 500us per idle worker
+    BOOST_CHECK_LT(percentileUs(samples, 0.50), 2000.0);
+}
+
+BOOST_AUTO_TEST_CASE(BurstWakeLatency) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    std::vector<double> firstStartSamples;
+    std::vector<double> allDoneSamples;
+    firstStartSamples.reserve(BURST_SAMPLES);
+    allDoneSamples.reserve(BURST_SAMPLES);
+
+    for (int sample = 0; sample < BURST_SAMPLES; ++sample) {
+        BOOST_REQUIRE(waitForAllParked());
+        const size_t wakeupsBefore = threadSystem.getTotalWorkerWakeups();
+
+        std::atomic<size_t> completed{0};
+        std::atomic<int64_t> firstStartNs{INT64_MAX};
+        const auto submitted = Clock::now();
+
+        for (size_t i = 0; i < BURST_SIZE; ++i) {
+            threadSystem.enqueueTask([&]() {
+                int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - submitted).count();
+                int64_t current = firstStartNs.load(std::memory_order_relaxed);
+                while (now < current &&
+                       !firstStartNs.compare_exchange_weak(current, now, std::memory_order_relaxed)) {
+                }
+                completed.fetch_add(1, std::memory_order_release);
+            }, Hammer::TaskPriority::High, "WakeLatency_Burst");
+        }
+
+        BOOST_REQUIRE(waitUntil([&]() { return completed.load(std::memory_order_acquire) == BURST_SIZE; }));
+        const auto done = Clock::now();
+        firstStartSamples.push_back(static_cast<double>(firstStartNs.load()) / 1000.0);
+        allDoneSamples.push_back(elapsedUs(submitted, done));
+
+        // At most one wakeup per task (a worker may re-park mid-burst and be woken again)
+        BOOST_CHECK_LE(threadSystem.getTotalWorkerWakeups() - wakeupsBefore, BURST_SIZE);
+    }
+
+    printLatency("Burst of " + std::to_string(BURST_SIZE) + ": first task starts", firstStartSamples);
+    printLatency("Burst of " + std::to_string(BURST_SIZE) + ": all tasks done", allDoneSamples);
+    BOOST_CHECK_LT(percentileUs(firstStartSamples, 0.50), 2000.0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallBurstWakesOnlyWhatItNeeds) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+
+    for (size_t burst = 1; burst < WORKER_COUNT; ++burst) {
+        BOOST_REQUIRE(waitForAllParked());
+        const size_t wakeupsBefore = threadSystem.getTotalWorkerWakeups();
+
+        std::atomic<size_t> completed{0};
+        for (size_t i = 0; i < burst; ++i) {
+            threadSystem.enqueueTask([&]() {
+                completed.fetch_add(1, std::memory_order_release);
+            }, Hammer::TaskPriority::Normal, "WakeLatency_SmallBurst");
+        }
+        BOOST_REQUIRE(waitUntil([&]() { return completed.load(std::memory_order_acquire) == burst; }));
+
+        BOOST_CHECK_LE(threadSystem.getTotalWorkerWakeups() - wakeupsBefore, burst);
+    }
+}
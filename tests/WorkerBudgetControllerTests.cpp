@@ -0,0 +1,159 @@
+/* Copyright (c) 2025 Hammer Forged Games
+ * All rights reserved.
+ * Licensed under the MIT License - see LICENSE file for details
+*/
+
+#define BOOST_TEST_MODULE WorkerBudgetControllerTests
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include "core/ThreadSystem.hpp"
+#include "core/WorkerBudget.hpp"
+
+namespace {
+
+constexpr size_t HIGH_END_WORKERS = 12; // Baseline: engine 2, AI 6, events 3, buffer 1
+
+// Report one frame of load and close it
+bool runFrame(Hammer::WorkerBudgetController& controller, double aiMs, double eventMs) {
+    controller.reportWorkTime(Hammer::BudgetSubsystem::AI, aiMs);
+    controller.reportWorkTime(Hammer::BudgetSubsystem::Events, eventMs);
+    return controller.endFrame();
+}
+
+void checkBudgetEqual(const Hammer::WorkerBudget& actual, const Hammer::WorkerBudget& expected) {
+    BOOST_CHECK_EQUAL(actual.totalWorkers, expected.totalWorkers);
+    BOOST_CHECK_EQUAL(actual.engineReserved, expected.engineReserved);
+    BOOST_CHECK_EQUAL(actual.aiAllocated, expected.aiAllocated);
+    BOOST_CHECK_EQUAL(actual.eventAllocated, expected.eventAllocated);
+    BOOST_CHECK_EQUAL(actual.remaining, expected.remaining);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestStartsFromStaticBudget) {
+    Hammer::WorkerBudgetController controller;
+    controller.reset(HIGH_END_WORKERS);
+    checkBudgetEqual(controller.getBudget(), Hammer::calculateWorkerBudget(HIGH_END_WORKERS));
+
+    // No reported load means nothing to balance
+    for (int frame = 0; frame < 100; ++frame) {
+        BOOST_CHECK(!controller.endFrame());
+    }
+    checkBudgetEqual(controller.getBudget(), Hammer::calculateWorkerBudget(HIGH_END_WORKERS));
+    BOOST_CHECK_EQUAL(controller.getStats().frames, 100);
+}
+
+BOOST_AUTO_TEST_CASE(TestAIHeavyLoadShiftsWorkersWithHysteresis) {
+    Hammer::WorkerBudgetController controller;
+    controller.reset(HIGH_END_WORKERS);
+    const Hammer::WorkerBudget baseline = controller.getBudget();
+    const size_t allocatable = baseline.aiAllocated + baseline.eventAllocated;
+
+    // 90% AI load targets 8 of 9 workers; each step needs the full hysteresis window
+    std::vector<uint64_t> changeFrames;
+    for (uint64_t frame = 1; frame <= 200; ++frame) {
+        if (runFrame(controller, 9.0, 1.0)) {
+            changeFrames.push_back(frame);
+        }
+        Hammer::WorkerBudget budget = controller.getBudget();
+        BOOST_CHECK_EQUAL(budget.aiAllocated + budget.eventAllocated, allocatable);
+        BOOST_CHECK_EQUAL(budget.engineReserved, baseline.engineReserved);
+        BOOST_CHECK_EQUAL(budget.remaining, baseline.remaining);
+        BOOST_CHECK_GE(budget.eventAllocated, 1);
+    }
+
+    BOOST_REQUIRE_EQUAL(changeFrames.size(), 2);
+    BOOST_CHECK_EQUAL(changeFrames[0], Hammer::WorkerBudgetController::BUDGET_HYSTERESIS_FRAMES);
+    BOOST_CHECK_EQUAL(changeFrames[1], 2 * Hammer::WorkerBudgetController::BUDGET_HYSTERESIS_FRAMES);
+    BOOST_CHECK_EQUAL(controller.getBudget().aiAllocated, 8);
+    BOOST_CHECK_EQUAL(controller.getBudget().eventAllocated, 1);
+
+    // Every change is recorded, one worker at a time
+    auto decisions = controller.getRecentDecisions();
+    BOOST_REQUIRE_EQUAL(decisions.size(), 2);
+    BOOST_CHECK_EQUAL(decisions[0].aiAllocated, 7);
+    BOOST_CHECK_EQUAL(decisions[1].aiAllocated, 8);
+    BOOST_CHECK_EQUAL(decisions[1].frame, changeFrames[1]);
+    BOOST_CHECK_GT(decisions[1].aiLoadMs, decisions[1].eventLoadMs);
+
+    auto stats = controller.getStats();
+    BOOST_CHECK_EQUAL(stats.rebalances, 2);
+    BOOST_CHECK_EQUAL(stats.lastRebalanceFrame, changeFrames[1]);
+    BOOST_CHECK_CLOSE(stats.aiShare, 0.9, 1.0);
+    checkBudgetEqual(stats.baseline, baseline);
+
+    std::cout << "AI-heavy split after 200 frames: AI " << stats.budget.aiAllocated
+              << ", Events " << stats.budget.eventAllocated << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(TestEventHeavyLoadShiftsBack) {
+    Hammer::WorkerBudgetController controller;
+    controller.reset(HIGH_END_WORKERS);
+
+    for (int frame = 0; frame < 400; ++frame) {
+        runFrame(controller, 1.0, 9.0);
+    }
+    BOOST_CHECK_EQUAL(controller.getBudget().aiAllocated, 1);
+    BOOST_CHECK_EQUAL(controller.getBudget().eventAllocated, 8);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeadbandIgnoresSmallShifts) {
+    Hammer::WorkerBudgetController controller;
+    controller.reset(HIGH_END_WORKERS);
+    const Hammer::WorkerBudget baseline = controller.getBudget();
+
+    // 65% AI share is within the deadband of the baseline 6/9 split
+    for (int frame = 0; frame < 300; ++frame) {
+        BOOST_CHECK(!runFrame(controller, 6.5, 3.5));
+    }
+    checkBudgetEqual(controller.getBudget(), baseline);
+    BOOST_CHECK(controller.getRecentDecisions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestBriefSpikeDoesNotRebalance) {
+    Hammer::WorkerBudgetController controller;
+    controller.reset(HIGH_END_WORKERS);
+    const Hammer::WorkerBudget baseline = controller.getBudget();
+
+    // A spike shorter than the hysteresis window decays without a change
+    for (int cycle = 0; cycle < 10; ++cycle) {
+        for (int frame = 0; frame < 5; ++frame) {
+            runFrame(controller, 1.0, 20.0);
+        }
+        for (int frame = 0; frame < 20; ++frame) {
+            runFrame(controller, 6.0, 3.0);
+        }
+    }
+    checkBudgetEqual(controller.getBudget(), baseline);
+}
+
+BOOST_AUTO_TEST_CASE(TestLowEndTiersKeepStaticBudget) {
+    for (size_t workers : {0, 1, 2, 3, 4}) {
+        Hammer::WorkerBudgetController controller;
+        controller.reset(workers);
+        const Hammer::WorkerBudget baseline = Hammer::calculateWorkerBudget(workers);
+
+        for (int frame = 0; frame < 200; ++frame) {
+            BOOST_CHECK(!runFrame(controller, 1.0, 20.0));
+        }
+        checkBudgetEqual(controller.getBudget(), baseline);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestThreadSystemPublishesBudget) {
+    auto& threadSystem = Hammer::ThreadSystem::Instance();
+    BOOST_REQUIRE(threadSystem.init(Hammer::ThreadSystem::DEFAULT_QUEUE_CAPACITY, 4));
+
+    // Before any load is reported the adaptive budget matches the static one
+    checkBudgetEqual(threadSystem.getWorkerBudget(),
+                     Hammer::calculateWorkerBudget(threadSystem.getThreadCount()));
+
+    threadSystem.reportSubsystemWork(Hammer::BudgetSubsystem::AI, 2.0);
+    threadSystem.getWorkerBudgetController().endFrame();
+    BOOST_CHECK_GT(threadSystem.getWorkerBudgetController().getStats().aiLoadMs, 0.0);
+
+    threadSystem.clean();
+}